@@ -776,6 +776,7 @@ fi
 [[ -n $NOGITHUB ]] && CXXFLAGS_INCLUDES="$CXXFLAGS_INCLUDES -DTS_NO_GITHUB=1"
 [[ -n $ASSERTIONS ]] && CXXFLAGS_INCLUDES="$CXXFLAGS_INCLUDES -DTS_KEEP_ASSERTIONS=1"
 [[ -n $NOHWACCEL ]] && CXXFLAGS_INCLUDES="$CXXFLAGS_INCLUDES -DTS_NO_ARM_CRC32_INSTRUCTIONS=1"
+[[ -n $NOHWACCEL ]] && CXXFLAGS_INCLUDES="$CXXFLAGS_INCLUDES -DTS_NO_X86_PCLMUL_INSTRUCTIONS=1"
 [[ -n $NOHWACCEL ]] && CXXFLAGS_INCLUDES="$CXXFLAGS_INCLUDES -DTS_NO_ARM_AES_INSTRUCTIONS=1"
 [[ -n $NODEPRECATE ]] && CXXFLAGS_INCLUDES="$CXXFLAGS_INCLUDES -DTS_NODEPRECATE=1"
 
@@ -129,6 +129,8 @@ tsplugin {
     QMAKE_POST_LINK += cp $${TARGET}$$SO ../tsp $$escape_expand(\\n\\t)
     QMAKE_POST_LINK += mkdir -p ../tsprofiling $$escape_expand(\\n\\t)
     QMAKE_POST_LINK += cp $${TARGET}$$SO ../tsprofiling $$escape_expand(\\n\\t)
+    QMAKE_POST_LINK += mkdir -p ../tsbench $$escape_expand(\\n\\t)
+    QMAKE_POST_LINK += cp $${TARGET}$$SO ../tsbench $$escape_expand(\\n\\t)
 }
 libtscore {
     # Applications using libtscore shall use "CONFIG += libtscore".
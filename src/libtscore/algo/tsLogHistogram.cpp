@@ -0,0 +1,101 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsLogHistogram.h"
+
+
+//----------------------------------------------------------------------------
+// Reset the content of the histogram.
+//----------------------------------------------------------------------------
+
+void ts::LogHistogram::reset()
+{
+    _count.store(0, std::memory_order_relaxed);
+    _sum.store(0, std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+    for (auto& b : _buckets) {
+        b.store(0, std::memory_order_relaxed);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Accumulate one more data sample.
+//----------------------------------------------------------------------------
+
+void ts::LogHistogram::feed(uint64_t value)
+{
+    // Use atomic read-modify-write operations, the histogram may be concurrently reset from another thread.
+    _buckets[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(value, std::memory_order_relaxed);
+    uint64_t max = _max.load(std::memory_order_relaxed);
+    while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+        // max was reloaded by compare_exchange_weak(), retry.
+    }
+    _count.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+//----------------------------------------------------------------------------
+// Get statistics.
+//----------------------------------------------------------------------------
+
+double ts::LogHistogram::mean() const
+{
+    const uint64_t cnt = count();
+    return cnt == 0 ? 0.0 : double(sum()) / double(cnt);
+}
+
+uint64_t ts::LogHistogram::percentile(double percent) const
+{
+    // Use the sum of buckets instead of _count for consistency with the buckets.
+    std::array<uint64_t, BUCKET_COUNT> buckets;
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        total += buckets[i] = bucket(i);
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // Number of samples below or equal to the percentile.
+    const uint64_t limit = std::max<uint64_t>(1, uint64_t(std::ceil(double(total) * std::clamp(percent, 0.0, 100.0) / 100.0)));
+    uint64_t acc = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        acc += buckets[i];
+        if (acc >= limit) {
+            return std::min(BucketUpperBound(i), maximum());
+        }
+    }
+    return maximum();
+}
+
+
+//----------------------------------------------------------------------------
+// Format the non-empty buckets of the histogram as a string.
+//----------------------------------------------------------------------------
+
+ts::UString ts::LogHistogram::bucketsString() const
+{
+    UString str;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        const uint64_t cnt = bucket(i);
+        if (cnt > 0) {
+            if (!str.empty()) {
+                str.append(u", ");
+            }
+            if (i < 64) {
+                str.format(u"<%d:%d", uint64_t(1) << i, cnt);
+            }
+            else {
+                str.format(u"max:%d", cnt);
+            }
+        }
+    }
+    return str;
+}
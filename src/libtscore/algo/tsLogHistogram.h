@@ -0,0 +1,119 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Lock-free histogram with logarithmic buckets.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsUString.h"
+
+namespace ts {
+    //!
+    //! Lock-free histogram of unsigned integer values with logarithmic buckets.
+    //! @ingroup libtscore cpp
+    //!
+    //! Bucket 0 counts the zero values. Bucket @a n (n > 0) counts the values in the
+    //! range 2^(n-1) to 2^n - 1. The histogram can be fed, reset and read by any number
+    //! of threads, without synchronization. All updates are atomic read-modify-write
+    //! operations and are never lost. A reset which is concurrent with an update may
+    //! keep part of this update. The values which are read while the histogram is updated may be slightly
+    //! inconsistent (e.g. the total count may not exactly match the sum of all
+    //! buckets) but this is acceptable for monitoring purpose.
+    //!
+    class TSCOREDLL LogHistogram
+    {
+        TS_NOCOPY(LogHistogram);
+    public:
+        //!
+        //! Number of buckets in the histogram.
+        //!
+        static constexpr size_t BUCKET_COUNT = 65;
+
+        //!
+        //! Default constructor.
+        //!
+        LogHistogram() = default;
+
+        //!
+        //! Reset the content of the histogram.
+        //!
+        void reset();
+
+        //!
+        //! Accumulate one more data sample.
+        //! @param [in] value Data sample.
+        //!
+        void feed(uint64_t value);
+
+        //!
+        //! Get the number of accumulated samples.
+        //! @return The number of accumulated samples.
+        //!
+        uint64_t count() const { return _count.load(std::memory_order_relaxed); }
+
+        //!
+        //! Get the sum of all accumulated samples.
+        //! @return The sum of all accumulated samples.
+        //!
+        uint64_t sum() const { return _sum.load(std::memory_order_relaxed); }
+
+        //!
+        //! Get the maximum value of all accumulated samples.
+        //! @return The maximum value.
+        //!
+        uint64_t maximum() const { return _max.load(std::memory_order_relaxed); }
+
+        //!
+        //! Get the mean value of all accumulated samples.
+        //! @return The mean value, zero if there is no sample.
+        //!
+        double mean() const;
+
+        //!
+        //! Get the number of samples in a bucket.
+        //! @param [in] index Bucket index, from 0 to BUCKET_COUNT - 1.
+        //! @return The number of samples in the bucket.
+        //!
+        uint64_t bucket(size_t index) const { return index < BUCKET_COUNT ? _buckets[index].load(std::memory_order_relaxed) : 0; }
+
+        //!
+        //! Get the index of the bucket which counts a value.
+        //! @param [in] value A data sample.
+        //! @return The index of the bucket for @a value.
+        //!
+        static size_t BucketIndex(uint64_t value) { return value == 0 ? 0 : 64 - size_t(std::countl_zero(value)); }
+
+        //!
+        //! Get the highest value which is counted by a bucket.
+        //! @param [in] index Bucket index, from 0 to BUCKET_COUNT - 1.
+        //! @return The highest value which is counted by the bucket.
+        //!
+        static uint64_t BucketUpperBound(size_t index) { return index >= 64 ? ~uint64_t(0) : (uint64_t(1) << index) - 1; }
+
+        //!
+        //! Get an approximation of a percentile of all accumulated samples.
+        //! @param [in] percent The percentile, from 0 to 100. For instance, 50 is the median.
+        //! @return The upper bound of the bucket which contains the percentile, bounded by the maximum value.
+        //!
+        uint64_t percentile(double percent) const;
+
+        //!
+        //! Format the non-empty buckets of the histogram as a string.
+        //! @return A string like "<1:0, <2:12, <4:25".
+        //!
+        UString bucketsString() const;
+
+    private:
+        std::atomic<uint64_t> _count {0};
+        std::atomic<uint64_t> _sum {0};
+        std::atomic<uint64_t> _max {0};
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> _buckets {};
+    };
+}
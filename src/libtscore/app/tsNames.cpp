@@ -9,6 +9,9 @@
 #include "tsNames.h"
 #include "tsFileUtils.h"
 #include "tsIntegerUtils.h"
+#include "tsEnvironment.h"
+#include "tsByteBlock.h"
+#include "tsCRC32.h"
 #include "tsCerrReport.h"
 
 // Limit the number of inheritance levels to avoid infinite loop.
@@ -175,12 +178,14 @@ void ts::Names::addValueImplLocked(const NameValue& range)
     }
 }
 
-void ts::Names::addValueImplLocked(const UString& name, uint_t first, uint_t last)
+void ts::Names::addValueImplLocked(UString name, uint_t first, uint_t last)
 {
-    _entries.insert(std::make_pair(first, std::make_shared<ValueRange>(first, last, name)));
+    // Values are usually added in increasing order, the end of the map is the most probable insertion point.
+    const auto range = std::make_shared<ValueRange>(first, last, std::move(name));
+    _entries.emplace_hint(_entries.end(), first, range);
     for (auto vis : _visitors) {
         for (uint_t i = first; i <= last; ++i) {
-            vis->handleNameValue(*this, i, name);
+            vis->handleNameValue(*this, i, range->name);
         }
     }
 }
@@ -872,44 +877,45 @@ bool ts::Names::AllInstances::loadFileLocked(const UString& file_name)
     _loaded_files.insert(full_path);
 
     CERR.debug(u"loading names from %s, aliases: %s", full_path, UString::Join(names));
-    std::ifstream strm(full_path.toUTF8().c_str());
-    if (!strm) {
-        CERR.error(u"error opening file %s", full_path);
-        return false;
+
+    // Decode the file from its compiled cache if up to date, from the text file otherwise.
+    DirectiveVector directives;
+    size_t error_count = 0;
+    const UString cache_file(CacheFileName(full_path));
+    if (cache_file.empty() || !LoadCache(cache_file, full_path, directives)) {
+        if (!LoadText(full_path, directives, error_count)) {
+            return false;
+        }
+        // Do not cache files with errors, errors shall be reported each time.
+        if (error_count == 0 && !cache_file.empty()) {
+            SaveCache(cache_file, full_path, directives);
+        }
     }
 
-    // Read configuration file line by line.
-    UString line;
+    // Apply the directives on sections, in order of appearance in the file.
     std::set<UString> section_names;
     NamesPtr section;
-    size_t error_count = 0;
+    UStringVector text_lines;  // Lines of the text file, loaded on error only.
 
     try {
-        for (size_t line_number = 1; line.getLine(strm); ++line_number) {
-
-            // Remove leading and trailing spaces in line.
-            line.trim();
-
-            if (line.empty() || line[0] == UChar('#')) {
-                // Empty or comment line, ignore.
-            }
-            else if (line.front() == UChar('[') && line.back() == UChar(']')) {
-                // Handle beginning of section, get section name.
-                line.erase(0, 1);
-                line.pop_back();
-                section_names.insert(line);
+        for (auto& dir : directives) {
+            if (dir.type == Directive::SECTION) {
+                section_names.insert(dir.text);
                 // Unlock previous section.
                 if (section != nullptr) {
                     section->_mutex.unlock();
                 }
                 // Get or create associated section.
-                section = getLocked(line, true);
+                section = getLocked(dir.text, true);
                 // Get write lock on this section (exclusive).
                 section->_mutex.lock();
             }
-            else if (!decodeDefinition(full_path, line, section)) {
-                // Invalid line.
-                CERR.error(u"%s: invalid line %d: %s", full_path, line_number, line);
+            else if (section == nullptr || !ApplyDirective(full_path, dir, *section)) {
+                // The directive may come from the cache, get the invalid line from the text file.
+                if (text_lines.empty()) {
+                    UString::Load(text_lines, full_path);
+                }
+                CERR.error(u"%s: invalid line %d: %s", full_path, dir.line, dir.line > 0 && dir.line <= text_lines.size() ? text_lines[dir.line - 1].toTrimmed() : UString());
                 if (++error_count >= 20) {
                     // Give up after that number of errors
                     CERR.error(u"%s: too many errors, giving up", full_path);
@@ -930,7 +936,6 @@ bool ts::Names::AllInstances::loadFileLocked(const UString& file_name)
     if (section != nullptr) {
         section->_mutex.unlock();
     }
-    strm.close();
 
     // Verify that all sections have bits size.
     for (const auto& sname : section_names) {
@@ -1002,15 +1007,70 @@ bool ts::Names::AllInstances::loadFileLocked(const UString& file_name)
 }
 
 
+//----------------------------------------------------------------------------
+// Decode a text file.
+//----------------------------------------------------------------------------
+
+bool ts::Names::AllInstances::LoadText(const UString& file_name, DirectiveVector& directives, size_t& error_count)
+{
+    std::ifstream strm(file_name.toUTF8().c_str());
+    if (!strm) {
+        CERR.error(u"error opening file %s", file_name);
+        return false;
+    }
+
+    // Read configuration file line by line.
+    UString line;
+    UString section_name;
+    bool in_section = false;
+
+    for (size_t line_number = 1; line.getLine(strm); ++line_number) {
+
+        // Remove leading and trailing spaces in line.
+        line.trim();
+
+        if (line.empty() || line[0] == UChar('#')) {
+            // Empty or comment line, ignore.
+        }
+        else if (line.front() == UChar('[') && line.back() == UChar(']')) {
+            // Handle beginning of section, get section name.
+            section_name.assign(line, 1, line.length() - 2);
+            directives.emplace_back();
+            directives.back().type = Directive::SECTION;
+            directives.back().line = line_number;
+            directives.back().text = section_name;
+            in_section = true;
+        }
+        else {
+            Directive dir;
+            dir.line = line_number;
+            if (in_section && DecodeDefinition(file_name, section_name, line, dir)) {
+                directives.push_back(std::move(dir));
+            }
+            else {
+                // Invalid line.
+                CERR.error(u"%s: invalid line %d: %s", file_name, line_number, line);
+                if (++error_count >= 20) {
+                    // Give up after that number of errors
+                    CERR.error(u"%s: too many errors, giving up", file_name);
+                    break;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Decode a line as "first[-last] = name". Return true on success.
 //----------------------------------------------------------------------------
 
-bool ts::Names::AllInstances::decodeDefinition(const UString& file_name, const UString& line, NamesPtr section)
+bool ts::Names::AllInstances::DecodeDefinition(const UString& file_name, const UString& section_name, const UString& line, Directive& dir)
 {
-    // Check the presence of the '=' and in a valid section.
+    // Check the presence of the '='.
     const size_t equal = line.find(u'=');
-    if (equal == 0 || equal == NPOS || section == nullptr) {
+    if (equal == 0 || equal == NPOS) {
         return false;
     }
 
@@ -1018,8 +1078,8 @@ bool ts::Names::AllInstances::decodeDefinition(const UString& file_name, const U
     UString range(line, 0, equal);
     range.trim();
 
-    UString value(line, equal + 1, line.length() - equal - 1);
-    value.trim();
+    dir.text.assign(line, equal + 1, line.length() - equal - 1);
+    dir.text.trim();
 
     // Allowed "thousands separators" (ignored characters)
     const UString ignore(u".,_");
@@ -1027,60 +1087,223 @@ bool ts::Names::AllInstances::decodeDefinition(const UString& file_name, const U
     // Special cases (not values):
     if (range.similar(u"bits")) {
         // Specification of size in bits of values in this section.
-        size_t bits = 0;
-        if (section->_bits > 0) {
-            CERR.error(u"%s: section %s, duplicated bits clauses %d and %s", file_name, section->_section_name, section->_bits, value);
-            return false;
-        }
-        else if (value.toInteger(bits, ignore, 0, UString()) && bits > 0 && bits <= 8 * sizeof(uint_t)) {
-            section->_bits = bits;
+        dir.type = Directive::BITS;
+        if (dir.text.toInteger(dir.first, ignore, 0, UString()) && dir.first > 0 && dir.first <= 8 * sizeof(uint_t)) {
             return true;
         }
         else {
-            CERR.error(u"%s: section %s, invalid bits value; %s", file_name, section->_section_name, value);
+            CERR.error(u"%s: section %s, invalid bits value; %s", file_name, section_name, dir.text);
             return false;
         }
     }
     else if (range.similar(u"inherit")) {
         // Name of a section where to search unknown values here.
-        if (section->_inherit.empty()) {
-            section->_inherit = value;
-            return true;
-        }
-        else {
-            CERR.error(u"%s: section %s, duplicated inherit clauses %s and %s", file_name, section->_section_name, section->_inherit, value);
-            return false;
-        }
+        dir.type = Directive::INHERIT;
+        return true;
     }
     else if (range.similar(u"extended")) {
         // "extended = true|false" indicates the presence of extended values, larger than the specified bit size.
-        return value.toBool(section->_has_extended);
+        bool extended = false;
+        dir.type = Directive::EXTENDED;
+        if (!dir.text.toBool(extended)) {
+            return false;
+        }
+        dir.first = extended;
+        return true;
     }
 
     // Decode "first[-last]"
-    uint_t first = 0;
-    uint_t last = 0;
     const size_t dash = range.find(u'-');
-    bool valid = false;
+    dir.type = Directive::RANGE;
 
     if (dash == NPOS) {
-        valid = range.toInteger(first, ignore, 0, UString());
-        last = first;
+        const bool valid = range.toInteger(dir.first, ignore, 0, UString());
+        dir.last = dir.first;
+        return valid;
     }
     else {
-        valid = range.substr(0, dash).toInteger(first, ignore, 0, UString()) && range.substr(dash + 1).toInteger(last, ignore, 0, UString()) && last >= first;
+        return range.substr(0, dash).toInteger(dir.first, ignore, 0, UString()) &&
+               range.substr(dash + 1).toInteger(dir.last, ignore, 0, UString()) &&
+               dir.last >= dir.first;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Apply a directive on a section with write lock held.
+//----------------------------------------------------------------------------
+
+bool ts::Names::AllInstances::ApplyDirective(const UString& file_name, Directive& dir, Names& section)
+{
+    switch (dir.type) {
+        case Directive::BITS:
+            if (section._bits > 0) {
+                CERR.error(u"%s: section %s, duplicated bits clauses %d and %d", file_name, section._section_name, section._bits, dir.first);
+                return false;
+            }
+            section._bits = size_t(dir.first);
+            return true;
+        case Directive::INHERIT:
+            if (!section._inherit.empty()) {
+                CERR.error(u"%s: section %s, duplicated inherit clauses %s and %s", file_name, section._section_name, section._inherit, dir.text);
+                return false;
+            }
+            section._inherit = dir.text;
+            return true;
+        case Directive::EXTENDED:
+            section._has_extended = dir.first != 0;
+            return true;
+        case Directive::RANGE:
+            if (!section.freeRangeLocked(dir.first, dir.last)) {
+                CERR.error(u"%s: section %s, range 0x%X-0x%X overlaps with an existing range", file_name, section._section_name, dir.first, dir.last);
+                return false;
+            }
+            section.addValueImplLocked(std::move(dir.text), dir.first, dir.last);
+            return true;
+        case Directive::SECTION:
+        default:
+            return false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Compiled cache of ".names" files.
+//----------------------------------------------------------------------------
+
+namespace {
+    // File format: header, fixed-size directive records, pool of UTF-8 strings (starting with the source file path).
+    // All integers are big endian. A change in the format shall be reflected in the magic number.
+    constexpr char   CACHE_MAGIC[] = "TSNAMES1";
+    constexpr size_t CACHE_MAGIC_SIZE = sizeof(CACHE_MAGIC) - 1;
+    constexpr size_t CACHE_HEADER_SIZE = CACHE_MAGIC_SIZE + 8 + 8 + 4 + 4 + 4;  // magic, size, time, path size, dir count, pool size
+    constexpr size_t CACHE_RECORD_SIZE = 8 + 8 + 4 + 4 + 4 + 4;  // first, last, line, text offset, text size, type
+
+    // Smaller files are quickly parsed, they are not worth a cache file.
+    constexpr uintmax_t CACHE_MIN_SOURCE_SIZE = 16 * 1024;
+
+    // Get the size and modification time of a file, as saved in the cache.
+    bool CacheFileStatus(const ts::UString& file_name, uint64_t& size, uint64_t& time)
+    {
+        std::error_code err;
+        size = uint64_t(fs::file_size(file_name, err));
+        if (!err) {
+            time = uint64_t(fs::last_write_time(file_name, err).time_since_epoch().count());
+        }
+        return !err;
     }
+}
 
-    // Add the definition.
-    if (valid) {
-        if (section->freeRangeLocked(first, last)) {
-            // Valid range, add it.
-            section->addValueImplLocked(value, first, last);
+ts::UString ts::Names::AllInstances::CacheFileName(const UString& file_name)
+{
+    std::error_code err;
+    if (!GetEnvironment(u"TSDUCK_NO_NAMES_CACHE").empty() || fs::file_size(file_name, err) < CACHE_MIN_SOURCE_SIZE || err) {
+        return UString();
+    }
+    // Distinct cache files for files with same name in different directories.
+    const std::string path(AbsoluteFilePath(file_name).toUTF8());
+    return UserCacheFileName(UString::Format(u"%s.%08X.bin", BaseName(file_name), CRC32(path.data(), path.size()).value()));
+}
+
+bool ts::Names::AllInstances::LoadCache(const UString& cache_file, const UString& file_name, DirectiveVector& directives)
+{
+    // Load the complete cache file at once, if it exists, silently ignore errors.
+    ByteBlock data;
+    uint64_t size = 0;
+    uint64_t time = 0;
+    if (!fs::exists(cache_file) || !data.loadFromFile(cache_file) || data.size() < CACHE_HEADER_SIZE || !CacheFileStatus(file_name, size, time)) {
+        return false;
+    }
+
+    // Check that the cache is valid and matches the source file.
+    const uint8_t* const base = data.data();
+    const uint8_t* hdr = base + CACHE_MAGIC_SIZE;
+    const size_t path_size = GetUInt32(hdr + 16);
+    const size_t count = GetUInt32(hdr + 20);
+    const size_t pool_size = GetUInt32(hdr + 24);
+    const uint8_t* const records = base + CACHE_HEADER_SIZE;
+    if (MemCompare(base, CACHE_MAGIC, CACHE_MAGIC_SIZE) != 0 ||
+        GetUInt64(hdr) != size ||
+        GetUInt64(hdr + 8) != time ||
+        data.size() != CACHE_HEADER_SIZE + count * CACHE_RECORD_SIZE + pool_size ||
+        path_size > pool_size ||
+        UString::FromUTF8(reinterpret_cast<const char*>(records + count * CACHE_RECORD_SIZE), path_size) != AbsoluteFilePath(file_name))
+    {
+        CERR.debug(u"names cache %s is obsolete", cache_file);
+        return false;
+    }
+
+    // Decode all directives.
+    const char* const pool = reinterpret_cast<const char*>(records + count * CACHE_RECORD_SIZE);
+    directives.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* rec = records + i * CACHE_RECORD_SIZE;
+        const size_t offset = GetUInt32(rec + 20);
+        const size_t length = GetUInt32(rec + 24);
+        const uint32_t type = GetUInt32(rec + 28);
+        if (offset + length > pool_size || type > Directive::RANGE) {
+            CERR.debug(u"names cache %s is corrupted", cache_file);
+            directives.clear();
+            return false;
+        }
+        Directive& dir(directives[i]);
+        dir.type = Directive::Type(type);
+        dir.first = GetUInt64(rec);
+        dir.last = GetUInt64(rec + 8);
+        dir.line = GetUInt32(rec + 16);
+        dir.text = UString::FromUTF8(pool + offset, length);
+    }
+    CERR.debug(u"loaded names from cache %s", cache_file);
+    return true;
+}
+
+void ts::Names::AllInstances::SaveCache(const UString& cache_file, const UString& file_name, const DirectiveVector& directives)
+{
+    uint64_t size = 0;
+    uint64_t time = 0;
+    if (!CacheFileStatus(file_name, size, time)) {
+        return;
+    }
+
+    // Build the pool of strings first.
+    std::string pool(AbsoluteFilePath(file_name).toUTF8());
+    const size_t path_size = pool.size();
+    ByteBlock records;
+    records.reserve(directives.size() * CACHE_RECORD_SIZE);
+    for (const auto& dir : directives) {
+        const std::string text(dir.text.toUTF8());
+        records.appendUInt64(dir.first);
+        records.appendUInt64(dir.last);
+        records.appendUInt32(uint32_t(dir.line));
+        records.appendUInt32(uint32_t(pool.size()));
+        records.appendUInt32(uint32_t(text.size()));
+        records.appendUInt32(dir.type);
+        pool.append(text);
+    }
+
+    ByteBlock data;
+    data.reserve(CACHE_HEADER_SIZE + records.size() + pool.size());
+    data.append(CACHE_MAGIC, CACHE_MAGIC_SIZE);
+    data.appendUInt64(size);
+    data.appendUInt64(time);
+    data.appendUInt32(uint32_t(path_size));
+    data.appendUInt32(uint32_t(directives.size()));
+    data.appendUInt32(uint32_t(pool.size()));
+    data.append(records);
+    data.append(pool);
+
+    // Write into a temporary file which is atomically renamed, in case of concurrent applications.
+    // Errors are silently ignored, there is simply no cache.
+    std::error_code err;
+    const UString tmp_file(UString::Format(u"%s.%X.tmp", cache_file, std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(DirectoryName(cache_file), err);
+    if (!err && data.saveToFile(tmp_file)) {
+        fs::rename(tmp_file, cache_file, err);
+        if (err) {
+            fs::remove(tmp_file, err);
         }
         else {
-            CERR.error(u"%s: section %s, range 0x%X-0x%X overlaps with an existing range", file_name, section->_section_name, first, last);
-            valid = false;
+            CERR.debug(u"saved names cache %s", cache_file);
         }
     }
-    return valid;
 }
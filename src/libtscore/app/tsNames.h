@@ -16,6 +16,10 @@
 #include "tsIntegerUtils.h"
 #include "tsEnumUtils.h"
 
+//! @cond nodoxygen
+class NamesTest;  // Unit test of the compiled cache of ".names" files.
+//! @endcond
+
 namespace ts {
     //!
     //! Flags to be used in the formating of names using class Names.
@@ -573,6 +577,8 @@ namespace ts {
         };
 
     private:
+        friend class ::NamesTest;
+
         // Description of a range of values with same name.
         class TSCOREDLL ValueRange
         {
@@ -608,7 +614,7 @@ namespace ts {
         bool freeRangeLocked(uint_t first, uint_t last) const;
         void addValueImpl(const NameValue& range);
         void addValueImplLocked(const NameValue& range);
-        void addValueImplLocked(const UString& name, uint_t first, uint_t last);
+        void addValueImplLocked(UString name, uint_t first, uint_t last);
         bool getValueImpl(uint_t& e, const UString& name, bool case_sensitive, bool abbreviated, bool allow_integer_value) const;
         bool containsImpl(uint_t value) const;
         UString getName(uint_t value) const;
@@ -624,6 +630,7 @@ namespace ts {
         class TSCOREDLL AllInstances
         {
             TS_SINGLETON(AllInstances);
+            friend class ::NamesTest;
         public:
             // Load a file, if not already loaded, and create one Names instance per section.
             // If no directory is specified, search in configuraiton directories, try with
@@ -638,14 +645,42 @@ namespace ts {
             std::set<UString> _loaded_files {};
             std::map<UString, NamesPtr> _names {};
 
+            // One decoded line of a ".names" file. The content of a file is first decoded as a list of
+            // directives, either from the text file or from its compiled cache, and then applied.
+            class Directive
+            {
+            public:
+                enum Type : uint8_t {SECTION, BITS, INHERIT, EXTENDED, RANGE};
+                Type    type = RANGE;  // Type of line.
+                size_t  line = 0;      // Line number in the text file, for error messages.
+                uint_t  first = 0;     // First value of a range, number of bits, extended flag (0 or 1).
+                uint_t  last = 0;      // Last value of a range.
+                UString text {};       // Section name, inherited section name, name of a range.
+            };
+            using DirectiveVector = std::vector<Directive>;
+
             // Load a file with exclusive lock already held.
             bool loadFileLocked(const UString& file_name);
 
             // Get or create a section with exclusive lock already held.
             NamesPtr getLocked(const UString& section_name, bool create);
 
-            // Decode a line as "first[-last] = name". Return true on success, false on error.
-            bool decodeDefinition(const UString& file_name, const UString& line, NamesPtr section);
+            // Decode a text file. Return false if the file cannot be read. Count invalid lines in error_count.
+            static bool LoadText(const UString& file_name, DirectiveVector& directives, size_t& error_count);
+
+            // Decode a line as "first[-last] = name" or special directive. Return true on success, false on error.
+            static bool DecodeDefinition(const UString& file_name, const UString& section_name, const UString& line, Directive& dir);
+
+            // Apply a directive on a section with write lock held. Return true on success, false on error.
+            // The text of the directive may be moved into the section.
+            static bool ApplyDirective(const UString& file_name, Directive& dir, Names& section);
+
+            // Compiled cache of a ".names" file. The cache file contains the decoded directives of an error-free text file,
+            // as fixed-size binary records, followed by a pool of UTF-8 strings. It is reused as long as the path, size and
+            // modification time of the text file are unchanged. Return an empty string if there is no cache to use.
+            static UString CacheFileName(const UString& file_name);
+            static bool LoadCache(const UString& cache_file, const UString& file_name, DirectiveVector& directives);
+            static void SaveCache(const UString& cache_file, const UString& file_name, const DirectiveVector& directives);
 
             // Normalized section name, as used in _names index.
             static UString NormalizedSectionName(const UString& section_name) { return section_name.toTrimmed().toLower(); }
@@ -434,6 +434,14 @@
     #define TS_NO_ARM_CRC32_INSTRUCTIONS
 #endif
 
+//!
+//! Define TS_NO_X86_PCLMUL_INSTRUCTIONS from the command line if you want to disable the usage of Intel carry-less multiplication instructions.
+//! @ingroup cpp
+//!
+#if defined(DOXYGEN)
+    #define TS_NO_X86_PCLMUL_INSTRUCTIONS
+#endif
+
 
 //----------------------------------------------------------------------------
 // Static linking.
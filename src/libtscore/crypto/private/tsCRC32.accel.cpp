@@ -22,9 +22,17 @@
     #define TS_ARM_CRC32_INSTRUCTIONS 1
 #endif
 
+// Check if Intel carry-less multiplication (PCLMULQDQ) and byte shuffle (SSSE3) can be used.
+#if defined(__PCLMUL__) && defined(__SSSE3__) && !defined(TS_NO_X86_PCLMUL_INSTRUCTIONS)
+    #define TS_X86_PCLMUL_INSTRUCTIONS 1
+    #include "tsBeforeStandardHeaders.h"
+    #include <immintrin.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
+
 // "Hidden" exported bool to inform the SysInfo class that we have compiled accelerated instructions.
 extern const bool tsCRC32IsAccelerated =
-#if defined(TS_ARM_CRC32_INSTRUCTIONS)
+#if defined(TS_ARM_CRC32_INSTRUCTIONS) || defined(TS_X86_PCLMUL_INSTRUCTIONS)
     true;
 #else
     false;
@@ -45,6 +53,9 @@ uint32_t ts::CRC32::valueAccel() const
     uint32_t x;
     asm("rbit %w0, %w1" : "=r" (x) : "r" (_fcs));
     return x;
+#elif defined(TS_X86_PCLMUL_INSTRUCTIONS)
+    // With carry-less multiplication, the CRC32 is computed in the same order as the portable version.
+    return _fcs;
 #else
     // Shall not be called.
     assert(false);
@@ -88,6 +99,67 @@ namespace {
 #endif
 
 
+//----------------------------------------------------------------------------
+// Basic operations for the Intel carry-less multiplication.
+//----------------------------------------------------------------------------
+
+#if defined(TS_X86_PCLMUL_INSTRUCTIONS)
+namespace {
+
+    // The data are folded by 128-bit blocks, using the Intel method "Fast CRC
+    // Computation for Generic Polynomials Using PCLMULQDQ Instruction". Each
+    // 128-bit block is loaded with bytes reversed: the first bit of the data is
+    // the most significant bit of the block, as in the MPEG CRC32 bit order.
+    // A block X = H.x^64 + L, followed by n bits, is replaced by the congruent
+    // (modulo the CRC polynomial) value H.(x^(n+64) mod P) + L.(x^n mod P).
+
+    // The MPEG CRC32 polynomial, without the x^32 term.
+    constexpr uint32_t CRC32_POLY = 0x04C11DB7;
+
+    // Compute x^n modulo the CRC32 polynomial.
+    constexpr uint64_t XPowMod(size_t n)
+    {
+        uint32_t r = 1;
+        while (n-- > 0) {
+            r = (r << 1) ^ ((r & 0x80000000) != 0 ? CRC32_POLY : 0);
+        }
+        return r;
+    }
+
+    // Folding constants, computed at compile time.
+    constexpr uint64_t K576 = XPowMod(576);
+    constexpr uint64_t K512 = XPowMod(512);
+    constexpr uint64_t K448 = XPowMod(448);
+    constexpr uint64_t K384 = XPowMod(384);
+    constexpr uint64_t K320 = XPowMod(320);
+    constexpr uint64_t K256 = XPowMod(256);
+    constexpr uint64_t K192 = XPowMod(192);
+    constexpr uint64_t K128 = XPowMod(128);
+
+    // Pair of constants to fold a 128-bit block over n bits.
+    inline __attribute__((always_inline)) __m128i foldConstants(uint64_t k_high, uint64_t k_low)
+    {
+        return _mm_set_epi64x(int64_t(k_high), int64_t(k_low));
+    }
+
+    // Fold a 128-bit block using a pair of constants.
+    inline __attribute__((always_inline)) __m128i fold(__m128i x, __m128i k)
+    {
+        return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00));
+    }
+
+    // Load a 128-bit block, with bytes reversed.
+    inline __attribute__((always_inline)) __m128i load(const uint8_t* p, __m128i bswap)
+    {
+        return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), bswap);
+    }
+
+    // Minimum data size to use the carry-less multiplication.
+    constexpr size_t FOLD_MIN_SIZE = 64;
+}
+#endif
+
+
 //----------------------------------------------------------------------------
 // Continue the computation of a data area, following a previous CRC32.
 //----------------------------------------------------------------------------
@@ -133,6 +205,54 @@ void ts::CRC32::addAccel(const void* data, size_t size)
     while (size--) {
         crcAdd8(_fcs, *cp8++);
     }
+#elif defined(TS_X86_PCLMUL_INSTRUCTIONS)
+    // Use the portable slice-by-16 method on short data.
+    if (size < FOLD_MIN_SIZE) {
+        addPortable(data, size);
+        return;
+    }
+
+    const uint8_t* cp = reinterpret_cast<const uint8_t*>(data);
+    const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    // Load 4 blocks of 128 bits. The current CRC is merged in the first 32 bits of data.
+    __m128i x0 = _mm_xor_si128(load(cp, bswap), _mm_set_epi32(int(_fcs), 0, 0, 0));
+    __m128i x1 = load(cp + 16, bswap);
+    __m128i x2 = load(cp + 32, bswap);
+    __m128i x3 = load(cp + 48, bswap);
+    cp += 64;
+    size -= 64;
+
+    // Fold 4 blocks of 128 bits in parallel, over the next 512 bits.
+    const __m128i k512 = foldConstants(K576, K512);
+    while (size >= 64) {
+        x0 = _mm_xor_si128(fold(x0, k512), load(cp, bswap));
+        x1 = _mm_xor_si128(fold(x1, k512), load(cp + 16, bswap));
+        x2 = _mm_xor_si128(fold(x2, k512), load(cp + 32, bswap));
+        x3 = _mm_xor_si128(fold(x3, k512), load(cp + 48, bswap));
+        cp += 64;
+        size -= 64;
+    }
+
+    // Fold the 4 blocks into one.
+    const __m128i k128 = foldConstants(K192, K128);
+    __m128i x = _mm_xor_si128(fold(x0, foldConstants(K448, K384)), fold(x1, foldConstants(K320, K256)));
+    x = _mm_xor_si128(x, _mm_xor_si128(fold(x2, k128), x3));
+
+    // Fold the remaining 128-bit blocks.
+    while (size >= 16) {
+        x = _mm_xor_si128(fold(x, k128), load(cp, bswap));
+        cp += 16;
+        size -= 16;
+    }
+
+    // The CRC32 of the last block, starting from zero, is the CRC32 of all previous data.
+    // Then add the remaining bytes.
+    uint8_t last[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(last), _mm_shuffle_epi8(x, bswap));
+    _fcs = 0;
+    addPortable(last, sizeof(last));
+    addPortable(cp, size);
 #else
     // Shall not be called.
     assert(false);
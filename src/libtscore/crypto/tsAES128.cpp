@@ -92,6 +92,17 @@ ts::ECB<ts::AES128>::ECB(const BlockCipherProperties& props) : AES128(props)
     canProcessInPlace(true);
 }
 
+// The blocks of all areas are processed in one single operation.
+bool ts::ECB<ts::AES128>::encryptInPlaceImpl(InPlaceArea* areas, size_t count)
+{
+    return processInPlaceECB(areas, count, true);
+}
+
+bool ts::ECB<ts::AES128>::decryptInPlaceImpl(InPlaceArea* areas, size_t count)
+{
+    return processInPlaceECB(areas, count, false);
+}
+
 #if defined(TS_WINDOWS)
 
 void ts::ECB<ts::AES128>::getAlgorithm(::BCRYPT_ALG_HANDLE& algo, size_t& length, bool& ignore_iv) const
@@ -139,6 +150,13 @@ ts::CBC<ts::AES128>::CBC(const BlockCipherProperties& props) : AES128(props)
     canProcessInPlace(true);
 }
 
+// The decryption of all areas is performed in one single operation.
+// The encryption is inherently sequential and uses the default implementation.
+bool ts::CBC<ts::AES128>::decryptInPlaceImpl(InPlaceArea* areas, size_t count)
+{
+    return decryptInPlaceCBC(areas, count);
+}
+
 #if defined(TS_WINDOWS)
 
 void ts::CBC<ts::AES128>::getAlgorithm(::BCRYPT_ALG_HANDLE& algo, size_t& length, bool& ignore_iv) const
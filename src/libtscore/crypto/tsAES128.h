@@ -59,6 +59,8 @@ namespace ts {
     protected:
         static const BlockCipherProperties& Properties();
         ECB(const BlockCipherProperties& props);
+        virtual bool encryptInPlaceImpl(InPlaceArea* areas, size_t count) override;
+        virtual bool decryptInPlaceImpl(InPlaceArea* areas, size_t count) override;
 #if defined(TS_WINDOWS)
         virtual void getAlgorithm(::BCRYPT_ALG_HANDLE& algo, size_t& length, bool& ignore_iv) const override;
 #elif !defined(TS_NO_OPENSSL)
@@ -75,6 +77,7 @@ namespace ts {
     protected:
         static const BlockCipherProperties& Properties();
         CBC(const BlockCipherProperties& props);
+        virtual bool decryptInPlaceImpl(InPlaceArea* areas, size_t count) override;
 #if defined(TS_WINDOWS)
         virtual void getAlgorithm(::BCRYPT_ALG_HANDLE& algo, size_t& length, bool& ignore_iv) const override;
 #elif !defined(TS_NO_OPENSSL)
@@ -92,6 +92,17 @@ ts::ECB<ts::AES256>::ECB(const BlockCipherProperties& props) : AES256(props)
     canProcessInPlace(true);
 }
 
+// The blocks of all areas are processed in one single operation.
+bool ts::ECB<ts::AES256>::encryptInPlaceImpl(InPlaceArea* areas, size_t count)
+{
+    return processInPlaceECB(areas, count, true);
+}
+
+bool ts::ECB<ts::AES256>::decryptInPlaceImpl(InPlaceArea* areas, size_t count)
+{
+    return processInPlaceECB(areas, count, false);
+}
+
 #if defined(TS_WINDOWS)
 
 void ts::ECB<ts::AES256>::getAlgorithm(::BCRYPT_ALG_HANDLE& algo, size_t& length, bool& ignore_iv) const
@@ -137,6 +148,13 @@ ts::CBC<ts::AES256>::CBC(const BlockCipherProperties& props) : AES256(props)
     canProcessInPlace(true);
 }
 
+// The decryption of all areas is performed in one single operation.
+// The encryption is inherently sequential and uses the default implementation.
+bool ts::CBC<ts::AES256>::decryptInPlaceImpl(InPlaceArea* areas, size_t count)
+{
+    return decryptInPlaceCBC(areas, count);
+}
+
 #if defined(TS_WINDOWS)
 
 void ts::CBC<ts::AES256>::getAlgorithm(::BCRYPT_ALG_HANDLE& algo, size_t& length, bool& ignore_iv) const
@@ -281,6 +281,160 @@ bool ts::BlockCipher::decrypt(const void* cipher, size_t cipher_length, void* pl
 }
 
 
+//----------------------------------------------------------------------------
+// Encrypt / decrypt several data areas in place.
+//----------------------------------------------------------------------------
+
+bool ts::BlockCipher::encryptInPlace(InPlaceArea* areas, size_t count)
+{
+    // Same accounting as individual encryptions: stop at the first disallowed one.
+    size_t allowed = 0;
+    while (allowed < count && allowEncrypt()) {
+        allowed++;
+    }
+    return (allowed == 0 || encryptInPlaceImpl(areas, allowed)) && allowed == count;
+}
+
+bool ts::BlockCipher::decryptInPlace(InPlaceArea* areas, size_t count)
+{
+    size_t allowed = 0;
+    while (allowed < count && allowDecrypt()) {
+        allowed++;
+    }
+    return (allowed == 0 || decryptInPlaceImpl(areas, allowed)) && allowed == count;
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt / decrypt several data areas in place (default implementation).
+//----------------------------------------------------------------------------
+
+bool ts::BlockCipher::encryptInPlaceImpl(InPlaceArea* areas, size_t count)
+{
+    bool ok = true;
+    for (size_t i = 0; ok && i < count; ++i) {
+        if (_can_process_in_place) {
+            ok = encryptImpl(areas[i].data, areas[i].size, areas[i].data, areas[i].size, nullptr);
+        }
+        else {
+            const ByteBlock plain(areas[i].data, areas[i].size);
+            ok = encryptImpl(plain.data(), plain.size(), areas[i].data, areas[i].size, nullptr);
+        }
+    }
+    return ok;
+}
+
+bool ts::BlockCipher::decryptInPlaceImpl(InPlaceArea* areas, size_t count)
+{
+    bool ok = true;
+    for (size_t i = 0; ok && i < count; ++i) {
+        if (_can_process_in_place) {
+            ok = decryptImpl(areas[i].data, areas[i].size, areas[i].data, areas[i].size, nullptr);
+        }
+        else {
+            const ByteBlock cipher(areas[i].data, areas[i].size);
+            ok = decryptImpl(cipher.data(), cipher.size(), areas[i].data, areas[i].size, nullptr);
+        }
+    }
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt several data areas in place in ECB mode, in one operation.
+//----------------------------------------------------------------------------
+
+bool ts::BlockCipher::processInPlaceECB(InPlaceArea* areas, size_t count, bool encrypt)
+{
+    // Without padding, all areas must contain complete blocks, as with individual operations.
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (areas[i].size % properties.block_size != 0) {
+            return false;
+        }
+        total += areas[i].size;
+    }
+    if (total == 0) {
+        return true;
+    }
+
+    // Gather all areas in the first half of the buffer, process into the second half.
+    batch.resize(2 * total);
+    uint8_t* in = batch.data();
+    uint8_t* out = in + total;
+    for (size_t i = 0; i < count; ++i) {
+        MemCopy(in, areas[i].data, areas[i].size);
+        in += areas[i].size;
+    }
+    if (!(encrypt ? encryptImpl(batch.data(), total, out, total, nullptr) : decryptImpl(batch.data(), total, out, total, nullptr))) {
+        return false;
+    }
+
+    // Scatter the results in the areas.
+    for (size_t i = 0; i < count; ++i) {
+        MemCopy(areas[i].data, out, areas[i].size);
+        out += areas[i].size;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Decrypt several data areas in place in CBC mode, in one operation.
+//----------------------------------------------------------------------------
+
+bool ts::BlockCipher::decryptInPlaceCBC(InPlaceArea* areas, size_t count)
+{
+    const size_t bsize = properties.block_size;
+    if (_current_iv.size() != bsize) {
+        return false;
+    }
+
+    // All areas must contain complete blocks, as with individual operations.
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (areas[i].size % bsize != 0) {
+            return false;
+        }
+        total += areas[i].size;
+    }
+    if (total == 0) {
+        return true;
+    }
+
+    // Gather all areas in the first half of the buffer, decrypt into the second half.
+    batch.resize(2 * total);
+    const uint8_t* in = batch.data();
+    const uint8_t* out = in + total;
+    uint8_t* gather = batch.data();
+    for (size_t i = 0; i < count; ++i) {
+        MemCopy(gather, areas[i].data, areas[i].size);
+        gather += areas[i].size;
+    }
+    if (!decryptImpl(batch.data(), total, batch.data() + total, total, nullptr)) {
+        return false;
+    }
+
+    // In the concatenation, the first block of each area was chained with the last
+    // cipher block of the previous area instead of the IV. Fix it while scattering.
+    const uint8_t* last = nullptr;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t size = areas[i].size;
+        if (size > 0) {
+            MemCopy(areas[i].data, out, size);
+            if (last != nullptr) {
+                MemXor(areas[i].data, areas[i].data, last, bsize);
+                MemXor(areas[i].data, areas[i].data, _current_iv.data(), bsize);
+            }
+            last = in + size - bsize;
+            in += size;
+            out += size;
+        }
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Schedule a new key (implementation of algorithm-specific part).
 // Default implementation for the system-provided cryptographic library.
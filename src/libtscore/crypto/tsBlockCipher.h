@@ -202,6 +202,44 @@ namespace ts {
         //!
         bool decrypt(const void* cipher, size_t cipher_length, void* plain, size_t plain_maxsize, size_t* plain_length = nullptr);
 
+        //!
+        //! Description of a data area which is encrypted or decrypted in place in a multiple operation.
+        //! @see encryptInPlace()
+        //! @see decryptInPlace()
+        //!
+        class TSCOREDLL InPlaceArea
+        {
+        public:
+            uint8_t* data = nullptr;  //!< Address of the data area.
+            size_t   size = 0;        //!< Size in bytes of the data area.
+        };
+
+        //!
+        //! Encrypt several independent data areas in place, using the same key.
+        //!
+        //! The result is the same as calling encrypt() in place on each area, in order.
+        //! Some algorithms provide an optimized implementation which processes all areas at once.
+        //! This is typically useful to encrypt the payloads of many TS packets using the same control word.
+        //!
+        //! @param [in,out] areas Array of @a count data areas to encrypt in place.
+        //! @param [in] count Number of data areas in @a areas.
+        //! @return True on success, false on error.
+        //!
+        bool encryptInPlace(InPlaceArea* areas, size_t count);
+
+        //!
+        //! Decrypt several independent data areas in place, using the same key.
+        //!
+        //! The result is the same as calling decrypt() in place on each area, in order.
+        //! Some algorithms provide an optimized implementation which processes all areas at once.
+        //! This is typically useful to decrypt the payloads of many TS packets using the same control word.
+        //!
+        //! @param [in,out] areas Array of @a count data areas to decrypt in place.
+        //! @param [in] count Number of data areas in @a areas.
+        //! @return True on success, false on error.
+        //!
+        bool decryptInPlace(InPlaceArea* areas, size_t count);
+
         //!
         //! Get the number of times the current key was used for encryption.
         //! @return The number of times the current key was used for encryption.
@@ -313,6 +351,24 @@ namespace ts {
         //!
         virtual bool decryptImpl(const void* cipher, size_t cipher_length, void* plain, size_t plain_maxsize, size_t* plain_length);
 
+        //!
+        //! Encrypt several data areas in place (implementation of algorithm-specific part).
+        //! The default implementation calls encryptImpl() on each area.
+        //! @param [in,out] areas Array of @a count data areas to encrypt in place.
+        //! @param [in] count Number of data areas in @a areas.
+        //! @return True on success, false on error.
+        //!
+        virtual bool encryptInPlaceImpl(InPlaceArea* areas, size_t count);
+
+        //!
+        //! Decrypt several data areas in place (implementation of algorithm-specific part).
+        //! The default implementation calls decryptImpl() on each area.
+        //! @param [in,out] areas Array of @a count data areas to decrypt in place.
+        //! @param [in] count Number of data areas in @a areas.
+        //! @return True on success, false on error.
+        //!
+        virtual bool decryptInPlaceImpl(InPlaceArea* areas, size_t count);
+
         //!
         //! Inform the superclass that the subclass can encrypt and decrypt in place (identical in/out buffers).
         //! Typically called by a subclass in constructor.
@@ -320,6 +376,28 @@ namespace ts {
         //!
         void canProcessInPlace(bool can_do) { _can_process_in_place = can_do; }
 
+        //!
+        //! Encrypt or decrypt several data areas in place, using one single operation on their concatenation.
+        //! This is valid only when all blocks are independently processed (ECB mode).
+        //! Typically used by a subclass to implement encryptInPlaceImpl() and decryptInPlaceImpl()
+        //! when encryptImpl() and decryptImpl() are implemented by the system cryptographic library.
+        //! @param [in,out] areas Array of @a count data areas to encrypt or decrypt in place.
+        //! @param [in] count Number of data areas in @a areas.
+        //! @param [in] encrypt If true, encrypt the data areas. Otherwise, decrypt them.
+        //! @return True on success, false on error.
+        //!
+        bool processInPlaceECB(InPlaceArea* areas, size_t count, bool encrypt);
+
+        //!
+        //! Decrypt several data areas in place in CBC mode, using one single operation on their concatenation.
+        //! This is valid only when decryptImpl() implements the CBC mode, starting with the current IV.
+        //! The first block of each area is then fixed to remove the chaining with the previous area.
+        //! @param [in,out] areas Array of @a count data areas to decrypt in place.
+        //! @param [in] count Number of data areas in @a areas.
+        //! @return True on success, false on error.
+        //!
+        bool decryptInPlaceCBC(InPlaceArea* areas, size_t count);
+
 #if defined(TS_WINDOWS) || defined(DOXYGEN)
         //!
         //! Get the algorithm handle and subobject size, when the subclass uses Microsoft BCrypt library.
@@ -339,7 +417,8 @@ namespace ts {
 #endif
 
     protected:
-        ByteBlock work {}; //!< Temporary working buffer.
+        ByteBlock work {};   //!< Temporary working buffer.
+        ByteBlock batch {};  //!< Temporary working buffer for operations on multiple data areas.
 
     private:
         bool      _can_process_in_place = false;      // The subclass can encrypt and decrypt in place (identical in/out buffers).
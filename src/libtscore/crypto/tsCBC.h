@@ -45,6 +45,8 @@ namespace ts {
         //! @cond nodoxygen
         virtual bool encryptImpl(const void* plain, size_t plain_length, void* cipher, size_t cipher_maxsize, size_t* cipher_length) override;
         virtual bool decryptImpl(const void* cipher, size_t cipher_length, void* plain, size_t plain_maxsize, size_t* plain_length) override;
+        virtual bool encryptInPlaceImpl(BlockCipher::InPlaceArea* areas, size_t count) override;
+        virtual bool decryptInPlaceImpl(BlockCipher::InPlaceArea* areas, size_t count) override;
         //! @endcond
     };
 }
@@ -169,4 +171,104 @@ bool ts::CBC<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, void
     return true;
 }
 
+
+//----------------------------------------------------------------------------
+// Encryption of several areas in CBC mode.
+// The blocks of an area are chained but the areas are independent. All areas
+// progress at the same time, one block per round. In each round, the next block
+// of all areas are encrypted at once, the underlying cipher being in ECB mode.
+//----------------------------------------------------------------------------
+
+template<class CIPHER> requires std::derived_from<CIPHER, ts::BlockCipher>
+bool ts::CBC<CIPHER>::encryptInPlaceImpl(BlockCipher::InPlaceArea* areas, size_t count)
+{
+    const size_t bsize = this->properties.block_size;
+    const uint8_t* iv = this->currentIV().data();
+
+    if (this->currentIV().size() != bsize) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (areas[i].size % bsize != 0) {
+            return false;
+        }
+    }
+
+    this->batch.resize(count * bsize);
+    for (size_t offset = 0; ; offset += bsize) {
+        // Gather the blocks at this offset: plain-text XOR previous cipher-text.
+        uint8_t* b = this->batch.data();
+        for (size_t i = 0; i < count; ++i) {
+            if (offset < areas[i].size) {
+                MemXor(b, offset == 0 ? iv : areas[i].data + offset - bsize, areas[i].data + offset, bsize);
+                b += bsize;
+            }
+        }
+        const size_t size = b - this->batch.data();
+        if (size == 0) {
+            return true;
+        }
+        // Encrypt all blocks at once and scatter the cipher-text blocks.
+        if (!CIPHER::encryptImpl(this->batch.data(), size, this->batch.data(), size, nullptr)) {
+            return false;
+        }
+        b = this->batch.data();
+        for (size_t i = 0; i < count; ++i) {
+            if (offset < areas[i].size) {
+                MemCopy(areas[i].data + offset, b, bsize);
+                b += bsize;
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Decryption of several areas in CBC mode.
+// All blocks of all areas are decrypted at once.
+//----------------------------------------------------------------------------
+
+template<class CIPHER> requires std::derived_from<CIPHER, ts::BlockCipher>
+bool ts::CBC<CIPHER>::decryptInPlaceImpl(BlockCipher::InPlaceArea* areas, size_t count)
+{
+    const size_t bsize = this->properties.block_size;
+    const uint8_t* iv = this->currentIV().data();
+
+    if (this->currentIV().size() != bsize) {
+        return false;
+    }
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (areas[i].size % bsize != 0) {
+            return false;
+        }
+        total += areas[i].size;
+    }
+    if (total == 0) {
+        return true;
+    }
+
+    // Decrypt all blocks in one operation.
+    this->batch.resize(total);
+    uint8_t* b = this->batch.data();
+    for (size_t i = 0; i < count; ++i) {
+        MemCopy(b, areas[i].data, areas[i].size);
+        b += areas[i].size;
+    }
+    if (!CIPHER::decryptImpl(this->batch.data(), total, this->batch.data(), total, nullptr)) {
+        return false;
+    }
+
+    // plain-text = previous-cipher XOR work. Start from the end of each area to keep previous-cipher.
+    b = this->batch.data();
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t offset = areas[i].size; offset > 0; ) {
+            offset -= bsize;
+            MemXor(areas[i].data + offset, offset == 0 ? iv : areas[i].data + offset - bsize, b + offset, bsize);
+        }
+        b += areas[i].size;
+    }
+    return true;
+}
+
 #endif
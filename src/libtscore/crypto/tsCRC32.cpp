@@ -8,6 +8,7 @@
 
 #include "tsCRC32.h"
 #include "tsSysInfo.h"
+#include "tsMemory.h"
 
 // Runtime check once if accelerated CRC32 instructions are supported on this CPU.
 volatile bool ts::CRC32::_accel_checked = false;
@@ -40,7 +41,7 @@ uint32_t ts::CRC32::value() const
 
 
 //----------------------------------------------------------------------------
-// Static table for the portable implementation (no CRC32 instructions).
+// Static tables for the portable implementation (no CRC32 instructions).
 // The FCS-32 generator polynomial:
 //     x**0 + x**1 + x**2 + x**4 + x**5 +
 //     x**7 + x**8 + x**10 + x**11 + x**12 + x**16 +
@@ -48,7 +49,7 @@ uint32_t ts::CRC32::value() const
 //----------------------------------------------------------------------------
 
 namespace {
-    const uint32_t _fcstab_32[256] = {
+    constexpr uint32_t _fcstab_32[256] = {
         0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9,
         0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
         0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61,
@@ -114,6 +115,34 @@ namespace {
         0xAFB010B1, 0xAB710D06, 0xA6322BDF, 0xA2F33668,
         0xBCB4666D, 0xB8757BDA, 0xB5365D03, 0xB1F740B4
     };
+
+    // Tables for the "slice-by-N" method, where up to 16 bytes are processed using independent lookups.
+    // _slicetab_32[k][b] is the CRC32 contribution of byte b when followed by k other bytes.
+    // _slicetab_32[0] is the same as _fcstab_32.
+    constexpr size_t SLICE_COUNT = 16;
+    using SliceTables = std::array<std::array<uint32_t, 256>, SLICE_COUNT>;
+
+    constexpr SliceTables BuildSliceTables()
+    {
+        SliceTables tab {};
+        for (size_t b = 0; b < 256; ++b) {
+            tab[0][b] = _fcstab_32[b];
+        }
+        for (size_t k = 1; k < SLICE_COUNT; ++k) {
+            for (size_t b = 0; b < 256; ++b) {
+                tab[k][b] = (tab[k-1][b] << 8) ^ _fcstab_32[tab[k-1][b] >> 24];
+            }
+        }
+        return tab;
+    }
+
+    constexpr SliceTables _slicetab_32 = BuildSliceTables();
+
+    // Compute the CRC32 contribution of a 32-bit word, when followed by k other bytes.
+    inline uint32_t SliceWord(uint32_t w, size_t k)
+    {
+        return _slicetab_32[k + 3][w >> 24] ^ _slicetab_32[k + 2][(w >> 16) & 0xFF] ^ _slicetab_32[k + 1][(w >> 8) & 0xFF] ^ _slicetab_32[k][w & 0xFF];
+    }
 }
 
 
@@ -127,10 +156,32 @@ void ts::CRC32::add(const void* data, size_t size)
         addAccel(data, size);
     }
     else {
-        // Portable implementation, using the pre-computed table.
-        const uint8_t* cp = reinterpret_cast<const uint8_t*>(data);
-        while (size-- > 0) {
-            _fcs = (_fcs << 8) ^ _fcstab_32[((_fcs >> 24) ^ (*cp++)) & 0xFF];
-        }
+        addPortable(data, size);
+    }
+}
+
+void ts::CRC32::addPortable(const void* data, size_t size)
+{
+    const uint8_t* cp = reinterpret_cast<const uint8_t*>(data);
+    uint32_t fcs = _fcs;
+
+    // Slice-by-16: the current CRC is merged in the first word, 16 independent lookups.
+    while (size >= 16) {
+        fcs = SliceWord(fcs ^ GetUInt32(cp), 12) ^ SliceWord(GetUInt32(cp + 4), 8) ^ SliceWord(GetUInt32(cp + 8), 4) ^ SliceWord(GetUInt32(cp + 12), 0);
+        cp += 16;
+        size -= 16;
+    }
+
+    // Slice-by-8 on the remaining data.
+    if (size >= 8) {
+        fcs = SliceWord(fcs ^ GetUInt32(cp), 4) ^ SliceWord(GetUInt32(cp + 4), 0);
+        cp += 8;
+        size -= 8;
+    }
+
+    // Byte-wise on the last bytes, using the classical table.
+    while (size-- > 0) {
+        fcs = (fcs << 8) ^ _fcstab_32[((fcs >> 24) ^ (*cp++)) & 0xFF];
     }
+    _fcs = fcs;
 }
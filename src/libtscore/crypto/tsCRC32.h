@@ -86,6 +86,9 @@ namespace ts {
         static volatile bool _accel_checked;
         static volatile bool _accel_supported;
 
+        // Portable version, using slice-by-16 and slice-by-8 lookup tables.
+        void addPortable(const void* data, size_t size);
+
         // Accelerated versions, compiled in a separated module.
         uint32_t valueAccel() const;
         void addAccel(const void* data, size_t size);
@@ -61,6 +61,8 @@ namespace ts {
         //! @cond nodoxygen
         virtual bool encryptImpl(const void* plain, size_t plain_length, void* cipher, size_t cipher_maxsize, size_t* cipher_length) override;
         virtual bool decryptImpl(const void* cipher, size_t cipher_length, void* plain, size_t plain_maxsize, size_t* plain_length) override;
+        virtual bool encryptInPlaceImpl(BlockCipher::InPlaceArea* areas, size_t count) override;
+        virtual bool decryptInPlaceImpl(BlockCipher::InPlaceArea* areas, size_t count) override;
         //! @endcond
 
     private:
@@ -149,7 +151,7 @@ bool ts::CTR<CIPHER>::encryptImpl(const void* plain, size_t plain_length, void*
     uint8_t* work1 = this->work.data();
     uint8_t* work2 = this->work.data() + bsize;
 
-    if (plain_length % bsize != 0 || this->currentIV().size() != bsize || cipher_maxsize < plain_length) {
+    if (this->currentIV().size() != bsize || cipher_maxsize < plain_length) {
         return false;
     }
     if (cipher_length != nullptr) {
@@ -194,4 +196,58 @@ bool ts::CTR<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, void
     return encryptImpl(cipher, cipher_length, plain, plain_maxsize, plain_length);
 }
 
+
+//----------------------------------------------------------------------------
+// Encryption of several areas in CTR mode.
+// All counter blocks are encrypted at once, the underlying cipher being in ECB mode.
+//----------------------------------------------------------------------------
+
+template<class CIPHER> requires std::derived_from<CIPHER, ts::BlockCipher>
+bool ts::CTR<CIPHER>::encryptInPlaceImpl(BlockCipher::InPlaceArea* areas, size_t count)
+{
+    const size_t bsize = this->properties.block_size;
+    uint8_t* work1 = this->work.data();
+
+    if (this->currentIV().size() != bsize) {
+        return false;
+    }
+
+    // Build the successive counter blocks of all areas.
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += round_up(areas[i].size, bsize);
+    }
+    if (total == 0) {
+        return true;
+    }
+    this->batch.resize(total);
+    uint8_t* ks = this->batch.data();
+    for (size_t i = 0; i < count; ++i) {
+        MemCopy(work1, this->currentIV().data(), bsize);
+        for (size_t size = 0; size < areas[i].size; size += bsize) {
+            MemCopy(ks, work1, bsize);
+            incrementCounter();
+            ks += bsize;
+        }
+    }
+
+    // Encrypt all counter blocks in one operation, then xor the key stream with the data.
+    if (!CIPHER::encryptImpl(this->batch.data(), total, this->batch.data(), total, nullptr)) {
+        return false;
+    }
+    ks = this->batch.data();
+    for (size_t i = 0; i < count; ++i) {
+        MemXor(areas[i].data, areas[i].data, ks, areas[i].size);
+        ks += round_up(areas[i].size, bsize);
+    }
+    return true;
+}
+
+template<class CIPHER> requires std::derived_from<CIPHER, ts::BlockCipher>
+bool ts::CTR<CIPHER>::decryptInPlaceImpl(BlockCipher::InPlaceArea* areas, size_t count)
+{
+    // With CTR, the encryption and decryption are identical operations.
+    return encryptInPlaceImpl(areas, count);
+}
+
 #endif
@@ -131,74 +131,123 @@ bool ts::UDPReceiver::receive(void* data,
             return false;
         }
 
-        // Debug (level 2) message for each message.
-        if (report.maxSeverity() >= 2) {
-            // Prior report level checking to avoid evaluating parameters when not necessary.
-            report.log(2, u"received UDP packet, source: %s, destination: %s, timestamp: %'d", sender, destination, timestamp != nullptr ? timestamp->count() : -1);
+        // Check the message.
+        if (acceptMessage(sender, destination, timestamp != nullptr ? *timestamp : cn::microseconds(-1), report)) {
+            return true;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Receive several messages. Override UDPSocket::receiveMultiple().
+//----------------------------------------------------------------------------
+
+bool ts::UDPReceiver::receiveMultiple(ReceivedMessage* messages,
+                                      size_t max_count,
+                                      size_t& ret_count,
+                                      const AbortInterface* abort,
+                                      Report& report)
+{
+    // Loop on packet reception until at least one message matches the filtering criteria.
+    for (;;) {
+
+        // Wait for UDP messages from the superclass.
+        if (!UDPSocket::receiveMultiple(messages, max_count, ret_count, abort, report)) {
+            return false;
         }
 
-        // Check the destination address to exclude packets from other streams.
-        // When several multicast streams use the same destination port and several
-        // applications on the same system listen to these distinct streams,
-        // the multicast MAC address management is such that any socket which
-        // is bound to the common port will receive the traffic for all streams.
-        // This is why we need to check the destination address and exclude
-        // packets which are not from the intended stream.
-        //
-        // We accept a packet in any of:
-        // 1) Actual packet destination is unknown. Probably, the system cannot
-        //    report the destination address.
-        // 2) We listen to a multicast address and the actual destination is the same.
-        // 3) If we listen to unicast traffic and the actual destination is unicast.
-        //    In that case, unicast is by definition sent to us.
-
-        if (destination.hasAddress() && ((_args.destination.hasAddress() && destination != _args.destination) || (!_args.destination.hasAddress() && destination.isMulticast()))) {
-            // This is a spurious packet.
-            if (report.maxSeverity() >= Severity::Debug) {
-                // Prior report level checking to avoid evaluating parameters when not necessary.
-                report.debug(u"rejecting packet, destination: %s, expecting: %s", destination, _args.destination);
+        // Keep only the messages which match the filtering criteria, in the same order.
+        size_t count = 0;
+        for (size_t i = 0; i < ret_count; ++i) {
+            if (acceptMessage(messages[i].sender, messages[i].destination, messages[i].timestamp, report)) {
+                if (i != count) {
+                    std::swap(messages[count], messages[i]);
+                }
+                count++;
             }
-            continue;
         }
+        ret_count = count;
+        if (ret_count > 0) {
+            return true;
+        }
+    }
+}
 
-        // Keep track of the first sender address.
-        if (!_first_source.hasAddress()) {
-            // First packet, keep address of the sender.
-            _first_source = sender;
-            _sources.insert(sender);
 
-            // With option --first-source, use this one to filter packets.
-            if (_args.use_first_source) {
-                _args.source = sender;
-                report.verbose(u"now filtering on source address %s", sender);
-            }
+//----------------------------------------------------------------------------
+// Check if a received message matches the filtering criteria.
+//----------------------------------------------------------------------------
+
+bool ts::UDPReceiver::acceptMessage(const IPSocketAddress& sender, const IPSocketAddress& destination, cn::microseconds timestamp, Report& report)
+{
+    // Debug (level 2) message for each message.
+    if (report.maxSeverity() >= 2) {
+        // Prior report level checking to avoid evaluating parameters when not necessary.
+        report.log(2, u"received UDP packet, source: %s, destination: %s, timestamp: %'d", sender, destination, timestamp.count());
+    }
+
+    // Check the destination address to exclude packets from other streams.
+    // When several multicast streams use the same destination port and several
+    // applications on the same system listen to these distinct streams,
+    // the multicast MAC address management is such that any socket which
+    // is bound to the common port will receive the traffic for all streams.
+    // This is why we need to check the destination address and exclude
+    // packets which are not from the intended stream.
+    //
+    // We accept a packet in any of:
+    // 1) Actual packet destination is unknown. Probably, the system cannot
+    //    report the destination address.
+    // 2) We listen to a multicast address and the actual destination is the same.
+    // 3) If we listen to unicast traffic and the actual destination is unicast.
+    //    In that case, unicast is by definition sent to us.
+
+    if (destination.hasAddress() && ((_args.destination.hasAddress() && destination != _args.destination) || (!_args.destination.hasAddress() && destination.isMulticast()))) {
+        // This is a spurious packet.
+        if (report.maxSeverity() >= Severity::Debug) {
+            // Prior report level checking to avoid evaluating parameters when not necessary.
+            report.debug(u"rejecting packet, destination: %s, expecting: %s", destination, _args.destination);
         }
+        return false;
+    }
 
-        // Keep track of senders (sources) to detect or filter multiple sources.
-        if (_sources.count(sender) == 0) {
-            // Detected an additional source, warn the user that distinct streams are potentially mixed.
-            // If no source filtering is applied, this is a warning since this may affect the resulting stream.
-            // With source filtering, this is just an informational verbose-level message.
-            const int level = _args.source.hasAddress() ? Severity::Verbose : Severity::Warning;
-            if (_sources.size() == 1) {
-                report.log(level, u"detected multiple sources for the same destination %s with potentially distinct streams", destination);
-                report.log(level, u"detected source: %s", _first_source);
-            }
-            report.log(level, u"detected source: %s", sender);
-            _sources.insert(sender);
+    // Keep track of the first sender address.
+    if (!_first_source.hasAddress()) {
+        // First packet, keep address of the sender.
+        _first_source = sender;
+        _sources.insert(sender);
+
+        // With option --first-source, use this one to filter packets.
+        if (_args.use_first_source) {
+            _args.source = sender;
+            report.verbose(u"now filtering on source address %s", sender);
         }
+    }
 
-        // Filter packets based on source address if requested.
-        if (!sender.match(_args.source)) {
-            // Not the expected source, this is a spurious packet.
-            if (report.maxSeverity() >= Severity::Debug) {
-                // Prior report level checking to avoid evaluating parameters when not necessary.
-                report.debug(u"rejecting packet, source: %s, expecting: %s", sender, _args.source);
-            }
-            continue;
+    // Keep track of senders (sources) to detect or filter multiple sources.
+    if (_sources.count(sender) == 0) {
+        // Detected an additional source, warn the user that distinct streams are potentially mixed.
+        // If no source filtering is applied, this is a warning since this may affect the resulting stream.
+        // With source filtering, this is just an informational verbose-level message.
+        const int level = _args.source.hasAddress() ? Severity::Verbose : Severity::Warning;
+        if (_sources.size() == 1) {
+            report.log(level, u"detected multiple sources for the same destination %s with potentially distinct streams", destination);
+            report.log(level, u"detected source: %s", _first_source);
         }
+        report.log(level, u"detected source: %s", sender);
+        _sources.insert(sender);
+    }
 
-        // Now found a packet matching all criteria.
-        return true;
+    // Filter packets based on source address if requested.
+    if (!sender.match(_args.source)) {
+        // Not the expected source, this is a spurious packet.
+        if (report.maxSeverity() >= Severity::Debug) {
+            // Prior report level checking to avoid evaluating parameters when not necessary.
+            report.debug(u"rejecting packet, source: %s, expecting: %s", sender, _args.source);
+        }
+        return false;
     }
+
+    // Now found a packet matching all criteria.
+    return true;
 }
@@ -66,10 +66,18 @@ namespace ts {
                              const AbortInterface* abort = nullptr,
                              Report& report = CERR,
                              cn::microseconds* timestamp = nullptr) override;
+        virtual bool receiveMultiple(ReceivedMessage* messages,
+                                     size_t max_count,
+                                     size_t& ret_count,
+                                     const AbortInterface* abort = nullptr,
+                                     Report& report = CERR) override;
 
     private:
         UDPReceiverArgs    _args {};          // Reception parameters (typically from the command line).
         IPSocketAddress    _first_source {};  // Socket address of first received packet.
         IPSocketAddressSet _sources {};       // Set of all detected packet sources.
+
+        // Check if a received message matches the filtering criteria.
+        bool acceptMessage(const IPSocketAddress& sender, const IPSocketAddress& destination, cn::microseconds timestamp, Report& report);
     };
 }
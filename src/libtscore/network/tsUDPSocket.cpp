@@ -569,6 +569,76 @@ bool ts::UDPSocket::send(const void* data, size_t size, const IPSocketAddress& d
 }
 
 
+//----------------------------------------------------------------------------
+// Send several messages to a destination address and port.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::sendMultiple(const SentMessage* messages, size_t count, Report& report)
+{
+    return sendMultiple(messages, count, _default_destination, report);
+}
+
+bool ts::UDPSocket::sendMultiple(const SentMessage* messages, size_t count, const IPSocketAddress& dest_in, Report& report)
+{
+    if (messages == nullptr || count == 0) {
+        return true;
+    }
+
+#if defined(TS_LINUX)
+
+    IPSocketAddress dest(dest_in);
+    if (!convert(dest, report)) {
+        return false;
+    }
+
+    ::sockaddr_storage addr;
+    const size_t addr_size = dest.get(addr);
+
+    // All system structures are on the stack, at most MAX_SEND_MULTIPLE messages per system call.
+    ::mmsghdr hdr[MAX_SEND_MULTIPLE];
+    ::iovec vec[MAX_SEND_MULTIPLE];
+
+    while (count > 0) {
+        const size_t max_count = std::min(count, MAX_SEND_MULTIPLE);
+        for (size_t i = 0; i < max_count; ++i) {
+            TS_ZERO(hdr[i]);
+            vec[i].iov_base = const_cast<void*>(messages[i].data);
+            vec[i].iov_len = messages[i].size;
+            hdr[i].msg_hdr.msg_name = &addr;
+            hdr[i].msg_hdr.msg_namelen = socklen_t(addr_size);
+            hdr[i].msg_hdr.msg_iov = &vec[i];
+            hdr[i].msg_hdr.msg_iovlen = 1; // number of iovec structures
+        }
+
+        // The kernel may send fewer messages than requested, loop on the rest.
+        const int sent = ::sendmmsg(getSocket(), hdr, static_cast<unsigned int>(max_count), 0);
+        if (sent < 0) {
+            if (LastSysErrorCode() == EINTR) {
+                report.debug(u"signal, not user interrupt");
+                continue;
+            }
+            report.error(u"error sending UDP message: %s", SysErrorCodeMessage());
+            return false;
+        }
+        messages += sent;
+        count -= size_t(sent);
+    }
+    return true;
+
+#else
+
+    // No multiple send on this system, send messages one by one.
+    for (size_t i = 0; i < count; ++i) {
+        if (!send(messages[i].data, messages[i].size, dest_in, report)) {
+            return false;
+        }
+    }
+    return true;
+
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Receive a message.
 //----------------------------------------------------------------------------
@@ -744,13 +814,161 @@ int ts::UDPSocket::receiveOne(void* data,
         return LastSysErrorCode();
     }
 
+    // Browse returned ancillary data.
+    getAncillaryData(hdr, destination, timestamp);
+
+#endif // Windows vs. UNIX
+
+    // Successfully received a message
+    ret_size = size_t(insize);
+    sender = IPSocketAddress(sender_sock);
+
+    return 0; // success
+}
+
+
+//----------------------------------------------------------------------------
+// Receive several messages in one operation.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::receiveMultiple(ReceivedMessage* messages, size_t max_count, size_t& ret_count, const AbortInterface* abort, Report& report)
+{
+    ret_count = 0;
+    if (messages == nullptr || max_count == 0) {
+        return true;
+    }
+
+    // Loop on unsollicited interrupts
+    for (;;) {
+
+        // Wait for at least one message.
+        const int err = receiveBatch(messages, std::min(max_count, MAX_RECEIVE_MULTIPLE), ret_count, report);
+
+        if (abort != nullptr && abort->aborting()) {
+            // Aborting, no error message.
+            return false;
+        }
+        else if (err == 0) {
+            // Sometimes, we get "successful" empty message coming from nowhere. Ignore them.
+            size_t count = 0;
+            for (size_t i = 0; i < ret_count; ++i) {
+                if (messages[i].size > 0 || messages[i].sender.hasAddress()) {
+                    if (i != count) {
+                        std::swap(messages[count], messages[i]);
+                    }
+                    count++;
+                }
+            }
+            ret_count = count;
+            if (ret_count > 0) {
+                return true;
+            }
+        }
+        else if (abort != nullptr && abort->aborting()) {
+            // User-interrupt, end of processing but no error message
+            return false;
+        }
+#if defined(TS_UNIX)
+        else if (err == EINTR) {
+            // Got a signal, not a user interrupt, will ignore it
+            report.debug(u"signal, not user interrupt");
+        }
+#endif
+        else {
+            // Abort on non-interrupt errors.
+            if (isOpen()) {
+                // Report the error only if the error does not result from a close in another thread.
+                report.error(u"error receiving from UDP socket: %s", SysErrorCodeMessage(err));
+            }
+            return false;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Perform one multiple receive operation.
+//----------------------------------------------------------------------------
+
+int ts::UDPSocket::receiveBatch(ReceivedMessage* messages, size_t max_count, size_t& ret_count, Report& report)
+{
+    ret_count = 0;
+
+#if defined(TS_LINUX)
+
+    // Size of ancillary data per message: destination address and timestamp only.
+    static constexpr size_t ANCIL_SIZE = 256;
+
+    // All system structures are on the stack (max_count <= MAX_RECEIVE_MULTIPLE).
+    ::mmsghdr hdr[MAX_RECEIVE_MULTIPLE];
+    ::iovec vec[MAX_RECEIVE_MULTIPLE];
+    ::sockaddr_storage sender_sock[MAX_RECEIVE_MULTIPLE];
+    uint8_t ancil_data[MAX_RECEIVE_MULTIPLE][ANCIL_SIZE];
+
+    assert(max_count <= MAX_RECEIVE_MULTIPLE);
+    for (size_t i = 0; i < max_count; ++i) {
+        TS_ZERO(hdr[i]);
+        TS_ZERO(sender_sock[i]);
+        vec[i].iov_base = messages[i].data;
+        vec[i].iov_len = messages[i].max_size;
+        hdr[i].msg_hdr.msg_name = &sender_sock[i];
+        hdr[i].msg_hdr.msg_namelen = sizeof(sender_sock[i]);
+        hdr[i].msg_hdr.msg_iov = &vec[i];
+        hdr[i].msg_hdr.msg_iovlen = 1; // number of iovec structures
+        hdr[i].msg_hdr.msg_control = ancil_data[i];
+        hdr[i].msg_hdr.msg_controllen = ANCIL_SIZE;
+    }
+
+    // Wait for the first message, then get all available messages without waiting.
+    const int count = ::recvmmsg(getSocket(), hdr, static_cast<unsigned int>(max_count), MSG_WAITFORONE, nullptr);
+    if (count < 0) {
+        return LastSysErrorCode();
+    }
+
+    // Analyze all messages.
+    ret_count = size_t(count);
+    for (size_t i = 0; i < ret_count; ++i) {
+        ReceivedMessage& msg(messages[i]);
+        msg.size = size_t(hdr[i].msg_len);
+        msg.sender = IPSocketAddress(sender_sock[i]);
+        msg.destination.clear();
+        msg.timestamp = cn::microseconds(-1);
+        getAncillaryData(hdr[i].msg_hdr, msg.destination, &msg.timestamp);
+        if ((hdr[i].msg_hdr.msg_flags & MSG_TRUNC) != 0) {
+            report.warning(u"truncated UDP message, received %d bytes, buffer size is %d bytes", msg.size, msg.max_size);
+        }
+    }
+
+#else
+
+    // No multiple receive on this system, receive one message.
+    ReceivedMessage& msg(messages[0]);
+    msg.timestamp = cn::microseconds(-1);
+    const int err = receiveOne(msg.data, msg.max_size, msg.size, msg.sender, msg.destination, report, &msg.timestamp);
+    if (err != 0) {
+        return err;
+    }
+    ret_count = 1;
+
+#endif
+
+    return 0; // success
+}
+
+//----------------------------------------------------------------------------
+// Analyze the ancillary data of a received message (UNIX only).
+//----------------------------------------------------------------------------
+
+#if !defined(TS_WINDOWS)
+
+void ts::UDPSocket::getAncillaryData(::msghdr& hdr, IPSocketAddress& destination, cn::microseconds* timestamp)
+{
     TS_PUSH_WARNING()
     TS_GCC_NOWARNING(zero-as-null-pointer-constant) // invalid definition of CMSG_NXTHDR in musl libc (Alpine Linux)
 #if defined(TS_OPENBSD)
     TS_LLVM_NOWARNING(cast-align) // invalid definition of CMSG_NXTHDR on OpenBSD
 #endif
 
-    // Browse returned ancillary data.
     for (::cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
 
         // Look for destination IP address.
@@ -789,12 +1007,6 @@ int ts::UDPSocket::receiveOne(void* data,
     }
 
     TS_POP_WARNING()
-
-#endif // Windows vs. UNIX
-
-    // Successfully received a message
-    ret_size = size_t(insize);
-    sender = IPSocketAddress(sender_sock);
-
-    return 0; // success
 }
+
+#endif
@@ -336,6 +336,50 @@ namespace ts {
         //!
         virtual bool send(const void* data, size_t size, Report& report = CERR);
 
+        //!
+        //! Description of one message in a multiple send operation.
+        //! @see sendMultiple()
+        //!
+        class TSCOREDLL SentMessage
+        {
+        public:
+            const void* data = nullptr;  //!< Address of the message to send.
+            size_t      size = 0;        //!< Size in bytes of the message to send.
+        };
+
+        //!
+        //! Maximum number of messages which are sent in one system call by sendMultiple().
+        //!
+        static constexpr size_t MAX_SEND_MULTIPLE = 64;
+
+        //!
+        //! Send several messages to a destination address and port in one operation.
+        //!
+        //! On Linux, sendmmsg() is used to send up to MAX_SEND_MULTIPLE messages in one system call.
+        //! On other systems, the messages are sent one by one. In all cases, the messages are sent
+        //! in order, as if send() was called for each of them.
+        //!
+        //! @param [in] messages Array of @a count message descriptions.
+        //! @param [in] count Number of messages to send.
+        //! @param [in] destination Socket address of the destination.
+        //! Both address and port are mandatory in the socket address, they cannot
+        //! be set to IPAddress::AnyAddress4 or IPSocketAddress::AnyPort.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        virtual bool sendMultiple(const SentMessage* messages, size_t count, const IPSocketAddress& destination, Report& report = CERR);
+
+        //!
+        //! Send several messages to the default destination address and port in one operation.
+        //!
+        //! @param [in] messages Array of @a count message descriptions.
+        //! @param [in] count Number of messages to send.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //! @see sendMultiple(const SentMessage*, size_t, const IPSocketAddress&, Report&)
+        //!
+        virtual bool sendMultiple(const SentMessage* messages, size_t count, Report& report = CERR);
+
         //!
         //! Receive a message.
         //!
@@ -363,6 +407,52 @@ namespace ts {
                              Report& report = CERR,
                              cn::microseconds* timestamp = nullptr);
 
+        //!
+        //! Description of one message in a multiple reception operation.
+        //! @see receiveMultiple()
+        //!
+        class TSCOREDLL ReceivedMessage
+        {
+        public:
+            uint8_t*         data = nullptr;  //!< [in] Address of the buffer for the received message.
+            size_t           max_size = 0;    //!< [in] Size in bytes of the reception buffer.
+            size_t           size = 0;        //!< [out] Size in bytes of the received message. Never larger than @a max_size.
+            IPSocketAddress  sender {};       //!< [out] Socket address of the sender.
+            IPSocketAddress  destination {};  //!< [out] Socket address of the packet destination.
+            cn::microseconds timestamp {-1};  //!< [out] Receive timestamp in micro-seconds, negative if not available.
+        };
+
+        //!
+        //! Maximum number of messages which are received in one system call by receiveMultiple().
+        //!
+        static constexpr size_t MAX_RECEIVE_MULTIPLE = 64;
+
+        //!
+        //! Receive several messages in one operation.
+        //!
+        //! Wait for at least one message and then return all messages which are already available,
+        //! without waiting for more, up to @a max_count. On Linux, recvmmsg() is used to receive
+        //! all messages in one system call. On other systems, only one message is returned at a time.
+        //!
+        //! @param [in,out] messages Array of @a max_count message descriptions. In each of them,
+        //! the fields @a data and @a max_size shall be set on input. The other fields are returned.
+        //! The received messages are returned in the @a ret_count first elements. Because some messages
+        //! may be dropped by subclasses, the elements of the array may be reordered, including their
+        //! @a data and @a max_size fields.
+        //! @param [in] max_count Maximum number of messages to receive.
+        //! @param [out] ret_count Number of received messages. Never zero on success.
+        //! @param [in] abort If non-zero, invoked when I/O is interrupted
+        //! (in case of user-interrupt, return, otherwise retry).
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //! @see setReceiveTimestamps()
+        //!
+        virtual bool receiveMultiple(ReceivedMessage* messages,
+                                     size_t max_count,
+                                     size_t& ret_count,
+                                     const AbortInterface* abort = nullptr,
+                                     Report& report = CERR);
+
         // Implementation of Socket interface.
         virtual bool open(IP gen, Report& report = CERR) override;
         virtual bool close(Report& report = CERR) override;
@@ -442,6 +532,14 @@ namespace ts {
         // Perform one receive operation. Hide the system mud. Return a system socket error code.
         int receiveOne(void* data, size_t max_size, size_t& ret_size, IPSocketAddress& sender, IPSocketAddress& destination, Report& report, cn::microseconds* timestamp);
 
+        // Perform one multiple receive operation. Return a system socket error code.
+        int receiveBatch(ReceivedMessage* messages, size_t max_count, size_t& ret_count, Report& report);
+
+#if !defined(TS_WINDOWS)
+        // Analyze the ancillary data of a received message (UNIX only).
+        void getAncillaryData(::msghdr& hdr, IPSocketAddress& destination, cn::microseconds* timestamp);
+#endif
+
         // Add multicast membership common code, local interface by index or by address.
         bool addMembershipImpl(const IPAddress& multicast, const IPAddress& local, int interface_index, const IPAddress& source, Report& report);
 
@@ -470,3 +470,13 @@ ts::UString ts::UserConfigurationFileName(const UString& fileName, const UString
     return UserHomeDirectory() + u"/" + fileName;
 #endif
 }
+
+
+//----------------------------------------------------------------------------
+// Build the name of a user-specific cache file.
+//----------------------------------------------------------------------------
+
+ts::UString ts::UserCacheFileName(const UString& fileName)
+{
+    return UserConfigurationFileName(u".tsduck.cache", u"cache") + fs::path::preferred_separator + fileName;
+}
@@ -281,6 +281,18 @@ namespace ts {
     //! - Unix: @c $HOME
     //!
     TSCOREDLL UString UserConfigurationFileName(const UString& fileName, const UString& winFileName = UString());
+
+    //!
+    //! Build the name of a user-specific cache file.
+    //! Cache files contain data which can be rebuilt at any time, they can be safely deleted.
+    //! @ingroup files
+    //! @param [in] fileName Base name of the cache file.
+    //! @return The path to the user-specific cache file. The file may exist or not.
+    //! The cache directory depends on the operating system:
+    //! - Windows: @c \%APPDATA%\\tsduck\\cache
+    //! - Unix: @c $HOME/.tsduck.cache
+    //!
+    TSCOREDLL UString UserCacheFileName(const UString& fileName);
 }
 
 
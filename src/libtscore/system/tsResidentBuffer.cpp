@@ -0,0 +1,192 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsResidentBuffer.h"
+
+// The NUMA memory policy is set using the system call directly, using the kernel headers only.
+#if defined(TS_LINUX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #if __has_include(<linux/mempolicy.h>)
+        #include <linux/mempolicy.h>
+        #define TS_MBIND 1
+    #endif
+    #include "tsAfterStandardHeaders.h"
+#endif
+
+
+//----------------------------------------------------------------------------
+// Constructor, based on required size in bytes.
+//----------------------------------------------------------------------------
+
+ts::ResidentMemory::ResidentMemory(size_t requested_size, bool huge_pages, int numa_node)
+{
+    const size_t page_size = SysInfo::Instance().memoryPageSize();
+
+    // Huge pages and NUMA placement require full pages, allocated using mmap().
+    if (huge_pages || numa_node >= 0) {
+        mapMemory(requested_size, huge_pages);
+    }
+
+#if defined(TS_MBIND)
+    // Set the preferred NUMA node before the pages are actually allocated (when first touched or locked).
+    if (_mapped && numa_node >= 0 && numa_node < 1024) {
+        std::array<unsigned long, 1024 / (8 * sizeof(unsigned long))> mask {};
+        mask[size_t(numa_node) / (8 * sizeof(unsigned long))] |= 1UL << (size_t(numa_node) % (8 * sizeof(unsigned long)));
+        if (::syscall(SYS_mbind, _locked_base, _locked_size, MPOL_PREFERRED, mask.data(), 8 * sizeof(mask), 0) == 0) {
+            _numa_node = numa_node;
+        }
+    }
+#endif
+
+    // Default allocation.
+    if (!_mapped) {
+        // Allocate enough space to include memory pages around the requested size
+        _allocated_size = requested_size + 2 * page_size;
+        _allocated_base = new char[_allocated_size];
+
+        // Locked space starts at next page boundary after allocated base:
+        // Its size is the next multiple of page size after requested_size:
+        // Be sure to use size_t (unsigned) instead of ptrdiff_t (signed)
+        // to perform arithmetics on pointers because we use modulo operations.
+        assert(sizeof(size_t) == sizeof(char_ptr));
+        _locked_base = char_ptr(round_up(size_t(_allocated_base), page_size));
+        _locked_size = round_up(requested_size, page_size);
+    }
+
+    // Integrity checks
+    assert(_allocated_base <= _locked_base);
+    assert(_mapped || _locked_base < _allocated_base + page_size);
+    assert(_locked_base + _locked_size <= _allocated_base + _allocated_size);
+    assert(requested_size <= _locked_size);
+    assert(_locked_size <= _allocated_size);
+    assert(size_t(_locked_base) % page_size == 0);
+    assert(_locked_size % page_size == 0);
+
+#if defined(TS_WINDOWS)
+
+    // Windows implementation.
+
+    // Get the current working set of the process.
+    // If working set too low, try to extend working set.
+    ::SIZE_T wsmin = 0;
+    ::SIZE_T wsmax = 0;
+    if (::GetProcessWorkingSetSize(::GetCurrentProcess(), &wsmin, &wsmax) == 0) {
+        _error_code.assign(::GetLastError(), std::system_category());
+    }
+    else if (size_t(wsmin) < 2 * _locked_size) {
+        wsmin = ::SIZE_T(2 * _locked_size);
+        wsmax = std::max(wsmax, ::SIZE_T(4 * _locked_size));
+        if (::SetProcessWorkingSetSize(::GetCurrentProcess(), wsmin, wsmax) == 0) {
+            _error_code.assign(::GetLastError(), std::system_category());
+        }
+    }
+
+    // Lock in virtual memory.
+    _is_locked = ::VirtualLock(_locked_base, _locked_size) != 0;
+    if (!_is_locked && _error_code.default_error_condition().value() == 0) {
+        // Keep this error only when no previous error.
+        _error_code.assign(::GetLastError(), std::system_category());
+    }
+
+#else
+
+    // UNIX implementation
+
+    _is_locked = ::mlock(_locked_base, _locked_size) == 0;
+    if (!_is_locked) {
+        _error_code.assign(errno, std::system_category());
+    }
+
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Try to allocate the memory area using mmap().
+//----------------------------------------------------------------------------
+
+bool ts::ResidentMemory::mapMemory(size_t size, bool huge_pages)
+{
+#if defined(TS_LINUX)
+
+    // The default huge page size is 2 MB on x86_64 and arm64 (with 4 kB base pages).
+    // With explicit huge pages, the mapped size must be a multiple of the huge page size.
+    // With transparent huge pages, using a multiple of the huge page size gives a chance
+    // to the last huge page to be used.
+    constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+    size = round_up(size, huge_pages ? HUGE_PAGE_SIZE : SysInfo::Instance().memoryPageSize());
+
+    // First try: explicit huge pages.
+    void* addr = huge_pages ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0) : MAP_FAILED;
+    if (addr != MAP_FAILED) {
+        _huge_pages = true;
+    }
+    else {
+        // Normal pages, possibly using transparent huge pages.
+        addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+        _huge_pages = huge_pages && ::madvise(addr, size, MADV_HUGEPAGE) == 0;
+    }
+
+    _mapped = true;
+    _allocated_base = _locked_base = reinterpret_cast<char*>(addr);
+    _allocated_size = _locked_size = size;
+    return true;
+
+#else
+
+    // Not implemented on other systems.
+    return false;
+
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Destructor
+//----------------------------------------------------------------------------
+
+ts::ResidentMemory::~ResidentMemory()
+{
+    // Unlock from physical memory
+    if (_is_locked) {
+#if defined(TS_WINDOWS)
+        ::VirtualUnlock(_locked_base, _locked_size);
+#else
+        ::munlock(_locked_base, _locked_size);
+#endif
+    }
+
+    // Free memory
+    if (_allocated_base != nullptr) {
+#if defined(TS_LINUX)
+        if (_mapped) {
+            ::munmap(_allocated_base, _allocated_size);
+        }
+        else
+#endif
+        {
+            delete[] _allocated_base;
+        }
+    }
+
+    // Reset state (it explicit call of destructor)
+    _allocated_base = nullptr;
+    _locked_base = nullptr;
+    _allocated_size = 0;
+    _locked_size = 0;
+    _mapped = false;
+    _huge_pages = false;
+    _numa_node = -1;
+    _is_locked = false;
+}
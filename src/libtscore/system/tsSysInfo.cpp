@@ -14,6 +14,7 @@
 
 #if defined(TS_LINUX)
     #include <sys/auxv.h>
+    #include <sched.h>
 #endif
 
 #if defined(TS_MAC)
@@ -285,6 +286,38 @@ ts::SysInfo::SysInfo() :
 
 #endif
 
+    //
+    // Get the NUMA topology.
+    //
+#if defined(TS_LINUX)
+
+    // Each NUMA node is described in a directory /sys/devices/system/node/node<n>.
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(u"/sys/devices/system/node", error)) {
+        const UString dir_name(entry.path().filename());
+        size_t node = 0;
+        UStringList cpulist;
+        std::set<size_t> cpus;
+        if (dir_name.starts_with(u"node") && dir_name.substr(4).toInteger(node) && node < 1024 &&
+            UString::Load(cpulist, entry.path() / u"cpulist") && !cpulist.empty() && DecodeCPUList(cpus, cpulist.front()))
+        {
+            if (node >= _numaCPUs.size()) {
+                _numaCPUs.resize(node + 1);
+            }
+            _numaCPUs[node] = cpus;
+        }
+    }
+
+#endif
+
+    // Without NUMA information, use one single node with all CPU's.
+    if (_numaCPUs.empty()) {
+        _numaCPUs.resize(1);
+        for (size_t cpu = 0; cpu < std::max<size_t>(1, std::thread::hardware_concurrency()); ++cpu) {
+            _numaCPUs[0].insert(cpu);
+        }
+    }
+
     //
     // Get support for specialized instructions.
     // Can be globally disabled using environment variables.
@@ -295,12 +328,107 @@ ts::SysInfo::SysInfo() :
                 _crcInstructions = tsCRC32IsAccelerated && (::getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
             #elif defined(TS_MAC)
                 _crcInstructions = tsCRC32IsAccelerated && SysCtrlBool("hw.optional.armv8_crc32");
+            #elif defined(TS_GCC) && (defined(TS_X86_64) || defined(TS_I386))
+                _crcInstructions = tsCRC32IsAccelerated && __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+            #endif
+        }
+        if (GetEnvironment(u"TS_NO_AVX2_INSTRUCTIONS").empty()) {
+            #if defined(TS_GCC) && (defined(TS_X86_64) || defined(TS_I386))
+                _avx2Instructions = __builtin_cpu_supports("avx2");
             #endif
         }
     }
 }
 
 
+//----------------------------------------------------------------------------
+// NUMA topology.
+//----------------------------------------------------------------------------
+
+const std::set<size_t>& ts::SysInfo::numaNodeCPUs(size_t node) const
+{
+    static const std::set<size_t> empty;
+    return node < _numaCPUs.size() ? _numaCPUs[node] : empty;
+}
+
+size_t ts::SysInfo::cpuNUMANode(size_t cpu) const
+{
+    for (size_t node = 0; node < _numaCPUs.size(); ++node) {
+        if (_numaCPUs[node].contains(cpu)) {
+            return node;
+        }
+    }
+    return NPOS;
+}
+
+size_t ts::SysInfo::CurrentCPU()
+{
+#if defined(TS_LINUX)
+    const int cpu = ::sched_getcpu();
+    return cpu < 0 ? NPOS : size_t(cpu);
+#elif defined(TS_WINDOWS)
+    return size_t(::GetCurrentProcessorNumber());
+#else
+    return NPOS;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Decode / format a list of CPU's.
+//----------------------------------------------------------------------------
+
+bool ts::SysInfo::DecodeCPUList(std::set<size_t>& cpus, const UString& list)
+{
+    cpus.clear();
+    UStringVector fields;
+    list.split(fields, u',', true, true);
+    for (const auto& field : fields) {
+        size_t first = 0, last = 0;
+        const size_t dash = field.find(u'-');
+        if (dash == NPOS) {
+            if (!field.toInteger(first)) {
+                return false;
+            }
+            last = first;
+        }
+        else if (!field.substr(0, dash).toInteger(first) || !field.substr(dash + 1).toInteger(last) || last < first) {
+            return false;
+        }
+        if (last >= MAX_CPUS) {
+            return false;
+        }
+        for (size_t cpu = first; cpu <= last; ++cpu) {
+            cpus.insert(cpu);
+        }
+    }
+    return !cpus.empty();
+}
+
+ts::UString ts::SysInfo::FormatCPUList(const std::set<size_t>& cpus)
+{
+    UString list;
+    for (auto it = cpus.begin(); it != cpus.end(); ) {
+        // Find a range of contiguous CPU's.
+        const size_t first = *it;
+        size_t last = first;
+        while (++it != cpus.end() && *it == last + 1) {
+            last++;
+        }
+        if (!list.empty()) {
+            list.append(u',');
+        }
+        if (last == first) {
+            list.format(u"%d", first);
+        }
+        else {
+            list.format(u"%d-%d", first, last);
+        }
+    }
+    return list;
+}
+
+
 //----------------------------------------------------------------------------
 // Build a string representing the system on which the application runs.
 //----------------------------------------------------------------------------
@@ -337,7 +465,7 @@ TS_REGISTER_FEATURE(u"acceleration", u"Acceleration", ALWAYS, ts::SysInfo::GetAc
 
 ts::UString ts::SysInfo::GetAccelerations()
 {
-    return UString::Format(u"CRC32: %s", UString::YesNo(Instance().crcInstructions()));
+    return UString::Format(u"CRC32: %s, AVX2: %s", UString::YesNo(Instance().crcInstructions()), UString::YesNo(Instance().avx2Instructions()));
 }
 
 
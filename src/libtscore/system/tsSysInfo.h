@@ -86,10 +86,16 @@ namespace ts {
         SysFlavor osFlavor() const { return _osFlavor; }
         //!
         //! Check if the CPU supports accelerated instructions for CRC32 computation.
+        //! These are the CRC32 instructions on Arm64 and the carry-less multiplication on Intel.
         //! @return True if the CPU supports CRC32 instructions.
         //!
         bool crcInstructions() const { return _crcInstructions; }
         //!
+        //! Check if the CPU supports AVX2 SIMD instructions (Intel x86 and x86_64 only).
+        //! @return True if the CPU supports AVX2 instructions.
+        //!
+        bool avx2Instructions() const { return _avx2Instructions; }
+        //!
         //! Get the operating system version.
         //! @return The operating system version.
         //!
@@ -120,6 +126,51 @@ namespace ts {
         //! @return The system memory page size in bytes.
         //!
         size_t memoryPageSize() const { return _memoryPageSize; }
+        //!
+        //! Maximum number of CPU's which are supported in CPU lists and NUMA nodes.
+        //!
+        static constexpr size_t MAX_CPUS = 4096;
+        //!
+        //! Get the number of NUMA nodes in the system.
+        //! On systems without NUMA information, there is one single node containing all CPU's.
+        //! NUMA node numbers are not necessarily contiguous. Missing node numbers are reported
+        //! as nodes without CPU.
+        //! @return The number of NUMA nodes, at least one.
+        //!
+        size_t numaNodeCount() const { return _numaCPUs.size(); }
+        //!
+        //! Get the CPU's in a NUMA node.
+        //! @param [in] node NUMA node index, from 0 to numaNodeCount() - 1.
+        //! @return A constant reference to the set of CPU indexes in the node. Empty if @a node is invalid.
+        //!
+        const std::set<size_t>& numaNodeCPUs(size_t node) const;
+        //!
+        //! Get the NUMA node of a CPU.
+        //! @param [in] cpu CPU index.
+        //! @return The NUMA node index of @a cpu or NPOS if unknown.
+        //!
+        size_t cpuNUMANode(size_t cpu) const;
+
+        //!
+        //! Get the index of the CPU on which the current thread is running.
+        //! @return The CPU index or NPOS if unknown.
+        //!
+        static size_t CurrentCPU();
+
+        //!
+        //! Decode a list of CPU's, as used in the Linux /sys filesystem or by the taskset command.
+        //! @param [out] cpus Set of CPU indexes.
+        //! @param [in] list List of CPU's, for instance "0-3,8,10-11".
+        //! @return True on success, false on invalid list or CPU index greater than or equal to MAX_CPUS.
+        //!
+        static bool DecodeCPUList(std::set<size_t>& cpus, const UString& list);
+
+        //!
+        //! Format a set of CPU's as a list, as used in the Linux /sys filesystem or by the taskset command.
+        //! @param [in] cpus Set of CPU indexes.
+        //! @return A list of CPU's, for instance "0-3,8,10-11".
+        //!
+        static UString FormatCPUList(const std::set<size_t>& cpus);
 
         //!
         //! Build a string representing the system on which the application runs.
@@ -145,10 +196,12 @@ namespace ts {
         SysOS     _osFamily;
         SysFlavor _osFlavor = UNKNOWN;
         bool      _crcInstructions = false;
+        bool      _avx2Instructions = false;
         int       _systemMajorVersion = -1;
         UString   _systemVersion {};
         UString   _systemName {};
         UString   _hostName {};
         size_t    _memoryPageSize = 0;
+        std::vector<std::set<size_t>> _numaCPUs {};  // CPU's in each NUMA node.
     };
 }
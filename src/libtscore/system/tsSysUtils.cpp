@@ -249,6 +249,37 @@ cn::milliseconds ts::GetProcessCpuTime()
 }
 
 
+//----------------------------------------------------------------------------
+// Get the CPU time of the calling thread in microseconds.
+//----------------------------------------------------------------------------
+
+cn::microseconds ts::GetThreadCpuTime()
+{
+#if defined(TS_WINDOWS)
+
+    ::FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (::GetThreadTimes(::GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time) == 0) {
+        return cn::microseconds::zero();
+    }
+    return cn::microseconds(1000 * (ts::Time::Win32FileTimeToMilliSecond(kernel_time) + ts::Time::Win32FileTimeToMilliSecond(user_time)));
+
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+
+    ::timespec tspec;
+    if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &tspec) < 0) {
+        return cn::microseconds::zero();
+    }
+    using rep = cn::microseconds::rep;
+    return cn::microseconds(rep(tspec.tv_sec) * 1'000'000 + rep(tspec.tv_nsec) / 1000);
+
+#else
+
+    return cn::microseconds::zero();
+
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Get the virtual memory size of the process in bytes.
 //----------------------------------------------------------------------------
@@ -112,6 +112,13 @@ namespace ts {
     //!
     TSCOREDLL cn::milliseconds GetProcessCpuTime();
 
+    //!
+    //! Get the CPU time of the calling thread in microseconds.
+    //! @ingroup system
+    //! @return The CPU time of the calling thread in microseconds or zero if it cannot be obtained.
+    //!
+    TSCOREDLL cn::microseconds GetThreadCpuTime();
+
     //!
     //! Get the virtual memory size of the process in bytes.
     //! @ingroup system
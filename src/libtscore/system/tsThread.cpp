@@ -184,17 +184,37 @@ bool ts::Thread::start()
         return false;
     }
 
+    // On error, the suspended thread must be terminated before closing its handle.
+    // Otherwise, it would remain suspended forever in the process.
+    const auto abort_thread = [this]() {
+        ::TerminateThread(_handle, 0);
+        ::WaitForSingleObject(_handle, INFINITE);
+        ::CloseHandle(_handle);
+        return false;
+    };
+
     // Set the thread priority
     ::BOOL status = ::SetThreadPriority(_handle, ThreadAttributes::Win32Priority(_attributes._priority));
     if (status == 0) {
-        ::CloseHandle(_handle);
-        return false;
+        return abort_thread();
+    }
+
+    // Set the CPU affinity.
+    if (!_attributes._cpus.empty()) {
+        ::DWORD_PTR mask = 0;
+        for (size_t cpu : _attributes._cpus) {
+            if (cpu < 8 * sizeof(mask)) {
+                mask |= ::DWORD_PTR(1) << cpu;
+            }
+        }
+        if (mask == 0 || ::SetThreadAffinityMask(_handle, mask) == 0) {
+            return abort_thread();
+        }
     }
 
     // Release the thread
     if (::ResumeThread(_handle) == ::DWORD(-1)) {
-        ::CloseHandle(_handle);
-        return false;
+        return abort_thread();
     }
 
 #else
@@ -232,6 +252,23 @@ bool ts::Thread::start()
         return false;
     }
 
+#if defined(TS_LINUX)
+    // Set the CPU affinity.
+    if (!_attributes._cpus.empty()) {
+        ::cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (size_t cpu : _attributes._cpus) {
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &cpus);
+            }
+        }
+        if (::pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus) != 0) {
+            ::pthread_attr_destroy(&attr);
+            return false;
+        }
+    }
+#endif
+
     // Use explicit scheduling attributes, do not inherit them from the current thread.
     // Apparently not supported on Android before API version 28.
 #if !defined(__ANDROID_API__) || __ANDROID_API__ >= 28
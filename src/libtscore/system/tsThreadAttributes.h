@@ -215,6 +215,33 @@ namespace ts {
             return _priority;
         }
 
+        //!
+        //! Set the CPU affinity of the thread.
+        //!
+        //! The thread will run only on the specified CPU's. By default, the set is empty
+        //! and the thread can run on any CPU. The CPU affinity is supported on Linux and
+        //! Windows (CPU's 0 to 63 only). It is ignored on other operating systems.
+        //!
+        //! @param [in] cpus Set of CPU indexes. If empty, the thread can run on any CPU.
+        //! @return A reference to this object.
+        //! @see SysInfo::numaNodeCPUs()
+        //!
+        ThreadAttributes& setCPUs(const std::set<size_t>& cpus)
+        {
+            _cpus = cpus;
+            return *this;
+        }
+
+        //!
+        //! Get the CPU affinity of the thread.
+        //! @return A constant reference to the set of CPU indexes. Empty means any CPU.
+        //! @see setCPUs()
+        //!
+        const std::set<size_t>& getCPUs() const
+        {
+            return _cpus;
+        }
+
         //!
         //! Get the minimum priority for a thread in this context of the operating system.
         //! @return The minimum priority for a thread.
@@ -274,6 +301,7 @@ namespace ts {
         bool    _exitOnException = false;
         int     _priority = 0;
         UString _name {};
+        std::set<size_t> _cpus {};
 
         //
         // These fields describe the operating system priority range.
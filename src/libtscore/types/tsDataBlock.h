@@ -118,6 +118,8 @@ namespace ts {
 
         //!
         //! Reload from full binary content.
+        //! If the current binary data are not shared with another instance, the
+        //! memory is reused. Otherwise, the content is copied into a new byte block.
         //! @param [in] content Address of the binary packet data.
         //! @param [in] content_size Size in bytes of the packet.
         //!
@@ -325,11 +327,18 @@ _TEMPLATE bool ts::_CLASSNAME::isValid() const
 // Reload from full binary content (virtual).
 _TEMPLATE void ts::_CLASSNAME::reload(const void* content, size_t content_size)
 {
-    if (ValidateLengthField(content, content_size, false)) {
-        _data = std::make_shared<ByteBlock>(content, content_size);
+    if (!ValidateLengthField(content, content_size, false)) {
+        _data.reset();
+    }
+    else if (_data != nullptr && _data.use_count() == 1 &&
+             (static_cast<const uint8_t*>(content) + content_size <= _data->data() ||
+              static_cast<const uint8_t*>(content) >= _data->data() + _data->size()))
+    {
+        // Not shared and not overlapping the new content, reuse the previous memory.
+        _data->copy(content, content_size);
     }
     else {
-        _data.reset();
+        _data = std::make_shared<ByteBlock>(content, content_size);
     }
 }
 
@@ -0,0 +1,50 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+// Bitsliced DVB-CSA2 stream cipher using accelerated instructions, when available.
+// This module is compiled with special options to use optional instructions
+// for the target architecture (AVX2 on Intel). It may fail when these instructions
+// are not implemented in the current CPU. Consequently, this module shall not be
+// called when these instructions are not implemented.
+//
+//----------------------------------------------------------------------------
+
+#include "tsDVBCSA2.h"
+#include "tsDVBCSA2Bitslice.h"
+
+// Check if AVX2 instructions can be used with 256-bit vectors.
+#if defined(TS_GCC) && defined(__AVX2__) && !defined(TS_NO_AVX2_INSTRUCTIONS)
+    #define TS_AVX2_INSTRUCTIONS 1
+    typedef uint64_t DVBCSA2Vector256 __attribute__((vector_size(32)));
+#endif
+
+// "Hidden" exported bool to inform the DVBCSA2 class that we have compiled accelerated instructions.
+extern const bool tsDVBCSA2IsAccelerated =
+#if defined(TS_AVX2_INSTRUCTIONS)
+    true;
+#else
+    false;
+#endif
+
+// Don't complain about assert(false) when acceleration is not implemented.
+TS_LLVM_NOWARNING(missing-noreturn)
+
+
+//----------------------------------------------------------------------------
+// Compute the keystreams of up to 256 packets.
+//----------------------------------------------------------------------------
+
+void ts::DVBCSA2::StreamBatchAccel(const uint8_t* key, const uint8_t* const* init, size_t count, uint8_t* ks, size_t ks_stride, size_t ks_size)
+{
+#if defined(TS_AVX2_INSTRUCTIONS)
+    DVBCSA2StreamBitslice<DVBCSA2Vector256>::Generate(key, init, count, ks, ks_stride, ks_size);
+#else
+    // Shall not be called.
+    assert(false);
+#endif
+}
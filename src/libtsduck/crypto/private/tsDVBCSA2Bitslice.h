@@ -0,0 +1,447 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Bitsliced implementation of the DVB-CSA2 stream cipher (private header).
+//!
+//----------------------------------------------------------------------------
+//
+// In a bitsliced implementation, each bit of the state of the stream cipher
+// is stored in one "word" of type W. Bit N of each word belongs to the state
+// of the Nth packet. Thus, with 64-bit words, 64 packets are processed at once,
+// using logical operations only. With 128-bit or 256-bit SIMD words, 128 or 256
+// packets are processed at once. All packets share the same control word but
+// each packet has its own initialization block (first 8 bytes of the payload).
+//
+// The type W must support the operators &, |, ^ and ~. It shall be either
+// uint64_t or a GCC vector type of 64-bit integers (vector_size attribute).
+//
+// This header is included in distinct modules which are compiled with distinct
+// target instructions (e.g. AVX2). All code is consequently declared with an
+// internal linkage to make sure that the linker never mixes the instances.
+//
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+// "Hidden" global constant which is true when the accelerated module is compiled with AVX2 instructions.
+extern const bool tsDVBCSA2IsAccelerated;
+
+namespace {
+
+    // Number of 64-bit lanes in a bitsliced word.
+    template <typename W>
+    constexpr size_t DVBCSA2Lanes = sizeof(W) / sizeof(uint64_t);
+
+    // Transpose a 64x64 bit matrix: bit c of row r becomes bit r of row c.
+    inline void DVBCSA2Transpose64(uint64_t m[64])
+    {
+        uint64_t mask = 0x00000000FFFFFFFF;
+        for (size_t j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+            for (size_t k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+                const uint64_t t = ((m[k] >> j) ^ m[k | j]) & mask;
+                m[k] ^= t << j;
+                m[k | j] ^= t;
+            }
+        }
+    }
+
+    // S-box 1 of the stream cipher: hi, lo = sbox1[x4 x3 x2 x1 x0].
+    template <typename W>
+    inline void Sbox1(W& hi, W& lo, W x4, W x3, W x2, W x1, W x0)
+    {
+        const W x1x0 = x1 & x0;
+        const W x2x0 = x2 & x0;
+        const W x2x1 = x2 & x1;
+        const W x3x0 = x3 & x0;
+        const W x3x1 = x3 & x1;
+        const W x3x2 = x3 & x2;
+        const W x4x0 = x4 & x0;
+        const W x4x2 = x4 & x2;
+        const W x4x3 = x4 & x3;
+        const W x3x1x0 = x3x1 & x0;
+        const W x3x2x0 = x3x2 & x0;
+        const W x3x2x1 = x3x2 & x1;
+        const W x4x1 = x4 & x1;
+        const W x4x1x0 = x4x1 & x0;
+        const W x4x2x1 = x4x2 & x1;
+        const W x4x3x1 = x4x3 & x1;
+        const W x4x3x2 = x4x3 & x2;
+        const W x4x3x1x0 = x4x3x1 & x0;
+        const W x4x3x2x0 = x4x3x2 & x0;
+        const W x4x3x2x1 = x4x3x2 & x1;
+        hi = ~(x0 ^ x1 ^ x4 ^ x1x0 ^ x2x0 ^ x2x1 ^ x3x0 ^ x3x1 ^ x3x2 ^ x4x2 ^ x4x3 ^ x3x2x0 ^ x3x2x1 ^ x4x1x0 ^ x4x2x1 ^ x4x3x1 ^ x4x3x2 ^ x4x3x1x0 ^ x4x3x2x1);
+        lo = x1 ^ x3 ^ x2x0 ^ x3x0 ^ x4x0 ^ x4x3 ^ x3x1x0 ^ x4x3x1 ^ x4x3x2 ^ x4x3x2x0;
+    }
+
+    // S-box 2 of the stream cipher: hi, lo = sbox2[x4 x3 x2 x1 x0].
+    template <typename W>
+    inline void Sbox2(W& hi, W& lo, W x4, W x3, W x2, W x1, W x0)
+    {
+        const W x2x0 = x2 & x0;
+        const W x2x1 = x2 & x1;
+        const W x4x2 = x4 & x2;
+        const W x4x3 = x4 & x3;
+        const W x2x1x0 = x2x1 & x0;
+        const W x3x1 = x3 & x1;
+        const W x3x1x0 = x3x1 & x0;
+        const W x3x2 = x3 & x2;
+        const W x3x2x0 = x3x2 & x0;
+        const W x4x1 = x4 & x1;
+        const W x4x1x0 = x4x1 & x0;
+        const W x4x2x1 = x4x2 & x1;
+        const W x4x3x0 = x4x3 & x0;
+        const W x4x3x1 = x4x3 & x1;
+        const W x4x3x2 = x4x3 & x2;
+        const W x4x3x1x0 = x4x3x1 & x0;
+        const W x4x3x2x0 = x4x3x2 & x0;
+        hi = ~(x0 ^ x1 ^ x3 ^ x2x0 ^ x2x1 ^ x2x1x0 ^ x4x2x1 ^ x4x3x0 ^ x4x3x1 ^ x4x3x2 ^ x4x3x1x0);
+        lo = ~(x1 ^ x2 ^ x2x0 ^ x4x2 ^ x4x3 ^ x3x1x0 ^ x3x2x0 ^ x4x1x0 ^ x4x3x1x0 ^ x4x3x2x0);
+    }
+
+    // S-box 3 of the stream cipher: hi, lo = sbox3[x4 x3 x2 x1 x0].
+    template <typename W>
+    inline void Sbox3(W& hi, W& lo, W x4, W x3, W x2, W x1, W x0)
+    {
+        const W x1x0 = x1 & x0;
+        const W x2x0 = x2 & x0;
+        const W x2x1 = x2 & x1;
+        const W x3x0 = x3 & x0;
+        const W x3x1 = x3 & x1;
+        const W x3x2 = x3 & x2;
+        const W x4x1 = x4 & x1;
+        const W x4x2 = x4 & x2;
+        const W x2x1x0 = x2x1 & x0;
+        const W x3x1x0 = x3x1 & x0;
+        const W x3x2x1 = x3x2 & x1;
+        const W x4x1x0 = x4x1 & x0;
+        const W x4x2x0 = x4x2 & x0;
+        const W x4x2x1 = x4x2 & x1;
+        const W x4x3 = x4 & x3;
+        const W x4x3x0 = x4x3 & x0;
+        const W x4x3x2 = x4x3 & x2;
+        const W x4x2x1x0 = x4x2x1 & x0;
+        const W x4x3x2x1 = x4x3x2 & x1;
+        hi = ~(x0 ^ x1 ^ x3 ^ x4 ^ x2x0 ^ x2x1 ^ x3x0 ^ x3x1 ^ x3x2 ^ x4x1 ^ x4x2 ^ x2x1x0 ^ x3x1x0 ^ x3x2x1 ^ x4x1x0 ^ x4x2x0 ^ x4x2x1 ^ x4x3x0 ^ x4x3x2 ^ x4x2x1x0 ^ x4x3x2x1);
+        lo = x1 ^ x3 ^ x4 ^ x1x0 ^ x2x0;
+    }
+
+    // S-box 4 of the stream cipher: hi, lo = sbox4[x4 x3 x2 x1 x0].
+    template <typename W>
+    inline void Sbox4(W& hi, W& lo, W x4, W x3, W x2, W x1, W x0)
+    {
+        const W x1x0 = x1 & x0;
+        const W x3x0 = x3 & x0;
+        const W x3x2 = x3 & x2;
+        const W x4x0 = x4 & x0;
+        const W x4x1 = x4 & x1;
+        const W x4x3 = x4 & x3;
+        const W x2x1 = x2 & x1;
+        const W x2x1x0 = x2x1 & x0;
+        const W x3x1 = x3 & x1;
+        const W x3x1x0 = x3x1 & x0;
+        const W x3x2x1 = x3x2 & x1;
+        const W x4x3x0 = x4x3 & x0;
+        const W x4x3x2 = x4x3 & x2;
+        const W x4x2 = x4 & x2;
+        const W x4x2x1 = x4x2 & x1;
+        const W x4x2x1x0 = x4x2x1 & x0;
+        const W x4x3x1 = x4x3 & x1;
+        const W x4x3x1x0 = x4x3x1 & x0;
+        const W x4x3x2x1 = x4x3x2 & x1;
+        hi = ~(x0 ^ x2 ^ x3 ^ x4 ^ x1x0 ^ x4x0 ^ x4x1 ^ x4x3 ^ x2x1x0 ^ x3x2x1 ^ x4x3x0 ^ x4x3x2 ^ x4x2x1x0 ^ x4x3x1x0 ^ x4x3x2x1);
+        lo = ~(x1 ^ x2 ^ x1x0 ^ x3x0 ^ x3x2 ^ x4x0 ^ x4x1 ^ x4x3 ^ x3x1x0 ^ x4x3x0 ^ x4x3x2 ^ x4x2x1x0 ^ x4x3x1x0 ^ x4x3x2x1);
+    }
+
+    // S-box 5 of the stream cipher: hi, lo = sbox5[x4 x3 x2 x1 x0].
+    template <typename W>
+    inline void Sbox5(W& hi, W& lo, W x4, W x3, W x2, W x1, W x0)
+    {
+        const W x1x0 = x1 & x0;
+        const W x2x0 = x2 & x0;
+        const W x2x1 = x2 & x1;
+        const W x3x0 = x3 & x0;
+        const W x3x1 = x3 & x1;
+        const W x4x0 = x4 & x0;
+        const W x4x1 = x4 & x1;
+        const W x4x2 = x4 & x2;
+        const W x4x3 = x4 & x3;
+        const W x2x1x0 = x2x1 & x0;
+        const W x3x1x0 = x3x1 & x0;
+        const W x3x2 = x3 & x2;
+        const W x3x2x0 = x3x2 & x0;
+        const W x3x2x1 = x3x2 & x1;
+        const W x4x2x0 = x4x2 & x0;
+        const W x4x2x1 = x4x2 & x1;
+        const W x4x3x0 = x4x3 & x0;
+        const W x4x3x1 = x4x3 & x1;
+        const W x4x2x1x0 = x4x2x1 & x0;
+        const W x4x3x1x0 = x4x3x1 & x0;
+        const W x4x3x2 = x4x3 & x2;
+        const W x4x3x2x0 = x4x3x2 & x0;
+        const W x4x3x2x1 = x4x3x2 & x1;
+        hi = ~(x0 ^ x1 ^ x3 ^ x1x0 ^ x2x0 ^ x2x1 ^ x3x0 ^ x4x0 ^ x4x1 ^ x4x2 ^ x2x1x0 ^ x3x1x0 ^ x3x2x0 ^ x3x2x1 ^ x4x2x1 ^ x4x3x0 ^ x4x3x1 ^ x4x2x1x0 ^ x4x3x2x0 ^ x4x3x2x1);
+        lo = x2 ^ x1x0 ^ x2x0 ^ x3x0 ^ x3x1 ^ x4x0 ^ x4x2 ^ x4x3 ^ x2x1x0 ^ x3x2x0 ^ x4x2x0 ^ x4x2x1 ^ x4x3x0 ^ x4x3x1 ^ x4x2x1x0 ^ x4x3x1x0;
+    }
+
+    // S-box 6 of the stream cipher: hi, lo = sbox6[x4 x3 x2 x1 x0].
+    template <typename W>
+    inline void Sbox6(W& hi, W& lo, W x4, W x3, W x2, W x1, W x0)
+    {
+        const W x2x0 = x2 & x0;
+        const W x2x1 = x2 & x1;
+        const W x3x1 = x3 & x1;
+        const W x3x2 = x3 & x2;
+        const W x2x1x0 = x2x1 & x0;
+        const W x3x1x0 = x3x1 & x0;
+        const W x3x2x0 = x3x2 & x0;
+        const W x3x2x1 = x3x2 & x1;
+        const W x4x1 = x4 & x1;
+        const W x4x1x0 = x4x1 & x0;
+        const W x4x2 = x4 & x2;
+        const W x4x2x1 = x4x2 & x1;
+        const W x4x3 = x4 & x3;
+        const W x4x3x0 = x4x3 & x0;
+        const W x4x2x1x0 = x4x2x1 & x0;
+        const W x4x3x1 = x4x3 & x1;
+        const W x4x3x1x0 = x4x3x1 & x0;
+        const W x4x3x2 = x4x3 & x2;
+        const W x4x3x2x1 = x4x3x2 & x1;
+        hi = x1 ^ x4 ^ x2x0 ^ x3x2 ^ x3x1x0 ^ x3x2x0 ^ x4x1x0 ^ x4x3x0;
+        lo = x0 ^ x2 ^ x2x1 ^ x3x1 ^ x3x2 ^ x2x1x0 ^ x3x2x1 ^ x4x1x0 ^ x4x2x1 ^ x4x2x1x0 ^ x4x3x1x0 ^ x4x3x2x1;
+    }
+
+    // S-box 7 of the stream cipher: hi, lo = sbox7[x4 x3 x2 x1 x0].
+    template <typename W>
+    inline void Sbox7(W& hi, W& lo, W x4, W x3, W x2, W x1, W x0)
+    {
+        const W x1x0 = x1 & x0;
+        const W x2x1 = x2 & x1;
+        const W x3x2 = x3 & x2;
+        const W x4x0 = x4 & x0;
+        const W x4x2 = x4 & x2;
+        const W x2x1x0 = x2x1 & x0;
+        const W x3x1 = x3 & x1;
+        const W x3x1x0 = x3x1 & x0;
+        const W x4x1 = x4 & x1;
+        const W x4x1x0 = x4x1 & x0;
+        const W x4x2x1 = x4x2 & x1;
+        const W x4x3 = x4 & x3;
+        const W x4x3x1 = x4x3 & x1;
+        const W x4x2x1x0 = x4x2x1 & x0;
+        const W x4x3x1x0 = x4x3x1 & x0;
+        const W x4x3x2 = x4x3 & x2;
+        const W x4x3x2x1 = x4x3x2 & x1;
+        hi = x0 ^ x1 ^ x2 ^ x3 ^ x1x0 ^ x4x0 ^ x4x2 ^ x3x1x0 ^ x4x1x0 ^ x4x2x1 ^ x4x2x1x0 ^ x4x3x1x0 ^ x4x3x2x1;
+        lo = x0 ^ x2 ^ x3 ^ x4 ^ x1x0 ^ x2x1 ^ x3x2 ^ x2x1x0 ^ x4x3x1 ^ x4x3x1x0;
+    }
+
+    // Bitsliced state of the DVB-CSA2 stream cipher for a batch of packets.
+    // The names of the registers are the same as in the reference implementation
+    // (see tsDVBCSA2.cpp). Each register nibble is made of 4 words, index 0 being
+    // the least significant bit.
+    template <typename W>
+    class DVBCSA2StreamBitslice
+    {
+    public:
+        // Maximum number of packets in a batch.
+        static constexpr size_t MAX_PACKETS = 8 * sizeof(W);
+
+        // Generate the keystreams of a batch of packets.
+        // - key: 8-byte control word (already entropy-reduced, if necessary).
+        // - init: array of 'count' addresses of 8-byte initialization blocks.
+        // - count: number of packets, up to MAX_PACKETS.
+        // - ks: address of the first keystream buffer. The keystream of packet N starts at ks + N * ks_stride.
+        // - ks_size: number of keystream bytes to generate per packet, a multiple of 8.
+        static void Generate(const uint8_t* key, const uint8_t* const* init, size_t count, uint8_t* ks, size_t ks_stride, size_t ks_size)
+        {
+            DVBCSA2StreamBitslice state(key);
+            W bits[64];
+
+            // Initialize the stream cipher with the first block of all packets.
+            LoadBlocks(bits, init, count);
+            state.cipher<true>(bits);
+
+            // Generate the keystreams, 8 bytes at a time.
+            for (size_t offset = 0; offset + 8 <= ks_size; offset += 8) {
+                state.cipher<false>(bits);
+                StoreBlocks(bits, ks + offset, ks_stride, count);
+            }
+        }
+
+    private:
+        W A[10][4] {};  // A[1]..A[10] in reference implementation
+        W B[10][4] {};  // B[1]..B[10] in reference implementation
+        W X[4] {};
+        W Y[4] {};
+        W Z[4] {};
+        W D[4] {};
+        W E[4] {};
+        W F[4] {};
+        W p {};
+        W q {};
+        W r {};
+
+        // Word with all bits set to the same value.
+        static W Fill(bool bit) { return bit ? ~W{} : W{}; }
+
+        // Initialize the state with the control word, identical for all packets.
+        DVBCSA2StreamBitslice(const uint8_t* key)
+        {
+            // Load first 32 bits of key into A[1]..A[8], last 32 bits of key into B[1]..B[8].
+            for (size_t i = 0; i < 8; ++i) {
+                const uint8_t ka = uint8_t(key[i / 2] >> (i % 2 == 0 ? 4 : 0));
+                const uint8_t kb = uint8_t(key[4 + i / 2] >> (i % 2 == 0 ? 4 : 0));
+                for (size_t k = 0; k < 4; ++k) {
+                    A[i][k] = Fill(((ka >> k) & 1) != 0);
+                    B[i][k] = Fill(((kb >> k) & 1) != 0);
+                }
+            }
+            // All other registers are zero (default initialization).
+        }
+
+        // Process 8 bytes. In init mode, 'bits' contains the input block.
+        // Otherwise, 'bits' receives the generated block.
+        // Bit k of byte i is in bits[8*i+k].
+        template <bool INIT>
+        void cipher(W* bits)
+        {
+            for (size_t i = 0; i < 8; ++i) {
+                W* byte = bits + 8 * i;
+                for (size_t j = 0; j < 4; ++j) {
+                    // Input nibbles in init mode: in1 = most significant nibble, in2 = least significant nibble.
+                    // In T1, use in1 then in2 (alternate). In T2, use in2 then in1.
+                    const W* in_a = byte + (j % 2 == 0 ? 4 : 0);
+                    const W* in_b = byte + (j % 2 == 0 ? 0 : 4);
+
+                    // From A[1]..A[10], 35 bits are selected as inputs to 7 s-boxes.
+                    W s1h, s1l, s2h, s2l, s3h, s3l, s4h, s4l, s5h, s5l, s6h, s6l, s7h, s7l;
+                    Sbox1(s1h, s1l, A[3][0], A[0][2], A[5][1], A[6][3], A[8][0]);
+                    Sbox2(s2h, s2l, A[1][1], A[2][2], A[5][3], A[6][0], A[8][1]);
+                    Sbox3(s3h, s3l, A[0][3], A[1][0], A[4][1], A[4][3], A[5][2]);
+                    Sbox4(s4h, s4l, A[2][3], A[0][1], A[1][3], A[3][2], A[7][0]);
+                    Sbox5(s5h, s5l, A[4][2], A[3][3], A[5][0], A[7][1], A[8][2]);
+                    Sbox6(s6h, s6l, A[2][1], A[3][1], A[4][0], A[6][2], A[8][3]);
+                    Sbox7(s7h, s7l, A[1][2], A[2][0], A[6][1], A[7][2], A[7][3]);
+
+                    // Use 4x4 xor to produce extra nibble for T3.
+                    W extra_B[4];
+                    extra_B[3] = B[2][0] ^ B[5][1] ^ B[6][2] ^ B[8][3];
+                    extra_B[2] = B[5][0] ^ B[7][1] ^ B[2][3] ^ B[3][2];
+                    extra_B[1] = B[4][3] ^ B[7][2] ^ B[3][0] ^ B[4][1];
+                    extra_B[0] = B[8][2] ^ B[5][3] ^ B[2][1] ^ B[7][0];
+
+                    W next_A1[4], next_B1[4], next_E[4];
+                    for (size_t k = 0; k < 4; ++k) {
+                        // T1 = xor all inputs. in1, in2, D are only used during initialisation.
+                        next_A1[k] = A[9][k] ^ X[k];
+                        // T2 = xor all inputs. in1, in2 are only used during initialisation.
+                        next_B1[k] = B[6][k] ^ B[9][k] ^ Y[k];
+                        if constexpr (INIT) {
+                            next_A1[k] ^= D[k] ^ in_a[k];
+                            next_B1[k] ^= in_b[k];
+                        }
+                    }
+
+                    // If p=1, rotate next_B1 left.
+                    const W b3 = next_B1[3];
+                    next_B1[3] ^= p & (next_B1[3] ^ next_B1[2]);
+                    next_B1[2] ^= p & (next_B1[2] ^ next_B1[1]);
+                    next_B1[1] ^= p & (next_B1[1] ^ next_B1[0]);
+                    next_B1[0] ^= p & (next_B1[0] ^ b3);
+
+                    // T3 = xor all inputs.
+                    for (size_t k = 0; k < 4; ++k) {
+                        D[k] = E[k] ^ Z[k] ^ extra_B[k];
+                    }
+
+                    // T4 = sum, carry of Z + E + r, if q=1. Otherwise F = E.
+                    W carry = r;
+                    for (size_t k = 0; k < 4; ++k) {
+                        const W sum = Z[k] ^ E[k] ^ carry;
+                        carry = (Z[k] & E[k]) | (carry & (Z[k] ^ E[k]));
+                        next_E[k] = F[k];
+                        F[k] = (q & sum) | (~q & E[k]);
+                        E[k] = next_E[k];
+                    }
+                    r = (q & carry) | (~q & r);
+
+                    // Shift the registers.
+                    for (size_t n = 9; n > 0; --n) {
+                        for (size_t k = 0; k < 4; ++k) {
+                            A[n][k] = A[n-1][k];
+                            B[n][k] = B[n-1][k];
+                        }
+                    }
+                    for (size_t k = 0; k < 4; ++k) {
+                        A[0][k] = next_A1[k];
+                        B[0][k] = next_B1[k];
+                    }
+
+                    X[3] = s4l; X[2] = s3l; X[1] = s2h; X[0] = s1h;
+                    Y[3] = s6l; Y[2] = s5l; Y[1] = s4h; Y[0] = s3h;
+                    Z[3] = s2l; Z[2] = s1l; Z[1] = s6h; Z[0] = s5h;
+                    p = s7h;
+                    q = s7l;
+
+                    // 2 output bits are a function of the 4 bits of D, most significant bits first.
+                    if constexpr (!INIT) {
+                        byte[7 - 2 * j] = D[3] ^ D[2];
+                        byte[6 - 2 * j] = D[1] ^ D[0];
+                    }
+                }
+            }
+        }
+
+        // Load the 8-byte blocks of all packets in bitsliced form.
+        static void LoadBlocks(W* bits, const uint8_t* const* blocks, size_t count)
+        {
+            constexpr size_t LANES = DVBCSA2Lanes<W>;
+            uint64_t rows[64 * LANES];
+            uint64_t m[64];
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                for (size_t t = 0; t < 64; ++t) {
+                    const size_t index = 64 * lane + t;
+                    m[t] = 0;
+                    if (index < count) {
+                        for (size_t b = 0; b < 8; ++b) {
+                            m[t] |= uint64_t(blocks[index][b]) << (8 * b);
+                        }
+                    }
+                }
+                DVBCSA2Transpose64(m);
+                for (size_t row = 0; row < 64; ++row) {
+                    rows[row * LANES + lane] = m[row];
+                }
+            }
+            std::memcpy(bits, rows, sizeof(rows));
+        }
+
+        // Store the bitsliced 8-byte blocks of all packets.
+        static void StoreBlocks(const W* bits, uint8_t* ks, size_t ks_stride, size_t count)
+        {
+            constexpr size_t LANES = DVBCSA2Lanes<W>;
+            uint64_t rows[64 * LANES];
+            uint64_t m[64];
+            std::memcpy(rows, bits, sizeof(rows));
+            for (size_t lane = 0; lane < LANES && 64 * lane < count; ++lane) {
+                for (size_t row = 0; row < 64; ++row) {
+                    m[row] = rows[row * LANES + lane];
+                }
+                DVBCSA2Transpose64(m);
+                for (size_t t = 0; t < 64 && 64 * lane + t < count; ++t) {
+                    uint8_t* out = ks + (64 * lane + t) * ks_stride;
+                    for (size_t b = 0; b < 8; ++b) {
+                        out[b] = uint8_t(m[t] >> (8 * b));
+                    }
+                }
+            }
+        }
+    };
+}
@@ -10,6 +10,14 @@
 //----------------------------------------------------------------------------
 
 #include "tsDVBCSA2.h"
+#include "tsDVBCSA2Bitslice.h"
+#include "tsSysInfo.h"
+
+// Bitsliced stream cipher with 128-bit vectors: SSE2 on Intel, Neon on Arm.
+#if defined(TS_GCC) && (defined(__SSE2__) || defined(__ARM_NEON))
+    #define TS_DVBCSA2_VECTOR128 1
+    typedef uint64_t DVBCSA2Vector128 __attribute__((vector_size(16)));
+#endif
 
 // Operations on 64-bit areas.
 
@@ -740,3 +748,186 @@ bool ts::DVBCSA2::decryptImpl(const void* input, size_t input_length, void* outp
 
     return true;
 }
+
+
+//----------------------------------------------------------------------------
+// Encrypt / decrypt several data areas in place, typically TS packets payloads.
+// The block cipher is applied on each area. The stream cipher is bitsliced
+// and applied on batches of areas.
+//----------------------------------------------------------------------------
+
+bool ts::DVBCSA2::encryptInPlaceImpl(InPlaceArea* areas, size_t count)
+{
+    // Filter invalid parameters.
+    for (size_t i = 0; i < count; ++i) {
+        if (areas[i].data == nullptr || areas[i].size / 8 > MAX_NBLOCKS) {
+            return false;
+        }
+    }
+    if (!_init) {
+        return false;
+    }
+
+    // Not enough areas to amortize the bitsliced stream cipher.
+    if (count < MIN_BITSLICE_COUNT) {
+        return BlockCipher::encryptInPlaceImpl(areas, count);
+    }
+
+    const uint8_t* init[MAX_BITSLICE_COUNT];
+    InPlaceArea* group[MAX_BITSLICE_COUNT];
+
+    while (count > 0) {
+        // Perform the block cipher on a batch of areas. Areas smaller than 8 bytes are left unscrambled.
+        size_t ks_size = 0;
+        size_t bcount = 0;
+        for (; count > 0 && bcount < MAX_BITSLICE_COUNT; ++areas, --count) {
+            if (areas->size >= 8) {
+                blockEncrypt(areas->data, areas->size / 8);
+                init[bcount] = areas->data;
+                group[bcount++] = areas;
+                ks_size = std::max(ks_size, areas->size - 8);
+            }
+        }
+
+        // Compute the keystreams of all areas in the batch, in multiples of 8 bytes.
+        streamBatch(init, bcount, round_up<size_t>(ks_size, 8));
+
+        // The first block of each area is scrambled using the block cipher only.
+        for (size_t i = 0; i < bcount; ++i) {
+            uint8_t* data = group[i]->data;
+            const uint8_t* ks = _keystream.data() + i * MAX_KEYSTREAM_SIZE;
+            for (size_t j = 8; j < group[i]->size; ++j) {
+                data[j] ^= ks[j - 8];
+            }
+        }
+    }
+    return true;
+}
+
+bool ts::DVBCSA2::decryptInPlaceImpl(InPlaceArea* areas, size_t count)
+{
+    // Filter invalid parameters.
+    for (size_t i = 0; i < count; ++i) {
+        if (areas[i].data == nullptr || areas[i].size / 8 > MAX_NBLOCKS) {
+            return false;
+        }
+    }
+    if (!_init) {
+        return false;
+    }
+
+    // Not enough areas to amortize the bitsliced stream cipher.
+    if (count < MIN_BITSLICE_COUNT) {
+        return BlockCipher::decryptInPlaceImpl(areas, count);
+    }
+
+    const uint8_t* init[MAX_BITSLICE_COUNT];
+    InPlaceArea* group[MAX_BITSLICE_COUNT];
+
+    while (count > 0) {
+        // The stream cipher is initialized with the first 8 bytes of each scrambled area.
+        // Areas smaller than 8 bytes are left unscrambled.
+        size_t ks_size = 0;
+        size_t bcount = 0;
+        for (; count > 0 && bcount < MAX_BITSLICE_COUNT; ++areas, --count) {
+            if (areas->size >= 8) {
+                init[bcount] = areas->data;
+                group[bcount++] = areas;
+                ks_size = std::max(ks_size, areas->size - 8);
+            }
+        }
+
+        // Compute the keystreams of all areas in the batch, then decipher each area.
+        streamBatch(init, bcount, round_up<size_t>(ks_size, 8));
+        for (size_t i = 0; i < bcount; ++i) {
+            blockDecrypt(group[i]->data, group[i]->size, _keystream.data() + i * MAX_KEYSTREAM_SIZE);
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Block cipher part of the scrambling of one data area, in place.
+//----------------------------------------------------------------------------
+
+void ts::DVBCSA2::blockEncrypt(uint8_t* data, size_t nblocks)
+{
+    // Perform block cipher in reverse CBC mode.
+    // After last block is initialization vector (zero in DVB-CSA).
+    uint8_t iblock[8];
+    for (size_t i = nblocks; i-- > 0; ) {
+        if (i + 1 < nblocks) {
+            xor_8(iblock, data + 8*i, data + 8*(i+1));
+        }
+        else {
+            memcpy_8(iblock, data + 8*i);
+        }
+        _block.encipher(iblock, data + 8*i);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Descrambling of one data area, in place, using a precomputed keystream.
+//----------------------------------------------------------------------------
+
+void ts::DVBCSA2::blockDecrypt(uint8_t* data, size_t size, const uint8_t* keystream)
+{
+    const size_t nblocks = size / 8;
+    const size_t rsize = size % 8;
+    uint8_t ib[8];      // intermediate block
+    uint8_t oblock[8];  // output of block cipher
+
+    // Decipher all blocks except last one.
+    memcpy_8(ib, data);
+    for (size_t i = 1; i < nblocks; i++) {
+        _block.decipher(ib, oblock);
+        xor_8(ib, data + 8*i, keystream + 8*(i-1));
+        xor_8(data + 8*(i-1), ib, oblock);
+    }
+
+    // Last block - sb[nblocks+1] = IV = 0
+    _block.decipher(ib, data + 8*(nblocks-1));
+
+    // Decipher residue, if any
+    for (size_t i = 0; i < rsize; i++) {
+        data[8*nblocks + i] ^= keystream[8*(nblocks-1) + i];
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Compute the keystreams of the packets in a batch.
+//----------------------------------------------------------------------------
+
+void ts::DVBCSA2::streamBatch(const uint8_t* const* init, size_t count, size_t ks_size)
+{
+    // Use the accelerated module only if the CPU supports it.
+    static const bool accel = tsDVBCSA2IsAccelerated && SysInfo::Instance().avx2Instructions();
+
+    _keystream.resize(MAX_BITSLICE_COUNT * MAX_KEYSTREAM_SIZE);
+    uint8_t* ks = _keystream.data();
+
+    // Use the smallest bitsliced width which covers the remaining packets.
+    while (count > 0) {
+        size_t done = 0;
+        if (accel && count > 2 * DVBCSA2StreamBitslice<uint64_t>::MAX_PACKETS) {
+            done = std::min(count, MAX_BITSLICE_COUNT);
+            StreamBatchAccel(_key, init, done, ks, MAX_KEYSTREAM_SIZE, ks_size);
+        }
+#if defined(TS_DVBCSA2_VECTOR128)
+        else if (count > DVBCSA2StreamBitslice<uint64_t>::MAX_PACKETS) {
+            done = std::min(count, DVBCSA2StreamBitslice<DVBCSA2Vector128>::MAX_PACKETS);
+            DVBCSA2StreamBitslice<DVBCSA2Vector128>::Generate(_key, init, done, ks, MAX_KEYSTREAM_SIZE, ks_size);
+        }
+#endif
+        else {
+            done = std::min(count, DVBCSA2StreamBitslice<uint64_t>::MAX_PACKETS);
+            DVBCSA2StreamBitslice<uint64_t>::Generate(_key, init, done, ks, MAX_KEYSTREAM_SIZE, ks_size);
+        }
+        init += done;
+        ks += done * MAX_KEYSTREAM_SIZE;
+        count -= done;
+    }
+}
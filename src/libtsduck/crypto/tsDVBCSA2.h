@@ -77,8 +77,16 @@ namespace ts {
         virtual bool setKeyImpl() override;
         virtual bool encryptImpl(const void* plain, size_t plain_length, void* cipher, size_t cipher_maxsize, size_t* cipher_length) override;
         virtual bool decryptImpl(const void* cipher, size_t cipher_length, void* plain, size_t plain_maxsize, size_t* plain_length) override;
+        virtual bool encryptInPlaceImpl(InPlaceArea* areas, size_t count) override;
+        virtual bool decryptInPlaceImpl(InPlaceArea* areas, size_t count) override;
 
     private:
+        // Multiple packets processing: the stream cipher is bitsliced over batches of packets.
+        // Below MIN_BITSLICE_COUNT packets, the byte-oriented implementation is faster.
+        static constexpr size_t MIN_BITSLICE_COUNT = 4;
+        static constexpr size_t MAX_BITSLICE_COUNT = 256;
+        static constexpr size_t MAX_KEYSTREAM_SIZE = 184;  // All blocks of an area of up to 191 bytes (23 blocks and a residue), except the first one.
+
         // Block cipher data
         class DVBBlockCipher
         {
@@ -116,5 +124,19 @@ namespace ts {
         uint8_t         _key[KEY_SIZE] {};
         DVBBlockCipher  _block {};
         DVBStreamCipher _stream {};
+        ByteBlock       _keystream {};  // Keystreams of a batch of packets, MAX_KEYSTREAM_SIZE bytes per packet.
+
+        // Block cipher part of the scrambling of one data area, in place (reverse CBC mode).
+        void blockEncrypt(uint8_t* data, size_t nblocks);
+
+        // Descrambling of one data area, in place, using a precomputed keystream.
+        void blockDecrypt(uint8_t* data, size_t size, const uint8_t* keystream);
+
+        // Compute the keystreams of the packets in a batch, starting with their first 8-byte block.
+        void streamBatch(const uint8_t* const* init, size_t count, size_t ks_size);
+
+        // Bitsliced stream cipher using accelerated instructions, compiled in a separated module.
+        // Process up to MAX_BITSLICE_COUNT packets at a time.
+        static void StreamBatchAccel(const uint8_t* key, const uint8_t* const* init, size_t count, uint8_t* ks, size_t ks_stride, size_t ks_size);
     };
 }
@@ -13,6 +13,7 @@
 
 #pragma once
 #include "tsBlockCipher.h"
+#include "tsIntegerUtils.h"
 #include "tsMemory.h"
 
 namespace ts {
@@ -82,11 +83,22 @@ namespace ts {
         //! @cond nodoxygen
         virtual bool encryptImpl(const void* plain, size_t plain_length, void* cipher, size_t cipher_maxsize, size_t* cipher_length) override;
         virtual bool decryptImpl(const void* cipher, size_t cipher_length, void* plain, size_t plain_maxsize, size_t* plain_length) override;
+        virtual bool encryptInPlaceImpl(BlockCipher::InPlaceArea* areas, size_t count) override;
+        virtual bool decryptInPlaceImpl(BlockCipher::InPlaceArea* areas, size_t count) override;
         //! @endcond
 
     private:
         bool _ignore_short_iv = false;
         ByteBlock _short_iv {};
+
+        // Check the IV's before encryption or decryption.
+        bool validIV() const;
+
+        // Get the IV for the first block of an area.
+        const uint8_t* firstIV(size_t area_size) const;
+
+        // Process the residues of several areas (final incomplete blocks, same operation in encryption and decryption).
+        bool processResidues(BlockCipher::InPlaceArea* areas, size_t count);
     };
 }
 
@@ -261,6 +273,163 @@ bool ts::DVS042<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, v
     return true;
 }
 
+
+//----------------------------------------------------------------------------
+// Check the IV's before encryption or decryption.
+//----------------------------------------------------------------------------
+
+template<class CIPHER> requires std::derived_from<CIPHER, ts::BlockCipher>
+bool ts::DVS042<CIPHER>::validIV() const
+{
+    const size_t bsize = this->properties.block_size;
+    return this->currentIV().size() == bsize && (_ignore_short_iv || _short_iv.size() == 0 || _short_iv.size() == bsize);
+}
+
+template<class CIPHER> requires std::derived_from<CIPHER, ts::BlockCipher>
+const uint8_t* ts::DVS042<CIPHER>::firstIV(size_t area_size) const
+{
+    // Short IV, if unset, is equal to IV.
+    return area_size < this->properties.block_size && !_ignore_short_iv && _short_iv.size() != 0 ? _short_iv.data() : this->currentIV().data();
+}
+
+
+//----------------------------------------------------------------------------
+// Process the final incomplete blocks of several areas.
+// The previous blocks of each area must contain the cipher-text.
+//----------------------------------------------------------------------------
+
+template<class CIPHER> requires std::derived_from<CIPHER, ts::BlockCipher>
+bool ts::DVS042<CIPHER>::processResidues(BlockCipher::InPlaceArea* areas, size_t count)
+{
+    const size_t bsize = this->properties.block_size;
+
+    // Gather Cn-1 (or IV for short areas) of all areas with a residue.
+    this->batch.resize(count * bsize);
+    uint8_t* b = this->batch.data();
+    for (size_t i = 0; i < count; ++i) {
+        const size_t full = round_down(areas[i].size, bsize);
+        if (full < areas[i].size) {
+            MemCopy(b, full == 0 ? firstIV(areas[i].size) : areas[i].data + full - bsize, bsize);
+            b += bsize;
+        }
+    }
+    const size_t size = b - this->batch.data();
+    if (size == 0) {
+        return true;
+    }
+
+    // Encrypt all of them at once, then xor with residues.
+    if (!CIPHER::encryptImpl(this->batch.data(), size, this->batch.data(), size, nullptr)) {
+        return false;
+    }
+    b = this->batch.data();
+    for (size_t i = 0; i < count; ++i) {
+        const size_t full = round_down(areas[i].size, bsize);
+        if (full < areas[i].size) {
+            MemXor(areas[i].data + full, areas[i].data + full, b, areas[i].size - full);
+            b += bsize;
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Encryption of several areas in DVS 042 mode.
+// All areas progress at the same time, one block per round. In each round, the next
+// block of all areas are encrypted at once, the underlying cipher being in ECB mode.
+//----------------------------------------------------------------------------
+
+template<class CIPHER> requires std::derived_from<CIPHER, ts::BlockCipher>
+bool ts::DVS042<CIPHER>::encryptInPlaceImpl(BlockCipher::InPlaceArea* areas, size_t count)
+{
+    const size_t bsize = this->properties.block_size;
+    if (!validIV()) {
+        return false;
+    }
+
+    this->batch.resize(count * bsize);
+    for (size_t offset = 0; ; offset += bsize) {
+        // Gather the complete blocks at this offset: plain-text XOR previous cipher-text.
+        uint8_t* b = this->batch.data();
+        for (size_t i = 0; i < count; ++i) {
+            if (offset + bsize <= areas[i].size) {
+                MemXor(b, offset == 0 ? this->currentIV().data() : areas[i].data + offset - bsize, areas[i].data + offset, bsize);
+                b += bsize;
+            }
+        }
+        const size_t size = b - this->batch.data();
+        if (size == 0) {
+            break;
+        }
+        // Encrypt all blocks at once and scatter the cipher-text blocks.
+        if (!CIPHER::encryptImpl(this->batch.data(), size, this->batch.data(), size, nullptr)) {
+            return false;
+        }
+        b = this->batch.data();
+        for (size_t i = 0; i < count; ++i) {
+            if (offset + bsize <= areas[i].size) {
+                MemCopy(areas[i].data + offset, b, bsize);
+                b += bsize;
+            }
+        }
+    }
+
+    // Process final blocks if incomplete.
+    return processResidues(areas, count);
+}
+
+
+//----------------------------------------------------------------------------
+// Decryption of several areas in DVS 042 mode.
+// All complete blocks of all areas are decrypted at once.
+//----------------------------------------------------------------------------
+
+template<class CIPHER> requires std::derived_from<CIPHER, ts::BlockCipher>
+bool ts::DVS042<CIPHER>::decryptInPlaceImpl(BlockCipher::InPlaceArea* areas, size_t count)
+{
+    const size_t bsize = this->properties.block_size;
+    if (!validIV()) {
+        return false;
+    }
+
+    // Process final incomplete blocks first, while the previous cipher-text blocks are available.
+    if (!processResidues(areas, count)) {
+        return false;
+    }
+
+    // Decrypt all complete blocks in one operation.
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += round_down(areas[i].size, bsize);
+    }
+    if (total == 0) {
+        return true;
+    }
+    this->batch.resize(total);
+    uint8_t* b = this->batch.data();
+    for (size_t i = 0; i < count; ++i) {
+        const size_t full = round_down(areas[i].size, bsize);
+        MemCopy(b, areas[i].data, full);
+        b += full;
+    }
+    if (!CIPHER::decryptImpl(this->batch.data(), total, this->batch.data(), total, nullptr)) {
+        return false;
+    }
+
+    // plain-text = previous-cipher XOR work. Start from the end of each area to keep previous-cipher.
+    b = this->batch.data();
+    for (size_t i = 0; i < count; ++i) {
+        const size_t full = round_down(areas[i].size, bsize);
+        for (size_t offset = full; offset > 0; ) {
+            offset -= bsize;
+            MemXor(areas[i].data + offset, offset == 0 ? this->currentIV().data() : areas[i].data + offset - bsize, b + offset, bsize);
+        }
+        b += full;
+    }
+    return true;
+}
+
 TS_POP_WARNING()
 
 #endif
@@ -96,6 +96,7 @@ void ts::TSAnalyzer::reset()
     _scrambled_services_cnt = 0;
     _tid_present.reset();
     _pids.clear();
+    _counters = std::make_unique<PIDCounters>();
     _services.clear();
     _ts_bitrate_sum = 0;
     _ts_bitrate_cnt = 0;
@@ -266,10 +267,12 @@ ts::TSAnalyzer::XTIDContextPtr ts::TSAnalyzer::getXTID(const Section& section)
 
 ts::TSAnalyzer::PIDContextPtr ts::TSAnalyzer::getPID(PID pid, const UString& description)
 {
-    const PIDContextPtr p(_pids[pid]);
+    PIDContextPtr& p(_pids[pid]);
     if (p == nullptr) {
         // The PID was not yet used, map entry just created.
-        return _pids[pid] = std::make_shared<PIDContext>(pid, description);
+        p = std::make_shared<PIDContext>(pid, description);
+        _counters->context[pid & (PID_MAX - 1)] = p.get();
+        return p;
     }
     else {
         // If the PID was marked as unreferenced, now use actual description.
@@ -281,6 +284,14 @@ ts::TSAnalyzer::PIDContextPtr ts::TSAnalyzer::getPID(PID pid, const UString& des
 }
 
 
+ts::TSAnalyzer::PIDContext& ts::TSAnalyzer::getPIDContext(PID pid)
+{
+    // Fast path: direct access, without map lookup and shared pointer copy.
+    PIDContext* pc = _counters->context[pid & (PID_MAX - 1)];
+    return pc != nullptr ? *pc : *getPID(pid);
+}
+
+
 //----------------------------------------------------------------------------
 //  Return a service context. Allocate a new entry if service not found.
 //----------------------------------------------------------------------------
@@ -1458,88 +1469,92 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
     _pes_demux.feedPacket(pkt);
     _t2mi_demux.feedPacket(pkt);
 
-    // Get PID context
-    PIDContextPtr ps(getPID(pkt.getPID()));
-    ps->ts_pkt_cnt++;
+    // Get PID context and per-packet counters.
+    const PID pid = pkt.getPID();
+    PIDContext& ps(getPIDContext(pid));
+    PIDCounters& cnt(*_counters);
+    const uint64_t pid_pkt_cnt = ++cnt.ts_pkt_cnt[pid];
 
     // Accumulate stat from packet
     if (pkt.hasAF()) {
-        ps->ts_af_cnt++;
+        cnt.ts_af_cnt[pid]++;
     }
     if (pkt.getPUSI()) {
-        ps->unit_start_cnt++;
+        cnt.unit_start_cnt[pid]++;
     }
     if (pkt.getPUSI() && pkt.hasPayload()) {
-        ps->pl_start_cnt++;
+        cnt.pl_start_cnt[pid]++;
     }
 
     // Process scrambling information
-    if (pkt.getScrambling() != SC_CLEAR && !ps->scrambled) {
-        ps->scrambled = true;
+    const uint8_t scrambling = pkt.getScrambling();
+    if (scrambling != SC_CLEAR && !ps.scrambled) {
+        ps.scrambled = true;
         _scrambled_pid_cnt++;
     }
-    if (pkt.getScrambling() == SC_DVB_RESERVED) {
-        ps->inv_ts_sc_cnt++;
+    if (scrambling == SC_DVB_RESERVED) {
+        cnt.inv_ts_sc_cnt[pid]++;
     }
-    else if (pkt.getScrambling() != SC_CLEAR) {
-        ps->ts_sc_cnt++;
+    else if (scrambling != SC_CLEAR) {
+        cnt.ts_sc_cnt[pid]++;
     }
-    if (pkt.getScrambling() != ps->cur_ts_sc) {
+    if (scrambling != cnt.cur_ts_sc[pid]) {
         // Change of crypto-period
-        if (ps->cur_ts_sc != SC_CLEAR) {
+        if (cnt.cur_ts_sc[pid] != SC_CLEAR) {
             // End of a crypto-period, not a clear/scramble transition.
             // Count number of crypto-periods:
-            ps->cryptop_cnt++;
+            ps.cryptop_cnt++;
             // Count number of TS packets in all crypto-periods.
             // Ignore first crypto-period since it is truncated and
             // not significant for evaluation of duration.
-            if (ps->cryptop_cnt > 1) {
-                ps->cryptop_ts_cnt += packet_index - ps->cur_ts_sc_pkt;
+            if (ps.cryptop_cnt > 1) {
+                ps.cryptop_ts_cnt += packet_index - ps.cur_ts_sc_pkt;
             }
         }
-        ps->cur_ts_sc = pkt.getScrambling();
-        ps->cur_ts_sc_pkt = packet_index;
+        cnt.cur_ts_sc[pid] = scrambling;
+        ps.cur_ts_sc_pkt = packet_index;
     }
 
     // PID_IIP (0x1FF0) is a global PID with ISDB.
-    if (ps->pid == PID_IIP && !ps->carry_iip && bool(_duck.standards() & Standards::ISDB) && ps->services.empty()) {
+    if (pid == PID_IIP && !ps.carry_iip && bool(_duck.standards() & Standards::ISDB) && ps.services.empty()) {
         // First time we can consider this PID as IIP. Can be first packet in the PID and we knwow that we use ISDB
         // or not first packet in the PID but we didn(t know yet the TS was ISDB.
-        ps->carry_iip = true;
-        ps->referenced = true;
-        ps->description = u"ISDB IIP";
+        ps.carry_iip = true;
+        ps.referenced = true;
+        ps.description = u"ISDB IIP";
     }
 
     // Process discontinuities.
     // The continuity counter of null packets is undefined.
-    if (ps->pid != PID_NULL) {
-        if (ps->ts_pkt_cnt == 1) {
+    if (pid != PID_NULL) {
+        uint8_t& cur_continuity(cnt.cur_continuity[pid]);
+        if (pid_pkt_cnt == 1) {
             // First packet, initialize continuity
-            ps->cur_continuity = pkt.getCC();
+            cur_continuity = pkt.getCC();
         }
         else if (pkt.getDiscontinuityIndicator()) {
             // Expected discontinuity
-            ps->exp_discont++;
+            ps.exp_discont++;
             broken_rate = true;
         }
         else if (pkt.hasPayload()) {
             // Packet has payload.
-            if (pkt.getCC() == ps->cur_continuity) {
+            if (pkt.getCC() == cur_continuity) {
                 // Same counter means duplicated packet.
-                ps->duplicated++;
+                ps.duplicated++;
             }
-            else if (pkt.getCC() != (ps->cur_continuity + 1) % CC_MAX) {
+            else if (pkt.getCC() != (cur_continuity + 1) % CC_MAX) {
                 // Counter not following previous -> discontinuity
-                ps->unexp_discont++;
+                ps.unexp_discont++;
                 broken_rate = true;
             }
         }
-        else if (pkt.getCC() != ps->cur_continuity) {
+        else if (pkt.getCC() != cur_continuity) {
             // Packet has no payload -> should have same counter
-            ps->unexp_discont++;
+            ps.unexp_discont++;
             broken_rate = true;
         }
-        ps->cur_continuity = pkt.getCC();
+        cur_continuity = pkt.getCC();
     }
 
     // Process clocks.
@@ -1548,63 +1563,63 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
     const uint64_t dts = pkt.getDTS();
     if (broken_rate) {
         // Suspected packet loss, forget the last PCR with use to compute bitrate.
-        ps->br_last_pcr = INVALID_PCR;
+        ps.br_last_pcr = INVALID_PCR;
     }
     if (pcr != INVALID_PCR) {
         // Count PID's with PCR
-        if (ps->pcr_cnt++ == 0) {
+        if (ps.pcr_cnt++ == 0) {
             _pcr_pid_cnt++;
         }
         // If last PCR valid, compute transport rate between the two
-        if (ps->br_last_pcr != INVALID_PCR && ps->br_last_pcr < pcr) {
+        if (ps.br_last_pcr != INVALID_PCR && ps.br_last_pcr < pcr) {
             // Compute transport rate in b/s since last PCR
-            BitRate ts_bitrate = BitRate((packet_index - ps->br_last_pcr_pkt) * SYSTEM_CLOCK_FREQ * PKT_SIZE_BITS) / (pcr - ps->br_last_pcr);
+            BitRate ts_bitrate = BitRate((packet_index - ps.br_last_pcr_pkt) * SYSTEM_CLOCK_FREQ * PKT_SIZE_BITS) / (pcr - ps.br_last_pcr);
             // Per-PID statistics:
-            ps->ts_bitrate_sum += ts_bitrate;
-            ps->ts_bitrate_cnt++;
+            ps.ts_bitrate_sum += ts_bitrate;
+            ps.ts_bitrate_cnt++;
             // Transport stream statistics:
             _ts_bitrate_sum += ts_bitrate;
             _ts_bitrate_cnt++;
         }
         // Detect PCR leaps.
-        if (ps->last_pcr != INVALID_PCR && (ps->last_pcr > pcr || (pcr - ps->last_pcr) > SYSTEM_CLOCK_FREQ)) {
+        if (ps.last_pcr != INVALID_PCR && (ps.last_pcr > pcr || (pcr - ps.last_pcr) > SYSTEM_CLOCK_FREQ)) {
             // PCR wrap-up or more than one second diff.
-            ps->pcr_leap_cnt++;
+            ps.pcr_leap_cnt++;
         }
         // Save PCR for next calculation
-        ps->br_last_pcr = pcr;
-        ps->br_last_pcr_pkt = packet_index;
+        ps.br_last_pcr = pcr;
+        ps.br_last_pcr_pkt = packet_index;
         // Save first and last PCR outside of bitrate computation.
-        if (ps->first_pcr == INVALID_PCR) {
-            ps->first_pcr = pcr;
+        if (ps.first_pcr == INVALID_PCR) {
+            ps.first_pcr = pcr;
         }
-        ps->last_pcr = pcr;
+        ps.last_pcr = pcr;
     }
     if (pts != INVALID_PTS) {
-        ps->pts_cnt++;
-        if (ps->last_pts != INVALID_PTS) {
+        ps.pts_cnt++;
+        if (ps.last_pts != INVALID_PTS) {
             // PTS are allowed to be out-of-order.
-            const uint64_t diff = pts > ps->last_pts ? pts - ps->last_pts : ps->last_pts - pts;
+            const uint64_t diff = pts > ps.last_pts ? pts - ps.last_pts : ps.last_pts - pts;
             if (diff > 3 * SYSTEM_CLOCK_SUBFREQ) {
                 // PTS wrap-up or more than 3 seconds diff.
-                ps->pts_leap_cnt++;
+                ps.pts_leap_cnt++;
             }
         }
-        if (ps->first_pts == INVALID_PTS) {
-            ps->first_pts = pts;
+        if (ps.first_pts == INVALID_PTS) {
+            ps.first_pts = pts;
         }
-        ps->last_pts = pts;
+        ps.last_pts = pts;
     }
     if (dts != INVALID_DTS) {
-        ps->dts_cnt++;
-        if (ps->last_dts != INVALID_DTS && (ps->last_dts > dts || (dts - ps->last_dts) > 3 * SYSTEM_CLOCK_SUBFREQ)) {
+        ps.dts_cnt++;
+        if (ps.last_dts != INVALID_DTS && (ps.last_dts > dts || (dts - ps.last_dts) > 3 * SYSTEM_CLOCK_SUBFREQ)) {
             // DTS wrap-up or more than 3 seconds diff.
-            ps->dts_leap_cnt++;
+            ps.dts_leap_cnt++;
         }
-        if (ps->first_dts == INVALID_DTS) {
-            ps->first_dts = dts;
+        if (ps.first_dts == INVALID_DTS) {
+            ps.first_dts = dts;
         }
-        ps->last_dts = dts;
+        ps.last_dts = dts;
     }
 
     // Check PES start code: PES packet headers start with the constant sequence 00 00 01.
@@ -1613,7 +1628,7 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
     // (for instance if the PID is referenced as a video PID in a PMT). So, before getting the PMT referencing a PID,
     // we do not know if this PID carries PES or not.
     size_t header_size = pkt.getHeaderSize();
-    if (pkt.getPUSI() && pkt.getScrambling() == SC_CLEAR && header_size <= PKT_SIZE - 3) {
+    if (pkt.getPUSI() && scrambling == SC_CLEAR && header_size <= PKT_SIZE - 3) {
 
         // Got a "unit start indicator" in a clear packet.
         // This may be the start of a section or a PES packet.
@@ -1623,9 +1638,9 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
             // PID carries sections (we may not yet know this, so count
             // all these errors now and ignore them later if we know
             // that the PID does not carry PES packets).
-            ps->inv_pes_start++;
+            ps.inv_pes_start++;
         }
-        else if (header_size <= PKT_SIZE - 4 && ps->pid != 0) {
+        else if (header_size <= PKT_SIZE - 4 && pid != 0) {
             // Here, the start of the packet payload is 00 00 01.
             // The only case where this can happen on a section is a PAT
             // (first 00 = "pointer field", second 00 = table_id = PAT).
@@ -1634,14 +1649,14 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
             // As a consequence, we are pretty sure to have a PES packet.
             // Remember the stream_id of the PES packets on this PID
             // (the PES stream_id is next byte after PES start code).
-            if (ps->pes_stream_id == 0) {
+            if (ps.pes_stream_id == 0) {
                 // First PES stream_id found on this PID
-                ps->pes_stream_id = pkt.b[header_size + 3];
-                ps->same_stream_id = true;
+                ps.pes_stream_id = pkt.b[header_size + 3];
+                ps.same_stream_id = true;
             }
-            else if (ps->pes_stream_id != pkt.b[header_size + 3]) {
+            else if (ps.pes_stream_id != pkt.b[header_size + 3]) {
                 // Got different values of stream_id in PES packets
-                ps->same_stream_id = false;
+                ps.same_stream_id = false;
             }
         }
     }
@@ -1655,7 +1670,7 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
     if (info.is_valid) {
         // Count packets in the ISDB-T layers. Some PID's have all their packets in the same layers.
         // Some other PID's have been seen on multiple layers.
-        ps->isdb_layers[info.layer_indicator]++;
+        ps.isdb_layers[info.layer_indicator]++;
     }
 }
 
@@ -1727,6 +1742,17 @@ void ts::TSAnalyzer::recomputeStatistics()
     for (auto& pci : _pids) {
         PIDContext& pc(*pci.second);
 
+        // Update the per-packet counters from the PID-indexed arrays.
+        const PIDCounters& cnt(*_counters);
+        pc.ts_pkt_cnt = cnt.ts_pkt_cnt[pc.pid];
+        pc.ts_af_cnt = cnt.ts_af_cnt[pc.pid];
+        pc.unit_start_cnt = cnt.unit_start_cnt[pc.pid];
+        pc.pl_start_cnt = cnt.pl_start_cnt[pc.pid];
+        pc.ts_sc_cnt = cnt.ts_sc_cnt[pc.pid];
+        pc.inv_ts_sc_cnt = cnt.inv_ts_sc_cnt[pc.pid];
+        pc.cur_continuity = cnt.cur_continuity[pc.pid];
+        pc.cur_ts_sc = cnt.cur_ts_sc[pc.pid];
+
         // Count total packets.
         if (isdb) {
             _ts_isdb_layers.accumulate(pc.isdb_layers);
@@ -437,7 +437,7 @@ namespace ts {
         //! @param [in] pid PID to search.
         //! @return True if the PID exists, false otherwise.
         //!
-        bool pidExists(PID pid) const { return _pids.contains(pid); }
+        bool pidExists(PID pid) const { return pid < PID_MAX && _counters->context[pid] != nullptr; }
 
         //!
         //! Get a PID context.
@@ -461,6 +461,7 @@ namespace ts {
 
         // TSAnalyzer protected members.
         // Accessible to subclasses, valid after calling recomputeStatistics().
+        // The per-packet counters in the PIDContext instances are also updated by recomputeStatistics().
         // Important: subclasses shall not modify these fields, just read them.
         DuckContext&         _duck;                   //!< TSDuck execution context
         std::optional<uint16_t> _ts_id {};            //!< Transport stream id.
@@ -561,7 +562,27 @@ namespace ts {
         virtual void handleT2MIPacket(T2MIDemux& demux, const T2MIPacket& pkt) override;
         virtual void handleTSPacket(T2MIDemux& demux, const T2MIPacket& t2mi, const TSPacket& ts) override;
 
+        // Hot per-packet data, indexed by PID, in a struct-of-arrays layout. Analyzing a packet only
+        // touches a few cache lines, instead of looking up a map and chasing pointers to a large
+        // PIDContext. The corresponding fields in PIDContext are updated by recomputeStatistics().
+        struct PIDCounters
+        {
+            std::array<PIDContext*, PID_MAX> context {};         // Direct access to existing PID contexts, owned by _pids.
+            std::array<uint64_t, PID_MAX>    ts_pkt_cnt {};      // Same as PIDContext::ts_pkt_cnt.
+            std::array<uint64_t, PID_MAX>    ts_af_cnt {};       // Same as PIDContext::ts_af_cnt.
+            std::array<uint64_t, PID_MAX>    unit_start_cnt {};  // Same as PIDContext::unit_start_cnt.
+            std::array<uint64_t, PID_MAX>    pl_start_cnt {};    // Same as PIDContext::pl_start_cnt.
+            std::array<uint64_t, PID_MAX>    ts_sc_cnt {};       // Same as PIDContext::ts_sc_cnt.
+            std::array<uint64_t, PID_MAX>    inv_ts_sc_cnt {};   // Same as PIDContext::inv_ts_sc_cnt.
+            std::array<uint8_t, PID_MAX>     cur_continuity {};  // Same as PIDContext::cur_continuity.
+            std::array<uint8_t, PID_MAX>     cur_ts_sc {};       // Same as PIDContext::cur_ts_sc.
+        };
+
+        // Get a PID context from the packet processing path, allocate a new entry if PID not found.
+        PIDContext& getPIDContext(PID pid);
+
         // TSAnalyzer private members (state data, used during analysis):
+        std::unique_ptr<PIDCounters> _counters {std::make_unique<PIDCounters>()};  // Per-packet data, allocated on heap (about 400 kB)
         bool         _modified = false;              // Internal data modified, need recomputeStatistics
         BitRate      _ts_bitrate_sum = 0;            // Sum of all computed TS bitrates
         uint64_t     _ts_bitrate_cnt = 0;            // Number of computed TS bitrates
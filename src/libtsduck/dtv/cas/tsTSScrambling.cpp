@@ -530,3 +530,120 @@ bool ts::TSScrambling::decrypt(TSPacket& pkt)
     }
     return ok;
 }
+
+
+//----------------------------------------------------------------------------
+// Encrypt several TS packets with the current parity and corresponding CW.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::encrypt(TSPacket* const* packets, size_t count)
+{
+    // If no current parity is set, start with even by default.
+    if (_encrypt_scv == SC_CLEAR && !setEncryptParity(SC_EVEN_KEY)) {
+        return false;
+    }
+    assert(_encrypt_scv == SC_EVEN_KEY || _encrypt_scv == SC_ODD_KEY);
+
+    bool ok = true;
+    for (size_t i = 0; i < count; ++i) {
+        TSPacket* pkt = packets[i];
+        if (pkt->isScrambled()) {
+            // Filter out encrypted packets.
+            _report.error(u"try to scramble an already scrambled packet");
+            ok = false;
+        }
+        else if (pkt->hasPayload()) {
+            // Silently pass packets without payload.
+            addToBatch(pkt, _encrypt_scv);
+        }
+    }
+    return processBatch(true, _encrypt_scv) && ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Decrypt several TS packets with the CW corresponding to their parity.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::decrypt(TSPacket* const* packets, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+
+        // Clear or invalid packets are silently accepted.
+        const uint8_t scv = packets[i]->getScrambling();
+        if (scv != SC_EVEN_KEY && scv != SC_ODD_KEY) {
+            continue;
+        }
+
+        // When the parity changes, descramble all previous packets before switching keys.
+        const uint8_t previous_scv = _decrypt_scv;
+        if (scv != previous_scv) {
+            if (!processBatch(false, previous_scv)) {
+                return false;
+            }
+            _decrypt_scv = scv;
+
+            // In case of fixed control word, use next key when the scrambling control changes.
+            if (hasFixedCW() && !setNextFixedCW(_decrypt_scv)) {
+                return false;
+            }
+        }
+        addToBatch(packets[i], scv);
+    }
+    return processBatch(false, _decrypt_scv);
+}
+
+
+//----------------------------------------------------------------------------
+// Add a packet in the current batch.
+//----------------------------------------------------------------------------
+
+void ts::TSScrambling::addToBatch(TSPacket* pkt, uint8_t scv)
+{
+    const BlockCipher* algo = _scrambler[scv & 1];
+    assert(algo != nullptr);
+
+    // Check if the residue shall be included in the scrambling.
+    size_t psize = pkt->getPayloadSize();
+    if (!algo->residueAllowed()) {
+        // Remove the residue from the payload.
+        assert(algo->blockSize() != 0);
+        psize -= psize % algo->blockSize();
+    }
+
+    _batch_packets.push_back(pkt);
+    if (psize > 0) {
+        _batch_areas.push_back({pkt->getPayload(), psize});
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt the current batch.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::processBatch(bool encrypt, uint8_t scv)
+{
+    bool ok = true;
+    if (!_batch_packets.empty()) {
+        BlockCipher* algo = _scrambler[scv & 1];
+        assert(algo != nullptr);
+        if (encrypt) {
+            ok = _batch_areas.empty() || algo->encryptInPlace(_batch_areas.data(), _batch_areas.size());
+        }
+        else {
+            ok = _batch_areas.empty() || algo->decryptInPlace(_batch_areas.data(), _batch_areas.size());
+        }
+        if (ok) {
+            for (auto pkt : _batch_packets) {
+                pkt->setScrambling(encrypt ? scv : uint8_t(SC_CLEAR));
+            }
+        }
+        else {
+            _report.error(u"packet %s error using %s", encrypt ? u"encryption" : u"decryption", algo->name());
+        }
+        _batch_packets.clear();
+        _batch_areas.clear();
+    }
+    return ok;
+}
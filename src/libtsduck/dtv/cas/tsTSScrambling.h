@@ -191,6 +191,26 @@ namespace ts {
         //!
         bool decrypt(TSPacket& pkt);
 
+        //!
+        //! Encrypt several TS packets with the current parity and corresponding CW.
+        //! The result is the same as calling encrypt() on each packet, in order.
+        //! With some scrambling algorithms, encrypting many packets at once is much faster.
+        //! @param [in,out] packets Array of @a count addresses of packets to encrypt.
+        //! @param [in] count Number of packets in @a packets.
+        //! @return True on success, false on error. An already encrypted packet is an error.
+        //!
+        bool encrypt(TSPacket* const* packets, size_t count);
+
+        //!
+        //! Decrypt several TS packets with the CW corresponding to the parity in each packet.
+        //! The result is the same as calling decrypt() on each packet, in order.
+        //! With some scrambling algorithms, decrypting many packets at once is much faster.
+        //! @param [in,out] packets Array of @a count addresses of packets to decrypt.
+        //! @param [in] count Number of packets in @a packets.
+        //! @return True on success, false on error. Clear packets are not an error.
+        //!
+        bool decrypt(TSPacket* const* packets, size_t count);
+
     private:
         // List of control words
         using CWList = std::list<ByteBlock>;
@@ -210,10 +230,18 @@ namespace ts {
         CBC<AES128>      _aescbc[2] {};
         CTR<AES128>      _aesctr[2] {};
         BlockCipher*     _scrambler[2] {nullptr, nullptr};
+        std::vector<BlockCipher::InPlaceArea> _batch_areas {};  // Payloads of a batch of packets, same parity.
+        std::vector<TSPacket*> _batch_packets {};               // Packets of the same batch.
 
         // Set the next fixed control word as scrambling key.
         bool setNextFixedCW(int parity);
 
+        // Add a packet in the current batch, using the scrambler of the given parity.
+        void addToBatch(TSPacket* pkt, uint8_t scv);
+
+        // Encrypt or decrypt the current batch with the given parity, then clear it.
+        bool processBatch(bool encrypt, uint8_t scv);
+
         // Implementation of BlockCipherAlertInterface.
         virtual bool handleBlockCipherAlert(BlockCipher& cipher, AlertReason reason) override;
 
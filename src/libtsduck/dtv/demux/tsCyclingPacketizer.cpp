@@ -27,7 +27,8 @@ ts::CyclingPacketizer::~CyclingPacketizer()
 
 ts::CyclingPacketizer::SectionDesc::SectionDesc(const SectionPtr& sec, cn::milliseconds rep) :
     section(sec),
-    repetition(rep)
+    repetition(rep),
+    packets(sec->packetCount())
 {
 }
 
@@ -109,7 +110,7 @@ bool ts::CyclingPacketizer::SectionDesc::insertAfter(const SectionDesc& other) c
 
 
 //----------------------------------------------------------------------------
-// Insert a scheduled section in the list, sorted by due_packet.
+// Insert a scheduled section in the schedule, sorted by due_packet.
 //----------------------------------------------------------------------------
 
 void ts::CyclingPacketizer::addScheduledSection(const SectionDescPtr& sect)
@@ -119,11 +120,16 @@ void ts::CyclingPacketizer::addScheduledSection(const SectionDescPtr& sect)
                  sect->section->sectionNumber(), sect->section->lastSectionNumber(),
                  sect->last_cycle, sect->last_packet, sect->due_packet);
 
-    auto it = _sched_sections.begin();
-    while (it != _sched_sections.end() && sect->insertAfter(**it)) {
+    // All sections in previous groups have a lower due packet, the section is inserted after them.
+    // All sections in next groups have a higher due packet, the section is inserted before them.
+    // Only the sections with the same due packet need to be compared.
+    SectionDescList& group(_sched_sections[sect->due_packet]);
+    auto it = group.begin();
+    while (it != group.end() && sect->insertAfter(**it)) {
         ++it;
     }
-    _sched_sections.insert(it, sect);
+    group.insert(it, sect);
+    _sched_count++;
 }
 
 
@@ -143,8 +149,9 @@ void ts::CyclingPacketizer::addSection(const SectionPtr& sect, cn::milliseconds
         else {
             // Scheduled section, its due time is "now"
             desc->due_packet = packetCount();
+            desc->distance = std::max(PacketCounter(1), PacketDistance(_bitrate, rep_rate));
             addScheduledSection(desc);
-            _sched_packets += sect->packetCount();
+            _sched_packets += desc->packets;
         }
 
         _section_count++;
@@ -159,50 +166,63 @@ void ts::CyclingPacketizer::addSection(const SectionPtr& sect, cn::milliseconds
 
 void ts::CyclingPacketizer::removeSections(TID tid)
 {
-    removeSections(_sched_sections, tid, 0, 0, false, false, true);
-    removeSections(_other_sections, tid, 0, 0, false, false, false);
+    removeSections(tid, 0, 0, false, false);
 }
 
 void ts::CyclingPacketizer::removeSections(TID tid, uint16_t tid_ext)
 {
-    removeSections(_sched_sections, tid, tid_ext, 0, true, false, true);
-    removeSections(_other_sections, tid, tid_ext, 0, true, false, false);
+    removeSections(tid, tid_ext, 0, true, false);
 }
 
 void ts::CyclingPacketizer::removeSections(TID tid, uint16_t tid_ext, uint8_t sec_number)
 {
-    removeSections(_sched_sections, tid, tid_ext, sec_number, true, true, true);
-    removeSections(_other_sections, tid, tid_ext, sec_number, true, true, false);
+    removeSections(tid, tid_ext, sec_number, true, true);
 }
 
 
 //----------------------------------------------------------------------------
-// Remove all sections with the specified tid/tid_ext in the specified list.
+// Remove all sections with the specified tid/tid_ext.
 //----------------------------------------------------------------------------
 
-void ts::CyclingPacketizer::removeSections(SectionDescList& list, TID tid, uint16_t tid_ext, uint8_t sec_number, bool use_tid_ext, bool use_sec_number, bool scheduled)
+void ts::CyclingPacketizer::removeSections(TID tid, uint16_t tid_ext, uint8_t sec_number, bool use_tid_ext, bool use_sec_number)
 {
-    for (auto it = list.begin(); it != list.end(); ) {
-        const SectionDescPtr& sp(*it);
-        const Section& sect(*sp->section);
-        if (sect.tableId() == tid && (!use_tid_ext || sect.tableIdExtension() == tid_ext) && (!use_sec_number || sect.sectionNumber() == sec_number)) {
-            // Section match, remove it
-            assert(_section_count > 0);
-            _section_count--;
-            if (sp->last_cycle != _current_cycle) {
-                assert(_remain_in_cycle > 0);
-                _remain_in_cycle--;
-            }
-            if (scheduled) {
-                assert(_sched_packets >= sect.packetCount());
-                _sched_packets -= sect.packetCount();
-            }
-            it = list.erase(it);
-        }
-        else {
-            ++it;
-        }
+    for (auto group = _sched_sections.begin(); group != _sched_sections.end(); ) {
+        const size_t removed = std::erase_if(group->second, [&](const SectionDescPtr& sp) {
+            return removeSection(*sp, tid, tid_ext, sec_number, use_tid_ext, use_sec_number, true);
+        });
+        assert(_sched_count >= removed);
+        _sched_count -= removed;
+        group = group->second.empty() ? _sched_sections.erase(group) : std::next(group);
     }
+    std::erase_if(_other_sections, [&](const SectionDescPtr& sp) {
+        return removeSection(*sp, tid, tid_ext, sec_number, use_tid_ext, use_sec_number, false);
+    });
+}
+
+
+//----------------------------------------------------------------------------
+// Check if a section matches the specified tid/tid_ext and shall be removed.
+//----------------------------------------------------------------------------
+
+bool ts::CyclingPacketizer::removeSection(const SectionDesc& desc, TID tid, uint16_t tid_ext, uint8_t sec_number, bool use_tid_ext, bool use_sec_number, bool scheduled)
+{
+    const Section& sect(*desc.section);
+    if (sect.tableId() != tid || (use_tid_ext && sect.tableIdExtension() != tid_ext) || (use_sec_number && sect.sectionNumber() != sec_number)) {
+        return false;
+    }
+
+    // Section match, remove it
+    assert(_section_count > 0);
+    _section_count--;
+    if (desc.last_cycle != _current_cycle) {
+        assert(_remain_in_cycle > 0);
+        _remain_in_cycle--;
+    }
+    if (scheduled) {
+        assert(_sched_packets >= desc.packets);
+        _sched_packets -= desc.packets;
+    }
+    return true;
 }
 
 
@@ -215,6 +235,7 @@ void ts::CyclingPacketizer::removeAll()
     _section_count = 0;
     _remain_in_cycle = 0;
     _sched_packets = 0;
+    _sched_count = 0;
     _sched_sections.clear();
     _other_sections.clear();
 }
@@ -247,10 +268,11 @@ void ts::CyclingPacketizer::setBitRate(const BitRate& new_bitrate)
     else if (new_bitrate == 0) {
         // Bitrate now unknown, unable to schedule sections, move them all
         // into the list of unscheduled sections.
-        while (!_sched_sections.empty()) {
-            _other_sections.push_back(_sched_sections.front());
-            _sched_sections.pop_front();
+        for (auto& group : _sched_sections) {
+            _other_sections.splice(_other_sections.end(), group.second);
         }
+        _sched_sections.clear();
+        _sched_count = 0;
         _sched_packets = 0;
     }
     else if (_bitrate == 0) {
@@ -269,21 +291,27 @@ void ts::CyclingPacketizer::setBitRate(const BitRate& new_bitrate)
                 if (sp->due_packet < current_packet) {
                     sp->due_packet = current_packet;
                 }
+                sp->distance = std::max(PacketCounter(1), PacketDistance(new_bitrate, sp->repetition));
                 addScheduledSection(sp);
-                _sched_packets += sp->section->packetCount();
+                _sched_packets += sp->packets;
             }
         }
     }
     else {
         // Old and new bitrate not null. Compute new due packet for all
-        // scheduled sections and re-sort list according to new due packet.
-        SectionDescList tmp_list;
-        tmp_list.swap(_sched_sections);
-        while (!tmp_list.empty()) {
-            SectionDesc* sp(tmp_list.back().get());
-            sp->due_packet = sp->last_packet + PacketDistance(new_bitrate, sp->repetition);
-            addScheduledSection(tmp_list.back());
-            tmp_list.pop_back();
+        // scheduled sections and re-sort them according to new due packet.
+        // Sections are reinserted from the last one to the first one.
+        SectionDescSchedule tmp_sched;
+        tmp_sched.swap(_sched_sections);
+        _sched_count = 0;
+        for (auto group = tmp_sched.rbegin(); group != tmp_sched.rend(); ++group) {
+            for (auto it = group->second.rbegin(); it != group->second.rend(); ++it) {
+                SectionDesc* sp(it->get());
+                const PacketCounter distance = PacketDistance(new_bitrate, sp->repetition);
+                sp->distance = std::max(PacketCounter(1), distance);
+                sp->due_packet = sp->last_packet + distance;
+                addScheduledSection(*it);
+            }
         }
     }
 
@@ -319,15 +347,20 @@ void ts::CyclingPacketizer::provideSection(SectionCounter counter, SectionPtr& s
         // .. and either previous unscheduled sections not passed in current cycle ...
         ((spp = _other_sections.back().get())->last_cycle != _current_cycle ||
          // .. or previous unscheduled section passed in this cycle a long time ago
-         spp->last_packet + spp->section->packetCount() + _sched_packets < current_packet);
+         spp->last_packet + spp->packets + _sched_packets < current_packet);
 
-    if (!force_unscheduled && !_sched_sections.empty() && _sched_sections.front()->due_packet <= current_packet) {
+    if (!force_unscheduled && !_sched_sections.empty() && _sched_sections.begin()->first <= current_packet) {
         // One scheduled section is ready
-        sp = _sched_sections.front();
-        _sched_sections.pop_front();
-        // Reschedule the section. Make sure we add at least one packet to
-        // ensure that all scheduled sections may pass.
-        sp->due_packet = current_packet + std::max(PacketCounter(1), PacketDistance(_bitrate, sp->repetition));
+        const auto group = _sched_sections.begin();
+        sp = group->second.front();
+        group->second.pop_front();
+        if (group->second.empty()) {
+            _sched_sections.erase(group);
+        }
+        _sched_count--;
+        // Reschedule the section. The precomputed distance is at least one packet
+        // to ensure that all scheduled sections may pass.
+        sp->due_packet = current_packet + sp->distance;
         addScheduledSection(sp);
     }
     else if (!_other_sections.empty()) {
@@ -415,10 +448,12 @@ std::ostream& ts::CyclingPacketizer::display(std::ostream& strm) const
         << "  Remaining sections in cycle: " << _remain_in_cycle << std::endl
         << "  Section cycle end: " << (_cycle_end == UNDEFINED ? u"undefined" : UString::Decimal(_cycle_end)) << std::endl
         << "  Stored sections: " << _section_count << std::endl
-        << "  Scheduled sections: " << _sched_sections.size() << std::endl
+        << "  Scheduled sections: " << _sched_count << std::endl
         << "  Scheduled packets max: " << _sched_packets << std::endl;
-    for (auto& it : _sched_sections) {
-        it->display(duck(), strm);
+    for (auto& group : _sched_sections) {
+        for (auto& it : group.second) {
+            it->display(duck(), strm);
+        }
     }
     strm << "  Unscheduled sections: " << _other_sections.size() << std::endl;
     for (auto& it : _other_sections) {
@@ -202,6 +202,8 @@ namespace ts {
             PacketCounter    last_packet = 0; // Packet index of last time the section was sent
             PacketCounter    due_packet = 0;  // Packet index of next time
             SectionCounter   last_cycle = 0;  // Cycle index of last time the section was sent
+            PacketCounter    packets = 0;     // Size of the section in TS packets (the section is never modified)
+            PacketCounter    distance = 0;    // Repetition rate in packets at current bitrate, at least 1
 
             // Constructor
             SectionDesc(const SectionPtr& sec, cn::milliseconds rep);
@@ -217,24 +219,33 @@ namespace ts {
         using SectionDescPtr = std::shared_ptr<SectionDesc>;
         using SectionDescList = std::list<SectionDescPtr>;
 
+        // Scheduled sections are grouped by due packet, in increasing order. Selecting the next
+        // section and rescheduling it is O(log n). Inside a group, the order of sections is
+        // defined by SectionDesc::insertAfter().
+        using SectionDescSchedule = std::map<PacketCounter, SectionDescList>;
+
         // Private members:
-        StuffingPolicy  _stuffing = StuffingPolicy::NEVER;
-        BitRate         _bitrate = 0;
-        size_t          _section_count = 0;      // Number of sections in the 2 lists
-        SectionDescList _sched_sections {};      // Scheduled sections, with repetition rates
-        SectionDescList _other_sections {};      // Unscheduled sections
-        PacketCounter   _sched_packets = 0;      // Size in TS packets of all sections in _sched_sections
-        SectionCounter  _current_cycle {1};      // Cycle number (start at 1, always increasing)
-        size_t          _remain_in_cycle = 0;    // Number of unsent sections in this cycle
-        SectionCounter  _cycle_end = UNDEFINED;  // At end of cycle, contains the index of last section
+        StuffingPolicy      _stuffing = StuffingPolicy::NEVER;
+        BitRate             _bitrate = 0;
+        size_t              _section_count = 0;      // Number of sections in the 2 lists
+        size_t              _sched_count = 0;        // Number of sections in _sched_sections
+        SectionDescSchedule _sched_sections {};      // Scheduled sections, with repetition rates
+        SectionDescList     _other_sections {};      // Unscheduled sections
+        PacketCounter       _sched_packets = 0;      // Size in TS packets of all sections in _sched_sections
+        SectionCounter      _current_cycle {1};      // Cycle number (start at 1, always increasing)
+        size_t              _remain_in_cycle = 0;    // Number of unsent sections in this cycle
+        SectionCounter      _cycle_end = UNDEFINED;  // At end of cycle, contains the index of last section
 
         static constexpr SectionCounter UNDEFINED = std::numeric_limits<SectionCounter>::max();
 
-        // Insert a scheduled section in the list, sorted by due_packet.
+        // Insert a scheduled section in the schedule, sorted by due_packet.
         void addScheduledSection(const SectionDescPtr&);
 
-        // Remove all sections with the specified tid/tid_ext in the specified list.
-        void removeSections(SectionDescList&, TID tid, uint16_t tid_ext, uint8_t sec_number, bool use_tid_ext, bool use_sec_number, bool scheduled);
+        // Check if a section matches the specified tid/tid_ext and shall be removed. Update counters.
+        bool removeSection(const SectionDesc&, TID tid, uint16_t tid_ext, uint8_t sec_number, bool use_tid_ext, bool use_sec_number, bool scheduled);
+
+        // Remove all sections with the specified tid/tid_ext.
+        void removeSections(TID tid, uint16_t tid_ext, uint8_t sec_number, bool use_tid_ext, bool use_sec_number);
 
         // Inherited from SectionProviderInterface
         virtual void provideSection(SectionCounter, SectionPtr&) override;
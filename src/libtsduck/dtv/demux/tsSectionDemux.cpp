@@ -116,18 +116,18 @@ void ts::SectionDemux::Status::display(Report& report, int level, const UString&
 //----------------------------------------------------------------------------
 
 // Init for a new table.
-void ts::SectionDemux::XTIDContext::init(uint8_t new_version, uint8_t last_section)
+void ts::SectionDemux::XTIDContext::init(SectionDemux& demux, uint8_t new_version, uint8_t last_section)
 {
     notified = false;
     version = new_version;
     sect_expected = size_t(last_section) + 1;
     sect_received = 0;
-    sects.resize(sect_expected);
 
-    // Mark all section entries as unused
-    for (size_t i = 0; i < sect_expected; i++) {
-        sects[i].reset();
+    // Mark all section entries as unused, recycle unreferenced sections from the previous table.
+    for (auto& sect : sects) {
+        demux.recycleSection(sect);
     }
+    sects.resize(sect_expected);
 }
 
 // Notify the application if the table is complete.
@@ -191,13 +191,49 @@ ts::SectionDemux::SectionDemux(DuckContext& duck, TableHandlerInterface* table_h
 void ts::SectionDemux::immediateReset()
 {
     SuperClass::immediateReset();
-    _pids.clear();
+    _pids.reset();
 }
 
 void ts::SectionDemux::immediateResetPID(PID pid)
 {
     SuperClass::immediateResetPID(pid);
-    _pids.erase(pid);
+    if (_pids != nullptr && pid < PID_MAX) {
+        (*_pids)[pid].reset();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get the context of a PID or an XTID, create it if it does not exist.
+//----------------------------------------------------------------------------
+
+ts::SectionDemux::PIDContext& ts::SectionDemux::getPID(PID pid)
+{
+    // The PID table is allocated on first use. Only the contexts of the PID's
+    // which are actually demuxed are allocated, the direct indexing avoids
+    // searching a map for each packet.
+    if (_pids == nullptr) {
+        _pids = std::make_unique<std::array<std::unique_ptr<PIDContext>, PID_MAX>>();
+    }
+    auto& pc((*_pids)[pid & (PID_MAX - 1)]);
+    if (pc == nullptr) {
+        pc = std::make_unique<PIDContext>();
+    }
+    return *pc;
+}
+
+ts::SectionDemux::XTIDContext& ts::SectionDemux::PIDContext::getXTID(const XTID& xtid)
+{
+    // Fast path: same XTID as the previous section in this PID.
+    if (last_tid < tids.size() && tids[last_tid].first == xtid) {
+        return tids[last_tid].second;
+    }
+    auto it = std::lower_bound(tids.begin(), tids.end(), xtid, [](const auto& elem, const XTID& x) { return elem.first < x; });
+    if (it == tids.end() || it->first != xtid) {
+        it = tids.emplace(it, xtid, XTIDContext());
+    }
+    last_tid = it - tids.begin();
+    return it->second;
 }
 
 
@@ -224,7 +260,7 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
     // Get PID and reference to the PID context.
     // The PID context is created if did not exist.
     const PID pid = pkt.getPID();
-    PIDContext& pc(_pids[pid]);
+    PIDContext& pc(getPID(pid));
 
     // If TS packet is scrambled, we cannot decode it and we loose synchronization
     // on this PID (usually, PID's carrying sections are not scrambled).
@@ -442,7 +478,7 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             // Get reference to the XTID context for this PID.
             // The XTID context is created if did not exist.
             // Avoid accumulating partial sections when there is no table handler.
-            XTIDContext* tc = _table_handler == nullptr ? nullptr : &pc.tids[xtid];
+            XTIDContext* tc = _table_handler == nullptr ? nullptr : &pc.getXTID(xtid);
 
             // If this is a new version of the table, reset the TID context.
             // Note that short sections do not have versions, so the version
@@ -454,7 +490,7 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
                     tc->sect_expected == 0 ||    // new TID on this PID
                     tc->version != version)      // new version
                 {
-                    tc->init(version, last_section_number);
+                    tc->init(*this, version, last_section_number);
                 }
 
                 // Check that the total number of sections in the table
@@ -478,7 +514,7 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
                 if (section_length != old.size() || !MemEqual(ts_start, old.content(), section_length)) {
                     _duck.report().log(_ts_error_level, u"section updated without version update, PID %n, TID %n, section %d, version %d, packet index %'d", pid, tid, section_number, version, _packet_count);
                     // Reset the previous content of the section and make sure the table will be notified again.
-                    tc->sects[section_number].reset();
+                    recycleSection(tc->sects[section_number]);
                     assert(tc->sect_received > 0);
                     tc->sect_received--;
                     tc->notified = false;
@@ -494,7 +530,7 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             SectionPtr sect_ptr;
 
             if (section_ok && (_section_handler != nullptr || (tc != nullptr && tc->sects[section_number] == nullptr))) {
-                sect_ptr = std::make_shared<Section>(ts_start, section_length, pid, CRC32::CHECK);
+                sect_ptr = newSection(ts_start, section_length, pid);
                 sect_ptr->setFirstTSPacketIndex(pusi_pkt_index);
                 sect_ptr->setLastTSPacketIndex(_packet_count);
                 if (!sect_ptr->isValid()) {
@@ -535,6 +571,9 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             if (afterCallingHandler(true)) {
                 return;  // the PID of this packet or the complete demux was reset.
             }
+
+            // Reuse the section object and its data buffer if the handlers did not keep it.
+            recycleSection(sect_ptr);
         }
 
         // Move to next section in the buffer
@@ -563,10 +602,12 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
 
 void ts::SectionDemux::fixAndFlush(bool pack, bool fill_eit)
 {
-    // Loop on all PID's.
-    for (auto& it1 : _pids) {
-        const PID pid = it1.first;
-        PIDContext& pc(it1.second);
+    // Loop on all PID's, in increasing PID order.
+    for (PID pid = 0; _pids != nullptr && pid < PID_MAX; ++pid) {
+        if ((*_pids)[pid] == nullptr) {
+            continue;
+        }
+        PIDContext& pc(*(*_pids)[pid]);
 
         // Mark that we are in the context of a table or section handler.
         // This is used to prevent the destruction of PID contexts during
@@ -588,6 +629,38 @@ void ts::SectionDemux::fixAndFlush(bool pack, bool fill_eit)
 }
 
 
+//----------------------------------------------------------------------------
+// Pool of recycled sections.
+//----------------------------------------------------------------------------
+
+ts::SectionPtr ts::SectionDemux::newSection(const uint8_t* content, size_t content_size, PID pid)
+{
+    SectionPtr sect;
+    if (_section_pool.empty()) {
+        sect = std::make_shared<Section>(content, content_size, pid, CRC32::CHECK);
+    }
+    else {
+        // The section is not shared and its previous data buffer is reused when possible.
+        sect = std::move(_section_pool.back());
+        _section_pool.pop_back();
+        sect->reload(content, content_size, pid, CRC32::CHECK);
+        sect->setAttribute(UString());
+    }
+    return sect;
+}
+
+void ts::SectionDemux::recycleSection(SectionPtr& sect)
+{
+    // A use count of 1 means that the demux holds the only reference to the section object.
+    // If the binary data of the section were shared by the handler (Section copy in ShareMode::SHARE),
+    // the next reload() will allocate new data, leaving the shared data to the handler.
+    if (sect != nullptr && sect.use_count() == 1 && _section_pool.size() < SECTION_POOL_SIZE) {
+        _section_pool.push_back(std::move(sect));
+    }
+    sect.reset();
+}
+
+
 //----------------------------------------------------------------------------
 // Notify the application that the content of the TS payload buffer is invalid.
 //----------------------------------------------------------------------------
@@ -596,7 +669,7 @@ bool ts::SectionDemux::notifyInvalid(PID pid, Section::Status status, const uint
 {
     if (_invalid_handler != nullptr) {
         // Build a demuxed data from the TS payload buffer.
-        PIDContext& pc(_pids[pid]);
+        PIDContext& pc(getPID(pid));
         if (ts_start >= pc.ts.data() && ts_start < pc.ts.dataEnd()) {
             DemuxedData data(ts_start, std::min<size_t>(ts_size, pc.ts.dataEnd() - ts_start), pid);
             data.setFirstTSPacketIndex(pc.pusi_pkt_index);
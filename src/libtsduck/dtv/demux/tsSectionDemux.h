@@ -242,8 +242,8 @@ namespace ts {
             // Default constructor.
             XTIDContext() = default;
 
-            // Init for a new table.
-            void init(uint8_t new_version, uint8_t last_section);
+            // Init for a new table. Previous sections are recycled in the demux.
+            void init(SectionDemux& demux, uint8_t new_version, uint8_t last_section);
 
             // Notify the application if the table is complete.
             // Do not notify twice the same table.
@@ -258,16 +258,25 @@ namespace ts {
             PacketCounter pusi_pkt_index = 0;    // Index of last packet with PUSI in this PID
             uint8_t       continuity = 0;        // Last continuity counter
             bool          sync = false;          // We are synchronous in this PID
+            size_t        last_tid = 0;          // Index in tids of last used XTID context
             ByteBlock     ts {};                 // TS payload buffer
-            std::map<XTID,XTIDContext> tids {};  // TID analysis contexts
+            std::vector<std::pair<XTID,XTIDContext>> tids {};  // TID analysis contexts, sorted by XTID
 
             // Default constructor.
             PIDContext() = default;
 
             // Called when packet synchronization is lost on the pid.
             void syncLost();
+
+            // Get the context of an XTID, create it if it does not exist.
+            // Most PID's carry very few XTID's and consecutive sections usually have the same XTID.
+            // A sorted vector with a cache of the last used entry is faster than a map in that case.
+            XTIDContext& getXTID(const XTID& xtid);
         };
 
+        // Get the context of a PID, create it if it does not exist.
+        PIDContext& getPID(PID pid);
+
         // Notify the application if the table is complete.
         // Do not notify twice the same table.
         // If pack is true, build a packed version of the table and report it.
@@ -278,11 +287,24 @@ namespace ts {
         // Return true if a delayed reset was executed.
         bool notifyInvalid(PID pid, Section::Status status, const uint8_t* ts_start, size_t ts_size);
 
+        // Get a section object from the pool of recycled sections or allocate a new one.
+        // The section is loaded with the specified content.
+        SectionPtr newSection(const uint8_t* content, size_t content_size, PID pid);
+
+        // Return a section to the pool if it is no longer referenced outside the demux.
+        // A section which is still referenced (e.g. kept in a BinaryTable by a handler) is left
+        // to its owners. In all cases, the pointer is reset on return.
+        void recycleSection(SectionPtr& sect);
+
+        // Maximum number of recycled sections in the pool.
+        static constexpr size_t SECTION_POOL_SIZE = 64;
+
         // Private members:
         TableHandlerInterface*          _table_handler = nullptr;
         SectionHandlerInterface*        _section_handler = nullptr;
         InvalidSectionHandlerInterface* _invalid_handler = nullptr;
-        std::map<PID,PIDContext>        _pids {};
+        std::unique_ptr<std::array<std::unique_ptr<PIDContext>, PID_MAX>> _pids {};  // Indexed by PID, allocated on demand
+        std::vector<SectionPtr> _section_pool {};  // Recycled sections, with their binary data buffers.
         Status _status {};
         bool   _get_current = true;
         bool   _get_next = false;
@@ -59,6 +59,9 @@ void ts::EITGenerator::reset(PID pid)
     for (size_t i = 0; i < _injects.size(); ++i) {
         _injects[i].clear();
     }
+    _inject_back = 0;
+    _inject_front = -1;
+    _next_update.clear();
     _last_tid = TID_NULL;
     _obsolete_count = 0;
     _versions.clear();
@@ -185,6 +188,48 @@ void ts::EITGenerator::ESection::updateVersion(EITGenerator* gen, bool recompute
 }
 
 
+//----------------------------------------------------------------------------
+// EInjectQueue: Insert and remove sections.
+//----------------------------------------------------------------------------
+
+void ts::EITGenerator::EInjectQueue::insert(const EInject& inj)
+{
+    sections.insert(inj);
+    services[inj.section->section->tableIdExtension()].insert(inj);
+}
+
+void ts::EITGenerator::EInjectQueue::erase(const EInject& inj)
+{
+    // Get a copy first, the parameter may reference an element of the sets.
+    const EInject keep(inj);
+    const auto srv = services.find(keep.section->section->tableIdExtension());
+    if (srv != services.end()) {
+        srv->second.erase(keep);
+        if (srv->second.empty()) {
+            services.erase(srv);
+        }
+    }
+    sections.erase(keep);
+}
+
+void ts::EITGenerator::EInjectQueue::clear()
+{
+    sections.clear();
+    services.clear();
+}
+
+void ts::EITGenerator::EInjectQueue::removeObsolete()
+{
+    // Removing elements does not change the relative order of the others.
+    const auto obsolete = [](const EInject& inj) { return inj.section->obsolete; };
+    std::erase_if(sections, obsolete);
+    for (auto& srv : services) {
+        std::erase_if(srv.second, obsolete);
+    }
+    std::erase_if(services, [](const auto& srv) { return srv.second.empty(); });
+}
+
+
 //----------------------------------------------------------------------------
 // Compute the next version for a table. If option SYNC_VERSIONS is set, the section number is ignored.
 //----------------------------------------------------------------------------
@@ -218,47 +263,47 @@ uint8_t ts::EITGenerator::nextVersion(const ServiceIdTriplet& service_id, TID ta
 
 bool ts::EITGenerator::deleteEvent(const ServiceIdTriplet& service, uint16_t event_id)
 {
-    bool success = false;  // becomes true when the event is successfully located and removed.
-
     // Locate the service.
     const auto isrv = _services.find(service);
-    if (isrv != _services.end() && isrv->second.event_ids.contains(event_id)) {
-        // The event is known in the service.
-        auto& srv(isrv->second);
-
-        // Look for the event in this service.
-        for (auto iseg = srv.segments.begin(); !success && iseg != srv.segments.end(); ++iseg) {
-            auto& events((*iseg)->events);
-            for (auto iev = events.begin(); !success && iev != events.end(); ++iev) {
-                if ((*iev)->event_id == event_id) {
-                    // Found the event with same id.
-                    success = true;
-                    _duck.report().log(2, u"delete event id %n, %s, starting %s", event_id, service, (*iev)->start_time);
-
-                    // Remove event from segment and service.
-                    events.erase(iev);
-                    srv.event_ids.erase(event_id);
+    if (isrv == _services.end()) {
+        return false;
+    }
+    auto& srv(isrv->second);
 
-                    // Mark all EIT schedule in this segment as to be regenerated.
-                    _regenerate = srv.regenerate = (*iseg)->regenerate = true;
-
-                    // Check if that event is in the EIT p/f for the sevice.
-                    for (const auto& sec : srv.pf) {
-                        if (sec != nullptr &&
-                            sec->section != nullptr &&
-                            sec->section->size() >= LONG_SECTION_HEADER_SIZE + EIT::EIT_PAYLOAD_FIXED_SIZE + EIT::EIT_EVENT_FIXED_SIZE + SECTION_CRC32_SIZE &&
-                            GetUInt16(sec->section->content() + LONG_SECTION_HEADER_SIZE + EIT::EIT_PAYLOAD_FIXED_SIZE) == event_id)
-                        {
-                            // The event is in an EIT p/f. Regenerate them.
-                            regeneratePresentFollowing(service, srv, getCurrentTime());
-                            break;
-                        }
-                    }
-                }
-            }
+    // Locate the segment where the event is stored, then the event in the segment.
+    const auto iid = srv.event_ids.find(event_id);
+    const auto iseg = iid == srv.event_ids.end() ? srv.segments.end() : srv.segments.find(iid->second);
+    if (iseg == srv.segments.end()) {
+        return false;
+    }
+    auto& events(iseg->second->events);
+    const auto iev = std::find_if(events.begin(), events.end(), [event_id](const EventPtr& ev) { return ev->event_id == event_id; });
+    if (iev == events.end()) {
+        return false;
+    }
+    _duck.report().log(2, u"delete event id %n, %s, starting %s", event_id, service, (*iev)->start_time);
+
+    // Remove event from segment and service.
+    events.erase(iev);
+    srv.event_ids.erase(iid);
+    _next_update.clear();
+
+    // Mark all EIT schedule in this segment as to be regenerated.
+    _regenerate = srv.regenerate = iseg->second->regenerate = true;
+
+    // Check if that event is in the EIT p/f for the sevice.
+    for (const auto& sec : srv.pf) {
+        if (sec != nullptr &&
+            sec->section != nullptr &&
+            sec->section->size() >= LONG_SECTION_HEADER_SIZE + EIT::EIT_PAYLOAD_FIXED_SIZE + EIT::EIT_EVENT_FIXED_SIZE + SECTION_CRC32_SIZE &&
+            GetUInt16(sec->section->content() + LONG_SECTION_HEADER_SIZE + EIT::EIT_PAYLOAD_FIXED_SIZE) == event_id)
+        {
+            // The event is in an EIT p/f. Regenerate them.
+            regeneratePresentFollowing(service, srv, getCurrentTime());
+            break;
         }
     }
-    return success;
+    return true;
 }
 
 
@@ -328,34 +373,26 @@ bool ts::EITGenerator::loadEventsImpl(const ServiceIdTriplet& service_id, const
         }
 
         // Check if the same event id already existed in the service.
-        if (srv->event_ids.contains(ev->event_id)) {
-            // Look for existing event in this service with same id. Remove it if not an exact duplicate.
-            bool found = false;
-            bool duplicate = false;
-            for (auto iseg = srv->segments.begin(); !found && iseg != srv->segments.end(); ++iseg) {
-                auto& events((*iseg)->events);
-                for (auto iev = events.begin(); !found && iev != events.end(); ++iev) {
-                    if ((*iev)->event_id == ev->event_id) {
-                        // Found the event with same id.
-                        found = true;
-                        duplicate = (*iev)->event_data == ev->event_data;
-                        // Remove event if not a duplicate.
-                        if (!duplicate) {
-                            _duck.report().log(2, u"discard modified event id %n, %s, previously starting %s", (*iev)->event_id, service_id, (*iev)->start_time);
-                            // Remove event from segment and service.
-                            events.erase(iev);
-                            srv->event_ids.erase(ev->event_id);
-                            // Mark all EIT schedule in this segment as to be regenerated.
-                            _regenerate = srv->regenerate = (*iseg)->regenerate = true;
-                            break;
-                        }
+        const auto iid = srv->event_ids.find(ev->event_id);
+        if (iid != srv->event_ids.end()) {
+            // Look for existing event with same id in its segment. Remove it if not an exact duplicate.
+            const auto iseg = srv->segments.find(iid->second);
+            if (iseg != srv->segments.end()) {
+                auto& events(iseg->second->events);
+                const auto iev = std::find_if(events.begin(), events.end(), [&ev](const EventPtr& e) { return e->event_id == ev->event_id; });
+                if (iev != events.end()) {
+                    // If the event is an exact duplicate, no need to do anything with that event.
+                    if ((*iev)->event_data == ev->event_data) {
+                        continue;
                     }
+                    _duck.report().log(2, u"discard modified event id %n, %s, previously starting %s", (*iev)->event_id, service_id, (*iev)->start_time);
+                    // Remove event from segment and service.
+                    events.erase(iev);
+                    srv->event_ids.erase(iid);
+                    // Mark all EIT schedule in this segment as to be regenerated.
+                    _regenerate = srv->regenerate = iseg->second->regenerate = true;
                 }
             }
-            // If the event is an exact duplicate, no need to do anything with that event.
-            if (duplicate) {
-                continue;
-            }
         }
 
         // Locate or allocate the segment for that event. At this stage, we only create this
@@ -363,17 +400,13 @@ bool ts::EITGenerator::loadEventsImpl(const ServiceIdTriplet& service_id, const
         // empty intermediate segments. This will be done in regenerateSchedule().
 
         const Time seg_start_time(EIT::SegmentStartTime(ev->start_time));
-        auto seg_iter = srv->segments.begin();
-        while (seg_iter != srv->segments.end() && (*seg_iter)->start_time < seg_start_time) {
-            ++seg_iter;
-        }
-        if (seg_iter == srv->segments.end() || (*seg_iter)->start_time != seg_start_time) {
+        auto seg_iter = srv->segments.find(seg_start_time);
+        if (seg_iter == srv->segments.end()) {
             // The segment does not exist, create it.
             _duck.report().debug(u"create EIT segment starting at %s for %s", seg_start_time, service_id);
-            const ESegmentPtr seg(new ESegment(seg_start_time));
-            seg_iter = srv->segments.insert(seg_iter, seg);
+            seg_iter = srv->segments.emplace(seg_start_time, std::make_shared<ESegment>(seg_start_time)).first;
         }
-        ESegment& seg(**seg_iter);
+        ESegment& seg(*seg_iter->second);
 
         // Insert the binary event in the list of events for that segment.
         auto ev_iter = seg.events.begin();
@@ -382,7 +415,7 @@ bool ts::EITGenerator::loadEventsImpl(const ServiceIdTriplet& service_id, const
         }
         _duck.report().log(2, u"load event id %n, %s, starting %s", ev->event_id, service_id, ev->start_time);
         seg.events.insert(ev_iter, ev);
-        srv->event_ids.insert(ev->event_id);
+        srv->event_ids[ev->event_id] = seg_start_time;
         ev_count++;
 
         // Mark all EIT schedule in this segment as to be regenerated.
@@ -392,6 +425,7 @@ bool ts::EITGenerator::loadEventsImpl(const ServiceIdTriplet& service_id, const
     // If some events were added, it may be necessary to regenerate the EIT p/f in this service.
     if (ev_count > 0) {
         assert(srv != nullptr);
+        _next_update.clear();
         regeneratePresentFollowing(service_id, *srv, now);
     }
     return success;
@@ -466,8 +500,8 @@ void ts::EITGenerator::saveEITs(SectionPtrVector& sections)
         for (const auto& it1 : _services) {
             // Get first event of first non-empty segment in the service.
             for (const auto& it2 : it1.second.segments) {
-                if (!it2->events.empty()) {
-                    const Time& start_time(it2->events.front()->start_time);
+                if (!it2.second->events.empty()) {
+                    const Time& start_time(it2.second->events.front()->start_time);
                     if (_ref_time == Time::Epoch || start_time < _ref_time) {
                         _ref_time = start_time;
                         _ref_time_pkt = _packet_index;
@@ -502,7 +536,7 @@ void ts::EITGenerator::saveEITs(SectionPtrVector& sections)
     // Loop on all services again, saving all EIT schedule.
     for (const auto& it1 : _services) {
         for (const auto& it2 : it1.second.segments) {
-            for (const auto& it3 : it2->sections) {
+            for (const auto& it3 : it2.second->sections) {
                 sections.push_back(it3->section);
                 sched_count++;
             }
@@ -529,6 +563,7 @@ void ts::EITGenerator::setTransportStreamId(uint16_t new_ts_id)
     const uint16_t old_ts_id = _actual_ts_id_set ? _actual_ts_id : 0xFFFF;
     _actual_ts_id = new_ts_id;
     _actual_ts_id_set = true;
+    _next_update.clear();
 
     // No longer need the PAT when the TS id is known.
     _demux.removePID(PID_PAT);
@@ -579,7 +614,7 @@ void ts::EITGenerator::setTransportStreamId(uint16_t new_ts_id)
                 if ((_options & (EITOptions::GEN_ACTUAL | EITOptions::GEN_OTHER)) == (EITOptions::GEN_ACTUAL | EITOptions::GEN_OTHER)) {
                     // Actual and others are both requested. Toggle the state of existing sections.
                     for (const auto& seg_iter : srv.segments) {
-                        const ESegment& seg(*seg_iter);
+                        const ESegment& seg(*seg_iter.second);
                         for (const auto& sec_iter : seg.sections) {
                             sec_iter->toggleActual(new_actual);
                         }
@@ -589,13 +624,13 @@ void ts::EITGenerator::setTransportStreamId(uint16_t new_ts_id)
                     // The EIT schedule for that service were not there, we need them now, regenerate later.
                     _regenerate = srv.regenerate = true;
                     for (const auto& seg_iter : srv.segments) {
-                        seg_iter->regenerate = true;
+                        seg_iter.second->regenerate = true;
                     }
                 }
                 else {
                     // We no longer need the EIT schedule.
                     for (auto& seg_iter : srv.segments) {
-                        ESegment& seg(*seg_iter);
+                        ESegment& seg(*seg_iter.second);
                         for (auto& sec_iter : seg.sections) {
                             markObsoleteSection(*sec_iter);
                         }
@@ -618,6 +653,7 @@ void ts::EITGenerator::setOptions(EITOptions options)
     // Update the options.
     const EITOptions old_options = _options;
     _options = options;
+    _next_update.clear();
 
     // If the new options request to load events from input EIT's, demux the EIT PID.
     if (bool(options & EITOptions::LOAD_INPUT)) {
@@ -670,7 +706,7 @@ void ts::EITGenerator::setOptions(EITOptions options)
                 if (!need_eit || !(_options & GEN_SCHED)) {
                     // We no longer need the EIT schedule.
                     for (auto& seg_iter : srv.segments) {
-                        ESegment& seg(*seg_iter);
+                        ESegment& seg(*seg_iter.second);
                         for (auto& sec_iter : seg.sections) {
                             markObsoleteSection(*sec_iter);
                         }
@@ -682,7 +718,7 @@ void ts::EITGenerator::setOptions(EITOptions options)
                     // The EIT schedule for that service were not there, we need them now, regenerate later.
                     _regenerate = srv.regenerate = true;
                     for (const auto& seg_iter : srv.segments) {
-                        seg_iter->regenerate = true;
+                        seg_iter.second->regenerate = true;
                     }
                 }
             }
@@ -733,7 +769,8 @@ void ts::EITGenerator::setCurrentTime(const Time& current_utc)
     _ref_time_pkt = _packet_index;
     _duck.report().debug(u"setting TS time to %s at packet index %'d", _ref_time, _ref_time_pkt);
 
-    // Update EIT database if necessary.
+    // Update EIT database if necessary. The new time may be in the past, force a full update.
+    _next_update.clear();
     updateForNewTime(_ref_time);
 }
 
@@ -762,22 +799,20 @@ void ts::EITGenerator::markObsoleteSection(ESection& sec)
         // accumulate because the EIT bandwidth is not large enough and low-priority
         // EIT schedule never get a chance to get selected (and discarded when marked
         // as obsolete). Do some garbage collecting to avoid infinite accumulation.
+        // The threshold grows with the size of the queues to keep the cost of the
+        // garbage collection proportional to the number of obsolete sections.
         if (_obsolete_count > 100) {
-            // Loop on all injection queues.
-            for (size_t index = 0; index < _injects.size(); ++index) {
-                // Loop on all sections in the queue.
-                ESectionList& list(_injects[index]);
-                auto it = list.begin();
-                while (it != list.end()) {
-                    if ((*it)->obsolete) {
-                        it = list.erase(it);
-                    }
-                    else {
-                        ++it;
-                    }
+            size_t queued = 0;
+            for (const auto& queue : _injects) {
+                queued += queue.sections.size();
+            }
+            if (_obsolete_count > queued / 4) {
+                // Remove obsolete sections from all injection queues.
+                for (auto& queue : _injects) {
+                    queue.removeObsolete();
                 }
+                _obsolete_count = 0;
             }
-            _obsolete_count = 0;
         }
     }
 }
@@ -787,32 +822,19 @@ void ts::EITGenerator::markObsoleteSection(ESection& sec)
 // Enqueue a section for injection.
 //----------------------------------------------------------------------------
 
-void ts::EITGenerator::enqueueInjectSection(const ESectionPtr& sec, const Time& next_inject, bool try_front)
+void ts::EITGenerator::enqueueInjectSection(const ESectionPtr& sec, const Time& next_inject, bool front)
+{
+    // Compute which injection queue to use.
+    enqueueInjectSection(_injects[size_t(_profile.sectionToProfile(*sec->section))], sec, next_inject, front);
+}
+
+void ts::EITGenerator::enqueueInjectSection(EInjectQueue& queue, const ESectionPtr& sec, const Time& next_inject, bool front)
 {
     // Update section injection time.
     sec->next_inject = next_inject;
 
-    // Compute which injection queue to use.
-    ESectionList& list(_injects[size_t(_profile.sectionToProfile(*sec->section))]);
-
-    // Even start at from or back of the queue (possible optimization).
-    if (try_front) {
-        auto it = list.begin();
-        while (it != list.end() && (*it)->next_inject <= next_inject) {
-            ++it;
-        }
-        list.insert(it, sec);
-    }
-    else {
-        auto it = list.end();
-        while (it != list.begin() && (*--it)->next_inject > next_inject) {
-        }
-        if (it != list.end()) {
-            // it points to a section before sec, must insert after.
-            ++it;
-        }
-        list.insert(it, sec);
-    }
+    // The insertion order is increasing at back of the queues and decreasing at front.
+    queue.insert(EInject{next_inject, front ? _inject_front-- : _inject_back++, sec});
 }
 
 
@@ -844,7 +866,7 @@ void ts::EITGenerator::regeneratePresentFollowing(const ServiceIdTriplet& servic
         std::array<EventPtr, 2> events;
         size_t next_event = 0;
         for (auto seg_iter = srv.segments.begin(); next_event < events.size() && seg_iter != srv.segments.end(); ++seg_iter) {
-            const ESegment& seg(**seg_iter);
+            const ESegment& seg(*seg_iter->second);
             for (auto ev_iter = seg.events.begin(); next_event < events.size() && ev_iter != seg.events.end(); ++ev_iter) {
                 events[next_event++] = *ev_iter;
             }
@@ -894,7 +916,7 @@ bool ts::EITGenerator::regeneratePresentFollowingSection(const ServiceIdTriplet&
             sec->section->recomputeCRC();
         }
         // Place the section in the inject queue.
-        enqueueInjectSection(sec, inject_time, true);
+        enqueueInjectSection(sec, inject_time);
         // Section was modified.
         return true;
     }
@@ -971,28 +993,27 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
             const bool need_eits = bool(_options & GEN_SCHED);
 
             // Remove initial segments before last midnight.
-            while (!srv.segments.empty() && srv.segments.front()->start_time < last_midnight) {
-                markObsoleteSegment(*srv.segments.front());
-                srv.segments.pop_front();
+            while (!srv.segments.empty() && srv.segments.begin()->first < last_midnight) {
+                ESegment& seg(*srv.segments.begin()->second);
+                // Remove all remaining event ids of this segment from the service.
+                for (const auto& ev : seg.events) {
+                    srv.event_ids.erase(ev->event_id);
+                }
+                markObsoleteSegment(seg);
+                srv.segments.erase(srv.segments.begin());
             }
 
             // Remove final empty segments (no events). Keep at least one segment for last midnight, even if empty.
-            while (!srv.segments.empty() && srv.segments.back()->events.empty() && srv.segments.back()->start_time > last_midnight) {
-                // Remove all event ids of this segment from the service.
-                for (const auto& ev : srv.segments.back()->events) {
-                    srv.event_ids.erase(ev->event_id);
-                }
+            while (!srv.segments.empty() && srv.segments.rbegin()->second->events.empty() && srv.segments.rbegin()->first > last_midnight) {
                 // Remove segment from service
-                markObsoleteSegment(*srv.segments.back());
-                srv.segments.pop_back();
+                markObsoleteSegment(*srv.segments.rbegin()->second);
+                srv.segments.erase(std::prev(srv.segments.end()));
             }
 
             // Make sure that the first segment exists for last midnight.
-            if (srv.segments.empty() || srv.segments.front()->start_time != last_midnight) {
+            if (srv.segments.empty() || srv.segments.begin()->first != last_midnight) {
                 _duck.report().debug(u"creating EIT segment starting at %s for %s", last_midnight, service_id);
-                const ESegmentPtr seg(new ESegment(last_midnight));
-                CheckNonNull(seg.get());
-                srv.segments.push_front(seg);
+                srv.segments.emplace(last_midnight, std::make_shared<ESegment>(last_midnight));
             }
 
             // Loop on all segments. The first segment must be at last midnight.
@@ -1001,14 +1022,12 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
             for (auto seg_iter = srv.segments.begin(); seg_iter != srv.segments.end(); ++seg_iter) {
 
                 // Enforce the existence of contiguous segments. Create missing segments when necessary.
-                if ((*seg_iter)->start_time != segment_start_time) {
+                if (seg_iter->first != segment_start_time) {
                     _duck.report().debug(u"creating EIT segment starting at %s for %s", segment_start_time, service_id);
-                    assert((*seg_iter)->start_time > segment_start_time);
-                    const ESegmentPtr seg(new ESegment(segment_start_time));
-                    CheckNonNull(seg.get());
-                    seg_iter = srv.segments.insert(seg_iter, seg);
+                    assert(seg_iter->first > segment_start_time);
+                    seg_iter = srv.segments.emplace_hint(seg_iter, segment_start_time, std::make_shared<ESegment>(segment_start_time));
                 }
-                ESegment& seg(**seg_iter);
+                ESegment& seg(*seg_iter->second);
 
                 if (!need_eits) {
                     // We do not need EIT schedule here, delete all sections.
@@ -1045,9 +1064,10 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                             }
                         }
                         if (section_still_valid) {
+                            // All events in the section must still exist, the last ones may have been deleted.
                             // If the next event exists and could fit in the section, then the section is no longer valid.
-                            section_still_valid = ev_iter == seg.events.end() ||
-                                (*sec_iter)->section->payloadSize() + (*ev_iter)->event_data.size() > MAX_PRIVATE_LONG_SECTION_PAYLOAD_SIZE;
+                            section_still_valid = pl_size == 0 && (ev_iter == seg.events.end() ||
+                                (*sec_iter)->section->payloadSize() + (*ev_iter)->event_data.size() > MAX_PRIVATE_LONG_SECTION_PAYLOAD_SIZE);
                         }
 
                         // If the current section is still valid, skip those events and move to next section.
@@ -1093,7 +1113,7 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                             // Sections are independently versioned, this one is complete.
                             sec->section->recomputeCRC();
                         }
-                        enqueueInjectSection(sec, getCurrentTime(), true);
+                        enqueueInjectSection(sec, getCurrentTime());
 
                         // Move to next section (if it exists).
                         ++sec_iter;
@@ -1111,7 +1131,7 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                         const ESectionPtr sec(new ESection(this, service_id, table_id, first_section_number, first_section_number));
                         CheckNonNull(sec.get());
                         seg.sections.push_back(sec);
-                        enqueueInjectSection(sec, getCurrentTime(), true);
+                        enqueueInjectSection(sec, getCurrentTime());
                     }
                 }
 
@@ -1126,7 +1146,7 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
             // Fix synthetic fields in all EIT-schedule sections: last_section_number, segment_last_section_number, last_table_id.
             if (need_eits) {
                 assert(!srv.segments.empty());
-                assert(!srv.segments.back()->sections.empty());
+                assert(!srv.segments.rbegin()->second->sections.empty());
 
                 segment_number = srv.segments.size();
                 TID previous_table_id = TID_NULL;
@@ -1135,7 +1155,7 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
 
                 // Loop on segments from last to first.
                 for (auto seg_iter = srv.segments.rbegin(); seg_iter != srv.segments.rend(); ++seg_iter) {
-                    ESegment& seg(**seg_iter);
+                    ESegment& seg(*seg_iter->second);
                     assert(!seg.sections.empty());
                     assert(segment_number > 0);
 
@@ -1191,7 +1211,7 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                     for (size_t seg_count = 0; seg_count < EIT::SEGMENTS_PER_TABLE && seg_iter != srv.segments.end(); seg_count++) {
                         // Update all sections in that segment, if necessary.
                         if (update) {
-                            for (auto& sec : (*seg_iter)->sections) {
+                            for (auto& sec : seg_iter->second->sections) {
                                 (*sec).startModifying();
                                 (*sec).section->setVersion(version, true);
                             }
@@ -1208,8 +1228,9 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
         }
     }
 
-    // Clear global regeneration flag.
+    // Clear global regeneration flag. Segments were modified, the next time update must be complete.
     _regenerate = false;
+    _next_update.clear();
 }
 
 
@@ -1220,13 +1241,17 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
 void ts::EITGenerator::updateForNewTime(const Time& now)
 {
     // We cannot regenerate EIT if the TS id or the current time is unknown.
-    if (!_actual_ts_id_set || now == Time::Epoch) {
+    // Nothing changes in the EIT database before the next known update time.
+    if (!_actual_ts_id_set || now == Time::Epoch || (_next_update != Time::Epoch && now < _next_update)) {
         return;
     }
 
     // Reference time for EIT schedule.
     const Time last_midnight(now.thisDay());
 
+    // The database shall be updated again at next midnight at the latest.
+    _next_update = last_midnight + cn::days(1);
+
     // Loop on all services.
     for (auto& srv_iter : _services) {
 
@@ -1235,14 +1260,14 @@ void ts::EITGenerator::updateForNewTime(const Time& now)
         assert(!srv.segments.empty());
 
         // If we changed day, mark the service as being regenerated (will remove obsolete segments or create missing ones).
-        if (last_midnight != srv.segments.front()->start_time) {
+        if (last_midnight != srv.segments.begin()->first) {
             _regenerate = srv.regenerate = true;
         }
 
         // Segments between last midnight and current time shall be regenerated as well.
         // Segments before current one will now have one empty section, except if events are still in progress.
-        for (auto seg_iter = srv.segments.begin(); seg_iter != srv.segments.end() && (*seg_iter)->start_time <= now; ++seg_iter) {
-            ESegment& seg(**seg_iter);
+        for (auto seg_iter = srv.segments.begin(); seg_iter != srv.segments.end() && seg_iter->first <= now; ++seg_iter) {
+            ESegment& seg(*seg_iter->second);
             while (!seg.events.empty() && seg.events.front()->end_time <= now) {
                 // Remove event id from service.
                 srv.event_ids.erase(seg.events.front()->event_id);
@@ -1256,17 +1281,37 @@ void ts::EITGenerator::updateForNewTime(const Time& now)
         }
 
         // Discard events too far in the future.
-        while (!srv.segments.empty() && srv.segments.back()->start_time >= last_midnight + EIT::TOTAL_DAYS) {
+        while (!srv.segments.empty() && srv.segments.rbegin()->first >= last_midnight + EIT::TOTAL_DAYS) {
             // Remove all event ids of this segment from the service.
-            for (const auto& ev : srv.segments.back()->events) {
+            for (const auto& ev : srv.segments.rbegin()->second->events) {
                 srv.event_ids.erase(ev->event_id);
             }
             // Remove segment from service
-            srv.segments.pop_back();
+            srv.segments.erase(std::prev(srv.segments.end()));
         }
 
         // Renew EIT p/f of the service when necessary.
         regeneratePresentFollowing(service_id, srv, now);
+
+        // Compute the next time when something changes in this service: the first event in a current
+        // segment is removed when it ends, the first event of the service becomes present when it starts,
+        // the events of the next segment are checked when it starts.
+        bool first_event = true;
+        for (const auto& seg_iter : srv.segments) {
+            const ESegment& seg(*seg_iter.second);
+            if (seg.start_time > now) {
+                _next_update = std::min(_next_update, seg.start_time);
+                break;
+            }
+            else if (!seg.events.empty()) {
+                const Event& ev(*seg.events.front());
+                _next_update = std::min(_next_update, ev.end_time);
+                if (first_event && ev.start_time > now) {
+                    _next_update = std::min(_next_update, ev.start_time);
+                }
+                first_event = false;
+            }
+        }
     }
 }
 
@@ -1293,32 +1338,32 @@ void ts::EITGenerator::provideSection(SectionCounter counter, SectionPtr& sectio
 
     // Make sure no section for the last injected {tid,tidext} is scheduled for _section_gap milliseconds.
     if (_last_tid != TID_NULL) {
-        ESectionList& list(_injects[_last_index]);
+        EInjectQueue& queue(_injects[_last_index]);
         const Time next_inject = now + _section_gap;
         int gap_count = 0;
-        auto it = list.begin();
-        while (it != list.end() && (*it)->next_inject < next_inject) {
-            if ((*it)->section->tableId() != _last_tid || (*it)->section->tableIdExtension() != _last_tidext) {
-                ++it;
+        // Collect the sections of the same service which are scheduled before the gap, in order of injection.
+        // Sections of other services are left at the same place.
+        std::vector<EInject> early;
+        const auto srv = queue.services.find(_last_tidext);
+        if (srv != queue.services.end()) {
+            for (auto it = srv->second.begin(); it != srv->second.end() && it->next_inject < next_inject; ++it) {
+                if (it->section->obsolete || it->section->section->tableId() == _last_tid) {
+                    early.push_back(*it);
+                }
+            }
+        }
+        for (const auto& inj : early) {
+            queue.erase(inj);
+            if (inj.section->obsolete) {
+                // Drop obsolete sections, they do not need any gap.
+                assert(_obsolete_count > 0);
+                _obsolete_count--;
             }
             else {
-                // We have a section with the same {tid,tidext}, need to reschedule it later.
-                const ESectionPtr next_sec = *it;
-                _duck.report().log(2, u"reschedule section %d at %s", next_sec->section->sectionNumber(), next_inject);
-                it = list.erase(it);
-                // We can't call enqueueInjectSection() since we are currently walking through the same
-                // list and enqueueInjectSection() may change "it" iterator. Insert manually.
-                // Also reschedule each section "_section_gap" later than the previous one.
-                next_sec->next_inject = next_inject + gap_count++ * _section_gap;
-                auto it1 = it;
-                while (it1 != list.end() && (*it1)->next_inject < next_sec->next_inject) {
-                    ++it1;
-                }
-                const bool same_place = it1 == it;
-                it1 = list.insert(it1, next_sec);
-                if (same_place) {
-                    it = it1;
-                }
+                // We have a section with the same {tid,tidext}, need to reschedule it later, before other sections
+                // at the same time. Also reschedule each section "_section_gap" later than the previous one.
+                _duck.report().log(2, u"reschedule section %d at %s", inj.section->section->sectionNumber(), next_inject);
+                enqueueInjectSection(queue, inj.section, next_inject + gap_count++ * _section_gap, true);
             }
         }
         _last_tid = TID_NULL;
@@ -1329,11 +1374,12 @@ void ts::EITGenerator::provideSection(SectionCounter counter, SectionPtr& sectio
 
         // Check if the first section in the queue is ready for injection.
         // Loop on obsolete events. Return on first injected event.
-        while (!_injects[index].empty() && _injects[index].front()->next_inject <= now) {
+        EInjectQueue& queue(_injects[index]);
+        while (!queue.sections.empty() && queue.sections.begin()->next_inject <= now) {
 
             // Remove the first section from the queue.
-            const ESectionPtr sec(_injects[index].front());
-            _injects[index].pop_front();
+            const ESectionPtr sec(queue.sections.begin()->section);
+            queue.erase(*queue.sections.begin());
 
             if (sec->obsolete) {
                 // This is an obsolete section, no longer in the base, drop it.
@@ -1346,7 +1392,7 @@ void ts::EITGenerator::provideSection(SectionCounter counter, SectionPtr& sectio
                 sec->injected = true;
 
                 // Requeue next iteration of that section.
-                enqueueInjectSection(sec, now + _profile.repetitionSeconds(*sec->section), false);
+                enqueueInjectSection(sec, now + _profile.repetitionSeconds(*sec->section));
                 _duck.report().log(2, u"inject section TID %n, service %n, at %s, requeue for %s",
                                    section->tableId(), section->tableIdExtension(), now, sec->next_inject);
                 _last_tid = section->tableId();
@@ -1457,26 +1503,26 @@ void ts::EITGenerator::dumpInternalState(int lev) const
             dumpSection(lev, u"  Present section: ", it1.second.pf[0]);
             dumpSection(lev, u"  Follow section:  ", it1.second.pf[1]);
             for (const auto& it2 : it1.second.segments) {
-                const ESegment& seg(*it2);
+                const ESegment& seg(*it2.second);
                 rep.log(lev, u"  - Segment %s, regenerate: %s, events: %d, sections: %d", seg.start_time, seg.regenerate, seg.events.size(), seg.sections.size());
                 rep.log(lev, u"    Events:");
-                for (const auto& it3 : it2->events) {
+                for (const auto& it3 : seg.events) {
                     const Event& ev(*it3);
                     rep.log(lev, u"    - Event id: 0x%X, start: %s, end: %s, %d bytes", ev.event_id, ev.start_time, ev.end_time, ev.event_data.size());
                 }
                 rep.log(lev, u"    Sections:");
-                for (const auto& it3 : it2->sections) {
+                for (const auto& it3 : seg.sections) {
                     dumpSection(lev, u"    - Section: ", it3);
                 }
             }
         }
 
-        // Dump internal state of injection queues.
+        // Dump internal state of injection queues, in order of injection.
         for (size_t index = 0; index < _injects.size(); ++index) {
             rep.log(lev, u"");
-            rep.log(lev, u"- Injection queue #%d: %d sections", index, _injects[index].size());
-            for (auto it = _injects[index].begin(); it != _injects[index].end(); ++it) {
-                dumpSection(lev, u"  - ", *it);
+            rep.log(lev, u"- Injection queue #%d: %d sections", index, _injects[index].sections.size());
+            for (const auto& inj : _injects[index].sections) {
+                dumpSection(lev, u"  - ", inj.section);
             }
         }
         rep.log(lev, u"");
@@ -470,7 +470,7 @@ namespace ts {
         };
 
         using ESegmentPtr = std::shared_ptr<ESegment>;
-        using ESegmentList = std::list<ESegmentPtr>;
+        using ESegmentMap = std::map<Time, ESegmentPtr>;  // indexed by segment start time
 
         // ------------------------
         // Description of a service
@@ -480,10 +480,10 @@ namespace ts {
         {
             TS_NOCOPY(EService);
         public:
-            bool               regenerate = false;  // Some segments must be regenerated in the service.
-            ESectionPair       pf {};               // EIT p/f sections (0: present, 1: following).
-            ESegmentList       segments {};         // List of 3-hour segments (EPG events and EIT schedule sections).
-            std::set<uint16_t> event_ids {};        // Existing event ids in that service, used as fast lookup of event presence.
+            bool                    regenerate = false;  // Some segments must be regenerated in the service.
+            ESectionPair            pf {};               // EIT p/f sections (0: present, 1: following).
+            ESegmentMap             segments {};         // 3-hour segments (EPG events and EIT schedule sections), by start time.
+            std::map<uint16_t,Time> event_ids {};        // Existing event ids in that service -> start time of their segment.
 
             // Constructor.
             EService() = default;
@@ -498,15 +498,50 @@ namespace ts {
         // The event database is a map of EService, indexed by ServiceIdTriplet. This is
         // a static structure where new events are stored and obsolete events are removed.
         //
-        // The injection lists are organized by repetition profile, in order of profile
-        // priority (from EIT p/f actual to EID sched other/later). In each list, all
+        // The injection queues are organized by repetition profile, in order of profile
+        // priority (from EIT p/f actual to EID sched other/later). In each queue, all
         // sections have the same profile and, consequently, the same repetition rate.
-        // The sections are sorted in order of next injection. When a section is ready
-        // to inject, it is passed to the packetizer and requeued at the end of the list
-        // for the next injection.
+        // The sections are sorted in order of next injection. Sections with the same
+        // injection time are injected in their order of insertion in the queue. When a
+        // section is ready to inject, it is passed to the packetizer and requeued for
+        // the next injection. Each queue is also indexed by service id (table id extension)
+        // to quickly find the next sections of the same sub-table.
+
+        class EInject
+        {
+        public:
+            Time        next_inject {};  // Date of next injection, same as in the section.
+            int64_t     order = 0;       // Order of insertion, for sections with the same injection time.
+            ESectionPtr section {};      // Section to inject.
+
+            // Order of injection.
+            bool operator<(const EInject& other) const
+            {
+                return next_inject != other.next_inject ? next_inject < other.next_inject : order < other.order;
+            }
+        };
+
+        class EInjectQueue
+        {
+            TS_NOCOPY(EInjectQueue);
+        public:
+            std::set<EInject> sections {};                      // All sections, in order of injection.
+            std::map<uint16_t, std::set<EInject>> services {};  // Same sections, indexed by service id.
+
+            // Constructor.
+            EInjectQueue() = default;
+
+            // Insert and remove sections.
+            void insert(const EInject& inj);
+            void erase(const EInject& inj);
+            void clear();
+
+            // Remove all obsolete sections.
+            void removeObsolete();
+        };
 
         using EServiceMap = std::map<ServiceIdTriplet, EService>;
-        using ESectionListArray = std::array<ESectionList, EITRepetitionProfile::PROFILE_COUNT>;
+        using EInjectQueueArray = std::array<EInjectQueue, EITRepetitionProfile::PROFILE_COUNT>;
 
         // ---------------------------
         // EITGenerator private fields
@@ -531,7 +566,10 @@ namespace ts {
         SectionDemux         _demux;                     // Section demux for input stream, get PAT, TDT, TOT, EIT.
         Packetizer           _packetizer;                // Packetizer for generated EIT's.
         EServiceMap          _services {};               // Map of services -> segments -> events and sections.
-        ESectionListArray    _injects {};                // Arrays of sections for injection.
+        EInjectQueueArray    _injects {};                // Queues of sections for injection.
+        int64_t              _inject_back = 0;           // Next insertion order at back of injection queues.
+        int64_t              _inject_front = -1;         // Next insertion order at front of injection queues.
+        Time                 _next_update {};            // Next time at which the EIT database changes with time (Epoch: unknown).
         cn::milliseconds     _section_gap = cn::milliseconds(30);  // Minimum gap between sections of the same tid/tidext, DVB specifies at least 25 ms.
         TID                  _last_tid = TID_NULL;       // TID of last injected section, or 0.
         uint16_t             _last_tidext = 0;           // TIDEXT of last injected section.
@@ -545,6 +583,8 @@ namespace ts {
         // Update the EIT database according to the current time.
         // Obsolete events, sections and segments are discarded.
         // Segments which must be regenerated are marked as such (will be actually regenerated later, when used).
+        // Nothing is done when the time is before _next_update: the EIT database does not depend on the time
+        // until then. Any modification of the database shall reset _next_update to force a full update.
         void updateForNewTime(const Time& now);
 
         // Regenerate, if necessary, EIT p/f in a service. Return true if section is modified.
@@ -562,8 +602,10 @@ namespace ts {
         void markObsoleteSection(ESection& sec);
         void markObsoleteSegment(ESegment& seg);
 
-        // Enqueue a section for injection.
-        void enqueueInjectSection(const ESectionPtr& sec, const Time& next_inject, bool try_front);
+        // Enqueue a section for injection. With front = true, the section is injected before
+        // the other sections with the same injection time. Otherwise, it is injected after them.
+        void enqueueInjectSection(const ESectionPtr& sec, const Time& next_inject, bool front = false);
+        void enqueueInjectSection(EInjectQueue& queue, const ESectionPtr& sec, const Time& next_inject, bool front = false);
 
         // Helper for dumpInternalState()
         void dumpSection(int level, const UString& margin, const ESectionPtr& section) const;
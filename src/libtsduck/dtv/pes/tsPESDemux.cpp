@@ -17,6 +17,11 @@
 #include "tsAccessUnitIterator.h"
 #include "tsAlgorithm.h"
 
+// Maximum size of a PES header: 9-byte fixed part + 255 bytes of header data.
+namespace {
+    constexpr size_t MAX_PES_HEADER_SIZE = 9 + 255;
+}
+
 
 //----------------------------------------------------------------------------
 // Constructors and destructors.
@@ -74,6 +79,12 @@ ts::CodecType ts::PESDemux::getDefaultCodec(PID pid) const
     return it == _pid_types.end() || it->second.default_codec == CodecType::UNDEFINED ? _default_codec : it->second.default_codec;
 }
 
+uint8_t ts::PESDemux::getStreamType(PID pid) const
+{
+    const auto it = _pid_types.find(pid);
+    return it == _pid_types.end() ? uint8_t(ST_NULL) : it->second.stream_type;
+}
+
 
 //----------------------------------------------------------------------------
 // Get current audio/video attributes on the specified PID.
@@ -210,6 +221,7 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
             pc.continuity = pkt.getCC();
             pc.sync = true;
             pc.ts->copy(pl, pl_size);
+            pc.data_size = pl_size;
             pc.first_pkt = _packet_count;
             pc.last_pkt = _packet_count;
             pc.pcr = pkt.getPCR(); // can be invalid
@@ -243,6 +255,12 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
         return;
     }
     pc.continuity = pkt.getCC();
+    pc.data_size += pl_size;
+
+    // In header-only mode, stop accumulating the TS payloads when the PES header is complete.
+    if (_header_only && (pc.ts->size() >= MAX_PES_HEADER_SIZE || PESPacket::HeaderSize(pc.ts->data(), pc.ts->size()) > 0)) {
+        pl_size = 0;
+    }
 
     // Append the TS payload in PID context.
     size_t capacity = pc.ts->capacity();
@@ -353,7 +371,7 @@ void ts::PESDemux::processPESPacketIfComplete(PID pid, PIDContext& pc)
         const size_t len = GetUInt16(pc.ts->data() + 4);
         // If the size is zero, the PES packet is "unbounded", meaning it ends at the next PUSI.
         // But if the PES packet size is specified, check if we have the complete PES packet.
-        if (len != 0 && pc.ts->size() >= 6 + len) {
+        if (len != 0 && pc.data_size >= 6 + len) {
             // We have the complete PES packet.
             processPESPacket(pid, pc);
         }
@@ -374,43 +392,54 @@ void ts::PESDemux::processPESPacket(PID pid, PIDContext& pc)
     // This is used to prevent the destruction of PID contexts during the execution of a handler.
     beforeCallingHandler(pid);
     try {
-        // Build a PES packet object around the TS buffer
-        PESPacket pes(pc.ts, pid);
-
-        if (pes.isValid()) {
-            // Count valid PES packets
-            pc.pes_count++;
-
-            // Location of the PES packet inside the demultiplexed stream
-            pes.setFirstTSPacketIndex(pc.first_pkt);
-            pes.setLastTSPacketIndex(pc.last_pkt);
-            pes.setPCR(pc.pcr);
-
-            // Set stream type and codec if known.
-            const auto it_type = _pid_types.find(pid);
-            if (it_type != _pid_types.end()) {
-                pes.setStreamType(it_type->second.stream_type);
-                pes.setCodec(it_type->second.default_codec);
+        if (_header_only) {
+            // Only the beginning of the PES packet was accumulated, don't check it as a complete PES packet.
+            if (_pes_handler != nullptr) {
+                DemuxedData data(pc.ts, pid);
+                data.setFirstTSPacketIndex(pc.first_pkt);
+                data.setLastTSPacketIndex(pc.last_pkt);
+                _pes_handler->handlePESHeader(*this, data, pc.data_size);
             }
+        }
+        else {
+            // Build a PES packet object around the TS buffer
+            PESPacket pes(pc.ts, pid);
+
+            if (pes.isValid()) {
+                // Count valid PES packets
+                pc.pes_count++;
+
+                // Location of the PES packet inside the demultiplexed stream
+                pes.setFirstTSPacketIndex(pc.first_pkt);
+                pes.setLastTSPacketIndex(pc.last_pkt);
+                pes.setPCR(pc.pcr);
+
+                // Set stream type and codec if known.
+                const auto it_type = _pid_types.find(pid);
+                if (it_type != _pid_types.end()) {
+                    pes.setStreamType(it_type->second.stream_type);
+                    pes.setCodec(it_type->second.default_codec);
+                }
 
-            // Set a default codec if none was set from the PMT and the data look compatible.
-            pes.setDefaultCodec(getDefaultCodec(pid));
+                // Set a default codec if none was set from the PMT and the data look compatible.
+                pes.setDefaultCodec(getDefaultCodec(pid));
 
-            // Handle complete packet (virtual method). This must be executed even if _pes_handler is null
-            // because handlePESPacket() is virtual and can be overridden in a subclass (cf. TeletextDemux).
-            handlePESPacket(pes);
+                // Handle complete packet (virtual method). This must be executed even if _pes_handler is null
+                // because handlePESPacket() is virtual and can be overridden in a subclass (cf. TeletextDemux).
+                handlePESPacket(pes);
 
-            // Analyze audio/video content of the packet and notify all corresponding events.
-            if (_pes_handler != nullptr) {
-                handlePESContent(pc, pes);
+                // Analyze audio/video content of the packet and notify all corresponding events.
+                if (_pes_handler != nullptr) {
+                    handlePESContent(pc, pes);
+                }
+            }
+            else if (_pes_handler != nullptr) {
+                // Handle an invalid PES packet. Prepare raw demuxed data.
+                DemuxedData data(pc.ts, pid);
+                data.setFirstTSPacketIndex(pc.first_pkt);
+                data.setLastTSPacketIndex(pc.last_pkt);
+                _pes_handler->handleInvalidPESPacket(*this, data);
             }
-        }
-        else if (_pes_handler != nullptr) {
-            // Handle an invalid PES packet. Prepare raw demuxed data.
-            DemuxedData data(pc.ts, pid);
-            data.setFirstTSPacketIndex(pc.first_pkt);
-            data.setLastTSPacketIndex(pc.last_pkt);
-            _pes_handler->handleInvalidPESPacket(*this, data);
         }
     }
     catch (...) {
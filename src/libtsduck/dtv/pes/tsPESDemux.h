@@ -75,6 +75,29 @@ namespace ts {
         //!
         void setPESHandler(PESHandlerInterface* h) { _pes_handler = h; }
 
+        //!
+        //! Set the header-only mode.
+        //!
+        //! In header-only mode, the payload of the PES packets is not accumulated. Only the beginning
+        //! of each PES packet is buffered, up to the end of the TS packet which completes the PES header.
+        //! Then, the demux only counts the payload bytes. This is useful when the application needs the
+        //! PES headers only, the memory copies and allocations of large video PES packets are avoided.
+        //!
+        //! In header-only mode, PESHandlerInterface::handlePESHeader() is invoked for each PES packet,
+        //! valid or not. The other handlers, including the protected method handlePESPacket(), are not
+        //! invoked and no audio or video analysis is performed.
+        //!
+        //! @param [in] header_only If true, set the header-only mode. The default mode is off.
+        //!
+        void setHeaderOnly(bool header_only) { _header_only = header_only; }
+
+        //!
+        //! Check if the header-only mode is set.
+        //! @return True if the header-only mode is set.
+        //! @see setHeaderOnly()
+        //!
+        bool headerOnly() const { return _header_only; }
+
         //!
         //! Set the default audio or video codec for all analyzed PES PID's.
         //! The analysis of the content of a PES packet sometimes depends on the PES data format.
@@ -105,6 +128,13 @@ namespace ts {
         //!
         CodecType getDefaultCodec(PID pid) const;
 
+        //!
+        //! Get the stream type of a given PID, as found in the PMT.
+        //! @param [in] pid The PID to check.
+        //! @return The stream type of @a pid or ST_NULL if the PID was not found in a PMT.
+        //!
+        uint8_t getStreamType(PID pid) const;
+
         //!
         //! Get the current audio attributes on the specified PID.
         //! @param [in] pid The PID to check.
@@ -180,6 +210,7 @@ namespace ts {
             PacketCounter        last_pkt = 0;    // Index of last TS packet for current PES packet
             uint64_t             pcr {INVALID_PCR};         // First PCR for current PES packet
             ByteBlockPtr         ts {};          // TS payload buffer
+            size_t               data_size = 0;   // Total TS payload size, can be larger than ts in header-only mode
             MPEG2AudioAttributes audio {};       // Current audio attributes
             MPEG2VideoAttributes video {};       // Current video attributes (MPEG-1, MPEG-2)
             AVCAttributes        avc {};         // Current AVC attributes
@@ -191,7 +222,7 @@ namespace ts {
             PIDContext() : ts(new ByteBlock()) {}
 
             // Called when packet synchronization is lost on the PID.
-            void syncLost() { sync = false; ts->clear(); }
+            void syncLost() { sync = false; ts->clear(); data_size = 0; }
         };
 
         // Map of PID contexts, indexed by PID.
@@ -229,6 +260,7 @@ namespace ts {
 
         // Private members:
         PESHandlerInterface* _pes_handler = nullptr;
+        bool                 _header_only = false;
         CodecType            _default_codec {CodecType::UNDEFINED};
         PIDContextMap        _pids {};
         PIDTypeMap           _pid_types {};
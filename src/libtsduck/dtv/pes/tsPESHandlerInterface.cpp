@@ -12,6 +12,7 @@
 
 void ts::PESHandlerInterface::handlePESPacket(PESDemux&, const PESPacket&) {}
 void ts::PESHandlerInterface::handleInvalidPESPacket(PESDemux&, const DemuxedData&) {}
+void ts::PESHandlerInterface::handlePESHeader(PESDemux&, const DemuxedData&, size_t) {}
 void ts::PESHandlerInterface::handleVideoStartCode(PESDemux&, const PESPacket&, uint8_t, size_t, size_t) {}
 void ts::PESHandlerInterface::handleNewMPEG2VideoAttributes(PESDemux&, const PESPacket&, const MPEG2VideoAttributes&) {}
 void ts::PESHandlerInterface::handleAccessUnit(PESDemux&, const PESPacket&, uint8_t, size_t, size_t) {}
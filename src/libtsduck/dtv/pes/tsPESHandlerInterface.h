@@ -49,6 +49,16 @@ namespace ts {
         //!
         virtual void handleInvalidPESPacket(PESDemux& demux, const DemuxedData& data);
 
+        //!
+        //! This hook is invoked in header-only mode when a PES packet is complete, valid or not.
+        //! @param [in,out] demux A reference to the PES demux.
+        //! @param [in] data Beginning of the elementary stream data between two PUSI, up to the end of the
+        //! TS packet where the PES header is complete. This is typically the PES header and the start of its payload.
+        //! @param [in] data_size Total size in bytes of the elementary stream data, larger than or equal to @a data.size().
+        //! @see PESDemux::setHeaderOnly()
+        //!
+        virtual void handlePESHeader(PESDemux& demux, const DemuxedData& data, size_t data_size);
+
         //!
         //! This hook is invoked when a video start code is encountered.
         //! @param [in,out] demux A reference to the PES demux.
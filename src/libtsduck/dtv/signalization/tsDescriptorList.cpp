@@ -25,13 +25,17 @@ ts::DescriptorList::DescriptorList(const AbstractTable* table) :
 
 ts::DescriptorList::DescriptorList(const AbstractTable* table, const DescriptorList& dl) :
     AbstractTableAttachment(table),
-    _list(dl._list)
+    _list(dl._list),
+    _lazy_data(dl._lazy_data),
+    _lazy_offsets(dl._lazy_offsets)
 {
 }
 
 ts::DescriptorList::DescriptorList(const AbstractTable* table, DescriptorList&& dl) noexcept :
     AbstractTableAttachment(table),
-    _list(std::move(dl._list))
+    _list(std::move(dl._list)),
+    _lazy_data(std::move(dl._lazy_data)),
+    _lazy_offsets(std::move(dl._lazy_offsets))
 {
 }
 
@@ -40,6 +44,8 @@ ts::DescriptorList& ts::DescriptorList::operator=(const DescriptorList& dl)
     if (&dl != this) {
         // Copy the list of descriptors but preserve the parent table.
         _list = dl._list;
+        _lazy_data = dl._lazy_data;
+        _lazy_offsets = dl._lazy_offsets;
     }
     return *this;
 }
@@ -49,10 +55,69 @@ ts::DescriptorList& ts::DescriptorList::operator=(DescriptorList&& dl) noexcept
     if (&dl != this) {
         // Move the list of descriptors but preserve the parent table.
         _list = std::move(dl._list);
+        _lazy_data = std::move(dl._lazy_data);
+        _lazy_offsets = std::move(dl._lazy_offsets);
     }
     return *this;
 }
 
+void ts::DescriptorList::clear()
+{
+    _list.clear();
+    _lazy_data.reset();
+    _lazy_offsets.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Access to lazily added descriptors.
+//----------------------------------------------------------------------------
+
+const ts::DescriptorPtr& ts::DescriptorList::descriptorAt(size_t index) const
+{
+    assert(index < _list.size());
+    if (_list[index] == nullptr && !_lazy_offsets.empty()) {
+        // Build the descriptor on first access.
+        const uint8_t* data = _lazy_data->data() + _lazy_offsets[index];
+        _list[index] = std::make_shared<Descriptor>(data, size_t(data[1]) + 2);
+    }
+    return _list[index];
+}
+
+const uint8_t* ts::DescriptorList::rawContent(size_t index) const
+{
+    assert(index < _list.size());
+    if (_list[index] != nullptr) {
+        return _list[index]->isValid() ? _list[index]->content() : nullptr;
+    }
+    else if (!_lazy_offsets.empty()) {
+        return _lazy_data->data() + _lazy_offsets[index];
+    }
+    else {
+        return nullptr;
+    }
+}
+
+size_t ts::DescriptorList::rawSize(size_t index) const
+{
+    const uint8_t* data = rawContent(index);
+    return data == nullptr ? 0 : size_t(data[1]) + 2;
+}
+
+ts::DID ts::DescriptorList::rawTag(size_t index) const
+{
+    const uint8_t* data = rawContent(index);
+    return data == nullptr ? 0 : data[0];
+}
+
+void ts::DescriptorList::erase(size_t index)
+{
+    _list.erase(_list.begin() + index);
+    if (!_lazy_offsets.empty()) {
+        _lazy_offsets.erase(_lazy_offsets.begin() + index);
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Comparison
@@ -64,9 +129,10 @@ bool ts::DescriptorList::operator==(const DescriptorList& other) const
         return false;
     }
     for (size_t i = 0; i < _list.size(); ++i) {
-        const DescriptorPtr& desc1(_list[i]);
-        const DescriptorPtr& desc2(other._list[i]);
-        if (desc1 == nullptr || desc2 == nullptr || *desc1 != *desc2) {
+        // Compare binary contents, without building lazily added descriptors.
+        const uint8_t* desc1 = rawContent(i);
+        const uint8_t* desc2 = other.rawContent(i);
+        if (desc1 == nullptr || desc2 == nullptr || desc1[1] != desc2[1] || !MemEqual(desc1, desc2, size_t(desc1[1]) + 2)) {
             return false;
         }
     }
@@ -85,19 +151,16 @@ bool ts::DescriptorList::add(const DescriptorPtr& desc)
     }
     else {
         _list.push_back(desc);
+        if (!_lazy_offsets.empty()) {
+            _lazy_offsets.push_back(0);
+        }
         return true;
     }
 }
 
 bool ts::DescriptorList::add(const Descriptor& desc)
 {
-    if (!desc.isValid()) {
-        return false;
-    }
-    else {
-        _list.push_back(std::make_shared<Descriptor>(desc.content(), desc.size()));
-        return true;
-    }
+    return desc.isValid() && add(std::make_shared<Descriptor>(desc.content(), desc.size()));
 }
 
 bool ts::DescriptorList::add(DuckContext& duck, const AbstractDescriptor& desc)
@@ -136,6 +199,74 @@ bool ts::DescriptorList::add(const void* addr)
     return data != nullptr && add(data, size_t(data[1]) + 2);
 }
 
+bool ts::DescriptorList::addLazy(const void* data, size_t size)
+{
+    if (data == nullptr) {
+        return false;
+    }
+
+    // Compute the size of the valid descriptors and their count.
+    const uint8_t* const base = reinterpret_cast<const uint8_t*>(data);
+    size_t valid_size = 0;
+    size_t desc_count = 0;
+    size_t length = 0;
+    while (valid_size + 2 <= size && valid_size + (length = size_t(base[valid_size + 1]) + 2) <= size) {
+        valid_size += length;
+        desc_count++;
+    }
+
+    if (desc_count > 0) {
+        // Copy the binary descriptors in the shared data block, copy on write.
+        if (_lazy_data == nullptr) {
+            _lazy_data = std::make_shared<ByteBlock>();
+        }
+        else if (_lazy_data.use_count() > 1) {
+            _lazy_data = std::make_shared<ByteBlock>(*_lazy_data);
+        }
+        const size_t start = _lazy_data->size();
+        _lazy_data->append(base, valid_size);
+
+        // Placeholders for the descriptor objects, built on demand.
+        _lazy_offsets.resize(_list.size(), 0);
+        _list.resize(_list.size() + desc_count);
+        _lazy_offsets.reserve(_list.size());
+        for (size_t offset = 0; offset < valid_size; offset += size_t(base[offset + 1]) + 2) {
+            _lazy_offsets.push_back(start + offset);
+        }
+        assert(_lazy_offsets.size() == _list.size());
+    }
+
+    return valid_size == size;
+}
+
+
+//----------------------------------------------------------------------------
+// Add another list of descriptors at end of list.
+//----------------------------------------------------------------------------
+
+void ts::DescriptorList::add(const DescriptorList& dl)
+{
+    if (&dl == this) {
+        // Descriptors are duplicated in the same list.
+        const size_t count = _list.size();
+        for (size_t index = 0; index < count; ++index) {
+            const DescriptorPtr desc(descriptorAt(index));
+            add(desc);
+        }
+    }
+    else if (_list.empty() && !dl._lazy_offsets.empty()) {
+        // Share the lazily added descriptors of the other list.
+        _list = dl._list;
+        _lazy_data = dl._lazy_data;
+        _lazy_offsets = dl._lazy_offsets;
+    }
+    else {
+        for (size_t index = 0; index < dl._list.size(); ++index) {
+            add(dl.descriptorAt(index));
+        }
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Merge one descriptor in the list.
@@ -171,7 +302,7 @@ bool ts::DescriptorList::merge(DuckContext& duck, const AbstractDescriptor& desc
                 case DescriptorDuplication::MERGE: {
                     // New descriptor shall be merged into old one.
                     // We need to deserialize the previous descriptor first.
-                    const AbstractDescriptorPtr dp(_list[index]->deserialize(duck, edid));
+                    const AbstractDescriptorPtr dp(descriptorAt(index)->deserialize(duck, edid));
                     if (dp != nullptr && dp->merge(desc)) {
                         // Descriptor successfully merged. Reserialize it and replace it.
                         DescriptorPtr newdesc = std::make_shared<Descriptor>();
@@ -186,7 +317,7 @@ bool ts::DescriptorList::merge(DuckContext& duck, const AbstractDescriptor& desc
                 }
                 case DescriptorDuplication::ADD_OTHER: {
                     // In case the two binary descriptors are exactly identical, do nothing.
-                    if (*_list[index] == *bindesc) {
+                    if (*descriptorAt(index) == *bindesc) {
                         return true;
                     }
                     break;
@@ -219,7 +350,7 @@ void ts::DescriptorList::merge(DuckContext& duck, const DescriptorList& other)
     if (&other != this) {
         // Loop on all descriptors of the other list.
         for (size_t index = 0; index < other._list.size(); ++index) {
-            const auto& bindesc(other._list[index]);
+            const auto& bindesc(other.descriptorAt(index));
             assert(bindesc != nullptr);
             if (bindesc->isValid()) {
                 // The descriptor from the other list must be deserialized to be merged.
@@ -246,16 +377,16 @@ void ts::DescriptorList::merge(DuckContext& duck, const DescriptorList& other)
 
 ts::Descriptor& ts::DescriptorList::operator[](size_t index)
 {
-    assert(index < _list.size());
-    assert(_list[index] != nullptr);
-    return *_list[index];
+    const DescriptorPtr& desc(descriptorAt(index));
+    assert(desc != nullptr);
+    return *desc;
 }
 
 const ts::Descriptor& ts::DescriptorList::operator[](size_t index) const
 {
-    assert(index < _list.size());
-    assert(_list[index] != nullptr);
-    return *_list[index];
+    const DescriptorPtr& desc(descriptorAt(index));
+    assert(desc != nullptr);
+    return *desc;
 }
 
 
@@ -266,12 +397,12 @@ const ts::Descriptor& ts::DescriptorList::operator[](size_t index) const
 ts::EDID ts::DescriptorList::edid(const DuckContext& duck, size_t index) const
 {
     // Eliminate invalid descriptor, index out of range.
-    if (index >= _list.size() || _list[index] == nullptr || !_list[index]->isValid()) {
+    if (index >= _list.size() || rawContent(index) == nullptr) {
         return EDID(); // invalid value
     }
     else {
         DescriptorContext context(duck, *this, index);
-        return PSIRepository::Instance().getDescriptor(_list[index]->xdid(), context).edid;
+        return PSIRepository::Instance().getDescriptor(descriptorAt(index)->xdid(), context).edid;
     }
 }
 
@@ -282,9 +413,9 @@ ts::EDID ts::DescriptorList::edid(const DuckContext& duck, size_t index) const
 
 bool ts::DescriptorList::containsRegistration(REGID regid) const
 {
-    for (const auto& dp : _list) {
-        assert(dp != nullptr);
-        if (dp->isValid() && dp->tag() == DID_MPEG_REGISTRATION && dp->payloadSize() >= 4 && GetUInt32(dp->payload()) == regid) {
+    for (size_t index = 0; index < _list.size(); ++index) {
+        const uint8_t* desc = rawContent(index);
+        if (desc != nullptr && desc[0] == DID_MPEG_REGISTRATION && desc[1] >= 4 && GetUInt32(desc + 2) == regid) {
             return true;
         }
     }
@@ -304,10 +435,10 @@ void ts::DescriptorList::getAllRegistrations(const DuckContext& duck, REGIDVecto
     duck.updateREGIDs(regids);
 
     // Then add registration ids from the descriptor list.
-    for (const auto& dp : _list) {
-        assert(dp != nullptr);
-        if (dp->isValid() && dp->tag() == DID_MPEG_REGISTRATION && dp->payloadSize() >= 4) {
-            regids.push_back(GetUInt32(dp->payload()));
+    for (size_t index = 0; index < _list.size(); ++index) {
+        const uint8_t* desc = rawContent(index);
+        if (desc != nullptr && desc[0] == DID_MPEG_REGISTRATION && desc[1] >= 4) {
+            regids.push_back(GetUInt32(desc + 2));
         }
     }
 }
@@ -317,17 +448,17 @@ void ts::DescriptorList::getAllRegistrations(const DuckContext& duck, REGIDVecto
 // Update a REGID or PDS value if the descriptor is the right descriptor.
 //----------------------------------------------------------------------------
 
-void ts::DescriptorList::UpdateREGID(REGID& regid, const DescriptorPtr& desc)
+void ts::DescriptorList::UpdateREGID(REGID& regid, const uint8_t* desc)
 {
-    if (desc != nullptr && desc->isValid() && desc->tag() == DID_MPEG_REGISTRATION && desc->payloadSize() >= 4) {
-        regid = GetUInt32(desc->payload());
+    if (desc != nullptr && desc[0] == DID_MPEG_REGISTRATION && desc[1] >= 4) {
+        regid = GetUInt32(desc + 2);
     }
 }
 
-void ts::DescriptorList::UpdatePDS(PDS& pds, const DescriptorPtr& desc)
+void ts::DescriptorList::UpdatePDS(PDS& pds, const uint8_t* desc)
 {
-    if (desc != nullptr && desc->isValid() && desc->tag() == DID_DVB_PRIV_DATA_SPECIF && desc->payloadSize() >= 4) {
-        pds = GetUInt32(desc->payload());
+    if (desc != nullptr && desc[0] == DID_DVB_PRIV_DATA_SPECIF && desc[1] >= 4) {
+        pds = GetUInt32(desc + 2);
     }
 }
 
@@ -343,14 +474,14 @@ ts::REGID ts::DescriptorList::registrationId(size_t index) const
 
     // Loop on current descriptor list and top-level descriptor list for REGID.
     while (index-- > 0 && regid == REGID_NULL) {
-        UpdateREGID(regid, _list[index]);
+        UpdateREGID(regid, rawContent(index));
     }
     if (regid == REGID_NULL && hasTable()) {
         const DescriptorList* dlist = table()->topLevelDescriptorList();
         if (dlist != nullptr && dlist != this) {
             index = dlist->_list.size();
             while (index-- > 0 && regid == REGID_NULL) {
-                UpdateREGID(regid, dlist->_list[index]);
+                UpdateREGID(regid, dlist->rawContent(index));
             }
         }
     }
@@ -367,7 +498,7 @@ ts::PDS ts::DescriptorList::privateDataSpecifier(size_t index) const
     PDS pds = PDS_NULL;
     index = std::min(index, _list.size());
     while (index-- > 0 && pds == PDS_NULL) {
-        UpdatePDS(pds, _list[index]);
+        UpdatePDS(pds, rawContent(index));
     }
     return pds;
 }
@@ -377,18 +508,16 @@ ts::PDS ts::DescriptorList::privateDataSpecifier(size_t index) const
 // Prepare removal of a private_data_specifier descriptor.
 //----------------------------------------------------------------------------
 
-bool ts::DescriptorList::canRemovePDS(std::vector<DescriptorPtr>::iterator it)
+bool ts::DescriptorList::canRemovePDS(size_t index) const
 {
     // Eliminate invalid cases
-    if (it == _list.end() || *it == nullptr || (*it)->tag() != DID_DVB_PRIV_DATA_SPECIF) {
+    if (index >= _list.size() || rawTag(index) != DID_DVB_PRIV_DATA_SPECIF) {
         return false;
     }
 
     // Search for private descriptors ahead.
-    decltype(it) end;
-    for (end = it + 1; end != _list.end(); ++end) {
-        assert(*end != nullptr);
-        const DID tag = (*end)->tag();
+    for (size_t end = index + 1; end < _list.size(); ++end) {
+        const DID tag = rawTag(end);
         if (tag >= 0x80) {
             // This is a private descriptor, the private_data_specifier descriptor is necessary and cannot be removed.
             return false;
@@ -452,25 +581,25 @@ size_t ts::DescriptorList::removeInvalidPrivateDescriptors()
     size_t count = 0;
     PDS pds = 0;
 
-    for (auto it = _list.begin(); it != _list.end(); ) {
-        assert(*it != nullptr);
-        if (!(*it)->isValid()) {
+    for (size_t index = 0; index < _list.size(); ) {
+        const uint8_t* desc = rawContent(index);
+        if (desc == nullptr) {
             // Invalid descriptor, remove it.
-            it = _list.erase(it);
+            erase(index);
             count++;
         }
-        else if ((*it)->tag() == DID_DVB_PRIV_DATA_SPECIF) {
+        else if (desc[0] == DID_DVB_PRIV_DATA_SPECIF) {
             // Got a private data specifier descriptor.
-            UpdatePDS(pds, *it);
-            ++it;
+            UpdatePDS(pds, desc);
+            ++index;
         }
-        else if ((pds == 0 || pds == PDS_NULL) && (*it)->tag() >= 0x80) {
+        else if ((pds == 0 || pds == PDS_NULL) && desc[0] >= 0x80) {
             // Private descriptor without preceding PDS, remove it.
-            it = _list.erase(it);
+            erase(index);
             count++;
         }
         else {
-            ++it;
+            ++index;
         }
     }
 
@@ -490,13 +619,12 @@ bool ts::DescriptorList::removeByIndex(size_t index)
     }
 
     // Private_data_specifier descriptor can be removed under certain conditions only
-    assert(_list[index] != nullptr);
-    if (_list[index]->tag() == DID_DVB_PRIV_DATA_SPECIF && !canRemovePDS(_list.begin() + index)) {
+    if (rawTag(index) == DID_DVB_PRIV_DATA_SPECIF && !canRemovePDS(index)) {
         return false;
     }
 
     // Remove the specified descriptor
-    _list.erase(_list.begin() + index);
+    erase(index);
     return true;
 }
 
@@ -511,18 +639,17 @@ size_t ts::DescriptorList::removeByTag(DID tag, PDS pds)
     PDS current_pds = 0;
     size_t removed_count = 0;
 
-    for (auto it = _list.begin(); it != _list.end(); ) {
-        assert(*it != nullptr);
-        const DID itag = (*it)->tag();
-        if (itag == tag && (!check_pds || current_pds == pds) && (itag != DID_DVB_PRIV_DATA_SPECIF || canRemovePDS(it))) {
-            it = _list.erase(it);
+    for (size_t index = 0; index < _list.size(); ) {
+        const DID itag = rawTag(index);
+        if (itag == tag && (!check_pds || current_pds == pds) && (itag != DID_DVB_PRIV_DATA_SPECIF || canRemovePDS(index))) {
+            erase(index);
             ++removed_count;
         }
         else {
             if (check_pds) {
-                UpdatePDS(current_pds, *it);
+                UpdatePDS(current_pds, rawContent(index));
             }
-            ++it;
+            ++index;
         }
     }
 
@@ -541,7 +668,7 @@ size_t ts::DescriptorList::binarySize(size_t start, size_t count) const
     size_t size = 0;
 
     for (size_t i = start; i < start + count; ++i) {
-        size += _list[i]->size();
+        size += rawSize(i);
     }
 
     return size;
@@ -556,10 +683,11 @@ size_t ts::DescriptorList::serialize(uint8_t*& addr, size_t& size, size_t start)
 {
     size_t i;
 
-    for (i = start; i < _list.size() && _list[i]->size() <= size; ++i) {
-        MemCopy(addr, _list[i]->content(), _list[i]->size());
-        addr += _list[i]->size();
-        size -= _list[i]->size();
+    for (i = start; i < _list.size() && rawSize(i) <= size; ++i) {
+        const size_t dsize = rawSize(i);
+        MemCopy(addr, rawContent(i), dsize);
+        addr += dsize;
+        size -= dsize;
     }
 
     return i;
@@ -624,9 +752,9 @@ size_t ts::DescriptorList::search(DID tag, size_t start_index, PDS pds) const
     PDS current_pds = check_pds ? privateDataSpecifier(start_index) : PDS_NULL;
     size_t index = start_index;
 
-    while (index < _list.size() && (_list[index] == nullptr || _list[index]->tag() != tag || (check_pds && current_pds != pds))) {
+    while (index < _list.size() && (rawTag(index) != tag || (check_pds && current_pds != pds))) {
         if (check_pds) {
-            UpdatePDS(current_pds, _list[index]);
+            UpdatePDS(current_pds, rawContent(index));
         }
         index++;
     }
@@ -657,15 +785,15 @@ size_t ts::DescriptorList::search(const ts::EDID& edid, size_t start_index) cons
 
     // Now search in the list.
     for (size_t index = start_index; index < _list.size(); ++index) {
-        UpdateREGID(regid, _list[index]);
-        UpdatePDS(pds, _list[index]);
+        const uint8_t* desc = rawContent(index);
+        UpdateREGID(regid, desc);
+        UpdatePDS(pds, desc);
         // First, filter on descriptor id (no need to search more if does not match).
-        assert(_list[index] != nullptr);
-        if (_list[index]->isValid() && _list[index]->tag() == did) {
+        if (desc != nullptr && desc[0] == did) {
             // Now, it's worth having a look.
             if (edid.isRegular() ||
                 edid.isTableSpecific() ||
-                (edid.isExtension() && _list[index]->xdid() == xdid) ||
+                (edid.isExtension() && descriptorAt(index)->xdid() == xdid) ||
                 (edid.isPrivateMPEG() && edid.regid() == regid) ||
                 (edid.isPrivateDVB() && edid.pds() == pds))
             {
@@ -695,13 +823,12 @@ void ts::DescriptorList::browseLanguages(const DuckContext& duck, size_t start_i
     // Seach all known types of descriptors containing languages.
     bool more = true;
     for (size_t index = start_index; more && index < _list.size(); index++) {
-        const DescriptorPtr& desc(_list[index]);
-        assert(desc != nullptr);
-        if (desc->isValid()) {
+        const uint8_t* desc = rawContent(index);
+        if (desc != nullptr) {
 
-            const DID tag = desc->tag();
-            const char* data = reinterpret_cast<const char*>(desc->payload());
-            size_t size = desc->payloadSize();
+            const DID tag = desc[0];
+            const char* data = reinterpret_cast<const char*>(desc + 2);
+            size_t size = desc[1];
 
             if (tag == DID_MPEG_LANGUAGE) {
                 while (more && size >= 4) {
@@ -831,13 +958,12 @@ size_t ts::DescriptorList::searchSubtitle(const DuckContext& duck, const UString
 
     // Seach all known types of descriptors containing subtitles.
     for (size_t index = start_index; index < _list.size(); index++) {
-        const DescriptorPtr& desc(_list[index]);
-        assert(desc != nullptr);
-        if (desc->isValid()) {
+        const uint8_t* desc = rawContent(index);
+        if (desc != nullptr) {
 
-            const DID tag = desc->tag();
-            const uint8_t* data = desc->payload();
-            size_t size = desc->payloadSize();
+            const DID tag = desc[0];
+            const uint8_t* data = desc + 2;
+            size_t size = desc[1];
 
             if (dvb && tag == DID_DVB_SUBTITLING) {
                 // DVB Subtitling Descriptor, always contain subtitles
@@ -894,8 +1020,9 @@ bool ts::DescriptorList::toXML(DuckContext& duck, xml::Element* parent) const
     bool success = true;
     for (size_t index = 0; index < _list.size(); ++index) {
         DescriptorContext context(duck, *this, index);
-        assert(_list[index] != nullptr);
-        if (_list[index]->toXML(duck, parent, context, false) == nullptr) {
+        const DescriptorPtr& desc(descriptorAt(index));
+        assert(desc != nullptr);
+        if (desc->toXML(duck, parent, context, false) == nullptr) {
             success = false;
         }
     }
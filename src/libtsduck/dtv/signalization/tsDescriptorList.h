@@ -27,6 +27,14 @@ namespace ts {
     //! List of MPEG PSI/SI descriptors.
     //! @ingroup libtsduck mpeg
     //!
+    //! Descriptors which are added using addLazy() are kept in one binary block and Descriptor
+    //! objects are individually built only when they are accessed. This is used when tables are
+    //! deserialized with DuckContext::lazyDescriptors() set, in applications which usually access
+    //! a few descriptors only. Searching, comparing or serializing a descriptor list directly uses
+    //! the binary block. As a consequence, accessing descriptors in a const list may modify its
+    //! internal state. Concurrent accesses to the same const list from several threads must be
+    //! synchronized. Lists without lazily added descriptors have no such restriction.
+    //!
     class TSDUCKDLL DescriptorList : public AbstractTableAttachment
     {
         TS_NO_DEFAULT_CONSTRUCTORS(DescriptorList);
@@ -122,19 +130,20 @@ namespace ts {
         //! An iterator over binary descriptors in the list.
         //! Dereferencing an iterator accesses a Descriptor instance.
         //!
-        class TSDUCKDLL iterator : private std::vector<DescriptorPtr>::iterator
+        class TSDUCKDLL iterator
         {
         private:
-            using SuperClass = std::vector<DescriptorPtr>::iterator;
             friend class DescriptorList;
-            iterator(const SuperClass& up) : SuperClass(up) {}
+            DescriptorList* _dlist = nullptr;
+            size_t _index = 0;
+            iterator(DescriptorList* dlist, size_t index) : _dlist(dlist), _index(index) {}
         public:
             //! @cond nodoxygen
-            iterator& operator--() { --*static_cast<SuperClass*>(this); return *this; }
-            iterator& operator++() { ++*static_cast<SuperClass*>(this); return *this; }
-            Descriptor& operator*() { return **static_cast<SuperClass>(*this); }
-            Descriptor* operator->() { return &**static_cast<SuperClass>(*this); }
-            bool operator==(const iterator& other) const { return static_cast<SuperClass>(*this) == static_cast<SuperClass>(other); }
+            iterator& operator--() { --_index; return *this; }
+            iterator& operator++() { ++_index; return *this; }
+            Descriptor& operator*() { return (*_dlist)[_index]; }
+            Descriptor* operator->() { return &(*_dlist)[_index]; }
+            bool operator==(const iterator& other) const { return _dlist == other._dlist && _index == other._index; }
             //! @endcond
         };
 
@@ -142,19 +151,20 @@ namespace ts {
         //! A constant iterator over binary descriptors in the list.
         //! Dereferencing an iterator accesses a constant Descriptor instance.
         //!
-        class TSDUCKDLL const_iterator : private std::vector<DescriptorPtr>::const_iterator
+        class TSDUCKDLL const_iterator
         {
         private:
-            using SuperClass = std::vector<DescriptorPtr>::const_iterator;
             friend class DescriptorList;
-            const_iterator(const SuperClass& up) : SuperClass(up) {}
+            const DescriptorList* _dlist = nullptr;
+            size_t _index = 0;
+            const_iterator(const DescriptorList* dlist, size_t index) : _dlist(dlist), _index(index) {}
         public:
             //! @cond nodoxygen
-            const_iterator& operator--() { --*static_cast<SuperClass*>(this); return *this; }
-            const_iterator& operator++() { ++*static_cast<SuperClass*>(this); return *this; }
-            const Descriptor& operator*() { return **static_cast<SuperClass>(*this); }
-            const Descriptor* operator->() { return &**static_cast<SuperClass>(*this); }
-            bool operator==(const const_iterator& other) const { return static_cast<SuperClass>(*this) == static_cast<SuperClass>(other); }
+            const_iterator& operator--() { --_index; return *this; }
+            const_iterator& operator++() { ++_index; return *this; }
+            const Descriptor& operator*() { return (*_dlist)[_index]; }
+            const Descriptor* operator->() { return &(*_dlist)[_index]; }
+            bool operator==(const const_iterator& other) const { return _dlist == other._dlist && _index == other._index; }
             //! @endcond
         };
 
@@ -162,25 +172,25 @@ namespace ts {
         //! Get an iterator to the first descriptor in the list.
         //! @return An iterator to the first descriptor in the list.
         //!
-        iterator begin() { return static_cast<iterator>(_list.begin()); }
+        iterator begin() { return iterator(this, 0); }
 
         //!
         //! Get an iterator after the last descriptor in the list.
         //! @return An iterator after the last descriptor in the list.
         //!
-        iterator end() { return static_cast<iterator>(_list.end()); }
+        iterator end() { return iterator(this, _list.size()); }
 
         //!
         //! Get a constant iterator to the first descriptor in the list.
         //! @return A constant iterator to the first descriptor in the list.
         //!
-        const_iterator begin() const { return static_cast<const_iterator>(_list.begin()); }
+        const_iterator begin() const { return const_iterator(this, 0); }
 
         //!
         //! Get a constant iterator after the last descriptor in the list.
         //! @return A constant iterator after the last descriptor in the list.
         //!
-        const_iterator end() const { return static_cast<const_iterator>(_list.end()); }
+        const_iterator end() const { return const_iterator(this, _list.size()); }
 
         //!
         //! Get the extended descriptor id of a descriptor in the list.
@@ -233,10 +243,7 @@ namespace ts {
         //! The descriptors objects are shared between the two lists.
         //! @param [in] dl The descriptor list to add.
         //!
-        void add(const DescriptorList& dl)
-        {
-            _list.insert(_list.end(), dl._list.begin(), dl._list.end());
-        }
+        void add(const DescriptorList& dl);
 
         //!
         //! Add descriptors from a memory area at end of list
@@ -254,6 +261,16 @@ namespace ts {
         //!
         bool add(const void* addr);
 
+        //!
+        //! Add descriptors from a memory area at end of list, without building Descriptor objects.
+        //! The binary content of the descriptors is copied and the corresponding Descriptor objects
+        //! are built later, only when they are accessed.
+        //! @param [in] addr Address of descriptors in memory.
+        //! @param [in] size Size in bytes of descriptors in memory.
+        //! @return True in case of success, false in case of invalid or truncated descriptor.
+        //!
+        bool addLazy(const void* addr, size_t size);
+
         //!
         //! Add a MPEG registration_descriptor if necessary at end of list.
         //! If the current registration at end of list is not @a regid,
@@ -354,7 +371,7 @@ namespace ts {
         //!
         //! Clear the content of the descriptor list.
         //!
-        void clear() { _list.clear(); }
+        void clear();
 
         //!
         //! Search a descriptor with the specified tag.
@@ -509,19 +526,41 @@ namespace ts {
         bool fromXML(DuckContext& duck, const xml::Element* parent);
 
     private:
-        // Vector of safe pointers to descriptors.
-        std::vector<DescriptorPtr> _list {};
+        // Vector of safe pointers to descriptors. Descriptors which were added by addLazy()
+        // and not yet accessed are null pointers, built on demand by descriptorAt().
+        mutable std::vector<DescriptorPtr> _list {};
+
+        // Binary content of descriptors which were added by addLazy(), shared between copies of the list.
+        // When not empty, _lazy_offsets has the same size as _list and contains the offsets of all
+        // descriptors in _lazy_data (meaningless for descriptors which are not null in _list).
+        ByteBlockPtr _lazy_data {};
+        std::vector<size_t> _lazy_offsets {};
+
+        // Get the descriptor at the specified index, build it if it was lazily added.
+        const DescriptorPtr& descriptorAt(size_t index) const;
+
+        // Get the binary content and size of the descriptor at the specified index, without building it.
+        // Return a null pointer and a zero size if the descriptor is invalid.
+        const uint8_t* rawContent(size_t index) const;
+        size_t rawSize(size_t index) const;
+
+        // Get the tag of the descriptor at the specified index, without building it (zero if invalid).
+        DID rawTag(size_t index) const;
+
+        // Remove the descriptor at the specified index (no check).
+        void erase(size_t index);
 
         // Add a descriptor with a 32-bit payload at end of list.
         void add32BitDescriptor(DID did, uint32_t payload);
 
         // Update a REGID or PDS value if the descriptor contains one.
-        static void UpdateREGID(REGID& regid, const DescriptorPtr& desc);
-        static void UpdatePDS(PDS& pds, const DescriptorPtr& desc);
+        // The descriptor is given by its binary content (can be null).
+        static void UpdateREGID(REGID& regid, const uint8_t* desc);
+        static void UpdatePDS(PDS& pds, const uint8_t* desc);
 
         // Prepare removal of a private_data_specifier descriptor at the specified position, it any.
         // Return true if can be removed, false if it cannot (private descriptors ahead).
-        bool canRemovePDS(std::vector<DescriptorPtr>::iterator);
+        bool canRemovePDS(size_t index) const;
 
         // Explore the descriptor and invoke a callback for each language which is found.
         // Use: bool callback(size_t descriptor_index, const char* lang, size_t lang_size)
@@ -542,7 +581,7 @@ size_t ts::DescriptorList::search(DuckContext& duck, DID tag, DESC& desc, size_t
 {
     // Repeatedly search for a descriptor until one is successfully deserialized
     for (size_t index = search(tag, start_index, pds); index < _list.size(); index = search(tag, index + 1, pds)) {
-        if (_list[index] != nullptr) {
+        if (descriptorAt(index) != nullptr) {
             desc.deserialize(duck, *(_list[index]));
             if (desc.isValid()) {
                 return index;
@@ -419,8 +419,8 @@ bool ts::PSIBuffer::getDescriptorList(DescriptorList& descs, size_t length)
         return false;
     }
 
-    // Read descriptors.
-    const bool ok = descs.add(currentReadAddress(), length);
+    // Read descriptors. With lazy descriptors, descriptor objects are built only when accessed.
+    const bool ok = _duck.lazyDescriptors() ? descs.addLazy(currentReadAddress(), length) : descs.add(currentReadAddress(), length);
     skipBytes(length);
 
     if (!ok) {
@@ -440,9 +440,9 @@ bool ts::PSIBuffer::getDescriptorListWithLength(DescriptorList& descs, size_t le
     const size_t length = getUnalignedLength(length_bits);
     bool ok = !readError();
 
-    // Read descriptors.
+    // Read descriptors. With lazy descriptors, descriptor objects are built only when accessed.
     if (ok) {
-        ok = descs.add(currentReadAddress(), length);
+        ok = _duck.lazyDescriptors() ? descs.addLazy(currentReadAddress(), length) : descs.add(currentReadAddress(), length);
         skipBytes(length);
     }
 
@@ -418,6 +418,7 @@ namespace ts {
 
         //!
         //! Get (deserialize) a descriptor list.
+        //! The descriptors are lazily added when DuckContext::lazyDescriptors() is set, see DescriptorList::addLazy().
         //! @param [in,out] descs The descriptor list into which the deserialized descriptors are appended.
         //! @param [in] length Number of bytes to read. If NPOS is specified (the default), read the rest of the buffer.
         //! @return True on success, false on error (truncated, misaligned, etc.)
@@ -403,6 +403,22 @@ namespace ts {
         //!
         bool useLeapSeconds() const  { return _useLeapSeconds; }
 
+        //!
+        //! Set the lazy deserialization of the descriptor lists in tables.
+        //! When set, the descriptors of the deserialized tables are kept in binary form and the Descriptor
+        //! objects are built only when they are accessed, see DescriptorList::addLazy(). This is faster when
+        //! the application uses a few descriptors only. However, the descriptor lists of these tables must not
+        //! be concurrently accessed from several threads without synchronization. This is disabled by default.
+        //! @param [in] on True to use lazy deserialization of descriptor lists, false to build all descriptors.
+        //!
+        void setLazyDescriptors(bool on) { _lazyDescriptors = on; }
+
+        //!
+        //! Check the lazy deserialization of the descriptor lists in tables.
+        //! @return True if descriptor lists are lazily deserialized.
+        //!
+        bool lazyDescriptors() const { return _lazyDescriptors; }
+
         //!
         //! Define character set command line options in an Args.
         //! Defined options: @c -\-default-charset, @c -\-europe.
@@ -503,6 +519,7 @@ namespace ts {
         PDS                _defaultPDS = 0;                  // Default PDS value if undefined.
         REGIDVector        _defaultREGIDs {};                // Default registration id to initially set.
         bool               _useLeapSeconds = true;           // Explicit use of leap seconds.
+        bool               _lazyDescriptors = false;         // Lazy deserialization of descriptor lists.
         Standards          _cmdStandards = Standards::NONE;  // Forced standards from the command line.
         Standards          _accStandards = Standards::NONE;  // Accumulated list of standards in the context.
         UString            _hfDefaultRegion {};              // Default region for UHF/VHF band.
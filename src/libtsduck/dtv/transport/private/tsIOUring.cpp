@@ -0,0 +1,243 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsIOUring.h"
+#include "tsSysUtils.h"
+
+// The io_uring system calls are used directly, using the kernel headers only.
+#if defined(TS_LINUX) && __has_include(<linux/io_uring.h>)
+    #define TS_IO_URING 1
+    #include "tsBeforeStandardHeaders.h"
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
+
+
+//----------------------------------------------------------------------------
+// Open / close the io_uring instance.
+//----------------------------------------------------------------------------
+
+ts::IOUring::~IOUring()
+{
+    close();
+}
+
+bool ts::IOUring::open(size_t entries, Report& report)
+{
+    close();
+
+#if defined(TS_IO_URING)
+
+    ::io_uring_params params {};
+    _fd = int(::syscall(__NR_io_uring_setup, unsigned(entries), &params));
+    if (_fd < 0) {
+        report.debug(u"io_uring not available: %s", SysErrorCodeMessage());
+        return false;
+    }
+
+    // IORING_OP_READ and IORING_OP_WRITE appeared in Linux 5.6, IORING_FEAT_FAST_POLL in 5.7.
+    // There is no simpler way to check the presence of an operation without probing.
+    if ((params.features & IORING_FEAT_FAST_POLL) == 0) {
+        report.debug(u"io_uring too old, read and write operations not supported");
+        close();
+        return false;
+    }
+
+    // Map the submission and completion rings, possibly in one single mapping.
+    _entries = params.sq_entries;
+    _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        _sq_ring_size = _cq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+    }
+    _sq_ring = ::mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+    if (_sq_ring == MAP_FAILED) {
+        _sq_ring = nullptr;
+    }
+    else if (single_mmap) {
+        _cq_ring = _sq_ring;
+    }
+    else if ((_cq_ring = ::mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING)) == MAP_FAILED) {
+        _cq_ring = nullptr;
+    }
+    _sqes_size = params.sq_entries * sizeof(::io_uring_sqe);
+    if (_sq_ring != nullptr && _cq_ring != nullptr) {
+        _sqes = ::mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+        if (_sqes == MAP_FAILED) {
+            _sqes = nullptr;
+        }
+    }
+    if (_sqes == nullptr) {
+        report.debug(u"error mapping io_uring: %s", SysErrorCodeMessage());
+        close();
+        return false;
+    }
+
+    // Locate the fields in the mapped rings.
+    uint8_t* const sq = reinterpret_cast<uint8_t*>(_sq_ring);
+    uint8_t* const cq = reinterpret_cast<uint8_t*>(_cq_ring);
+    _sq_head = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+    _sq_tail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    _sq_mask = reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    _sq_array = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    _cq_head = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    _cq_tail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    _cq_mask = reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    _cqes = cq + params.cq_off.cqes;
+    _pending = 0;
+    _to_submit = 0;
+    return true;
+
+#else
+
+    report.debug(u"io_uring not supported on this system");
+    return false;
+
+#endif
+}
+
+void ts::IOUring::close()
+{
+#if defined(TS_IO_URING)
+    if (_sqes != nullptr) {
+        ::munmap(_sqes, _sqes_size);
+    }
+    if (_cq_ring != nullptr && _cq_ring != _sq_ring) {
+        ::munmap(_cq_ring, _cq_ring_size);
+    }
+    if (_sq_ring != nullptr) {
+        ::munmap(_sq_ring, _sq_ring_size);
+    }
+    if (_fd >= 0) {
+        ::close(_fd);
+    }
+#endif
+    _fd = -1;
+    _entries = _pending = 0;
+    _to_submit = 0;
+    _sq_ring = _cq_ring = _sqes = _cqes = nullptr;
+    _sq_head = _sq_tail = _sq_mask = _sq_array = _cq_head = _cq_tail = _cq_mask = nullptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Queue read or write requests.
+//----------------------------------------------------------------------------
+
+bool ts::IOUring::queueRead(int fd, void* addr, size_t size, uint64_t offset, uint64_t user_data)
+{
+#if defined(TS_IO_URING)
+    return queue(IORING_OP_READ, fd, addr, size, offset, user_data);
+#else
+    return false;
+#endif
+}
+
+bool ts::IOUring::queueWrite(int fd, const void* addr, size_t size, uint64_t offset, uint64_t user_data)
+{
+#if defined(TS_IO_URING)
+    return queue(IORING_OP_WRITE, fd, addr, size, offset, user_data);
+#else
+    return false;
+#endif
+}
+
+bool ts::IOUring::queue(uint8_t opcode, int fd, const void* addr, size_t size, uint64_t offset, uint64_t user_data)
+{
+#if defined(TS_IO_URING)
+    // The completion queue is at least as large as the submission queue.
+    // Limiting the number of pending requests to the submission queue size avoids overflowing the completion queue.
+    if (_fd < 0 || _pending >= _entries) {
+        return false;
+    }
+
+    // We are the only producer in the submission queue, the kernel is the consumer.
+    const uint32_t tail = *_sq_tail;
+    const uint32_t index = tail & *_sq_mask;
+    ::io_uring_sqe* sqe = reinterpret_cast<::io_uring_sqe*>(_sqes) + index;
+    TS_ZERO(*sqe);
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = uint64_t(reinterpret_cast<uintptr_t>(addr));
+    sqe->len = uint32_t(size);
+    sqe->off = offset;
+    sqe->user_data = user_data;
+    _sq_array[index] = index;
+
+    // Publish the new entry to the kernel.
+    std::atomic_ref<uint32_t>(*_sq_tail).store(tail + 1, std::memory_order_release);
+    _to_submit++;
+    _pending++;
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Submit all queued requests and optionally wait for completions.
+//----------------------------------------------------------------------------
+
+bool ts::IOUring::submit(size_t wait_count, Report& report)
+{
+#if defined(TS_IO_URING)
+    if (_fd < 0) {
+        return false;
+    }
+    for (;;) {
+        const int ret = int(::syscall(__NR_io_uring_enter, _fd, _to_submit, unsigned(wait_count), wait_count > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0));
+        if (ret >= 0) {
+            _to_submit -= std::min(_to_submit, uint32_t(ret));
+            return true;
+        }
+        else if (errno != EINTR) {
+            report.error(u"io_uring error: %s", SysErrorCodeMessage());
+            return false;
+        }
+    }
+#else
+    return false;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Get the next available completion, without waiting.
+//----------------------------------------------------------------------------
+
+bool ts::IOUring::getCompletion(uint64_t& user_data, int& result)
+{
+#if defined(TS_IO_URING)
+    if (_fd < 0) {
+        return false;
+    }
+
+    // We are the only consumer in the completion queue, the kernel is the producer.
+    const uint32_t head = *_cq_head;
+    if (head == std::atomic_ref<uint32_t>(*_cq_tail).load(std::memory_order_acquire)) {
+        return false;
+    }
+    const ::io_uring_cqe* cqe = reinterpret_cast<const ::io_uring_cqe*>(_cqes) + (head & *_cq_mask);
+    user_data = cqe->user_data;
+    result = cqe->res;
+
+    // Release the entry to the kernel.
+    std::atomic_ref<uint32_t>(*_cq_head).store(head + 1, std::memory_order_release);
+    if (_pending > 0) {
+        _pending--;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
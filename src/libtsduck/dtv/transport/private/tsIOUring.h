@@ -0,0 +1,129 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Minimal interface to Linux io_uring (private class).
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsReport.h"
+
+namespace ts {
+    //!
+    //! Minimal interface to Linux io_uring for asynchronous file I/O.
+    //! @ingroup libtsduck system
+    //!
+    //! Only plain read and write operations at explicit file offsets are supported.
+    //! The system calls are directly used, there is no dependency on liburing.
+    //! On other operating systems, or when the Linux kernel does not support or
+    //! does not allow io_uring, open() fails and the application shall use
+    //! synchronous I/O instead.
+    //!
+    class IOUring
+    {
+        TS_NOCOPY(IOUring);
+    public:
+        //!
+        //! Default constructor.
+        //!
+        IOUring() = default;
+
+        //!
+        //! Destructor.
+        //!
+        ~IOUring();
+
+        //!
+        //! Open the io_uring instance.
+        //! @param [in] entries Maximum number of simultaneous requests.
+        //! @param [in,out] report Where to report errors. Unsupported io_uring is reported at debug level only.
+        //! @return True on success, false on error.
+        //!
+        bool open(size_t entries, Report& report);
+
+        //!
+        //! Close the io_uring instance.
+        //! Pending requests are not waited for, the caller shall collect all completions first.
+        //!
+        void close();
+
+        //!
+        //! Check if the io_uring instance is open.
+        //! @return True if the io_uring instance is open.
+        //!
+        bool isOpen() const { return _fd >= 0; }
+
+        //!
+        //! Get the number of requests which were queued and not yet completed.
+        //! @return The number of pending requests.
+        //!
+        size_t pendingCount() const { return _pending; }
+
+        //!
+        //! Queue a read request. The request will be started by the next submit().
+        //! @param [in] fd File descriptor.
+        //! @param [out] addr Address of the buffer. Must remain valid until the request completes.
+        //! @param [in] size Size in bytes to read.
+        //! @param [in] offset Offset in the file.
+        //! @param [in] user_data Application data which is returned with the completion.
+        //! @return True on success, false if the queue is full.
+        //!
+        bool queueRead(int fd, void* addr, size_t size, uint64_t offset, uint64_t user_data);
+
+        //!
+        //! Queue a write request. The request will be started by the next submit().
+        //! @param [in] fd File descriptor.
+        //! @param [in] addr Address of the data. Must remain valid until the request completes.
+        //! @param [in] size Size in bytes to write.
+        //! @param [in] offset Offset in the file.
+        //! @param [in] user_data Application data which is returned with the completion.
+        //! @return True on success, false if the queue is full.
+        //!
+        bool queueWrite(int fd, const void* addr, size_t size, uint64_t offset, uint64_t user_data);
+
+        //!
+        //! Submit all queued requests and optionally wait for completions.
+        //! @param [in] wait_count Minimum number of completions to wait for.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool submit(size_t wait_count, Report& report);
+
+        //!
+        //! Get the next available completion, without waiting.
+        //! @param [out] user_data Application data of the completed request.
+        //! @param [out] result Result of the request: size in bytes on success, negated errno value on error.
+        //! @return True if a completion was returned, false if there is no available completion.
+        //!
+        bool getCompletion(uint64_t& user_data, int& result);
+
+    private:
+        int       _fd = -1;            // io_uring file descriptor.
+        size_t    _entries = 0;        // Number of entries in the submission queue.
+        size_t    _pending = 0;        // Number of requests which are queued or submitted but not completed.
+        uint32_t  _to_submit = 0;      // Number of queued but not yet submitted requests.
+        void*     _sq_ring = nullptr;  // Mapped submission queue ring.
+        size_t    _sq_ring_size = 0;
+        void*     _cq_ring = nullptr;  // Mapped completion queue ring, can be the same as _sq_ring.
+        size_t    _cq_ring_size = 0;
+        void*     _sqes = nullptr;     // Mapped array of submission queue entries.
+        size_t    _sqes_size = 0;
+        uint32_t* _sq_head = nullptr;  // Fields in the mapped rings.
+        uint32_t* _sq_tail = nullptr;
+        uint32_t* _sq_mask = nullptr;
+        uint32_t* _sq_array = nullptr;
+        uint32_t* _cq_head = nullptr;
+        uint32_t* _cq_tail = nullptr;
+        uint32_t* _cq_mask = nullptr;
+        void*     _cqes = nullptr;
+
+        // Queue a read or write request.
+        bool queue(uint8_t opcode, int fd, const void* addr, size_t size, uint64_t offset, uint64_t user_data);
+    };
+}
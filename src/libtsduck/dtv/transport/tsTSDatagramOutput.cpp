@@ -123,6 +123,16 @@ void ts::TSDatagramOutput::defineArgs(Args& args)
                   u"Specify the local UDP source port for outgoing packets. "
                   u"By default, a random source port is used.");
 
+        args.option(u"send-batch", 0, Args::INTEGER, 0, 1, 1, MAX_SEND_BATCH);
+        args.help(u"send-batch", u"count",
+                  u"Specify the maximum number of UDP datagrams to send in one system call. "
+                  u"On Linux systems, the datagrams are then sent in bursts using sendmmsg(). "
+                  u"Datagrams are never delayed beyond the current group of packets, "
+                  u"the output pacing is unchanged. "
+                  u"On other systems, this option has no effect. "
+                  u"The default is 1, meaning that datagrams are sent one by one. "
+                  u"The maximum is " + UString::Decimal(MAX_SEND_BATCH) + u".");
+
         args.option(u"tos", 's', Args::INTEGER, 0, 1, 1, 255);
         args.help(u"tos",
                   u"Specifies the TOS (Type-Of-Service) socket option. Setting this value "
@@ -164,6 +174,7 @@ bool ts::TSDatagramOutput::loadArgs(DuckContext& duck, Args& args)
         args.getIntValue(_ttl, u"ttl", 0);
         args.getIntValue(_tos, u"tos", -1);
         args.getIntValue(_send_bufsize, u"buffer-size", 0);
+        args.getIntValue(_send_batch, u"send-batch", 1);
         _mc_loopback = !args.present(u"disable-multicast-loop");
         _force_mc_local = args.present(u"force-local-multicast-outgoing");
     }
@@ -234,6 +245,11 @@ bool ts::TSDatagramOutput::open(Report& report)
             _sock.close(report);
             return false;
         }
+
+        // Datagram buffers for multiple send operations.
+        _batch_buffers.resize(_send_batch > 1 ? _send_batch : 0);
+        _batch.clear();
+        _batch.reserve(_send_batch);
     }
 
     // Other states.
@@ -262,6 +278,10 @@ bool ts::TSDatagramOutput::close(const BitRate& bitrate, bool abort, Report& rep
             success = sendPackets(_out_buffer.data(), _out_buffer_rs.data(), _out_count, bitrate, report);
             _out_count = 0;
         }
+        if (!abort) {
+            success = flushDatagrams(report) && success;
+        }
+        _batch.clear();
         if (_raw_udp) {
             _sock.close(report);
         }
@@ -366,6 +386,12 @@ bool ts::TSDatagramOutput::send(const TSPacket* pkt, const TSPacketMetadata* met
         packet_count -= count;
     }
 
+    // Send all pending datagrams before returning, to preserve the output pacing.
+    // This must be done before reusing the output buffer, which may be referenced by a pending datagram.
+    if (!flushDatagrams(report)) {
+        return false;
+    }
+
     // If remaining packets are present, save them in output buffer.
     if (packet_count > 0) {
         bufferPackets(pkt, metadata, packet_count);
@@ -393,7 +419,7 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, const TSPacketMetada
         // But never jump back in RTP timestamps, only increase "more slowly" when adjusting.
 
         // Build an RTP datagram. Use a simple RTP header without options nor extensions.
-        ByteBlock buffer(RTP_HEADER_SIZE + packet_count * PKT_RS_SIZE);
+        ByteBlock& buffer(datagramBuffer(RTP_HEADER_SIZE + packet_count * PKT_RS_SIZE));
 
         // Build the RTP header, except the timestamp.
         buffer[0] = 0x80;             // Version = 2, P = 0, X = 0, CC = 0
@@ -476,17 +502,17 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, const TSPacketMetada
             MemCopy(buf, pkt, packet_count * PKT_SIZE);
             buffer.resize(RTP_HEADER_SIZE + packet_count * PKT_SIZE);
         }
-        status = _output->sendDatagram(buffer.data(), buffer.size(), report);
+        status = outputDatagram(buffer.data(), buffer.size(), report);
     }
     else if (_rs204_format) {
         // No RTP header, add TS trailer after each packet.
-        ByteBlock buffer(packet_count * PKT_RS_SIZE);
+        ByteBlock& buffer(datagramBuffer(packet_count * PKT_RS_SIZE));
         serialize(buffer.data(), buffer.size(), pkt, metadata, packet_count);
-        status = _output->sendDatagram(buffer.data(), buffer.size(), report);
+        status = outputDatagram(buffer.data(), buffer.size(), report);
     }
     else {
         // No RTP, no trailer, send TS packets directly as datagram.
-        status = _output->sendDatagram(pkt, packet_count * PKT_SIZE, report);
+        status = outputDatagram(pkt, packet_count * PKT_SIZE, report);
     }
 
     // Count packets datagram per datagram.
@@ -496,6 +522,50 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, const TSPacketMetada
 }
 
 
+//----------------------------------------------------------------------------
+// Get a buffer to build a datagram.
+//----------------------------------------------------------------------------
+
+ts::ByteBlock& ts::TSDatagramOutput::datagramBuffer(size_t size)
+{
+    // With --send-batch, each pending datagram has its own buffer.
+    ByteBlock& buffer(_batch_buffers.empty() ? _dgram_buffer : _batch_buffers[_batch.size()]);
+    buffer.resize(size);
+    return buffer;
+}
+
+
+//----------------------------------------------------------------------------
+// Send a datagram or add it to the pending batch.
+//----------------------------------------------------------------------------
+
+bool ts::TSDatagramOutput::outputDatagram(const void* address, size_t size, Report& report)
+{
+    if (_batch_buffers.empty()) {
+        // No --send-batch, send the datagram immediately.
+        return _output->sendDatagram(address, size, report);
+    }
+    else {
+        // The datagram data shall remain valid until the next flush.
+        assert(_batch.size() < _send_batch);
+        _batch.push_back({address, size});
+        return _batch.size() < _send_batch || flushDatagrams(report);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Send all pending datagrams.
+//----------------------------------------------------------------------------
+
+bool ts::TSDatagramOutput::flushDatagrams(Report& report)
+{
+    const bool success = _batch.empty() || _sock.sendMultiple(_batch.data(), _batch.size(), report);
+    _batch.clear();
+    return success;
+}
+
+
 //----------------------------------------------------------------------------
 // Implementation of TSDatagramOutputHandlerInterface.
 // The object is its own handler in case of raw UDP output.
@@ -60,6 +60,11 @@ namespace ts {
         //!
         static constexpr size_t MAX_PACKET_BURST = 128;
 
+        //!
+        //! Maximum number of datagrams which are sent at once with option --send-batch.
+        //!
+        static constexpr size_t MAX_SEND_BATCH = UDPSocket::MAX_SEND_MULTIPLE;
+
         //!
         //! Constructor.
         //! @param [in] flags List of options.
@@ -144,6 +149,7 @@ namespace ts {
         bool            _mc_loopback = true;         // Multicast loopback option
         bool            _force_mc_local = false;     // Force multicast outgoing local interface
         size_t          _send_bufsize = 0;           // Socket send buffer size.
+        size_t          _send_batch = 1;             // Max number of datagrams per system call.
 
         // Working data.
         bool            _is_open = false;            // Currently in progress
@@ -159,6 +165,9 @@ namespace ts {
         TSPacketVector  _out_buffer {};              // Buffered packets for output with --enforce-burst
         TSPacketMetadataVector _out_buffer_rs {};    // Buffered RS trailers with --enforce-burst --rs204
         UDPSocket       _sock {};                    // Outgoing socket for raw UDP
+        ByteBlock       _dgram_buffer {};            // Datagram buffer, without --send-batch
+        ByteBlockVector _batch_buffers {};           // Datagram buffers, with --send-batch
+        std::vector<UDPSocket::SentMessage> _batch {}; // Pending datagrams, with --send-batch
 
         // Implementation of TSDatagramOutputHandlerInterface.
         // The object is its own handler in case of raw UDP output.
@@ -170,6 +179,15 @@ namespace ts {
         // Serialize a set of packets and RS trailers in a buffer.
         void serialize(uint8_t* buffer, size_t buffer_size, const TSPacket* packet, const TSPacketMetadata* metadata, size_t count);
 
+        // Get a buffer to build a datagram of a given size. The buffer remains valid until the datagram is sent.
+        ByteBlock& datagramBuffer(size_t size);
+
+        // Send a datagram or add it to the pending batch, with --send-batch.
+        bool outputDatagram(const void* address, size_t size, Report& report);
+
+        // Send all pending datagrams, with --send-batch.
+        bool flushDatagrams(Report& report);
+
         // Send contiguous packets in one single datagram.
         bool sendPackets(const TSPacket* packet, const TSPacketMetadata* metadata, size_t count, const BitRate& bitrate, Report& report);
     };
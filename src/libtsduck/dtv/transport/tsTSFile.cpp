@@ -16,13 +16,509 @@
     #include <io.h>
     #include "tsAfterStandardHeaders.h"
 #else
+    #include "tsIOUring.h"
+    #include "tsSysInfo.h"
+    #include "tsByteBlock.h"
+    #include "tsThread.h"
     #include "tsBeforeStandardHeaders.h"
     #include <sys/types.h>
     #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <fcntl.h>
     #include <unistd.h>
     #include "tsAfterStandardHeaders.h"
 #endif
 
+// With ReadMode::MMAP, already read areas are released from memory by chunks of this size.
+#define MAP_RELEASE_SIZE (64 * 1024 * 1024)
+
+// In write-behind mode, size of each buffer, a multiple of any direct I/O alignment.
+#define WRITE_BUFFER_SIZE (1024 * 1024)
+
+
+//----------------------------------------------------------------------------
+// Enumeration description of ts::TSFile::ReadMode.
+//----------------------------------------------------------------------------
+
+const ts::Names& ts::TSFile::ReadModeEnum()
+{
+    static const Names data {
+        {u"standard", ReadMode::STANDARD},
+        {u"mmap",     ReadMode::MMAP},
+        {u"async",    ReadMode::ASYNC},
+    };
+    return data;
+}
+
+
+//----------------------------------------------------------------------------
+// Enumeration description of ts::TSFile::WriteOverflow.
+//----------------------------------------------------------------------------
+
+const ts::Names& ts::TSFile::WriteOverflowEnum()
+{
+    static const Names data {
+        {u"wait", WriteOverflow::WAIT},
+        {u"drop", WriteOverflow::DROP},
+    };
+    return data;
+}
+
+
+//----------------------------------------------------------------------------
+// Asynchronous read-ahead state (ReadMode::ASYNC).
+// A ring of large chunks is read in advance at consecutive offsets using
+// io_uring. Each chunk is resubmitted as soon as it is entirely consumed.
+//----------------------------------------------------------------------------
+
+#if !defined(TS_WINDOWS)
+
+class ts::TSFile::ReadAhead
+{
+    TS_NOCOPY(ReadAhead);
+public:
+    // Constructor.
+    ReadAhead() = default;
+
+    // Initialize the io_uring instance. Return false if not supported.
+    bool open(Report& report);
+
+    // Start or restart reading ahead at the specified offset.
+    bool start(int fd, uint64_t offset, Report& report);
+
+    // Wait for all pending read operations.
+    void drain(Report& report);
+
+    // Read data. Return false on error. If the error is a read error, error_code is set
+    // to the system error code. Otherwise, the error was already reported.
+    // Zero size is returned at end of file.
+    bool read(void* addr, size_t max_size, size_t& ret_size, int& error_code, Report& report);
+
+private:
+    static constexpr size_t CHUNK_COUNT = 8;
+    static constexpr size_t CHUNK_SIZE = 1024 * 1024;
+
+    // Description of a chunk of data which is read ahead.
+    class Chunk
+    {
+    public:
+        uint64_t offset = 0;      // Offset in file.
+        size_t   size = 0;        // Read size in chunk.
+        int      error = 0;       // Read error code.
+        bool     pending = false; // Read operation in progress.
+    };
+
+    // Declaration order matters: the buffer must outlive the io_uring instance.
+    ByteBlock  _buffer {};        // Read-ahead buffer, CHUNK_COUNT chunks of CHUNK_SIZE bytes.
+    IOUring    _uring {};         // io_uring instance for asynchronous reads.
+    std::array<Chunk, CHUNK_COUNT> _chunks {};
+    int        _fd = -1;          // File descriptor.
+    size_t     _head = 0;         // Index of the chunk being read by the application.
+    size_t     _head_pos = 0;     // Read position in the head chunk.
+    uint64_t   _next_offset = 0;  // Next offset to read ahead.
+
+    // Queue the read-ahead of a chunk at the next offset.
+    bool queueChunk(size_t index);
+
+    // Collect all available completions.
+    void collect();
+};
+
+bool ts::TSFile::ReadAhead::open(Report& report)
+{
+    _buffer.resize(CHUNK_COUNT * CHUNK_SIZE);
+    return _uring.open(CHUNK_COUNT, report);
+}
+
+bool ts::TSFile::ReadAhead::queueChunk(size_t index)
+{
+    Chunk& chunk(_chunks[index]);
+    chunk.offset = _next_offset;
+    chunk.size = 0;
+    chunk.error = 0;
+    chunk.pending = _uring.queueRead(_fd, _buffer.data() + index * CHUNK_SIZE, CHUNK_SIZE, _next_offset, index);
+    if (chunk.pending) {
+        _next_offset += CHUNK_SIZE;
+    }
+    return chunk.pending;
+}
+
+void ts::TSFile::ReadAhead::collect()
+{
+    uint64_t index = 0;
+    int result = 0;
+    while (_uring.getCompletion(index, result)) {
+        if (index < CHUNK_COUNT) {
+            Chunk& chunk(_chunks[index]);
+            chunk.pending = false;
+            chunk.size = result < 0 ? 0 : size_t(result);
+            chunk.error = result < 0 ? -result : 0;
+        }
+    }
+}
+
+void ts::TSFile::ReadAhead::drain(Report& report)
+{
+    while (_uring.pendingCount() > 0 && _uring.submit(1, report)) {
+        collect();
+    }
+}
+
+bool ts::TSFile::ReadAhead::start(int fd, uint64_t offset, Report& report)
+{
+    drain(report);
+    _fd = fd;
+    _head = _head_pos = 0;
+    _next_offset = offset;
+    bool ok = true;
+    for (size_t i = 0; ok && i < CHUNK_COUNT; ++i) {
+        ok = queueChunk(i);
+    }
+    return ok && _uring.submit(0, report);
+}
+
+bool ts::TSFile::ReadAhead::read(void* addr, size_t max_size, size_t& ret_size, int& error_code, Report& report)
+{
+    ret_size = 0;
+    error_code = 0;
+
+    // Wait for the completion of the head chunk.
+    Chunk& chunk(_chunks[_head]);
+    while (chunk.pending) {
+        if (!_uring.submit(1, report)) {
+            return false;
+        }
+        collect();
+    }
+    if (chunk.error != 0) {
+        error_code = chunk.error;
+        return false;
+    }
+
+    // Return data from the head chunk. Zero size means end of file.
+    ret_size = std::min(max_size, chunk.size - _head_pos);
+    MemCopy(addr, _buffer.data() + _head * CHUNK_SIZE + _head_pos, ret_size);
+    _head_pos += ret_size;
+
+    // When the chunk is completely read, reuse it to read ahead the next one.
+    if (chunk.size > 0 && _head_pos >= chunk.size) {
+        if (chunk.size < CHUNK_SIZE) {
+            // Short read: this is the end of file or the file is still growing.
+            // All chunks which are read ahead are invalid. Restart reading after this point.
+            return start(_fd, chunk.offset + chunk.size, report);
+        }
+        else {
+            const size_t index = _head;
+            _head = (_head + 1) % CHUNK_COUNT;
+            _head_pos = 0;
+            return queueChunk(index) && _uring.submit(0, report);
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Asynchronous write-behind state.
+// The application fills a ring of large aligned buffers. Each full buffer is
+// queued and written into the file by a dedicated thread. The application
+// waits for the writer thread only when all buffers are queued.
+//----------------------------------------------------------------------------
+
+class ts::TSFile::WriteBehind : private Thread
+{
+    TS_NOCOPY(WriteBehind);
+public:
+    // Constructor.
+    WriteBehind(int fd, size_t queue_size, uint64_t preallocate);
+
+    // Destructor.
+    virtual ~WriteBehind() override;
+
+    // Start the writer thread. With direct_io, try to bypass the system cache.
+    bool start(bool direct_io, Report& report);
+
+    // Check if some data can be queued without waiting.
+    bool available(size_t size);
+
+    // Queue data, wait for a free buffer when necessary. On error, return false and set error_code.
+    // The error code is zero when the error was already reported or the write-behind was aborted.
+    bool write(const void* addr, size_t size, int& error_code);
+
+    // Write all queued data and terminate the writer thread. On write error, return false and set error_code.
+    bool stop(int& error_code);
+
+    // Abort the writer thread, drop all queued data.
+    void abort();
+
+private:
+    static constexpr size_t ALIGNMENT = 4096;  // Alignment of buffers for direct I/O.
+
+    // Description of a buffer.
+    class Buffer
+    {
+    public:
+        ByteBlock storage {};     // Allocated memory, larger than WRITE_BUFFER_SIZE for alignment.
+        uint8_t*  data = nullptr; // Aligned start of data in storage.
+        size_t    size = 0;       // Size of data in buffer.
+    };
+
+    // Accessed by the writer thread only, after start.
+    int       _fd = -1;           // File descriptor.
+    bool      _direct = false;    // Direct I/O is active.
+    uint64_t  _preallocate = 0;   // Preallocation size.
+    uint64_t  _offset = 0;        // Current write offset in file.
+    uint64_t  _allocated = 0;     // End of preallocated area.
+
+    // Accessed by the application thread only.
+    size_t    _fill = 0;          // Index of the buffer being filled by the application.
+    bool      _fill_queued = false;  // The buffer at _fill may still be queued, wait before filling it.
+
+    // Shared between the two threads.
+    std::vector<Buffer>     _buffers;
+    std::mutex              _mutex {};
+    std::condition_variable _queued {};    // Signaled when a buffer is queued or on termination request.
+    std::condition_variable _released {};  // Signaled when a buffer is written or the writer thread stops.
+    size_t                  _first = 0;    // Index of first queued buffer, under mutex.
+    size_t                  _count = 0;    // Number of queued buffers, under mutex.
+    bool                    _terminate = false;  // Write all queued buffers and terminate, under mutex.
+    std::atomic_bool        _aborted = false;    // Terminate immediately, modified under mutex.
+    std::atomic_int         _error = 0;          // Write error code from the writer thread, modified under mutex.
+
+    // Write data into the file in the context of the writer thread. Return a system error code.
+    int writeData(const uint8_t* data, size_t size);
+
+    // Stop using direct I/O, in the context of the writer thread.
+    void stopDirect();
+
+    // Implementation of Thread.
+    virtual void main() override;
+};
+
+ts::TSFile::WriteBehind::WriteBehind(int fd, size_t queue_size, uint64_t preallocate) :
+    _fd(fd),
+    _preallocate(preallocate),
+    _buffers(std::max<size_t>(2, (queue_size + WRITE_BUFFER_SIZE - 1) / WRITE_BUFFER_SIZE))
+{
+    for (auto& buf : _buffers) {
+        buf.storage.resize(WRITE_BUFFER_SIZE + ALIGNMENT);
+        buf.data = buf.storage.data() + (ALIGNMENT - reinterpret_cast<uintptr_t>(buf.storage.data()) % ALIGNMENT) % ALIGNMENT;
+    }
+}
+
+ts::TSFile::WriteBehind::~WriteBehind()
+{
+    abort();
+    waitForTermination();
+}
+
+bool ts::TSFile::WriteBehind::start(bool direct_io, Report& report)
+{
+    // The preallocation starts at the current position in the file.
+    const off_t pos = ::lseek(_fd, 0, SEEK_CUR);
+    if (pos < 0) {
+        _preallocate = 0;
+    }
+    else {
+        _offset = _allocated = uint64_t(pos);
+    }
+#if !defined(TS_LINUX)
+    _preallocate = 0;
+#endif
+
+    if (direct_io) {
+#if defined(O_DIRECT)
+        // Direct I/O requires aligned file offsets.
+        const int flags = ::fcntl(_fd, F_GETFL);
+        if (pos < 0 || _offset % ALIGNMENT != 0) {
+            report.verbose(u"unaligned write position, not using direct I/O");
+        }
+        else if (flags < 0 || ::fcntl(_fd, F_SETFL, flags | O_DIRECT) < 0) {
+            report.verbose(u"direct I/O not supported: %s", SysErrorCodeMessage());
+        }
+        else {
+            _direct = true;
+        }
+#else
+        report.verbose(u"direct I/O not supported on this system");
+#endif
+    }
+
+    if (!Thread::start()) {
+        report.error(u"cannot start write-behind thread");
+        stopDirect();
+        return false;
+    }
+    return true;
+}
+
+bool ts::TSFile::WriteBehind::available(size_t size)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _count < _buffers.size() && WRITE_BUFFER_SIZE - _buffers[_fill].size + (_buffers.size() - _count - 1) * WRITE_BUFFER_SIZE >= size;
+}
+
+bool ts::TSFile::WriteBehind::write(const void* addr, size_t size, int& error_code)
+{
+    error_code = _error;
+    if (error_code != 0 || _aborted) {
+        return false;
+    }
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(addr);
+    while (size > 0) {
+        // Wait for the current buffer to be free only when there is something to copy into it.
+        // This way, queueing data which exactly fills the last free buffer never waits.
+        if (_fill_queued) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _released.wait(lock, [this]() { return _count < _buffers.size() || _error != 0 || _aborted; });
+            error_code = _error;
+            if (error_code != 0 || _aborted) {
+                return false;
+            }
+            _fill_queued = false;
+        }
+
+        // Copy as much data as possible in the current buffer. The writer thread does not use it.
+        Buffer& buf(_buffers[_fill]);
+        const size_t chunk = std::min(size, WRITE_BUFFER_SIZE - buf.size);
+        MemCopy(buf.data + buf.size, data, chunk);
+        buf.size += chunk;
+        data += chunk;
+        size -= chunk;
+
+        // When the buffer is full, queue it. The next buffer is still queued when all buffers are now queued.
+        if (buf.size >= WRITE_BUFFER_SIZE) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _count++;
+            _fill = (_fill + 1) % _buffers.size();
+            _fill_queued = _count >= _buffers.size();
+            _queued.notify_one();
+        }
+    }
+    return true;
+}
+
+bool ts::TSFile::WriteBehind::stop(int& error_code)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        // Queue the last partial buffer. There is always room for it, the writer thread no longer needs a free buffer.
+        if (_buffers[_fill].size > 0 && _count < _buffers.size()) {
+            _count++;
+            _fill = (_fill + 1) % _buffers.size();
+        }
+        _terminate = true;
+        _queued.notify_one();
+    }
+    waitForTermination();
+    error_code = _error;
+    return error_code == 0;
+}
+
+void ts::TSFile::WriteBehind::abort()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _aborted = true;
+    _queued.notify_one();
+    _released.notify_all();
+}
+
+void ts::TSFile::WriteBehind::main()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        _queued.wait(lock, [this]() { return _count > 0 || _terminate || _aborted; });
+        if (_count == 0 || _aborted) {
+            break;
+        }
+
+        // Write the first queued buffer without holding the mutex.
+        Buffer& buf(_buffers[_first]);
+        lock.unlock();
+        const int error_code = writeData(buf.data, buf.size);
+        lock.lock();
+
+        // Release the buffer to the application.
+        buf.size = 0;
+        _first = (_first + 1) % _buffers.size();
+        _count--;
+        _error = error_code;
+        _released.notify_one();
+        if (error_code != 0) {
+            break;
+        }
+    }
+    _released.notify_one();
+    if (!_aborted) {
+        stopDirect();
+        // Release the preallocated disk space after the end of file.
+        if (_allocated > _offset && ::ftruncate(_fd, off_t(_offset)) == 0) {
+            _allocated = _offset;
+        }
+    }
+}
+
+int ts::TSFile::WriteBehind::writeData(const uint8_t* data, size_t size)
+{
+#if defined(TS_LINUX)
+    // Preallocate disk space by large chunks, ahead of the write position.
+    if (_preallocate > 0 && _offset + size > _allocated) {
+        const uint64_t length = round_up(_offset + size - _allocated, _preallocate);
+        if (::fallocate(_fd, FALLOC_FL_KEEP_SIZE, off_t(_allocated), off_t(length)) == 0) {
+            _allocated += length;
+        }
+        else {
+            // Not supported by the file system, don't try again.
+            _preallocate = 0;
+        }
+    }
+#endif
+
+    while (size > 0) {
+        // With direct I/O, the write size must be aligned. An unaligned size is only
+        // possible in the last buffer: write the aligned part first, then the rest without direct I/O.
+        size_t chunk = size;
+        if (_direct && size % ALIGNMENT != 0) {
+            if (size > ALIGNMENT) {
+                chunk = round_down(size, ALIGNMENT);
+            }
+            else {
+                stopDirect();
+            }
+        }
+        const ssize_t outsize = ::write(_fd, data, chunk);
+        if (outsize > 0) {
+            data += outsize;
+            size -= std::min(size, size_t(outsize));
+            _offset += uint64_t(outsize);
+        }
+        else if (_direct && errno == EINVAL) {
+            // Direct I/O not supported by the file system or unaligned partial write.
+            stopDirect();
+        }
+        else if (errno != EINTR) {
+            return LastSysErrorCode();
+        }
+    }
+    return 0;
+}
+
+void ts::TSFile::WriteBehind::stopDirect()
+{
+#if defined(O_DIRECT)
+    if (_direct) {
+        _direct = false;
+        const int flags = ::fcntl(_fd, F_GETFL);
+        if (flags >= 0) {
+            ::fcntl(_fd, F_SETFL, flags & ~O_DIRECT);
+        }
+    }
+#endif
+}
+
+#endif
+
 
 //----------------------------------------------------------------------------
 // Constructors and destructors.
@@ -51,10 +547,22 @@ ts::TSFile::TSFile(TSFile&& other) noexcept :
     _rewindable(other._rewindable),
     _regular(other._regular),
     _std_inout(other._std_inout),
+    _read_mode(other._read_mode),
+    _write_queue_size(other._write_queue_size),
+    _write_overflow(other._write_overflow),
+    _write_direct(other._write_direct),
+    _write_prealloc(other._write_prealloc),
+    _write_dropped(other._write_dropped),
 #if defined(TS_WINDOWS)
     _handle(other._handle)
 #else
-    _fd(other._fd)
+    _fd(other._fd),
+    _map_base(other._map_base),
+    _map_size(other._map_size),
+    _map_pos(other._map_pos),
+    _map_released(other._map_released),
+    _read_ahead(std::move(other._read_ahead)),
+    _write_behind(std::move(other._write_behind))
 #endif
 {
     // Mark other object as closed, just in case.
@@ -63,6 +571,7 @@ ts::TSFile::TSFile(TSFile&& other) noexcept :
     other._handle = INVALID_HANDLE_VALUE;
 #else
     other._fd = -1;
+    other._map_base = nullptr;
 #endif
 }
 
@@ -106,6 +615,19 @@ void ts::TSFile::setStuffing(size_t initial, size_t final)
 }
 
 
+//----------------------------------------------------------------------------
+// Set asynchronous write-behind mode.
+//----------------------------------------------------------------------------
+
+void ts::TSFile::setWriteBehind(size_t queue_size, WriteOverflow overflow, bool direct_io, uint64_t preallocate)
+{
+    _write_queue_size = queue_size;
+    _write_overflow = overflow;
+    _write_direct = direct_io;
+    _write_prealloc = preallocate;
+}
+
+
 //----------------------------------------------------------------------------
 // Open file for read in a rewindable mode.
 //----------------------------------------------------------------------------
@@ -308,6 +830,8 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
 
     // Close first if this is a reopen.
     if (reopen) {
+        stopReadMode();
+        stopWriteBehind(report);
         ::close(_fd);
         _fd = -1;
     }
@@ -379,11 +903,22 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
         return false;
     }
 
+    // Non-standard read methods apply to named regular files only.
+    if (read_only && _regular && !_std_inout && _read_mode != ReadMode::STANDARD) {
+        startReadMode(uint64_t(st.st_size), report);
+    }
+
+    // Write-behind applies to files which are opened in write-only mode.
+    if (write_access && !read_access && _write_queue_size > 0) {
+        startWriteBehind(report);
+    }
+
 #endif
 
     // Reset counters only if not a reopen.
     if (!reopen) {
         _total_read = _total_write = 0;
+        _write_dropped = 0;
     }
 
     // Clean initial state.
@@ -439,6 +974,23 @@ bool ts::TSFile::seekInternal(uint64_t index, Report& report)
 
     report.debug(u"seeking %s at offset %'d", _filename, _start_offset + index);
 
+#if !defined(TS_WINDOWS)
+    // With non-standard read methods, there is no file pointer to move.
+    if (_map_base != nullptr) {
+        _map_pos = size_t(std::min<uint64_t>(_start_offset + index, _map_size));
+        _map_released = round_down(_map_pos, SysInfo::Instance().memoryPageSize());
+        _at_eof = false;
+        return true;
+    }
+    else if (_read_ahead != nullptr) {
+        if (!_read_ahead->start(_fd, _start_offset + index, report)) {
+            return false;
+        }
+        _at_eof = false;
+        return true;
+    }
+#endif
+
 #if defined(TS_WINDOWS)
     // In Win32, LARGE_INTEGER is a 64-bit structure, not an integer type
     uint64_t where = _start_offset + index;
@@ -493,6 +1045,12 @@ bool ts::TSFile::close(Report& report)
         writeStuffing(_close_null, report);
     }
 
+    bool success = true;
+#if !defined(TS_WINDOWS)
+    stopReadMode();
+    success = stopWriteBehind(report);
+#endif
+
     if (!_std_inout) {
 #if defined(TS_WINDOWS)
         ::CloseHandle(_handle);
@@ -508,7 +1066,7 @@ bool ts::TSFile::close(Report& report)
     _filename.clear();
     _std_inout = false;
 
-    return true;
+    return success;
 }
 
 
@@ -562,7 +1120,25 @@ bool ts::TSFile::readStreamPartial(void* buffer, size_t request_size, size_t& re
 
 #else
 
-    // UNIX implementation
+    // UNIX implementation, with memory-mapped file.
+    if (_map_base != nullptr) {
+        return readMapped(buffer, request_size, read_size);
+    }
+
+    // UNIX implementation, with asynchronous read-ahead.
+    if (_read_ahead != nullptr) {
+        int errcode = 0;
+        if (!_read_ahead->read(buffer, request_size, read_size, errcode, report)) {
+            if (errcode != 0) {
+                report.log(_severity, u"error reading %s: %s", getDisplayFileName(), SysErrorCodeMessage(errcode));
+            }
+            return false;
+        }
+        _at_eof = read_size == 0;
+        return !_at_eof;
+    }
+
+    // UNIX implementation, standard read.
     for (;;) {
         const ssize_t insize = ::read(_fd, buffer, request_size);
         if (insize == 0) {
@@ -587,6 +1163,140 @@ bool ts::TSFile::readStreamPartial(void* buffer, size_t request_size, size_t& re
 }
 
 
+//----------------------------------------------------------------------------
+// Non-standard read methods (UNIX only).
+//----------------------------------------------------------------------------
+
+#if !defined(TS_WINDOWS)
+
+void ts::TSFile::startReadMode(uint64_t file_size, Report& report)
+{
+    if (_read_mode == ReadMode::MMAP) {
+        void* base = MAP_FAILED;
+        if (file_size > 0 && file_size <= uint64_t(std::numeric_limits<size_t>::max())) {
+            base = ::mmap(nullptr, size_t(file_size), PROT_READ, MAP_PRIVATE, _fd, 0);
+        }
+        if (base == MAP_FAILED) {
+            report.verbose(u"cannot map %s in memory, using standard read", getDisplayFileName());
+        }
+        else {
+            report.debug(u"mapped %s in memory, %'d bytes", getDisplayFileName(), file_size);
+            _map_base = reinterpret_cast<uint8_t*>(base);
+            _map_size = size_t(file_size);
+            _map_pos = size_t(std::min<uint64_t>(_start_offset, _map_size));
+            _map_released = round_down(_map_pos, SysInfo::Instance().memoryPageSize());
+            ::madvise(base, _map_size, MADV_SEQUENTIAL);
+        }
+    }
+    else if (_read_mode == ReadMode::ASYNC) {
+        _read_ahead = std::make_unique<ReadAhead>();
+        if (!_read_ahead->open(report) || !_read_ahead->start(_fd, _start_offset, report)) {
+            report.verbose(u"asynchronous read not available for %s, using standard read", getDisplayFileName());
+            _read_ahead->drain(report);
+            _read_ahead.reset();
+        }
+    }
+}
+
+void ts::TSFile::stopReadMode()
+{
+    if (_map_base != nullptr) {
+        ::munmap(_map_base, _map_size);
+        _map_base = nullptr;
+        _map_size = _map_pos = _map_released = 0;
+    }
+    if (_read_ahead != nullptr) {
+        _read_ahead->drain(NULLREP);
+        _read_ahead.reset();
+    }
+}
+
+bool ts::TSFile::readMapped(void* addr, size_t max_size, size_t& ret_size)
+{
+    ret_size = std::min(max_size, _map_size - _map_pos);
+    if (ret_size == 0) {
+        _at_eof = true;
+        return false;
+    }
+    MemCopy(addr, _map_base + _map_pos, ret_size);
+    _map_pos += ret_size;
+
+    // Release already read pages, by large areas, to avoid filling the memory with huge files.
+    if (_map_pos - _map_released >= MAP_RELEASE_SIZE) {
+        const size_t end = round_down(_map_pos, SysInfo::Instance().memoryPageSize());
+        ::madvise(_map_base + _map_released, end - _map_released, MADV_DONTNEED);
+        _map_released = end;
+    }
+    return true;
+}
+
+void ts::TSFile::startWriteBehind(Report& report)
+{
+    // Direct I/O and preallocation apply to named regular files only.
+    const bool regular = _regular && !_std_inout;
+    _write_behind = std::make_unique<WriteBehind>(_fd, _write_queue_size, regular ? _write_prealloc : 0);
+    if (_write_behind->start(regular && _write_direct, report)) {
+        report.debug(u"writing %s in write-behind mode", getDisplayFileName());
+    }
+    else {
+        _write_behind.reset();
+    }
+}
+
+bool ts::TSFile::stopWriteBehind(Report& report)
+{
+    bool success = true;
+    if (_write_behind != nullptr) {
+        int error_code = 0;
+        if (!_write_behind->stop(error_code)) {
+            success = false;
+            if (error_code != 0 && error_code != EPIPE) {
+                report.log(_severity, u"error writing %s: %s", getDisplayFileName(), SysErrorCodeMessage(error_code));
+            }
+        }
+        _write_behind.reset();
+    }
+    if (_write_dropped > 0) {
+        report.warning(u"%s: %'d packets dropped on write-behind queue overflow", getDisplayFileName(), _write_dropped);
+    }
+    return success;
+}
+
+#endif
+
+
+//----------------------------------------------------------------------------
+// Check if the file is currently written in write-behind mode.
+//----------------------------------------------------------------------------
+
+bool ts::TSFile::isWriteBehind() const
+{
+#if defined(TS_WINDOWS)
+    return false;
+#else
+    return _write_behind != nullptr;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Get the method which is actually used to read the file.
+//----------------------------------------------------------------------------
+
+ts::TSFile::ReadMode ts::TSFile::getReadMode() const
+{
+#if !defined(TS_WINDOWS)
+    if (_map_base != nullptr) {
+        return ReadMode::MMAP;
+    }
+    else if (_read_ahead != nullptr) {
+        return ReadMode::ASYNC;
+    }
+#endif
+    return ReadMode::STANDARD;
+}
+
+
 //----------------------------------------------------------------------------
 // Read TS packets. Return the actual number of read packets.
 // Override TSPacketStream implementation
@@ -690,6 +1400,22 @@ bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& writt
 
 #else
 
+    // In write-behind mode, queue the data for the writer thread.
+    if (_write_behind != nullptr) {
+        int error_code = 0;
+        if (_write_behind->write(buffer, data_size, error_code)) {
+            written_size = data_size;
+            return true;
+        }
+        else {
+            // Don't report error on broken pipe.
+            if (error_code != 0 && error_code != EPIPE) {
+                report.log(_severity, u"error writing %s: %s", getDisplayFileName(), SysErrorCodeMessage(error_code));
+            }
+            return false;
+        }
+    }
+
     // UNIX implementation
     const char* data = reinterpret_cast<const char*>(buffer);
     size_t remain = data_size;
@@ -719,6 +1445,43 @@ bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& writt
 }
 
 
+//----------------------------------------------------------------------------
+// Write TS packets. Override TSPacketStream implementation
+//----------------------------------------------------------------------------
+
+bool ts::TSFile::writePackets(const TSPacket* buffer, const TSPacketMetadata* metadata, size_t packet_count, Report& report)
+{
+#if !defined(TS_WINDOWS)
+    // In write-behind mode, with a drop policy, never wait for the writer thread.
+    // Packets are queued or dropped by groups which fit in one buffer.
+    if (_write_behind != nullptr && _write_overflow == WriteOverflow::DROP) {
+        const size_t packet_size = packetHeaderSize() + PKT_SIZE + packetTrailerSize();
+        const size_t max_group = WRITE_BUFFER_SIZE / packet_size;
+        bool success = true;
+        while (success && packet_count > 0) {
+            const size_t count = std::min(packet_count, max_group);
+            if (_write_behind->available(count * packet_size)) {
+                success = TSPacketStream::writePackets(buffer, metadata, count, report);
+            }
+            else {
+                if (_write_dropped == 0) {
+                    report.warning(u"write-behind queue full for %s, dropping packets", getDisplayFileName());
+                }
+                _write_dropped += count;
+            }
+            buffer += count;
+            if (metadata != nullptr) {
+                metadata += count;
+            }
+            packet_count -= count;
+        }
+        return success;
+    }
+#endif
+    return TSPacketStream::writePackets(buffer, metadata, packet_count, report);
+}
+
+
 //----------------------------------------------------------------------------
 // Read/write artificial stuffing.
 //----------------------------------------------------------------------------
@@ -763,6 +1526,9 @@ void ts::TSFile::abort()
         ::CloseHandle(_handle);
         _handle = INVALID_HANDLE_VALUE;
 #else // UNIX
+        if (_write_behind != nullptr) {
+            _write_behind->abort();
+        }
         ::close(_fd);
         _fd = -1;
 #endif
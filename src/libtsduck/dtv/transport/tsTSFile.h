@@ -16,6 +16,7 @@
 #include "tsAbstractReadStreamInterface.h"
 #include "tsAbstractWriteStreamInterface.h"
 #include "tsEnumUtils.h"
+#include "tsNames.h"
 
 namespace ts {
 
@@ -151,6 +152,87 @@ namespace ts {
         //!
         void setStuffing(size_t initial, size_t final);
 
+        //!
+        //! Method to read a file.
+        //!
+        enum class ReadMode {
+            STANDARD,  //!< Standard sequential read operations.
+            MMAP,      //!< Map the file in memory. UNIX systems only.
+            ASYNC,     //!< Asynchronous read-ahead using io_uring. Linux only.
+        };
+
+        //!
+        //! Enumeration description of ts::TSFile::ReadMode.
+        //! @return A constant reference to the enumeration description.
+        //!
+        static const Names& ReadModeEnum();
+
+        //!
+        //! Set the method to read the file.
+        //! This method shall be called before opening the file.
+        //! The non-standard methods apply to named regular files which are opened in read-only mode.
+        //! In all other cases, or when the method is not supported by the operating system,
+        //! the file is read using standard read operations.
+        //! @param [in] mode Method to read the file.
+        //!
+        void setReadMode(ReadMode mode) { _read_mode = mode; }
+
+        //!
+        //! Get the method which is actually used to read the file.
+        //! @return The read method of the open file. This can be different from the one
+        //! which was requested using setReadMode() when the requested method is not possible.
+        //!
+        ReadMode getReadMode() const;
+
+        //!
+        //! Policy when the write-behind queue is full.
+        //!
+        enum class WriteOverflow {
+            WAIT,  //!< Wait for the writer thread to free some space in the queue.
+            DROP,  //!< Drop the packets which do not fit in the queue, never wait.
+        };
+
+        //!
+        //! Enumeration description of ts::TSFile::WriteOverflow.
+        //! @return A constant reference to the enumeration description.
+        //!
+        static const Names& WriteOverflowEnum();
+
+        //!
+        //! Set asynchronous write-behind mode.
+        //! This method shall be called before opening the file.
+        //!
+        //! In write-behind mode, written packets are copied into large memory buffers
+        //! and a separate thread writes these buffers into the file. A slow or bursty
+        //! storage device does not immediately block the application.
+        //! Write-behind applies to files which are opened in write-only mode on UNIX systems.
+        //! It is ignored in all other cases.
+        //!
+        //! @param [in] queue_size Maximum size in bytes of the queue of data waiting to be written.
+        //! The actual size is rounded to a number of internal buffers. Zero means no write-behind.
+        //! @param [in] overflow Policy when the queue is full.
+        //! @param [in] direct_io If true, try to bypass the system cache when writing a named regular file
+        //! (O_DIRECT, Linux only). If not supported by the operating system or the file system,
+        //! standard buffered writes are used.
+        //! @param [in] preallocate If not zero, preallocate disk space by chunks of this size in bytes
+        //! ahead of the write position in a named regular file (Linux only).
+        //!
+        void setWriteBehind(size_t queue_size, WriteOverflow overflow = WriteOverflow::WAIT, bool direct_io = false, uint64_t preallocate = 0);
+
+        //!
+        //! Check if the file is currently written in write-behind mode.
+        //! @return True if the file is open and written in write-behind mode. This can be false when
+        //! write-behind was requested using setWriteBehind() but is not possible.
+        //!
+        bool isWriteBehind() const;
+
+        //!
+        //! Get the number of packets which were dropped because the write-behind queue was full.
+        //! Applicable with WriteOverflow::DROP only.
+        //! @return The number of dropped packets since the file was opened.
+        //!
+        PacketCounter writeDroppedCount() const { return _write_dropped; }
+
         //!
         //! Abort any currenly read/write operation in progress.
         //! The file is left in a broken state and can be only closed.
@@ -179,6 +261,7 @@ namespace ts {
 
         // Override TSPacketStream implementation
         virtual size_t readPackets(TSPacket* buffer, TSPacketMetadata* metadata, size_t max_packets, Report& report) override;
+        virtual bool writePackets(const TSPacket* buffer, const TSPacketMetadata* metadata, size_t packet_count, Report& report) override;
 
     private:
         fs::path      _filename {};          //!< Input file name.
@@ -197,10 +280,24 @@ namespace ts {
         bool          _rewindable = false;   //!< Opened in rewindable mode
         bool          _regular = false;      //!< Is a regular file (ie. not a pipe or special device)
         bool          _std_inout = false;    //!< File is standard input or output.
+        ReadMode      _read_mode = ReadMode::STANDARD;  //!< Requested read method.
+        size_t        _write_queue_size = 0; //!< Requested write-behind queue size.
+        WriteOverflow _write_overflow = WriteOverflow::WAIT;  //!< Policy when the write-behind queue is full.
+        bool          _write_direct = false; //!< Requested direct I/O in write-behind mode.
+        uint64_t      _write_prealloc = 0;   //!< Requested preallocation size in write-behind mode.
+        PacketCounter _write_dropped = 0;    //!< Number of dropped packets in write-behind mode.
 #if defined(TS_WINDOWS)
         ::HANDLE      _handle = INVALID_HANDLE_VALUE;
 #else
         int           _fd = -1;
+        uint8_t*      _map_base = nullptr;   //!< Base address of memory-mapped file (ReadMode::MMAP).
+        size_t        _map_size = 0;         //!< Size of memory-mapped file.
+        size_t        _map_pos = 0;          //!< Current read position in memory-mapped file.
+        size_t        _map_released = 0;     //!< Size of already read area which was released from memory.
+        class ReadAhead;
+        std::unique_ptr<ReadAhead> _read_ahead {};  //!< Asynchronous read-ahead state (ReadMode::ASYNC).
+        class WriteBehind;
+        std::unique_ptr<WriteBehind> _write_behind {};  //!< Asynchronous write-behind state.
 #endif
 
         // Implementation of AbstractReadStreamInterface
@@ -218,6 +315,13 @@ namespace ts {
         bool openInternal(bool reopen, Report& report);
         bool seekCheck(Report& report);
         bool seekInternal(uint64_t index, Report& report);
+#if !defined(TS_WINDOWS)
+        void startReadMode(uint64_t file_size, Report& report);
+        void stopReadMode();
+        bool readMapped(void* addr, size_t max_size, size_t& ret_size);
+        void startWriteBehind(Report& report);
+        bool stopWriteBehind(Report& report);
+#endif
 
         // Inaccessible operations. Same as TS_NOCOPY() except that we keep the move constructor (required for vectors).
         TSFile(const TSFile&) = delete;
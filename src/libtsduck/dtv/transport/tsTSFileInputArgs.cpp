@@ -75,6 +75,16 @@ void ts::TSFileInputArgs::defineArgs(Args& args)
               u"Start reading each file at the specified TS packet (default: 0). "
               u"This option is allowed only if all input files are regular files.");
 
+    args.option(u"read-mode", 0, TSFile::ReadModeEnum());
+    args.help(u"read-mode", u"name",
+              u"Specify how the input files are read. "
+              u"With \"mmap\", each file is mapped in memory. This is supported on UNIX systems only. "
+              u"With \"async\", large chunks of each file are asynchronously read in advance using io_uring. "
+              u"This is supported on Linux only, when io_uring is enabled in the kernel. "
+              u"These methods apply to regular files only. They are faster on very large files. "
+              u"When a method is not available, the standard read method is used. "
+              u"The default is \"standard\".");
+
     args.option(u"repeat", 'r', Args::POSITIVE);
     args.help(u"repeat",
               u"Repeat the playout of each file the specified number of times (default: only once). "
@@ -98,6 +108,7 @@ bool ts::TSFileInputArgs::loadArgs(DuckContext& duck, Args& args)
     args.getIntValues(_start_stuffing, u"add-start-stuffing");
     args.getIntValues(_stop_stuffing, u"add-stop-stuffing");
     _file_format = LoadTSPacketFormatInputOption(args);
+    args.getIntValue(_read_mode, u"read-mode", TSFile::ReadMode::STANDARD);
 
     // If there is no file, then this is the standard input, an empty file name.
     if (_filenames.empty()) {
@@ -144,6 +155,7 @@ bool ts::TSFileInputArgs::openFile(size_t name_index, size_t file_index, Report&
 
     // Preset artificial stuffing.
     _files[file_index].setStuffing(_start_stuffing[name_index], _stop_stuffing[name_index]);
+    _files[file_index].setReadMode(_read_mode);
 
     // Actually open the file.
     return _files[file_index].openRead(name, _repeat_count, _start_offset, report, _file_format);
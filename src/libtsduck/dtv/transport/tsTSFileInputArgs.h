@@ -92,6 +92,7 @@ namespace ts {
         uint64_t            _start_offset = 0;
         size_t              _base_label = 0;
         TSPacketFormat      _file_format = TSPacketFormat::AUTODETECT;
+        TSFile::ReadMode    _read_mode = TSFile::ReadMode::STANDARD;
         std::vector<fs::path> _filenames {};
         std::vector<size_t> _start_stuffing {};
         std::vector<size_t> _stop_stuffing {};
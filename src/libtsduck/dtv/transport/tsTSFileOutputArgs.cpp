@@ -92,6 +92,32 @@ void ts::TSFileOutputArgs::defineArgs(Args& args)
               u"Then, the integer part is incremented. "
               u"Example: if the specified file name is foo-027.ts, the various files are named foo-027.ts, foo-028.ts, etc.\n\n"
               u"The options --max-duration and --max-size are mutually exclusive.");
+
+    args.option(u"write-behind", 0, Args::POSITIVE);
+    args.help(u"write-behind", u"bytes",
+              u"Write the output file asynchronously in a separate thread. "
+              u"The packets are queued in large memory buffers and control returns immediately to the previous plugins. "
+              u"The value is the maximum size in bytes of the queue of data waiting to be written. "
+              u"This is useful on slow or bursty storage. This option is supported on UNIX systems only. "
+              u"The options --direct-io, --preallocate and --write-overflow imply write-behind with a default queue of " +
+              UString::Decimal(DEFAULT_WRITE_BEHIND) + u" bytes.");
+
+    args.option(u"write-overflow", 0, TSFile::WriteOverflowEnum());
+    args.help(u"write-overflow", u"name",
+              u"With --write-behind, specify what to do when the queue is full. "
+              u"With \"wait\", the previous plugins are blocked until some data are written. "
+              u"With \"drop\", the packets which do not fit in the queue are dropped. "
+              u"The default is \"wait\".");
+
+    args.option(u"direct-io");
+    args.help(u"direct-io",
+              u"With --write-behind, try to bypass the system cache when writing a regular file (Linux only). "
+              u"If this is not supported by the file system, standard writes are used.");
+
+    args.option(u"preallocate", 0, Args::POSITIVE);
+    args.help(u"preallocate", u"bytes",
+              u"With --write-behind, preallocate disk space by chunks of the specified size in bytes, "
+              u"ahead of the write position in a regular file (Linux only).");
 }
 
 
@@ -112,6 +138,11 @@ bool ts::TSFileOutputArgs::loadArgs(DuckContext& duck, Args& args)
     args.getChronoValue(_max_duration, u"max-duration", 0);
     _file_format = LoadTSPacketFormatOutputOption(args);
     _multiple_files = _max_size > 0 || _max_duration > cn::seconds::zero();
+    _direct_io = args.present(u"direct-io");
+    args.getIntValue(_preallocate, u"preallocate", 0);
+    args.getIntValue(_write_overflow, u"write-overflow", TSFile::WriteOverflow::WAIT);
+    const bool write_behind = _direct_io || _preallocate > 0 || args.present(u"write-overflow");
+    args.getIntValue(_write_queue_size, u"write-behind", write_behind ? DEFAULT_WRITE_BEHIND : 0);
 
     _flags = TSFile::WRITE | TSFile::SHARED;
     if (args.present(u"append")) {
@@ -152,6 +183,7 @@ bool ts::TSFileOutputArgs::open(Report& report, AbortInterface* abort)
     _next_open_time = Time::CurrentUTC();
     _current_files.clear();
     _file.setStuffing(_start_stuffing, _stop_stuffing);
+    _file.setWriteBehind(_write_queue_size, _write_overflow, _direct_io, _preallocate);
     size_t retry_allowed = _retry_max == 0 ? std::numeric_limits<size_t>::max() : _retry_max;
     return openAndRetry(false, retry_allowed, report, abort);
 }
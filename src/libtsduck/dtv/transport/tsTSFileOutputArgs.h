@@ -83,6 +83,11 @@ namespace ts {
         //!
         static constexpr cn::milliseconds DEFAULT_RETRY_INTERVAL = cn::milliseconds(2000);
 
+        //!
+        //! Default write-behind queue size in bytes, when write-behind is implicitly requested.
+        //!
+        static constexpr size_t DEFAULT_WRITE_BEHIND = 16 * 1024 * 1024;
+
     private:
         // Command line options:
         const bool        _allow_stdout;
@@ -98,6 +103,10 @@ namespace ts {
         cn::seconds       _max_duration {0};
         size_t            _max_files = 0;
         bool              _multiple_files = false;
+        size_t            _write_queue_size = 0;
+        TSFile::WriteOverflow _write_overflow = TSFile::WriteOverflow::WAIT;
+        bool              _direct_io = false;
+        uint64_t          _preallocate = 0;
 
         // Working data:
         TSFile            _file {};
@@ -911,6 +911,91 @@ bool ts::TSPacket::isDuplicate(const TSPacket& other) const
 }
 
 
+//----------------------------------------------------------------------------
+// Find the first sequence of equally spaced TS packets in a buffer.
+//----------------------------------------------------------------------------
+
+// Check that a sequence of packets has sync bytes. Return the number of consecutive valid packets.
+namespace {
+    inline size_t CountSync(const uint8_t* data, size_t packet_size, size_t max_count)
+    {
+        size_t count = 0;
+        while (count < max_count && *data == ts::SYNC_BYTE) {
+            ++count;
+            data += packet_size;
+        }
+        return count;
+    }
+}
+
+// Use 128-bit vectors when the target has them, same condition as in DVBCSA2.
+#if defined(TS_GCC) && (defined(__SSE2__) || defined(__ARM_NEON))
+    #define TS_SYNC_VECTOR 1
+namespace {
+    typedef uint8_t SyncVector __attribute__((vector_size(16)));
+    constexpr size_t SYNC_VECTOR_DEPTH = 8; // Max number of packets to check in vectors.
+    inline bool IsZero(const SyncVector& v)
+    {
+        uint64_t w[2];
+        std::memcpy(w, &v, sizeof(w));
+        return (w[0] | w[1]) == 0;
+    }
+}
+#endif
+
+size_t ts::TSPacket::FindSync(const uint8_t* buffer, size_t buffer_size, size_t packet_size, size_t header_size, size_t min_packets)
+{
+    min_packets = std::max<size_t>(min_packets, 1);
+    if (buffer == nullptr || packet_size <= header_size || buffer_size / packet_size < min_packets) {
+        return NPOS;
+    }
+
+    // Last candidate index for the start of the first packet.
+    const size_t last = buffer_size - min_packets * packet_size;
+    size_t start = 0;
+
+#if defined(TS_SYNC_VECTOR)
+    // Check blocks of consecutive candidate positions. In each block, a lane is kept as long as
+    // the sync bytes of all successive packets are 0x47. On random data, most blocks are eliminated
+    // after the first one or two packets. The few remaining lanes are then individually checked.
+    const SyncVector sync = SyncVector{} + SYNC_BYTE;
+    const size_t depth = std::min(min_packets, SYNC_VECTOR_DEPTH);
+    for (; start + sizeof(SyncVector) <= last + 1; start += sizeof(SyncVector)) {
+        SyncVector found = ~SyncVector{};
+        const uint8_t* data = buffer + start + header_size;
+        for (size_t count = 0; count < depth && !IsZero(found); ++count, data += packet_size) {
+            SyncVector bytes;
+            std::memcpy(&bytes, data, sizeof(bytes));
+            found &= SyncVector(bytes == sync);
+        }
+        if (!IsZero(found)) {
+            data = buffer + start + header_size + depth * packet_size;
+            for (size_t i = 0; i < sizeof(SyncVector); ++i) {
+                if (found[i] != 0 && CountSync(data + i, packet_size, min_packets - depth) == min_packets - depth) {
+                    return start + i;
+                }
+            }
+        }
+    }
+#endif
+
+    // Remaining candidate positions (or all of them without vector instructions).
+    while (start <= last) {
+        // Skip to next candidate sync byte.
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(std::memchr(buffer + start + header_size, SYNC_BYTE, last - start + 1));
+        if (data == nullptr) {
+            break;
+        }
+        start = data - buffer - header_size;
+        if (CountSync(data, packet_size, min_packets) == min_packets) {
+            return start;
+        }
+        ++start;
+    }
+    return NPOS;
+}
+
+
 //----------------------------------------------------------------------------
 // Locate contiguous TS packets into a buffer.
 //----------------------------------------------------------------------------
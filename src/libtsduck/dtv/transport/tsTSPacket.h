@@ -816,6 +816,26 @@ namespace ts {
         //!
         static void Copy(uint8_t* dest, const TSPacket* source, size_t count = 1, size_t packet_size = PKT_SIZE);
 
+        //!
+        //! Find the first sequence of equally spaced TS packets in a buffer.
+        //!
+        //! This static method is typically used to recover the synchronization in a corrupted stream.
+        //! When the compiler supports vector extensions on the target CPU, consecutive candidate
+        //! positions are checked in blocks: the sync bytes of all successive packets are compared
+        //! at once for all candidate positions of a block.
+        //!
+        //! @param [in] buffer Address of a buffer containing TS packets, possibly encapsulated.
+        //! @param [in] buffer_size Size in bytes of the buffer.
+        //! @param [in] packet_size Size in bytes of each packet, including its header and trailer,
+        //! typically PKT_SIZE (188), PKT_M2TS_SIZE (192) or PKT_RS_SIZE (204).
+        //! @param [in] header_size Size in bytes of the header before the 0x47 sync byte of each packet,
+        //! typically 0 or M2TS_HEADER_SIZE (4).
+        //! @param [in] min_packets Minimum number of consecutive packets to find. They must fit entirely in the buffer.
+        //! @return Index in bytes of the first packet (including its header) of the first sequence of at least
+        //! @a min_packets packets. Return NPOS if no such sequence is found.
+        //!
+        static size_t FindSync(const uint8_t* buffer, size_t buffer_size, size_t packet_size = PKT_SIZE, size_t header_size = 0, size_t min_packets = 1);
+
         //!
         //! Locate contiguous TS packets into a buffer.
         //!
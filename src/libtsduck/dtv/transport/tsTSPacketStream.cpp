@@ -165,6 +165,50 @@ size_t ts::TSPacketStream::readPackets(TSPacket *buffer, TSPacketMetadata *metad
     bool success = true;
     while (success && max_packets > 0 && !_reader->endOfStream()) {
 
+        // With encapsulated packets (header or trailer), read as many complete frames as
+        // possible directly in the packet buffer. Then, remove the headers and trailers in
+        // place. Each packet is moved backward and never overwrites the next frame.
+        const size_t frame_size = header_size + PKT_SIZE + packetTrailerSize();
+        const size_t frame_count = (max_packets * PKT_SIZE) / frame_size;
+        if (_format != TSPacketFormat::TS && frame_count > 0) {
+            // Make sure that the trailer buffer from first packet is used in second packet.
+            uint8_t* const cbuffer = reinterpret_cast<uint8_t*>(buffer);
+            MemCopy(cbuffer, _trail, _trail_size);
+            success = _reader->readStreamComplete(cbuffer + _trail_size, frame_count * frame_size - _trail_size, read_size, report);
+            read_size += _trail_size;
+            _trail_size = 0;
+            // Count packets. Truncate incomplete packets at end of file.
+            const size_t count = read_size / frame_size;
+            assert(count <= max_packets);
+            for (size_t i = 0; i < count; ++i) {
+                const uint8_t* const frame = cbuffer + i * frame_size;
+                // Extract the metadata before moving the packet over its own header.
+                if (metadata != nullptr) {
+                    if (_format == TSPacketFormat::M2TS) {
+                        // M2TS timestamps are in PCR units.
+                        metadata->reset();
+                        metadata->setInputTimeStamp(PCR(GetUInt32(frame) & 0x3FFFFFFF), TimeSource::M2TS);
+                    }
+                    else if (_format == TSPacketFormat::DUCK) {
+                        metadata->deserialize(frame, TSPacketMetadata::SERIALIZATION_SIZE);
+                    }
+                    else {
+                        metadata->reset();
+                        metadata->setAuxData(frame + PKT_SIZE, RS_SIZE);
+                    }
+                    metadata++;
+                }
+                MemCopy(buffer++, frame + header_size, PKT_SIZE);
+            }
+            read_packets += count;
+            max_packets -= count;
+            if (count < frame_count) {
+                // End of file or error.
+                break;
+            }
+            continue;
+        }
+
         switch (_format) {
             case TSPacketFormat::AUTODETECT: {
                 // Should not get there.
@@ -87,6 +87,48 @@ bool ts::TSPacketWindow::get(size_t index, TSPacket*& pkt, TSPacketMetadata*& md
 }
 
 
+//----------------------------------------------------------------------------
+// Get the PID's of all packets in the window.
+//----------------------------------------------------------------------------
+
+void ts::TSPacketWindow::getPIDs(std::vector<PID>& pids) const
+{
+    pids.resize(_size);
+    PID* out = pids.data();
+
+    // Tight loop over each contiguous range, no per-packet range lookup.
+    for (const auto& range : _ranges) {
+        const uint8_t* b = range.packets->b;
+        for (size_t i = 0; i < range.count; ++i, b += PKT_SIZE) {
+            // Dropped packets have a zero sync byte.
+            const PID pid = GetUInt16(b + 1) & 0x1FFF;
+            *out++ = b[0] == SYNC_BYTE ? pid : PID_MAX;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Select the packets of the window using their PID.
+//----------------------------------------------------------------------------
+
+size_t ts::TSPacketWindow::selectPIDs(std::vector<size_t>& indexes, const PIDSet& pids, bool in_set) const
+{
+    indexes.clear();
+    indexes.reserve(_size);
+
+    for (const auto& range : _ranges) {
+        const uint8_t* b = range.packets->b;
+        for (size_t i = 0; i < range.count; ++i, b += PKT_SIZE) {
+            if (b[0] == SYNC_BYTE && pids[GetUInt16(b + 1) & 0x1FFF] == in_set) {
+                indexes.push_back(range.first + i);
+            }
+        }
+    }
+    return indexes.size();
+}
+
+
 //----------------------------------------------------------------------------
 // Get the physical index of a packet inside a buffer.
 //----------------------------------------------------------------------------
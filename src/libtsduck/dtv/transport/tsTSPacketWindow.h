@@ -89,6 +89,28 @@ namespace ts {
         //!
         bool get(size_t index, TSPacket*& packet, TSPacketMetadata*& metadata) const;
 
+        //!
+        //! Get the PID's of all packets in the window.
+        //! The PID's are extracted in one pass over each physically contiguous range of packets.
+        //! This is much faster than accessing each packet individually.
+        //! @param [out] pids Receives the PID of each packet, indexed by position in the window.
+        //! The value is PID_MAX (an invalid PID value) for packets which were previously dropped.
+        //!
+        void getPIDs(std::vector<PID>& pids) const;
+
+        //!
+        //! Select the packets of the window using their PID.
+        //! The packets are tested in one pass over each physically contiguous range of packets.
+        //! This is much faster than accessing and testing each packet individually.
+        //! @param [out] indexes Receives the indexes in the window of the selected packets, in increasing order.
+        //! Previously dropped packets are never selected.
+        //! @param [in] pids The set of PID's to test.
+        //! @param [in] in_set If true, select the packets with a PID in @a pids.
+        //! If false, select the packets with a PID which is not in @a pids.
+        //! @return The number of selected packets, same as @a indexes.size().
+        //!
+        size_t selectPIDs(std::vector<size_t>& indexes, const PIDSet& pids, bool in_set = true) const;
+
         //!
         //! Get the physical index of a packet inside a buffer.
         //! @param [in] index Index of the packet inside the window, from 0 to size()-1.
@@ -0,0 +1,373 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSSharedMemoryRing.h"
+#include "tsNullReport.h"
+#include "tsSysUtils.h"
+
+#if defined(TS_UNIX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <sys/types.h>
+    #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
+
+
+//----------------------------------------------------------------------------
+// Destructor.
+//----------------------------------------------------------------------------
+
+ts::TSSharedMemoryRing::~TSSharedMemoryRing()
+{
+    close(NULLREP);
+}
+
+
+//----------------------------------------------------------------------------
+// Map and unmap the shared memory, system-specific parts.
+//----------------------------------------------------------------------------
+
+bool ts::TSSharedMemoryRing::mapMemory(bool create, size_t size, Report& report)
+{
+#if defined(TS_WINDOWS)
+
+    if (create) {
+        const uint64_t size64 = uint64_t(size);
+        _handle = ::CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, ::DWORD(size64 >> 32), ::DWORD(size64), _name.wc_str());
+    }
+    else {
+        _handle = ::OpenFileMappingW(FILE_MAP_READ, false, _name.wc_str());
+    }
+    if (_handle == nullptr) {
+        report.error(u"error opening shared memory %s: %s", _name, SysErrorCodeMessage());
+        return false;
+    }
+    void* base = ::MapViewOfFile(_handle, create ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+    if (base == nullptr) {
+        report.error(u"error mapping shared memory %s: %s", _name, SysErrorCodeMessage());
+        ::CloseHandle(_handle);
+        _handle = nullptr;
+        return false;
+    }
+    if (!create) {
+        ::MEMORY_BASIC_INFORMATION info;
+        TS_ZERO(info);
+        ::VirtualQuery(base, &info, sizeof(info));
+        size = info.RegionSize;
+    }
+
+#else
+
+    const std::string name(_name.toUTF8());
+    int fd = -1;
+    if (create) {
+        // Remove a previous ring with the same name. Existing readers keep the previous one.
+        ::shm_unlink(name.c_str());
+        fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    else {
+        fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    }
+    if (fd < 0) {
+        report.error(u"error opening shared memory %s: %s", _name, SysErrorCodeMessage());
+        return false;
+    }
+    bool ok = true;
+    if (create) {
+        if (::ftruncate(fd, ::off_t(size)) < 0) {
+            report.error(u"error resizing shared memory %s: %s", _name, SysErrorCodeMessage());
+            ok = false;
+        }
+    }
+    else {
+        struct stat st;
+        TS_ZERO(st);
+        if (::fstat(fd, &st) < 0) {
+            report.error(u"error getting size of shared memory %s: %s", _name, SysErrorCodeMessage());
+            ok = false;
+        }
+        size = size_t(st.st_size);
+    }
+    void* base = MAP_FAILED;
+    if (ok) {
+        base = ::mmap(nullptr, size, create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if (base == MAP_FAILED) {
+            report.error(u"error mapping shared memory %s: %s", _name, SysErrorCodeMessage());
+            ok = false;
+        }
+    }
+    // The file descriptor is no longer needed once the memory is mapped.
+    ::close(fd);
+    if (!ok) {
+        if (create) {
+            ::shm_unlink(name.c_str());
+        }
+        return false;
+    }
+
+#endif
+
+    _header = reinterpret_cast<Header*>(base);
+    _map_size = size;
+    return true;
+}
+
+void ts::TSSharedMemoryRing::unmapMemory(Report& report)
+{
+#if defined(TS_WINDOWS)
+    if (_header != nullptr && !::UnmapViewOfFile(_header)) {
+        report.error(u"error unmapping shared memory %s: %s", _name, SysErrorCodeMessage());
+    }
+    if (_handle != nullptr) {
+        ::CloseHandle(_handle);
+        _handle = nullptr;
+    }
+#else
+    if (_header != nullptr && ::munmap(_header, _map_size) < 0) {
+        report.error(u"error unmapping shared memory %s: %s", _name, SysErrorCodeMessage());
+    }
+    if (_writer && ::shm_unlink(_name.toUTF8().c_str()) < 0) {
+        report.error(u"error deleting shared memory %s: %s", _name, SysErrorCodeMessage());
+    }
+#endif
+    _header = nullptr;
+    _map_size = 0;
+    _capacity = 0;
+    _packets = nullptr;
+    _mdata = nullptr;
+}
+
+void ts::TSSharedMemoryRing::setAreas()
+{
+    _capacity = _header->capacity;
+    _packets = reinterpret_cast<TSPacket*>(reinterpret_cast<uint8_t*>(_header) + HEADER_SIZE);
+    _mdata = reinterpret_cast<uint8_t*>(_packets + _capacity);
+}
+
+
+//----------------------------------------------------------------------------
+// Open and close the ring.
+//----------------------------------------------------------------------------
+
+bool ts::TSSharedMemoryRing::openWriter(const UString& name, size_t packet_count, Report& report)
+{
+    if (isOpen()) {
+        report.error(u"shared memory ring %s already open", _name);
+        return false;
+    }
+    if (packet_count == 0 || packet_count > std::numeric_limits<uint32_t>::max()) {
+        report.error(u"invalid shared memory ring size: %'d packets", packet_count);
+        return false;
+    }
+
+#if defined(TS_WINDOWS)
+    _name = u"Local\\tsduck-" + name;
+#else
+    _name = u"/tsduck-" + name;
+#endif
+    _writer = true;
+    if (!mapMemory(true, MemorySize(packet_count), report)) {
+        return false;
+    }
+
+    // The memory is initially zero. Initialize the header.
+    _header->magic = MAGIC;
+    _header->version = VERSION;
+    _header->header_size = uint32_t(HEADER_SIZE);
+    _header->capacity = uint32_t(packet_count);
+    _header->reserved_index.store(0, std::memory_order_relaxed);
+    _header->bitrate.store(0, std::memory_order_relaxed);
+    _header->confidence.store(uint32_t(BitRateConfidence::LOW), std::memory_order_relaxed);
+    _header->state.store(ACTIVE, std::memory_order_relaxed);
+    _header->write_index.store(0, std::memory_order_release);
+    setAreas();
+    _index = 0;
+    return true;
+}
+
+bool ts::TSSharedMemoryRing::openReader(const UString& name, Report& report)
+{
+    if (isOpen()) {
+        report.error(u"shared memory ring %s already open", _name);
+        return false;
+    }
+
+#if defined(TS_WINDOWS)
+    _name = u"Local\\tsduck-" + name;
+#else
+    _name = u"/tsduck-" + name;
+#endif
+    _writer = false;
+    if (!mapMemory(false, 0, report)) {
+        return false;
+    }
+
+    // Check the validity of the shared memory.
+    if (_map_size < HEADER_SIZE ||
+        _header->magic != MAGIC ||
+        _header->version != VERSION ||
+        _header->header_size != HEADER_SIZE ||
+        _header->capacity == 0 ||
+        _map_size < MemorySize(_header->capacity))
+    {
+        report.error(u"%s is not a valid TSDuck shared memory ring", _name);
+        unmapMemory(report);
+        return false;
+    }
+
+    setAreas();
+    _index = _header->write_index.load(std::memory_order_acquire);
+    return true;
+}
+
+bool ts::TSSharedMemoryRing::close(Report& report)
+{
+    if (_header != nullptr) {
+        if (_writer) {
+            _header->state.store(TERMINATED, std::memory_order_release);
+        }
+        unmapMemory(report);
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Writer side.
+//----------------------------------------------------------------------------
+
+bool ts::TSSharedMemoryRing::write(const TSPacket* packets, const TSPacketMetadata* mdata, size_t count)
+{
+    if (!isWriter()) {
+        return false;
+    }
+
+    // Only the last capacity() packets can be seen by the readers.
+    if (count > _capacity) {
+        packets += count - _capacity;
+        if (mdata != nullptr) {
+            mdata += count - _capacity;
+        }
+        _index += count - _capacity;
+        count = _capacity;
+    }
+
+    // Announce the packets which will be overwritten before writing them.
+    // A reader which copies them in the meantime will detect it and drop them.
+    const uint64_t end = _index + count;
+    _header->reserved_index.store(end, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    static const TSPacketMetadata default_mdata;
+    while (count > 0) {
+        const size_t slot = size_t(_index % _capacity);
+        const size_t chunk = std::min(count, _capacity - slot);
+        TSPacket::Copy(_packets + slot, packets, chunk);
+        for (size_t i = 0; i < chunk; ++i) {
+            (mdata == nullptr ? default_mdata : mdata[i]).serialize(_mdata + (slot + i) * MDATA_SLOT_SIZE, MDATA_SLOT_SIZE);
+        }
+        packets += chunk;
+        if (mdata != nullptr) {
+            mdata += chunk;
+        }
+        _index += chunk;
+        count -= chunk;
+    }
+
+    // Publish the new packets.
+    _header->write_index.store(end, std::memory_order_release);
+    return true;
+}
+
+void ts::TSSharedMemoryRing::setBitrate(const BitRate& bitrate, BitRateConfidence confidence)
+{
+    if (isWriter()) {
+        _header->bitrate.store(uint64_t(bitrate.toInt()), std::memory_order_relaxed);
+        _header->confidence.store(uint32_t(confidence), std::memory_order_relaxed);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Reader side.
+//----------------------------------------------------------------------------
+
+size_t ts::TSSharedMemoryRing::read(TSPacket* packets, TSPacketMetadata* mdata, size_t max_count, uint64_t& lost)
+{
+    lost = 0;
+    if (!isOpen() || _writer || max_count == 0) {
+        return 0;
+    }
+
+    // Get the available packets. If we are late by more than a full ring, skip the lost packets.
+    const uint64_t windex = _header->write_index.load(std::memory_order_acquire);
+    if (windex < _index) {
+        // Should not happen, the ring was corrupted. Resynchronize.
+        _index = windex;
+        return 0;
+    }
+    if (windex - _index > _capacity) {
+        lost = windex - _index - _capacity;
+        _index = windex - _capacity;
+    }
+    size_t count = size_t(std::min<uint64_t>(max_count, windex - _index));
+
+    // Copy packets and metadata from the shared memory.
+    for (size_t done = 0; done < count; ) {
+        const size_t slot = size_t((_index + done) % _capacity);
+        const size_t chunk = std::min(count - done, _capacity - slot);
+        TSPacket::Copy(packets + done, _packets + slot, chunk);
+        if (mdata != nullptr) {
+            for (size_t i = 0; i < chunk; ++i) {
+                mdata[done + i].deserialize(_mdata + (slot + i) * MDATA_SLOT_SIZE, TSPacketMetadata::SERIALIZATION_SIZE);
+            }
+        }
+        done += chunk;
+    }
+
+    // Check if the writer has started to overwrite some of the packets we copied.
+    // These packets are possibly corrupted and must be dropped.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t rindex = _header->reserved_index.load(std::memory_order_relaxed);
+    if (rindex > _capacity && _index < rindex - _capacity) {
+        const size_t overwritten = size_t(std::min<uint64_t>(count, rindex - _capacity - _index));
+        if (overwritten < count) {
+            std::memmove(packets, packets + overwritten, (count - overwritten) * PKT_SIZE);
+            if (mdata != nullptr) {
+                std::move(mdata + overwritten, mdata + count, mdata);
+            }
+        }
+        _index += overwritten;
+        lost += overwritten;
+        count -= overwritten;
+    }
+
+    _index += count;
+    return count;
+}
+
+bool ts::TSSharedMemoryRing::endOfStream() const
+{
+    // The writer sets the state after publishing the last packets.
+    return isOpen() && !_writer &&
+        _header->state.load(std::memory_order_acquire) == TERMINATED &&
+        _header->write_index.load(std::memory_order_acquire) == _index;
+}
+
+ts::BitRate ts::TSSharedMemoryRing::bitrate() const
+{
+    return isOpen() ? BitRate(_header->bitrate.load(std::memory_order_relaxed)) : BitRate(0);
+}
+
+ts::BitRateConfidence ts::TSSharedMemoryRing::bitrateConfidence() const
+{
+    return isOpen() ? BitRateConfidence(_header->confidence.load(std::memory_order_relaxed)) : BitRateConfidence::LOW;
+}
@@ -0,0 +1,199 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Ring buffer of TS packets in a named shared memory.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSPacket.h"
+#include "tsTSPacketMetadata.h"
+#include "tsBitRate.h"
+#include "tsReport.h"
+
+namespace ts {
+    //!
+    //! Ring buffer of TS packets and their metadata in a named shared memory.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! The ring is used to exchange TS packets between processes on the same system,
+    //! typically several instances of @c tsp. There is one writer and any number of readers.
+    //! The writer creates the shared memory and never blocks: when a reader is too slow,
+    //! it loses packets which are overwritten by the writer. The readers never modify the
+    //! shared memory. All synchronization is done using lock-free atomic cursors.
+    //!
+    //! On UNIX systems, the ring is a POSIX shared memory object named "/tsduck-<name>".
+    //! On Windows, it is a named file mapping "Local\tsduck-<name>".
+    //!
+    class TSDUCKDLL TSSharedMemoryRing
+    {
+        TS_NOCOPY(TSSharedMemoryRing);
+    public:
+        //!
+        //! Default constructor.
+        //!
+        TSSharedMemoryRing() = default;
+
+        //!
+        //! Destructor.
+        //!
+        ~TSSharedMemoryRing();
+
+        //!
+        //! Default number of packets in a ring.
+        //!
+        static constexpr size_t DEFAULT_PACKET_COUNT = 50'000;
+
+        //!
+        //! Create a ring as writer.
+        //! If a ring with the same name already exists, it is replaced.
+        //! Readers which are still attached to the previous ring see it as terminated.
+        //! @param [in] name Name of the ring.
+        //! @param [in] packet_count Capacity of the ring in packets.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool openWriter(const UString& name, size_t packet_count, Report& report);
+
+        //!
+        //! Attach to an existing ring as reader.
+        //! The reader starts at the current write position in the ring.
+        //! Packets which were previously written in the ring are ignored.
+        //! @param [in] name Name of the ring.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool openReader(const UString& name, Report& report);
+
+        //!
+        //! Close the ring.
+        //! When closed by the writer, the readers see the end of stream after reading
+        //! all remaining packets and the name of the ring is removed.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool close(Report& report);
+
+        //!
+        //! Check if the ring is open.
+        //! @return True if the ring is open.
+        //!
+        bool isOpen() const { return _header != nullptr; }
+
+        //!
+        //! Check if the ring is open as writer.
+        //! @return True if the ring is open as writer.
+        //!
+        bool isWriter() const { return _header != nullptr && _writer; }
+
+        //!
+        //! Get the capacity of the ring.
+        //! @return The capacity of the ring in packets, zero if not open.
+        //!
+        size_t capacity() const { return _capacity; }
+
+        //!
+        //! Write packets in the ring (writer only).
+        //! This method never blocks. When there are more than capacity() packets,
+        //! only the last capacity() packets are kept for the readers.
+        //! @param [in] packets Address of the first packet to write.
+        //! @param [in] mdata Address of the metadata of the first packet to write. Can be null.
+        //! @param [in] count Number of packets to write.
+        //! @return True on success, false if the ring is not open as writer.
+        //!
+        bool write(const TSPacket* packets, const TSPacketMetadata* mdata, size_t count);
+
+        //!
+        //! Publish the bitrate of the stream in the ring (writer only).
+        //! @param [in] bitrate Bitrate of the stream.
+        //! @param [in] confidence Confidence in the bitrate value.
+        //!
+        void setBitrate(const BitRate& bitrate, BitRateConfidence confidence);
+
+        //!
+        //! Read packets from the ring (reader only).
+        //! This method never blocks. It returns zero when no packet is available.
+        //! @param [out] packets Address of the buffer receiving the packets.
+        //! @param [out] mdata Address of the buffer receiving the metadata of the packets. Can be null.
+        //! @param [in] max_count Maximum number of packets to read.
+        //! @param [out] lost Number of packets which were overwritten by the writer before being read.
+        //! @return Number of read packets.
+        //!
+        size_t read(TSPacket* packets, TSPacketMetadata* mdata, size_t max_count, uint64_t& lost);
+
+        //!
+        //! Check if the end of stream is reached (reader only).
+        //! @return True if the writer has closed the ring and all packets were read.
+        //!
+        bool endOfStream() const;
+
+        //!
+        //! Get the bitrate which was published by the writer.
+        //! @return The bitrate of the stream or zero if unknown.
+        //!
+        BitRate bitrate() const;
+
+        //!
+        //! Get the confidence in the bitrate which was published by the writer.
+        //! @return The confidence in the bitrate value.
+        //!
+        BitRateConfidence bitrateConfidence() const;
+
+    private:
+        // Header of the shared memory. The size of the header is one page.
+        // The header is followed by the packets, then the serialized metadata.
+        struct Header
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t header_size;
+            uint32_t capacity;
+            std::atomic<uint64_t> reserved_index;   // Packets up to this index may be written (being overwritten).
+            std::atomic<uint64_t> write_index;      // Packets up to this index are completely written.
+            std::atomic<uint64_t> bitrate;          // In bits/second.
+            std::atomic<uint32_t> confidence;       // BitRateConfidence value.
+            std::atomic<uint32_t> state;            // ACTIVE or TERMINATED.
+        };
+        static_assert(std::atomic<uint64_t>::is_always_lock_free, "64-bit atomic values must be lock-free in shared memory");
+        static_assert(std::atomic<uint32_t>::is_always_lock_free, "32-bit atomic values must be lock-free in shared memory");
+
+        static constexpr uint32_t MAGIC = 0x54535348;        // "TSSH"
+        static constexpr uint32_t VERSION = 1;
+        static constexpr uint32_t ACTIVE = 0;
+        static constexpr uint32_t TERMINATED = 1;
+        static constexpr size_t HEADER_SIZE = 4096;
+        static constexpr size_t MDATA_SLOT_SIZE = 16;        // Serialized TSPacketMetadata, rounded up.
+        static_assert(sizeof(Header) <= HEADER_SIZE);
+        static_assert(TSPacketMetadata::SERIALIZATION_SIZE <= MDATA_SLOT_SIZE);
+
+        bool      _writer = false;
+        UString   _name {};              // System name of the shared memory.
+        Header*   _header = nullptr;     // Base of the shared memory.
+        size_t    _map_size = 0;         // Size of the shared memory.
+        size_t    _capacity = 0;         // Capacity in packets.
+        TSPacket* _packets = nullptr;    // Packets area in shared memory.
+        uint8_t*  _mdata = nullptr;      // Metadata area in shared memory.
+        uint64_t  _index = 0;            // Next index to write or read.
+#if defined(TS_WINDOWS)
+        ::HANDLE  _handle = nullptr;     // File mapping handle.
+#endif
+
+        // Compute the total shared memory size for a given capacity.
+        static size_t MemorySize(size_t capacity) { return HEADER_SIZE + capacity * (PKT_SIZE + MDATA_SLOT_SIZE); }
+
+        // Map the shared memory. Set _header and _map_size.
+        bool mapMemory(bool create, size_t size, Report& report);
+
+        // Unmap the shared memory and release system resources.
+        void unmapMemory(Report& report);
+
+        // Set the pointers to the packets and metadata areas from the header.
+        void setAreas();
+    };
+}
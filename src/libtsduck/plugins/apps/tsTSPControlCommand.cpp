@@ -35,6 +35,17 @@ ts::TSPControlCommand::TSPControlCommand(Report& report) :
 
     arg = command(u"list", u"List all running plugins", u"[options]", flags);
 
+    arg = command(u"stats", u"Display execution statistics of plugins", u"[options] [plugin-index ...]", flags);
+    arg->setIntro(u"Display execution statistics of plugins. "
+                  u"The tsp process shall have been started with the option --plugin-statistics. "
+                  u"By default, display the statistics of all plugins.");
+    arg->option(u"", 0, Args::UNSIGNED, 0, Args::UNLIMITED_COUNT);
+    arg->help(u"", u"Index of a plugin for which statistics are displayed.");
+    arg->option(u"json", 'j');
+    arg->help(u"json", u"Display the statistics in JSON format.");
+    arg->option(u"reset", 'r');
+    arg->help(u"reset", u"Reset the statistics of the selected plugins after displaying them.");
+
     arg = command(u"suspend", u"Suspend a plugin", u"[options] plugin-index", flags);
     arg->setIntro(u"Suspend a plugin. When a packet processing plugin is suspended, "
                   u"the TS packets are directly passed from the previous to the next plugin, "
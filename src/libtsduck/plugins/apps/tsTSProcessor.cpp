@@ -12,6 +12,7 @@
 #include "tstspProcessorExecutor.h"
 #include "tstspControlServer.h"
 #include "tsFatal.h"
+#include "tsSysInfo.h"
 
 
 //----------------------------------------------------------------------------
@@ -77,6 +78,37 @@ void ts::TSProcessor::cleanupInternal()
 }
 
 
+//----------------------------------------------------------------------------
+// Build the thread attributes of a plugin executor.
+//----------------------------------------------------------------------------
+
+ts::ThreadAttributes ts::TSProcessor::executorAttributes(size_t index, const UString& name, int priority)
+{
+    ThreadAttributes attr;
+    attr.setPriority(priority);
+
+    // An explicit --cpu-affinity overrides the CPU's of the NUMA node.
+    // NUMA node numbers may be sparse, a missing node has no CPU and is not used to pin threads.
+    if (index < _args.cpu_affinity.size()) {
+        attr.setCPUs(_args.cpu_affinity[index]);
+    }
+    else if (_args.numa_node >= 0) {
+        const std::set<size_t>& cpus(SysInfo::Instance().numaNodeCPUs(size_t(_args.numa_node)));
+        if (cpus.empty()) {
+            _report.verbose(u"tsp: NUMA node %d has no CPU, plugin %d (%s) not bound", _args.numa_node, index, name);
+        }
+        else {
+            attr.setCPUs(cpus);
+        }
+    }
+
+    if (!attr.getCPUs().empty()) {
+        _report.verbose(u"tsp: plugin %d (%s) bound to CPU's %s", index, name, SysInfo::FormatCPUList(attr.getCPUs()));
+    }
+    return attr;
+}
+
+
 //----------------------------------------------------------------------------
 // Start the TS processing.
 //----------------------------------------------------------------------------
@@ -102,6 +134,9 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         // Clear errors on the report, used to check further initialisation errors.
         _report.resetErrors();
 
+        // Forget the "joint termination" state of a previous session in the same process.
+        tsp::JointTermination::ResetJointTermination();
+
         // Load all plugins and analyze their command line arguments.
         // The first plugin is always the input and the last one is the output.
         // The input thread has the highest priority to be always ready to load
@@ -109,10 +144,16 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         // plugin has a hight priority to make room in the buffer, but not as
         // high as the input which must remain the top-most priority?
 
-        _input = new tsp::InputExecutor(_args, *this, _args.input, ThreadAttributes().setPriority(ts::ThreadAttributes::GetMaximumPriority()), _global_mutex, &_report);
+        // The NUMA node of the global buffers and executor threads.
+        if (_args.numa_auto) {
+            const size_t node = SysInfo::Instance().cpuNUMANode(SysInfo::CurrentCPU());
+            _args.numa_node = node == NPOS ? -1 : int(node);
+        }
+
+        _input = new tsp::InputExecutor(_args, *this, _args.input, executorAttributes(0, _args.input.name, ThreadAttributes::GetMaximumPriority()), _global_mutex, &_report);
         CheckNonNull(_input);
 
-        _output = new tsp::OutputExecutor(_args, *this, _args.output, ThreadAttributes().setPriority(ts::ThreadAttributes::GetHighPriority()), _global_mutex, &_report);
+        _output = new tsp::OutputExecutor(_args, *this, _args.output, executorAttributes(_args.plugins.size() + 1, _args.output.name, ThreadAttributes::GetHighPriority()), _global_mutex, &_report);
         CheckNonNull(_output);
 
         _output->ringInsertAfter(_input);
@@ -121,7 +162,7 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         bool realtime = _args.realtime == Tristate::True || _input->isRealTime() || _output->isRealTime();
 
         for (size_t i = 0; i < _args.plugins.size(); ++i) {
-            tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *this, i, ThreadAttributes(), _global_mutex, &_report);
+            tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *this, i, executorAttributes(i + 1, _args.plugins[i].name, ThreadAttributes::GetNormalPriority()), _global_mutex, &_report);
             CheckNonNull(p);
             p->ringInsertBefore(_output);
             realtime = realtime || p->isRealTime();
@@ -157,17 +198,23 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         } while ((proc = proc->ringNext<ts::tsp::PluginExecutor>()) != _input);
 
         // Allocate a memory-resident buffer of TS packets
-        _packet_buffer = new PacketBuffer(_args.ts_buffer_size / ts::PKT_SIZE);
+        _packet_buffer = new PacketBuffer(_args.ts_buffer_size / ts::PKT_SIZE, _args.huge_pages, _args.numa_node);
         CheckNonNull(_packet_buffer);
         if (!_packet_buffer->isLocked()) {
             _report.debug(u"tsp: buffer failed to lock into physical memory (%d: %s), risk of real-time issue",
                           _packet_buffer->lockErrorCode().value(), _packet_buffer->lockErrorCode().message());
         }
         _report.debug(u"tsp: buffer size: %'d TS packets, %'d bytes", _packet_buffer->count(), _packet_buffer->count() * ts::PKT_SIZE);
+        _report.debug(u"tsp: packet hand-off between plugins: %s", _args.lock_free ? u"lock-free" : u"global mutex");
+        if (_args.huge_pages || _args.numa_node >= 0) {
+            _report.verbose(u"tsp: buffer using %s pages, NUMA node: %s",
+                            _packet_buffer->isHugePages() ? u"huge" : u"normal",
+                            _packet_buffer->numaNode() < 0 ? UString(u"default") : UString::Decimal(_packet_buffer->numaNode()));
+        }
 
         // Buffer for the packet metadata.
         // A packet and its metadata have the same index in their respective buffer.
-        _metadata_buffer = new PacketMetadataBuffer(_packet_buffer->count());
+        _metadata_buffer = new PacketMetadataBuffer(_packet_buffer->count(), _args.huge_pages, _args.numa_node);
         CheckNonNull(_metadata_buffer);
 
         // End of locked section.
@@ -15,6 +15,7 @@
 #include "tsPluginEventHandlerRegistry.h"
 #include "tsTSProcessorArgs.h"
 #include "tsTSPacketMetadata.h"
+#include "tsThreadAttributes.h"
 
 namespace ts {
 
@@ -99,5 +100,8 @@ namespace ts {
 
         // Deallocate and cleanup internal resources.
         void cleanupInternal();
+
+        // Build the thread attributes of the plugin executor at the given index in the chain.
+        ThreadAttributes executorAttributes(size_t index, const UString& name, int priority);
     };
 }
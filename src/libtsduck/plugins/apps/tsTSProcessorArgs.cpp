@@ -8,6 +8,7 @@
 
 #include "tsTSProcessorArgs.h"
 #include "tsArgsWithPlugins.h"
+#include "tsSysInfo.h"
 
 #define DEF_MAX_FLUSH_PKT_OFL  10000  // packets
 #define DEF_MAX_FLUSH_PKT_RT    1000  // packets
@@ -89,11 +90,29 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"Specify the reception timeout for control commands. "
               u"The default timeout is " + UString::Chrono(DEFAULT_CONTROL_TIMEOUT, true) + u".");
 
+    args.option(u"cpu-affinity", 0, Args::STRING, 0, Args::UNLIMITED_COUNT);
+    args.help(u"cpu-affinity", u"cpu-list",
+              u"Bind the thread of a plugin to a set of CPU's. "
+              u"The first --cpu-affinity option applies to the input plugin, the next ones apply to the "
+              u"packet processor plugins in order and the last one to the output plugin. "
+              u"The value is a comma-separated list of CPU indexes or ranges, for instance \"0-3,8\". "
+              u"The value \"any\" means no specific CPU for the corresponding plugin. "
+              u"Plugins without a corresponding --cpu-affinity option use the CPU's of the --numa-node, if specified.");
+
     args.option<cn::milliseconds>(u"final-wait");
     args.help(u"final-wait",
               u"Wait the specified duration after the last input packet. "
               u"Zero means wait forever.");
 
+    args.option(u"huge-pages");
+    args.help(u"huge-pages",
+              u"Allocate the global TS packet buffer and its metadata using huge pages. "
+              u"This reduces the TLB misses with large buffers and high bitrates. "
+              u"Explicit huge pages are used when some are reserved by the system administrator, "
+              u"transparent huge pages are requested otherwise. "
+              u"When huge pages cannot be used, the buffers use normal pages. "
+              u"This option is currently implemented on Linux only.");
+
     args.option(u"ignore-joint-termination", 'i');
     args.help(u"ignore-joint-termination",
               u"Ignore all --joint-termination options in plugins. "
@@ -114,6 +133,13 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"a valid bitrate value from the beginning. "
               u"The default initial load is half the size of the global buffer.");
 
+    args.option(u"lock-free");
+    args.help(u"lock-free",
+              u"Pass packets between plugins using lock-free cursors on the global buffer "
+              u"instead of a global mutex. Each boundary between two consecutive plugins is "
+              u"then accessed by these two plugins only. This may reduce the contention "
+              u"between threads with long chains of plugins at high bitrates.");
+
     args.option(u"log-plugin-index");
     args.help(u"log-plugin-index",
               u"In log messages, add the plugin index to the plugin name. "
@@ -148,6 +174,25 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"This option is useful only when an output plugin or device has problems with large output requests. "
               u"This option forces multiple smaller send operations.");
 
+    args.option(u"numa-node", 0, Args::STRING);
+    args.help(u"numa-node", u"node|auto",
+              u"Allocate the global TS packet buffer on the specified NUMA node and bind all plugin threads "
+              u"to the CPU's of this node. With the value \"auto\", use the NUMA node of the CPU on which tsp starts. "
+              u"The option --cpu-affinity overrides the CPU's of individual plugins. "
+              u"The memory placement is currently implemented on Linux only.");
+
+    args.option(u"plugin-statistics");
+    args.help(u"plugin-statistics",
+              u"Collect execution statistics on each plugin: processing time and thread CPU time per packet batch, "
+              u"wait time, buffer occupancy and packets per second. "
+              u"The statistics are available using the control command 'stats' (see tspcontrol). "
+              u"The overhead of the statistics collection is small but, without this option, no statistics is collected.");
+
+    args.option<cn::seconds>(u"plugin-statistics-interval");
+    args.help(u"plugin-statistics-interval",
+              u"Periodically log the execution statistics of all plugins as one JSON line. "
+              u"This option implies --plugin-statistics.");
+
     args.option(u"realtime", 'r', Args::TRISTATE, 0, 1, -255, 256, true);
     args.help(u"realtime",
               u"Specifies if tsp and all plugins should use default values for real-time "
@@ -168,6 +213,7 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
 {
     app_name = args.appName();
     log_plugin_index = args.present(u"log-plugin-index");
+    lock_free = args.present(u"lock-free");
     ts_buffer_size = args.intValue<size_t>(u"buffer-size-mb", DEFAULT_BUFFER_SIZE);
     args.getValue(fixed_bitrate, u"bitrate", 0);
     args.getChronoValue(bitrate_adj, u"bitrate-adjust-interval", DEFAULT_BITRATE_INTERVAL);
@@ -185,6 +231,9 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
     args.getIntValue(control_port, u"control-port", 0);
     args.getChronoValue(control_timeout, u"control-timeout", DEFAULT_CONTROL_TIMEOUT);
     control_reuse = args.present(u"control-reuse-port");
+    huge_pages = args.present(u"huge-pages");
+    args.getChronoValue(plugin_stats_interval, u"plugin-statistics-interval");
+    plugin_stats = args.present(u"plugin-statistics") || plugin_stats_interval > cn::seconds::zero();
 
     // Convert MB in MiB for buffer size for compatibility with original versions.
     ts_buffer_size = size_t((uint64_t(ts_buffer_size) * 1024 * 1024) / 1000000);
@@ -208,6 +257,33 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
         args.error(u"invalid value for --add-input-stuffing, use \"nullpkt/inpkt\" format");
     }
 
+    // Decode --numa-node node|auto.
+    const UString numa(args.value(u"numa-node"));
+    numa_node = -1;
+    numa_auto = numa.similar(u"auto");
+    if (!numa.empty() && !numa_auto && (!numa.toInteger(numa_node) || numa_node < 0)) {
+        args.error(u"invalid value for --numa-node, use a NUMA node index or \"auto\"");
+        numa_node = -1;
+    }
+    else if (numa_node >= int(SysInfo::Instance().numaNodeCount())) {
+        args.error(u"invalid NUMA node %d, there are only %d nodes in this system", numa_node, SysInfo::Instance().numaNodeCount());
+        numa_node = -1;
+    }
+    else if (numa_node >= 0 && SysInfo::Instance().numaNodeCPUs(size_t(numa_node)).empty()) {
+        args.error(u"NUMA node %d does not exist or has no CPU", numa_node);
+        numa_node = -1;
+    }
+
+    // Decode --cpu-affinity options.
+    cpu_affinity.resize(args.count(u"cpu-affinity"));
+    for (size_t i = 0; i < cpu_affinity.size(); ++i) {
+        const UString list(args.value(u"cpu-affinity", u"", i));
+        cpu_affinity[i].clear();
+        if (!list.similar(u"any") && !SysInfo::DecodeCPUList(cpu_affinity[i], list)) {
+            args.error(u"invalid CPU list \"%s\" in --cpu-affinity", list);
+        }
+    }
+
     // Load all plugin descriptions.
     // The default input and output are the standard input and output files.
     ArgsWithPlugins* pargs = dynamic_cast<ArgsWithPlugins*>(&args);
@@ -30,6 +30,13 @@ namespace ts {
         UString           app_name {};              //!< Application name, for help messages.
         bool              ignore_jt = false;        //!< Ignore "joint termination" options in plugins.
         bool              log_plugin_index = false; //!< Log plugin index with plugin name.
+        bool              lock_free = false;        //!< Pass packets between plugins using lock-free cursors instead of the global mutex.
+        bool              huge_pages = false;       //!< Allocate the global TS packet buffer and metadata buffer using huge pages.
+        int               numa_node = -1;           //!< NUMA node for the global buffers and the executor threads, negative means none.
+        bool              numa_auto = false;        //!< Use the NUMA node of the CPU which starts the processing.
+        std::vector<std::set<size_t>> cpu_affinity {}; //!< CPU's for each executor thread, in plugin chain order. An empty set means any CPU.
+        bool              plugin_stats = false;     //!< Collect execution statistics on each plugin.
+        cn::seconds       plugin_stats_interval {}; //!< Interval between two JSON log lines of plugin statistics, zero means none.
         size_t            ts_buffer_size = DEFAULT_BUFFER_SIZE; //!< Size in bytes of the global TS packet buffer.
         size_t            max_flush_pkt = 0;        //!< Max processed packets before flush.
         size_t            max_input_pkt = 0;        //!< Max packets per input operation.
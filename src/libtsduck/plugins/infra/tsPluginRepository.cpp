@@ -9,8 +9,10 @@
 #include "tsPluginRepository.h"
 #include "tsApplicationSharedLibrary.h"
 #include "tsEnvironment.h"
+#include "tsFileUtils.h"
 #include "tsAlgorithm.h"
 #include "tsCerrReport.h"
+#include "tsCRC32.h"
 
 TS_DEFINE_SINGLETON(ts::PluginRepository);
 ts::PluginRepository::PluginRepository() {}
@@ -40,9 +42,20 @@ const ts::Names& ts::PluginRepository::ListProcessorEnum()
 // Plugin registration.
 //----------------------------------------------------------------------------
 
+// Record a plugin registration in the plugin index while loading all plugins.
+template <typename FACTORY>
+void ts::PluginRepository::indexPlugin(int type, const UString& name, FACTORY allocator)
+{
+    if (_indexing != nullptr && allocator != nullptr) {
+        // Duplicated plugins are also recorded: a plugin library may be indexed after the same plugin was statically linked.
+        _indexing->push_back({type, name, _loadingLibrary, UString(), allocator});
+    }
+}
+
 void ts::PluginRepository::registerInput(const UString& name, InputPluginFactory allocator)
 {
     CERR.debug(u"registering input plugin \"%s\", status: %s", name, allocator != nullptr ? u"ok" : u"error, no allocator");
+    indexPlugin(LIST_INPUT, name, allocator);
     if (allocator != nullptr) {
         if (_inputPlugins[name] == nullptr) {
             _inputPlugins[name] = allocator;
@@ -56,6 +69,7 @@ void ts::PluginRepository::registerInput(const UString& name, InputPluginFactory
 void ts::PluginRepository::registerProcessor(const UString& name, ProcessorPluginFactory allocator)
 {
     CERR.debug(u"registering processor plugin \"%s\", status: %s", name, allocator != nullptr ? u"ok" : u"error, no allocator");
+    indexPlugin(LIST_PACKET, name, allocator);
     if (allocator != nullptr) {
         if (_processorPlugins[name] == nullptr) {
             _processorPlugins[name] = allocator;
@@ -69,6 +83,7 @@ void ts::PluginRepository::registerProcessor(const UString& name, ProcessorPlugi
 void ts::PluginRepository::registerOutput(const UString& name, OutputPluginFactory allocator)
 {
     CERR.debug(u"registering output plugin \"%s\", status: %s", name, allocator != nullptr ? u"ok" : u"error, no allocator");
+    indexPlugin(LIST_OUTPUT, name, allocator);
     if (allocator != nullptr) {
         if (_outputPlugins[name] == nullptr) {
             _outputPlugins[name] = allocator;
@@ -99,8 +114,13 @@ ts::PluginRepository::Register::Register(const UString& name, OutputPluginFactor
 // Get plugins by name.
 //----------------------------------------------------------------------------
 
+ts::UString ts::PluginRepository::TypeName(int type)
+{
+    return type == LIST_INPUT ? u"input" : (type == LIST_OUTPUT ? u"output" : u"processor");
+}
+
 template<typename FACTORY>
-FACTORY ts::PluginRepository::getFactory(const UString& plugin_name, const UString& plugin_type, const std::map<UString,FACTORY>& plugin_map, Report& report)
+FACTORY ts::PluginRepository::getFactory(const UString& plugin_name, int plugin_type, const std::map<UString,FACTORY>& plugin_map, Report& report)
 {
     // Search plugin in current cache.
     auto it = plugin_map.find(plugin_name);
@@ -118,11 +138,27 @@ FACTORY ts::PluginRepository::getFactory(const UString& plugin_name, const UStri
             it = plugin_map.find(plugin_name);
         }
         else {
-            report.error(shlib.errorMessage());
+            // The plugin may be registered by a shared library with another name, look for it in the plugin index.
+            UString library;
+            if (loadIndex(false, report)) {
+                for (const auto& entry : _index) {
+                    if (entry.type == plugin_type && entry.name == plugin_name) {
+                        library = entry.library;
+                        break;
+                    }
+                }
+            }
+            if (!library.empty()) {
+                SharedLibrary lib(library, SharedLibraryFlags::PERMANENT, report);
+                CERR.debug(u"loaded plugin file \"%s\" from plugin index, status: %s", library, lib.isLoaded());
+            }
+            else {
+                report.error(shlib.errorMessage());
+            }
             // If a shared library was loaded but registered its plugin with the wrong name,
             // then plugin_map was modified but the previous 'plugin_map.end()' in invalidated.
-            // So, just to make sure  we don't fail on invalid plugins, reassign it.
-            it = plugin_map.end();
+            // So, just to make sure  we don't fail on invalid plugins, search again.
+            it = plugin_map.find(plugin_name);
         }
     }
 
@@ -132,24 +168,24 @@ FACTORY ts::PluginRepository::getFactory(const UString& plugin_name, const UStri
         return it->second;
     }
     else {
-        report.error(u"%s plugin %s not found", plugin_type, plugin_name);
+        report.error(u"%s plugin %s not found", TypeName(plugin_type), plugin_name);
         return nullptr;
     }
 }
 
 ts::PluginRepository::InputPluginFactory ts::PluginRepository::getInput(const UString& name, Report& report)
 {
-    return getFactory(name, u"input", _inputPlugins, report);
+    return getFactory(name, LIST_INPUT, _inputPlugins, report);
 }
 
 ts::PluginRepository::ProcessorPluginFactory ts::PluginRepository::getProcessor(const UString& name, Report& report)
 {
-    return getFactory(name, u"processor", _processorPlugins, report);
+    return getFactory(name, LIST_PACKET, _processorPlugins, report);
 }
 
 ts::PluginRepository::OutputPluginFactory ts::PluginRepository::getOutput(const UString& name, Report& report)
 {
-    return getFactory(name, u"output", _outputPlugins, report);
+    return getFactory(name, LIST_OUTPUT, _outputPlugins, report);
 }
 
 
@@ -193,6 +229,17 @@ namespace {
         virtual bool useJointTermination() const override { return false; }
         virtual bool thisJointTerminated() const override { return false; }
     };
+
+    // Get the descriptions of registered plugins.
+    template <typename FACTORY>
+    void GetDescriptions(std::map<ts::UString, ts::UString>& descriptions, const std::map<ts::UString, FACTORY>& plugins, ts::TSP& tsp)
+    {
+        for (const auto& it : plugins) {
+            ts::Plugin* p = it.second(&tsp);
+            descriptions[it.first] = p->getDescription();
+            delete p;
+        }
+    }
 }
 
 
@@ -211,11 +258,158 @@ void ts::PluginRepository::loadAllPlugins(Report& report)
     UStringVector files;
     ApplicationSharedLibrary::GetPluginList(files, u"tsplugin_", PLUGINS_PATH_ENVIRONMENT_VARIABLE);
 
-    // Load all plugins, let them register their plugins.
-    for (size_t i = 0; i < files.size(); ++i) {
+    // Load all plugins, let them register their plugins. Meanwhile, record the registrations
+    // to rebuild the plugin index. The new index is complete only if each shared library
+    // registers its plugins now, meaning that it was not already loaded.
+    IndexEntryList index;
+    bool complete = true;
+    _indexing = &index;
+    for (const auto& file : files) {
         // Permanent load.
-        SharedLibrary shlib(files[i], SharedLibraryFlags::PERMANENT, report);
-        CERR.debug(u"loaded plugin file \"%s\", status: %s", files[i], shlib.isLoaded());
+        const size_t count = index.size();
+        _loadingLibrary = file;
+        SharedLibrary shlib(file, SharedLibraryFlags::PERMANENT, report);
+        CERR.debug(u"loaded plugin file \"%s\", status: %s", file, shlib.isLoaded());
+        complete = complete && shlib.isLoaded() && index.size() > count;
+    }
+    _indexing = nullptr;
+    _loadingLibrary.clear();
+
+    // Build and save the new plugin index.
+    if (complete) {
+        ReportTSP tsp(report);
+        for (auto& entry : index) {
+            Plugin* p = std::visit([&tsp](auto allocator) -> Plugin* { return allocator(&tsp); }, entry.factory);
+            entry.description = p->getDescription();
+            delete p;
+        }
+        _index.swap(index);
+        _indexLoaded = true;
+        saveIndex(files, report);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Plugin index file management.
+//----------------------------------------------------------------------------
+
+namespace {
+    // The index is a text file. The first line is a magic string. The next lines describe
+    // the shared library files, with their size and modification time. The last lines
+    // describe the plugins. All fields are separated by tabulations. A change in the format
+    // shall be reflected in the magic string.
+    constexpr const ts::UChar* INDEX_MAGIC = u"TSDUCK-PLUGIN-INDEX-1";
+
+    // Line describing a shared library file in the index. Empty on error.
+    ts::UString IndexFileLine(const ts::UString& file_name)
+    {
+        std::error_code err;
+        const uintmax_t size = fs::file_size(file_name, err);
+        if (!err) {
+            const auto time = fs::last_write_time(file_name, err).time_since_epoch().count();
+            if (!err) {
+                return ts::UString::Format(u"file\t%d\t%d\t%s", size, time, file_name);
+            }
+        }
+        return ts::UString();
+    }
+}
+
+ts::UString ts::PluginRepository::IndexFileName(const UStringVector& files)
+{
+    if (files.empty() || !GetEnvironment(u"TSDUCK_NO_PLUGINS_INDEX").empty()) {
+        return UString();
+    }
+    // Distinct index files for distinct sets of shared libraries (installations, TSPLUGINS_PATH).
+    const std::string paths(UString::Join(files, u"\n").toUTF8());
+    return UserCacheFileName(UString::Format(u"plugins.%08X.idx", CRC32(paths.data(), paths.size()).value()));
+}
+
+bool ts::PluginRepository::loadIndex(bool fallback, Report& report)
+{
+    if (!_sharedLibraryAllowed || _indexLoaded) {
+        return _indexLoaded;
+    }
+
+    // Get list of shared library files and load the corresponding index file.
+    UStringVector files;
+    ApplicationSharedLibrary::GetPluginList(files, u"tsplugin_", PLUGINS_PATH_ENVIRONMENT_VARIABLE);
+    const UString index_file(IndexFileName(files));
+    UStringList lines;
+    if (!index_file.empty() && UString::Load(lines, index_file) && !lines.empty() && lines.front() == INDEX_MAGIC) {
+
+        // Check that all shared libraries are unchanged since the index was built.
+        auto line = std::next(lines.begin());
+        bool valid = true;
+        for (size_t i = 0; valid && i < files.size(); ++i) {
+            valid = line != lines.end() && *line++ == IndexFileLine(files[i]);
+        }
+
+        // Load plugin descriptions.
+        IndexEntryList index;
+        UStringVector fields;
+        while (valid && line != lines.end()) {
+            line->split(fields, u'\t', false, false);
+            valid = fields.size() == 4;
+            if (valid) {
+                const int type = fields[0] == TypeName(LIST_INPUT) ? LIST_INPUT :
+                                (fields[0] == TypeName(LIST_OUTPUT) ? LIST_OUTPUT :
+                                (fields[0] == TypeName(LIST_PACKET) ? LIST_PACKET : 0));
+                valid = type != 0;
+                index.push_back({type, fields[1], fields[2], fields[3]});
+            }
+            ++line;
+        }
+
+        if (valid) {
+            CERR.debug(u"loaded plugin index %s, %d plugins", index_file, index.size());
+            _index.swap(index);
+            _indexLoaded = true;
+        }
+    }
+
+    // Without index, load all plugins, this rebuilds the index.
+    if (!_indexLoaded && fallback) {
+        loadAllPlugins(report);
+    }
+    return _indexLoaded;
+}
+
+void ts::PluginRepository::saveIndex(const UStringVector& files, Report& report) const
+{
+    const UString index_file(IndexFileName(files));
+    if (index_file.empty()) {
+        return;
+    }
+
+    UStringList lines({INDEX_MAGIC});
+    for (const auto& file : files) {
+        lines.push_back(IndexFileLine(file));
+        if (lines.back().empty()) {
+            return;
+        }
+    }
+    for (const auto& entry : _index) {
+        UString description(entry.description);
+        description.substitute(u'\t', u' ');
+        description.substitute(u'\n', u' ');
+        lines.push_back(UString::Format(u"%s\t%s\t%s\t%s", TypeName(entry.type), entry.name, entry.library, description));
+    }
+
+    // Write into a temporary file which is atomically renamed, in case of concurrent applications.
+    // Errors are silently ignored, there is simply no index.
+    std::error_code err;
+    const UString tmp_file(UString::Format(u"%s.%X.tmp", index_file, std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(DirectoryName(index_file), err);
+    if (!err && UString::Save(lines, tmp_file)) {
+        fs::rename(tmp_file, index_file, err);
+        if (err) {
+            fs::remove(tmp_file, err);
+        }
+        else {
+            CERR.debug(u"saved plugin index %s", index_file);
+        }
     }
 }
 
@@ -230,43 +424,51 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
     UString out;
     out.reserve(5000);
 
-    // Load all shareable plugins first.
+    // Load the plugin index or all shareable plugins first.
     if (loadAll) {
-        loadAllPlugins(report);
+        loadIndex(true, report);
+    }
+
+    // A minimal TSP, used to build temporary plugins.
+    ReportTSP tsp(report);
+
+    // Get names and descriptions of registered plugins, then plugins from the index which are not loaded.
+    std::map<UString, UString> inputs, outputs, processors;
+    if ((flags & LIST_INPUT) != 0) {
+        GetDescriptions(inputs, _inputPlugins, tsp);
+    }
+    if ((flags & LIST_OUTPUT) != 0) {
+        GetDescriptions(outputs, _outputPlugins, tsp);
+    }
+    if ((flags & LIST_PACKET) != 0) {
+        GetDescriptions(processors, _processorPlugins, tsp);
+    }
+    if (loadAll && _indexLoaded) {
+        for (const auto& entry : _index) {
+            if ((flags & entry.type) != 0) {
+                auto& descriptions(entry.type == LIST_INPUT ? inputs : (entry.type == LIST_OUTPUT ? outputs : processors));
+                descriptions.insert(std::make_pair(entry.name, entry.description));
+            }
+        }
     }
 
     // Compute max name width of all plugins.
     size_t name_width = 0;
     if ((flags & (LIST_COMPACT | LIST_NAMES)) == 0) {
-        if ((flags & LIST_INPUT) != 0) {
-            for (const auto& it : _inputPlugins) {
-                name_width = std::max(name_width, it.first.width());
-            }
-        }
-        if ((flags & LIST_PACKET) != 0) {
-            for (const auto& it : _processorPlugins) {
-                name_width = std::max(name_width, it.first.width());
-            }
-        }
-        if ((flags & LIST_OUTPUT) != 0) {
-            for (const auto& it : _outputPlugins) {
+        for (const auto* descriptions : {&inputs, &outputs, &processors}) {
+            for (const auto& it : *descriptions) {
                 name_width = std::max(name_width, it.first.width());
             }
         }
     }
 
-    // A minimal TSP, used to build temporary plugins.
-    ReportTSP tsp(report);
-
     // List capabilities.
     if ((flags & LIST_INPUT) != 0) {
         if ((flags & (LIST_COMPACT | LIST_NAMES)) == 0) {
             out += u"\nList of tsp input plugins:\n\n";
         }
-        for (const auto& it : _inputPlugins) {
-            Plugin* p = it.second(&tsp);
-            ListOnePlugin(out, it.first, p, name_width, flags);
-            delete p;
+        for (const auto& it : inputs) {
+            ListOnePlugin(out, it.first, it.second, name_width, flags);
         }
     }
 
@@ -274,10 +476,8 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
         if ((flags & (LIST_COMPACT | LIST_NAMES)) == 0) {
             out += u"\nList of tsp output plugins:\n\n";
         }
-        for (const auto& it : _outputPlugins) {
-            Plugin* p = it.second(&tsp);
-            ListOnePlugin(out, it.first, p, name_width, flags);
-            delete p;
+        for (const auto& it : outputs) {
+            ListOnePlugin(out, it.first, it.second, name_width, flags);
         }
     }
 
@@ -285,10 +485,8 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
         if ((flags & (LIST_COMPACT | LIST_NAMES)) == 0) {
             out += u"\nList of tsp packet processor plugins:\n\n";
         }
-        for (const auto& it : _processorPlugins) {
-            Plugin* p = it.second(&tsp);
-            ListOnePlugin(out, it.first, p, name_width, flags);
-            delete p;
+        for (const auto& it : processors) {
+            ListOnePlugin(out, it.first, it.second, name_width, flags);
         }
     }
 
@@ -300,7 +498,7 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
 // List one plugin.
 //----------------------------------------------------------------------------
 
-void ts::PluginRepository::ListOnePlugin(UString& out, const UString& name, Plugin* plugin, size_t name_width, int flags)
+void ts::PluginRepository::ListOnePlugin(UString& out, const UString& name, const UString& description, size_t name_width, int flags)
 {
     if ((flags & LIST_NAMES) != 0) {
         out += name;
@@ -309,14 +507,14 @@ void ts::PluginRepository::ListOnePlugin(UString& out, const UString& name, Plug
     else if ((flags & LIST_COMPACT) != 0) {
         out += name;
         out += u":";
-        out += plugin->getDescription();
+        out += description;
         out += u"\n";
     }
     else {
         out += u"  ";
         out += name.toJustifiedLeft(name_width + 1, u'.', false, 1);
         out += u" ";
-        out += plugin->getDescription();
+        out += description;
         out += u"\n";
     }
 }
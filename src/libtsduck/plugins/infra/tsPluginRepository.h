@@ -145,6 +145,7 @@ namespace ts {
         //!
         //! Load all available tsp processors.
         //! Does nothing when dynamic loading of plugins is disabled.
+        //! When all shared libraries register plugins, the plugin index is rebuilt.
         //! @param [in,out] report Where to report errors.
         //!
         void loadAllPlugins(Report& report);
@@ -170,8 +171,10 @@ namespace ts {
         //!
         //! List all tsp processors.
         //! This function is typically used to implement the <code>tsp -\-list-processors</code> option.
-        //! @param [in] loadAll When true, all available plugins are loaded first.
-        //! Ignored when dynamic loading of plugins is disabled.
+        //! @param [in] loadAll When true, all available plugins are listed, including plugins from shared
+        //! libraries which are not yet loaded. When the plugin index is up to date, these plugins are listed
+        //! from the index, without loading their shared libraries. Otherwise, all available plugins are loaded
+        //! first and the plugin index is rebuilt. Ignored when dynamic loading of plugins is disabled.
         //! @param [in,out] report Where to report errors.
         //! @param [in] flags List options, an or'ed mask of ListFlags values.
         //! @return The text to display.
@@ -215,17 +218,53 @@ namespace ts {
         using ProcessorMap = std::map<UString, ProcessorPluginFactory>;
         using OutputMap = std::map<UString, OutputPluginFactory>;
 
-        bool         _sharedLibraryAllowed = true;
-        InputMap     _inputPlugins {};
-        ProcessorMap _processorPlugins {};
-        OutputMap    _outputPlugins {};
+        // Description of a plugin in the plugin index. The plugin index describes all plugins which are
+        // registered by the shared libraries. It is saved in a user cache file, validated by the size and
+        // modification time of all shared libraries. It is used to list the plugins or locate a plugin in a
+        // library of another name without loading all shared libraries.
+        class IndexEntry
+        {
+        public:
+            int     type = 0;        // One of LIST_INPUT, LIST_PACKET, LIST_OUTPUT.
+            UString name {};         // Plugin name.
+            UString library {};      // Shared library file which registers the plugin.
+            UString description {};  // Plugin description.
+            std::variant<InputPluginFactory, ProcessorPluginFactory, OutputPluginFactory> factory {};  // Only while rebuilding the index.
+        };
+        using IndexEntryList = std::list<IndexEntry>;
+
+        bool            _sharedLibraryAllowed = true;
+        bool            _indexLoaded = false;  // The plugin index is up to date.
+        InputMap        _inputPlugins {};
+        ProcessorMap    _processorPlugins {};
+        OutputMap       _outputPlugins {};
+        IndexEntryList  _index {};
+        IndexEntryList* _indexing = nullptr;   // Where to record plugin registrations while loading all plugins.
+        UString         _loadingLibrary {};    // Shared library being loaded while indexing.
 
         // Get plugin factory by name.
         template <typename FACTORY>
-        FACTORY getFactory(const UString& name, const UString& type, const std::map<UString,FACTORY>&, Report&);
+        FACTORY getFactory(const UString& name, int type, const std::map<UString,FACTORY>&, Report&);
+
+        // Record a plugin registration in the plugin index while loading all plugins.
+        template <typename FACTORY>
+        void indexPlugin(int type, const UString& name, FACTORY allocator);
+
+        // Load the plugin index. Without fallback, return false if there is no up to date index.
+        // With fallback, load all plugins and rebuild the index when there is no up to date index.
+        bool loadIndex(bool fallback, Report& report);
+
+        // Save the plugin index for a list of shared library files.
+        void saveIndex(const UStringVector& files, Report& report) const;
+
+        // Name of the plugin index file for a list of shared library files. Empty if disabled.
+        static UString IndexFileName(const UStringVector& files);
+
+        // Name of a plugin type in messages and plugin index.
+        static UString TypeName(int type);
 
         // List one plugin.
-        static void ListOnePlugin(UString& out, const UString& name, Plugin* plugin, size_t name_width, int flags);
+        static void ListOnePlugin(UString& out, const UString& name, const UString& description, size_t name_width, int flags);
     };
 }
 
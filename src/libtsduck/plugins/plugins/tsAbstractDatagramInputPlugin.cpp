@@ -8,6 +8,9 @@
 
 #include "tsAbstractDatagramInputPlugin.h"
 #include "tsIPProtocols.h"
+#include "tsUDPSocket.h"
+
+#define DEFAULT_RECEIVE_BATCH  32  // datagrams
 
 
 //----------------------------------------------------------------------------
@@ -24,9 +27,9 @@ ts::AbstractDatagramInputPlugin::AbstractDatagramInputPlugin(TSP* tsp_,
     InputPlugin(tsp_, description, syntax),
     _options(options),
     // Ensure at least 7 204-byte packets.
-    _inbuf(std::max(buffer_size, 7 * PKT_RS_SIZE)),
-    // Resize metadata based on 188-byte packets (max number of packets for that buffer).
-    _mdata(_inbuf.size() / PKT_SIZE)
+    _datagram_size(std::max(buffer_size, 7 * PKT_RS_SIZE)),
+    // Resize metadata based on 188-byte packets (max number of packets for one datagram).
+    _mdata(_datagram_size / PKT_SIZE)
 {
     if (bool(_options & TSDatagramInputOptions::REAL_TIME)) {
         option<cn::seconds>(u"display-interval", 'd');
@@ -51,6 +54,17 @@ ts::AbstractDatagramInputPlugin::AbstractDatagramInputPlugin(TSP* tsp_,
              u"Use this option only when necessary.");
     }
 
+    if (bool(_options & TSDatagramInputOptions::MULTIPLE)) {
+        option(u"receive-batch", 0, INTEGER, 0, 1, 1, UDPSocket::MAX_RECEIVE_MULTIPLE);
+        help(u"receive-batch", u"count",
+             u"Specify the maximum number of datagrams to receive at a time. "
+             u"When several datagrams are already available, they are received in one single system call, when possible. "
+             u"This reduces the CPU load at high bitrates without increasing the latency. "
+             u"The default is " + UString::Decimal(DEFAULT_RECEIVE_BATCH) + u" datagrams. "
+             u"The maximum is " + UString::Decimal(UDPSocket::MAX_RECEIVE_MULTIPLE) + u" datagrams, the maximum number of datagrams in one system call. "
+             u"Use 1 to receive one datagram at a time.");
+    }
+
     // Order of priority for input timestamps.
     _time_priority_enum.add(u"rtp-tsp", TimePriority::RTP_TSP);
     _time_priority_enum.add(u"tsp", TimePriority::TSP_ONLY);
@@ -98,6 +112,9 @@ bool ts::AbstractDatagramInputPlugin::getOptions()
     }
     _rs204_format = bool(_options & TSDatagramInputOptions::ALLOW_RS204) && present(u"rs204");
     getIntValue(_time_priority, u"timestamp-priority", _default_time_priority);
+    if (bool(_options & TSDatagramInputOptions::MULTIPLE)) {
+        getIntValue(_batch_max, u"receive-batch", DEFAULT_RECEIVE_BATCH);
+    }
     return true;
 }
 
@@ -110,6 +127,10 @@ bool ts::AbstractDatagramInputPlugin::start()
 {
     // Initialize working data.
     _inbuf_count = _inbuf_next = _mdata_next = 0;
+    _batch_count = _batch_next = 0;
+    _inbuf.resize(_batch_max * _datagram_size);
+    _batch_sizes.resize(_batch_max);
+    _batch_timestamps.resize(_batch_max);
     _start = _start_0 = _start_1 = _next_display = Time::Epoch;
     _packets = _packets_0 = _packets_1 = 0;
 
@@ -151,92 +172,157 @@ ts::BitRateConfidence ts::AbstractDatagramInputPlugin::getBitrateConfidence()
 }
 
 
+//----------------------------------------------------------------------------
+// Default implementation of multiple datagrams reception: only one.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDatagramInputPlugin::receiveDatagrams(uint8_t* buffer, size_t buffer_size, size_t max_count, size_t& ret_count, size_t* ret_sizes, cn::microseconds* timestamps, TimeSource& timesource)
+{
+    ret_count = 0;
+    if (max_count == 0 || !receiveDatagram(buffer, buffer_size, ret_sizes[0], timestamps[0], timesource)) {
+        return false;
+    }
+    ret_count = 1;
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Input method
 //----------------------------------------------------------------------------
 
 size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetadata* pkt_data, size_t max_packets)
 {
-    cn::microseconds timestamp = cn::microseconds(-1);
-    TimeSource timesource = TimeSource::UNDEFINED;
+    size_t pkt_total = 0;
+
+    // Return packets from as many received datagrams as possible.
+    // Wait for new datagrams only when no packet was returned yet.
+    while (pkt_total < max_packets) {
 
-    // Check if we receive new packets or process remain of previous buffer.
-    bool new_packets = false;
+        // If there is no remaining packet in the current datagram, load the next one.
+        if (_inbuf_count == 0 && !loadNextDatagram(pkt_total == 0)) {
+            break;
+        }
+
+        // Return packets from the current datagram.
+        const size_t pkt_cnt = std::min(_inbuf_count, max_packets - pkt_total);
+        TSPacket::Copy(buffer + pkt_total, _inbuf.data() + _inbuf_next, pkt_cnt, _packet_size);
+        TSPacketMetadata::Copy(pkt_data + pkt_total, &_mdata[_mdata_next], pkt_cnt);
+        _inbuf_count -= pkt_cnt;
+        _inbuf_next += pkt_cnt * _packet_size;
+        _mdata_next += pkt_cnt;
+        pkt_total += pkt_cnt;
+    }
 
-    // If there is no remaining packet in the input buffer, wait for a datagram message.
+    return pkt_total;
+}
+
+
+//----------------------------------------------------------------------------
+// Load the next datagram containing TS packets.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDatagramInputPlugin::loadNextDatagram(bool wait)
+{
     // Loop until we get some TS packets.
-    while (_inbuf_count == 0) {
+    for (;;) {
 
-        // Wait for a datagram message
-        size_t insize = 0;
-        if (!receiveDatagram(_inbuf.data(), _inbuf.size(), insize, timestamp, timesource)) {
-            return 0;
+        // If all datagrams from the previous reception are processed, wait for new datagram messages.
+        if (_batch_next >= _batch_count) {
+            _batch_count = _batch_next = 0;
+            if (!wait) {
+                return false;
+            }
+            if (!receiveDatagrams(_inbuf.data(), _datagram_size, _batch_max, _batch_count, _batch_sizes.data(), _batch_timestamps.data(), _batch_timesource)) {
+                _batch_count = 0;
+                return false;
+            }
+            if (_batch_count > 1) {
+                log(2, u"received %d datagrams at once", _batch_count);
+            }
         }
 
+        // Process the next datagram in the input buffer.
+        const size_t index = _batch_next++;
+        const size_t base = index * _datagram_size;
+        const size_t insize = _batch_sizes[index];
+        const cn::microseconds timestamp = _batch_timestamps[index];
+        uint8_t* const data = _inbuf.data() + base;
+
         // Look for TS packets in the UDP message.
-        new_packets = TSPacket::Locate(_inbuf.data(), insize, _inbuf_next, _inbuf_count, _packet_size);
-
-        if (new_packets) {
-            assert(_packet_size == PKT_SIZE || _packet_size == PKT_RS_SIZE);
-
-            // Look for an RTP header before the first packet. There is no clear proof of the presence of the RTP header.
-            // We check if the header size is large enough for an RTP header and if the "RTP payload type" is MPEG-2 TS.
-            const bool rtp = _inbuf_next >= RTP_HEADER_SIZE && (_inbuf[1] & 0x7F) == RTP_PT_MP2T;
-            const ts::rtp_units rtp_timestamp = ts::rtp_units(rtp ? GetUInt32(_inbuf.data() + 4) : 0);
-
-            // Use RTP time stamp if there is one and RTP is the preferred choice.
-            bool use_rtp = false;
-            bool use_kernel = false;
-            switch (_time_priority) {
-                case RTP_SYSTEM_TSP:
-                    use_rtp = rtp;
-                    use_kernel = !rtp && timestamp >= cn::microseconds::zero();
-                    break;
-                case SYSTEM_RTP_TSP:
-                    use_kernel = timestamp >= cn::microseconds::zero();
-                    use_rtp = !use_kernel && rtp;
-                    break;
-                case RTP_TSP:
-                    use_rtp = rtp;
-                    use_kernel = false;
-                    break;
-                case SYSTEM_TSP:
-                    use_kernel = timestamp >= cn::microseconds::zero();
-                    use_rtp = false;
-                    break;
-                case TSP_ONLY:
-                default:
-                    use_rtp = false;
-                    use_kernel = false;
-                    break;
-            }
+        if (!TSPacket::Locate(data, insize, _inbuf_next, _inbuf_count, _packet_size)) {
+            // No TS packet found in UDP message, wait for another one.
+            debug(u"no TS packet in message, %s bytes", insize);
+            continue;
+        }
+        assert(_packet_size == PKT_SIZE || _packet_size == PKT_RS_SIZE);
+
+        // Look for an RTP header before the first packet. There is no clear proof of the presence of the RTP header.
+        // We check if the header size is large enough for an RTP header and if the "RTP payload type" is MPEG-2 TS.
+        const bool rtp = _inbuf_next >= RTP_HEADER_SIZE && (data[1] & 0x7F) == RTP_PT_MP2T;
+        const ts::rtp_units rtp_timestamp = ts::rtp_units(rtp ? GetUInt32(data + 4) : 0);
+
+        // Use RTP time stamp if there is one and RTP is the preferred choice.
+        bool use_rtp = false;
+        bool use_kernel = false;
+        switch (_time_priority) {
+            case RTP_SYSTEM_TSP:
+                use_rtp = rtp;
+                use_kernel = !rtp && timestamp >= cn::microseconds::zero();
+                break;
+            case SYSTEM_RTP_TSP:
+                use_kernel = timestamp >= cn::microseconds::zero();
+                use_rtp = !use_kernel && rtp;
+                break;
+            case RTP_TSP:
+                use_rtp = rtp;
+                use_kernel = false;
+                break;
+            case SYSTEM_TSP:
+                use_kernel = timestamp >= cn::microseconds::zero();
+                use_rtp = false;
+                break;
+            case TSP_ONLY:
+            default:
+                use_rtp = false;
+                use_kernel = false;
+                break;
+        }
 
-            // Build time stamps in packet metadata.
-            _mdata_next = 0;
-            for (size_t i = 0; i < _inbuf_count; ++i) {
-                TSPacketMetadata& md(_mdata[i]);
-                md.reset();
-                if (use_rtp) {
-                    md.setInputTimeStamp(rtp_timestamp, TimeSource::RTP);
-                }
-                else if (use_kernel) {
-                    md.setInputTimeStamp(timestamp, timesource);
-                }
-                // Copy 204-byte trailer in metadata.
-                if (_packet_size == PKT_RS_SIZE) {
-                    md.setAuxData(_inbuf.data() + _inbuf_next + i * PKT_RS_SIZE + PKT_SIZE, RS_SIZE);
-                }
+        // Build time stamps in packet metadata.
+        _mdata_next = 0;
+        for (size_t i = 0; i < _inbuf_count; ++i) {
+            TSPacketMetadata& md(_mdata[i]);
+            md.reset();
+            if (use_rtp) {
+                md.setInputTimeStamp(rtp_timestamp, TimeSource::RTP);
+            }
+            else if (use_kernel) {
+                md.setInputTimeStamp(timestamp, _batch_timesource);
+            }
+            // Copy 204-byte trailer in metadata.
+            if (_packet_size == PKT_RS_SIZE) {
+                md.setAuxData(data + _inbuf_next + i * PKT_RS_SIZE + PKT_SIZE, RS_SIZE);
             }
-
-            break; // found packets.
         }
 
-        // No TS packet found in UDP message, wait for another one.
-        debug(u"no TS packet in message, %s bytes", insize);
+        // Make _inbuf_next an index in the complete input buffer.
+        _inbuf_next += base;
+
+        // We may need to re-evaluate the real-time input bitrate.
+        evaluateBitrate(_inbuf_count);
+        return true;
     }
+}
+
+
+//----------------------------------------------------------------------------
+// Update the real-time bitrate evaluation with newly received packets.
+//----------------------------------------------------------------------------
 
-    // If new packets were received, we may need to re-evaluate the real-time input bitrate.
-    if (new_packets && bool(_options & TSDatagramInputOptions::REAL_TIME) && _eval_time > cn::milliseconds::zero()) {
+void ts::AbstractDatagramInputPlugin::evaluateBitrate(size_t packet_count)
+{
+    if (bool(_options & TSDatagramInputOptions::REAL_TIME) && _eval_time > cn::milliseconds::zero()) {
 
         const Time now(Time::CurrentUTC());
 
@@ -249,9 +335,9 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
         }
 
         // Count packets
-        _packets += _inbuf_count;
-        _packets_0 += _inbuf_count;
-        _packets_1 += _inbuf_count;
+        _packets += packet_count;
+        _packets_0 += packet_count;
+        _packets_1 += packet_count;
 
         // Detect new evaluation period
         if (now >= _start_1 + _eval_time) {
@@ -274,14 +360,4 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
                  br_average == 0 ? u"undefined" : br_average.toString() + u" b/s");
         }
     }
-
-    // Return packets from the input buffer
-    size_t pkt_cnt = std::min(_inbuf_count, max_packets);
-    TSPacket::Copy(buffer, _inbuf.data() + _inbuf_next, pkt_cnt, _packet_size);
-    TSPacketMetadata::Copy(pkt_data, &_mdata[_mdata_next], pkt_cnt);
-    _inbuf_count -= pkt_cnt;
-    _inbuf_next += pkt_cnt * _packet_size;
-    _mdata_next += pkt_cnt;
-
-    return pkt_cnt;
 }
@@ -27,6 +27,7 @@ namespace ts {
         NONE        = 0x0000,  //!< No option.
         REAL_TIME   = 0x0001,  //!< Reception occurs in real-time, typically from the network..
         ALLOW_RS204 = 0x0002,  //!< Allow RS204 204-byte packets, autodetected, enforced with --rs204.
+        MULTIPLE    = 0x0004,  //!< The subclass can receive several datagrams at once, option --receive-batch.
     };
 }
 TS_ENABLE_BITMASK_OPERATORS(ts::TSDatagramInputOptions);
@@ -83,6 +84,24 @@ namespace ts {
         //!
         virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource) = 0;
 
+        //!
+        //! Receive several datagram messages at once.
+        //! Wait for at least one datagram and return all datagrams which are immediately available.
+        //! The default implementation receives one datagram using receiveDatagram().
+        //! Subclasses which declare TSDatagramInputOptions::MULTIPLE should override this method.
+        //! @param [out] buffer Address of the buffer for the received messages.
+        //! The message number @a i shall be stored at address @a buffer + @a i * @a buffer_size.
+        //! @param [in] buffer_size Size in bytes of the reception buffer of each message.
+        //! @param [in] max_count Maximum number of messages to receive.
+        //! @param [out] ret_count Number of received messages.
+        //! @param [out] ret_sizes Array of @a max_count sizes. Size in bytes of each received message.
+        //! @param [out] timestamps Array of @a max_count timestamps. Receive timestamp of each message
+        //! in micro-seconds or -1 if not available.
+        //! @param [out] timesource Type of timestamps.
+        //! @return True on success, false on error.
+        //!
+        virtual bool receiveDatagrams(uint8_t* buffer, size_t buffer_size, size_t max_count, size_t& ret_count, size_t* ret_sizes, cn::microseconds* timestamps, TimeSource& timesource);
+
     private:
         // Order of priority for input timestamps. SYSTEM means lower layer from subclass (UDP, SRT, etc).
         enum TimePriority {RTP_SYSTEM_TSP, SYSTEM_RTP_TSP, RTP_TSP, SYSTEM_TSP, TSP_ONLY};
@@ -95,6 +114,8 @@ namespace ts {
         TimePriority     _time_priority = RTP_TSP;         // Priority of time stamps sources.
         TimePriority     _default_time_priority = RTP_TSP; // Priority of time stamps sources.
         bool             _rs204_format = false;            // Input packets are always 204-byte format.
+        size_t           _datagram_size = 0;               // Maximum size of a datagram.
+        size_t           _batch_max = 1;                   // Maximum number of datagrams to receive at once.
 
         // Working data.
         Time          _next_display {};     // Next bitrate display time
@@ -104,11 +125,23 @@ namespace ts {
         PacketCounter _packets_0 = 0;       // Number of received packets since _start_0
         Time          _start_1 {};          // Start of previous bitrate evaluation period
         PacketCounter _packets_1 = 0;       // Number of received packets since _start_1
-        size_t        _inbuf_count = 0;     // Number of remaining TS packets in inbuf
+        size_t        _inbuf_count = 0;     // Number of remaining TS packets in current datagram
         size_t        _inbuf_next = 0;      // Byte index in _inbuf of next TS packet to return
         size_t        _mdata_next = 0;      // Index in _mdata of next TS packet metadata to return
         size_t        _packet_size = 0;     // Packet size (188 or 204).
-        ByteBlock     _inbuf {};            // Input buffer
-        TSPacketMetadataVector _mdata {};   // Metadata for packets in _inbuf
+        size_t        _batch_count = 0;     // Number of datagrams in _inbuf
+        size_t        _batch_next = 0;      // Index of next datagram to process in _inbuf
+        TimeSource    _batch_timesource = TimeSource::UNDEFINED; // Type of timestamps in _batch_timestamps
+        ByteBlock     _inbuf {};            // Input buffer, _batch_max areas of _datagram_size bytes
+        std::vector<size_t> _batch_sizes {};                // Size of each datagram in _inbuf
+        std::vector<cn::microseconds> _batch_timestamps {}; // Receive timestamp of each datagram in _inbuf
+        TSPacketMetadataVector _mdata {};   // Metadata for packets in current datagram
+
+        // Load the next datagram containing TS packets. Receive new datagrams only if wait is true.
+        // Return false if no datagram is available or on reception error.
+        bool loadNextDatagram(bool wait);
+
+        // Update the real-time bitrate evaluation with newly received packets.
+        void evaluateBitrate(size_t packet_count);
     };
 }
@@ -51,6 +51,10 @@ ts::AbstractDescrambler::AbstractDescrambler(TSP* tsp_, const UString& descripti
          u"mode, the packet processing continues while processing ECM's. This option "
          u"is always on in offline mode.");
 
+    definePacketWindowOption(u"Number of packets to process at once. Scrambled packets which use the same control word "
+                             u"are descrambled together, which is faster with some algorithms such as DVB-CSA2. "
+                             u"The value zero means that packets are processed one by one.");
+
     option(u"swap-cw");
     help(u"swap-cw",
         u"Swap even and odd control words from the ECM's. "
@@ -69,6 +73,7 @@ bool ts::AbstractDescrambler::getOptions()
     _service.set(value(u""));
     _synchronous = present(u"synchronous") || !tsp->realtime();
     _swap_cw = present(u"swap-cw");
+    _packet_window = getPacketWindowOption();
     getIntValues(_pids, u"pid");
     if (!duck.loadArgs(*this) || !_scrambling.loadArgs(duck, *this)) {
         return false;
@@ -122,6 +127,8 @@ bool ts::AbstractDescrambler::start()
     _ecm_streams.clear();
     _scrambled_streams.clear();
     _demux.reset();
+    _batch_scrambling = nullptr;
+    _batch_packets.clear();
 
     // Initialize the scrambling engine.
     if (!_scrambling.start()) {
@@ -445,14 +452,81 @@ void ts::AbstractDescrambler::ECMThread::main()
 //----------------------------------------------------------------------------
 
 ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    TSScrambling* scrambling = nullptr;
+    const Status status = analyzePacket(pkt, scrambling);
+    return status != TSP_OK || scrambling == nullptr || scrambling->decrypt(pkt) ? status : TSP_END;
+}
+
+
+//----------------------------------------------------------------------------
+// Packet window processing methods
+//----------------------------------------------------------------------------
+
+size_t ts::AbstractDescrambler::getPacketWindowSize()
+{
+    return _packet_window;
+}
+
+size_t ts::AbstractDescrambler::processPacketWindow(TSPacketWindow& win)
+{
+    // Scrambled packets are collected in batches which use the same descrambling engine.
+    size_t first = 0;  // Index in window of first packet in current batch.
+    for (size_t i = 0; i < win.size(); ++i) {
+        TSPacket* pkt = win.packet(i);
+        TSScrambling* scrambling = nullptr;
+        if (pkt == nullptr) {
+            // Previously dropped packet.
+            continue;
+        }
+        if (analyzePacket(*pkt, scrambling) != TSP_OK) {
+            return flushBatch() ? i : first;
+        }
+        if (scrambling != nullptr) {
+            if (scrambling != _batch_scrambling) {
+                if (!flushBatch()) {
+                    return first;
+                }
+                _batch_scrambling = scrambling;
+                first = i;
+            }
+            _batch_packets.push_back(pkt);
+        }
+    }
+    return flushBatch() ? win.size() : first;
+}
+
+
+//----------------------------------------------------------------------------
+// Descramble all packets in the current batch.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDescrambler::flushBatch()
+{
+    const bool ok = _batch_packets.empty() || _batch_scrambling->decrypt(_batch_packets.data(), _batch_packets.size());
+    _batch_packets.clear();
+    _batch_scrambling = nullptr;
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Analyze a packet, find the corresponding descrambling engine.
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::Status ts::AbstractDescrambler::analyzePacket(TSPacket& pkt, TSScrambling*& scrambling)
 {
     const PID pid = pkt.getPID();
+    scrambling = nullptr;
 
     // Descramble packets from fixed PID's using fixed control words.
     // If there is a user-specified list of PID's, we don't manage a service
     // and there is nothing else to do.
     if (_pids.any()) {
-        return !_pids.test(pid) || _scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+        if (_pids.test(pid)) {
+            scrambling = &_scrambling;
+        }
+        return TSP_OK;
     }
 
     // Filter sections to locate the service and grab ECM's.
@@ -474,7 +548,8 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
 
     // Without ECM's, we descramble using fixed control words.
     if (!_need_ecm) {
-        return _scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+        scrambling = &_scrambling;
+        return TSP_OK;
     }
 
     // Get PID context. If the PID is not known as a scrambled PID,
@@ -503,7 +578,11 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
     // Flags new_cw_even/odd are "write-protected, read-volatile", no mutex needed.
     if ((scv == SC_EVEN_KEY && pecm->new_cw_even) || (scv == SC_ODD_KEY && pecm->new_cw_odd)) {
 
-        // A new CW was deciphered.
+        // A new CW was deciphered. Previously collected packets must be descrambled with the previous CW.
+        if (!flushBatch()) {
+            return TSP_END;
+        }
+
         // In asynchronous mode, the CW are accessed under mutex protection.
         if (!_synchronous) {
             _mutex.lock();
@@ -526,6 +605,7 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
         }
     }
 
-    // Descramble the packet payload.
-    return pecm->scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+    // Descramble the packet payload using this ECM stream.
+    scrambling = &pecm->scrambling;
+    return TSP_OK;
 }
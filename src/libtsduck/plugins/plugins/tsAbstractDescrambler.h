@@ -37,6 +37,8 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     protected:
         //!
@@ -234,12 +236,20 @@ namespace ts {
         // Analyze a list of descriptors from the PMT, looking for ECM PID's
         void analyzeDescriptors(const DescriptorList& dlist, std::set<PID>& ecm_pids, uint8_t& scrambling);
 
+        // Analyze a packet, update the control words. Return the descrambling engine for the packet
+        // in 'scrambling' or a null pointer if the packet shall not be descrambled.
+        Status analyzePacket(TSPacket& pkt, TSScrambling*& scrambling);
+
+        // Descramble all packets in the current batch.
+        bool flushBatch();
+
         // Abstract descrambler private data.
         bool                    _use_service = false;         // Descramble a service (ie. not a specific list of PID's).
         bool                    _need_ecm = false;            // We need to get control words from ECM's.
         bool                    _abort = false;               // Error, abort asap.
         bool                    _synchronous = false;         // Synchronous ECM deciphering.
         bool                    _swap_cw = false;             // Swap even/odd CW from ECM.
+        size_t                  _packet_window = 0;           // Number of packets to process at once (zero means one by one).
         TSScrambling            _scrambling {*this};          // Default descrambling (used with fixed control words).
         PIDSet                  _pids {};                     // Explicit PID's to descramble.
         ServiceDiscovery        _service {duck, this};        // Service to descramble (by name, id or none).
@@ -250,6 +260,8 @@ namespace ts {
         std::mutex              _mutex {};                    // Exclusive access to protected areas
         std::condition_variable _ecm_to_do {};                // Notify thread to process ECM.
         ECMThread               _ecm_thread {this};           // Thread which deciphers ECM's.
+        TSScrambling*           _batch_scrambling = nullptr;  // Descrambling engine of the current batch of packets.
+        std::vector<TSPacket*>  _batch_packets {};            // Current batch of packets to descramble.
         // -- start of protected area --
         bool                    _stop_thread = false;         // Terminate ECM processing thread
         // -- end of protected area --
@@ -25,7 +25,9 @@ ts::ForkOutputPlugin::ForkOutputPlugin(TSP* tsp_) :
     help(u"", u"Specifies the command line to execute in the created process.");
 
     option(u"buffered-packets", 'b', POSITIVE);
-    help(u"buffered-packets", u"Windows only: Specifies the pipe buffer size in number of TS packets.");
+    help(u"buffered-packets",
+         u"Windows and Linux only: Specifies the pipe buffer size in number of TS packets. "
+         u"On Linux, a larger pipe reduces the number of context switches at high bitrates.");
 
     option(u"nowait", 'n');
     help(u"nowait", u"Do not wait for child process termination at end of input.");
@@ -52,7 +54,7 @@ bool ts::ForkOutputPlugin::start()
     // Create pipe & process.
     return _pipe.open(_command,
                       _nowait ? ForkPipe::ASYNCHRONOUS : ForkPipe::SYNCHRONOUS,
-                      PKT_SIZE * _buffer_size,  // Pipe buffer size (Windows only), same as internal buffer size.
+                      PKT_SIZE * _buffer_size,  // Pipe buffer size (Windows and Linux only), zero meaning default.
                       *this,                    // Error reporting.
                       ForkPipe::KEEP_BOTH,      // Output: same stdout and stderr as tsp process.
                       ForkPipe::STDIN_PIPE,     // Input: use the pipe.
@@ -23,6 +23,7 @@ ts::ForkPacketPlugin::ForkPacketPlugin(TSP* tsp_) :
     _format(TSPacketFormat::TS),
     _buffer_size(0),
     _buffer_count(0),
+    _pipe_size(0),
     _buffer(),
     _mdata(),
     _pipe()
@@ -37,7 +38,10 @@ ts::ForkPacketPlugin::ForkPacketPlugin(TSP* tsp_) :
          u"Specifies the number of TS packets to buffer before sending them through "
          u"the pipe to the forked process. When set to zero, the packets are not "
          u"buffered and sent one by one. The default is 500 packets in real-time mode "
-         u"and 1000 packets in offline mode.");
+         u"and 1000 packets in offline mode. On Windows, the pipe buffer is sized "
+         u"to hold this number of packets. On Linux, the pipe buffer is enlarged to "
+         u"hold at least this number of packets only when this option is explicitly "
+         u"specified.");
 
     option(u"ignore-abort", 'i');
     help(u"ignore-abort",
@@ -67,6 +71,13 @@ bool ts::ForkPacketPlugin::getOptions()
     _buffer.resize(_buffer_size);
     _mdata.resize(_buffer_size);
 
+    // On Linux, the pipe is enlarged only when explicitly requested, the default pipe size is kept otherwise.
+#if defined(TS_LINUX)
+    _pipe_size = present(u"buffered-packets") ? PKT_SIZE * _buffer_size : 0;
+#else
+    _pipe_size = PKT_SIZE * _buffer_size;
+#endif
+
     return true;
 }
 
@@ -79,7 +90,7 @@ bool ts::ForkPacketPlugin::start()
     // Create pipe & process.
     return _pipe.open(_command,
                       _nowait ? ForkPipe::ASYNCHRONOUS : ForkPipe::SYNCHRONOUS,
-                      PKT_SIZE * _buffer_size,  // Pipe buffer size (Windows only), same as internal buffer size.
+                      _pipe_size,               // Pipe buffer size (Windows and Linux only).
                       *this,                    // Error reporting.
                       ForkPipe::KEEP_BOTH,      // Output: same stdout and stderr as tsp process.
                       ForkPipe::STDIN_PIPE,     // Input: use the pipe.
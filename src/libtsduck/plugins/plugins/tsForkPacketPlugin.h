@@ -38,6 +38,7 @@ namespace ts {
         TSPacketFormat         _format = TSPacketFormat::TS;  // Packet format on the pipe
         size_t                 _buffer_size = 0;   // Max number of packets in buffer.
         size_t                 _buffer_count = 0;  // Number of packets currently in buffer.
+        size_t                 _pipe_size = 0;     // Pipe buffer size in bytes, zero for system default.
         TSPacketVector         _buffer {};         // Packet buffer.
         TSPacketMetadataVector _mdata {};          // Metadata for packets in buffer.
         TSForkPipe             _pipe {};           // The pipe device.
@@ -20,7 +20,7 @@ TS_REGISTER_INPUT_PLUGIN(u"ip", ts::IPInputPlugin);
 ts::IPInputPlugin::IPInputPlugin(TSP* tsp_) :
     AbstractDatagramInputPlugin(tsp_, IP_MAX_PACKET_SIZE, u"Receive TS packets from UDP/IP, multicast or unicast", u"[options] [address:]port",
                                 u"kernel", u"A kernel-provided time-stamp for the packet, when available (Linux only)",
-                                TSDatagramInputOptions::REAL_TIME | TSDatagramInputOptions::ALLOW_RS204)
+                                TSDatagramInputOptions::REAL_TIME | TSDatagramInputOptions::ALLOW_RS204 | TSDatagramInputOptions::MULTIPLE)
 {
     // Add UDP receiver common options.
     _sock_args.defineArgs(*this, true, true);
@@ -98,3 +98,37 @@ bool ts::IPInputPlugin::receiveDatagram(uint8_t* buffer, size_t buffer_size, siz
     timesource = TimeSource::KERNEL; // could be HARDWARE if generated by NIC, but no way to know
     return _sock.receive(buffer, buffer_size, ret_size, sender, destination, tsp, *this, &timestamp);
 }
+
+
+//----------------------------------------------------------------------------
+// Multiple datagrams reception method.
+//----------------------------------------------------------------------------
+
+bool ts::IPInputPlugin::receiveDatagrams(uint8_t* buffer, size_t buffer_size, size_t max_count, size_t& ret_count, size_t* ret_sizes, cn::microseconds* timestamps, TimeSource& timesource)
+{
+    // Build the description of the reception buffers.
+    _messages.resize(max_count);
+    for (size_t i = 0; i < max_count; ++i) {
+        _messages[i].data = buffer + i * buffer_size;
+        _messages[i].max_size = buffer_size;
+    }
+
+    timesource = TimeSource::KERNEL; // could be HARDWARE if generated by NIC, but no way to know
+    if (!_sock.receiveMultiple(_messages.data(), max_count, ret_count, tsp, *this)) {
+        return false;
+    }
+
+    // Some messages may have been filtered out and the remaining ones moved at the beginning of the array.
+    // Move the data of the remaining messages at their expected position. This is rare, in increasing
+    // order, the expected area of a message is always free (previous message already moved or rejected).
+    for (size_t i = 0; i < ret_count; ++i) {
+        uint8_t* const expected = buffer + i * buffer_size;
+        if (_messages[i].data != expected) {
+            MemCopy(expected, _messages[i].data, _messages[i].size);
+            _messages[i].data = expected;
+        }
+        ret_sizes[i] = _messages[i].size;
+        timestamps[i] = _messages[i].timestamp;
+    }
+    return true;
+}
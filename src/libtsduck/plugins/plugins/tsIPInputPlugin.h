@@ -34,9 +34,11 @@ namespace ts {
     protected:
         // Implementation of AbstractDatagramInputPlugin.
         virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource) override;
+        virtual bool receiveDatagrams(uint8_t* buffer, size_t buffer_size, size_t max_count, size_t& ret_count, size_t* ret_sizes, cn::microseconds* timestamps, TimeSource& timesource) override;
 
     private:
         UDPReceiverArgs _sock_args {};
         UDPReceiver     _sock {*tsp};
+        std::vector<UDPSocket::ReceivedMessage> _messages {};
     };
 }
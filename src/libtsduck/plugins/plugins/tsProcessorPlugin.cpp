@@ -31,6 +31,14 @@ ts::ProcessorPlugin::ProcessorPlugin(TSP* tsp_, const UString& description, cons
          u"Several --only-label options may be specified. "
          u"See also option --except-label. "
          u"This is a generic option which is defined in all packet processing plugins.");
+
+    option(u"parallel", 0, POSITIVE);
+    help(u"parallel", u"count",
+         u"Process the packets in parallel using the specified number of threads. "
+         u"This option is used only when the plugin processes packets by windows and declares "
+         u"that its processing does not depend on the packet order. It is ignored otherwise. "
+         u"The default is 1, no parallel processing. "
+         u"This is a generic option which is defined in all packet processing plugins.");
 }
 
 
@@ -61,6 +69,39 @@ void ts::ProcessorPlugin::getOnlyExceptLabelOption(TSPacketLabelSet& only, TSPac
 }
 
 
+//----------------------------------------------------------------------------
+// Get the content of the --parallel option (packet plugins only).
+//----------------------------------------------------------------------------
+
+size_t ts::ProcessorPlugin::getParallelOption() const
+{
+    size_t count = 1;
+    getIntValue(count, u"parallel", 1);
+    return count;
+}
+
+
+//----------------------------------------------------------------------------
+// Define and get the --packet-window option (packet window plugins only).
+//----------------------------------------------------------------------------
+
+void ts::ProcessorPlugin::definePacketWindowOption(const UString& description)
+{
+    option(u"packet-window", 0, UNSIGNED);
+    help(u"packet-window", u"count",
+         description + u" "
+         u"In real-time mode, the default is zero, to avoid adding latency. "
+         u"In offline mode, the default is " + UString::Decimal(DEFAULT_PACKET_WINDOW) + u".");
+}
+
+size_t ts::ProcessorPlugin::getPacketWindowOption() const
+{
+    size_t count = 0;
+    getIntValue(count, u"packet-window", tsp->realtime() ? 0 : DEFAULT_PACKET_WINDOW);
+    return count;
+}
+
+
 //----------------------------------------------------------------------------
 // Default implementations of virtual methods.
 //----------------------------------------------------------------------------
@@ -75,6 +116,16 @@ size_t ts::ProcessorPlugin::getPacketWindowSize()
     return 0;
 }
 
+ts::ProcessorPlugin::ParallelMode ts::ProcessorPlugin::getParallelMode()
+{
+    return ParallelMode::NONE;
+}
+
+size_t ts::ProcessorPlugin::analyzePacketWindow(TSPacketWindow& win)
+{
+    return win.size();
+}
+
 ts::ProcessorPlugin::Status ts::ProcessorPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
 {
     return TSP_OK;
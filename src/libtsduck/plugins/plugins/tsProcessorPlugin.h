@@ -70,6 +70,15 @@ namespace ts {
     //! sizes is larger than the size of the global buffer, the stream processing can enter a deadlock and
     //! stops. The global @c tsp command shall be carefully tuned to avoid that.
     //!
+    //! A plugin which uses the "packet window method" may additionally declare that its processing
+    //! does not depend on the order of the packets, either globally or per PID, by overriding
+    //! ProcessorPlugin::getParallelMode(). In that case, when the generic option -\-parallel is
+    //! specified, the packet window is split into disjoint slices and ProcessorPlugin::processPacketWindow()
+    //! is concurrently invoked on all slices from a pool of threads. The plugin shall be thread-safe.
+    //! The packets are updated in place in the global buffer and their order is consequently preserved.
+    //! Before processing the slices, ProcessorPlugin::analyzePacketWindow() is sequentially invoked on
+    //! the complete window, in packet order.
+    //!
     class TSDUCKDLL ProcessorPlugin : public Plugin
     {
         TS_NOBUILD_NOCOPY(ProcessorPlugin);
@@ -136,6 +145,46 @@ namespace ts {
         //!
         virtual size_t processPacketWindow(TSPacketWindow& win);
 
+        //!
+        //! Level of packet order independence of a plugin, for parallel processing.
+        //!
+        enum class ParallelMode {
+            NONE,        //!< The plugin needs all packets in order, no parallel processing.
+            PER_PID,     //!< The plugin needs the packets of each PID in order, independently of other PID's.
+            PER_PACKET,  //!< All packets are processed independently of each other.
+        };
+
+        //!
+        //! Get the level of packet order independence of the plugin.
+        //!
+        //! This method shall be overriden by plugins which use the "packet window method" and which
+        //! can process distinct packet windows in parallel. With ParallelMode::PER_PID, all packets from
+        //! a given PID are in the same slice, in their original order. With ParallelMode::PER_PACKET,
+        //! each slice is an arbitrary contiguous part of the packet window.
+        //!
+        //! @return The level of packet order independence. If this method is not overriden,
+        //! the default implementation returns ParallelMode::NONE.
+        //!
+        virtual ParallelMode getParallelMode();
+
+        //!
+        //! Sequential analysis of a packet window, before its parallel processing.
+        //!
+        //! When packet windows are processed in parallel (see getParallelMode()), this method is
+        //! invoked once on the complete packet window, in the plugin thread, before the concurrent
+        //! invocations of processPacketWindow() on the slices of the window. All packets are seen
+        //! in their original order. This method shall be overriden by plugins which process packets
+        //! per PID but which need a global analysis of the stream in packet order, typically to
+        //! demux PSI/SI and select the PID's to process.
+        //!
+        //! @param [in,out] win The complete window of TS packets to process.
+        //! @return Number of analyzed packets inside @a win. When the returned value is less than
+        //! @a win.size(), the packet processing is terminated after the specified number of packets
+        //! and the subsequent packets are not passed to processPacketWindow(). If this method is
+        //! not overriden, the default implementation returns @a win.size().
+        //!
+        virtual size_t analyzePacketWindow(TSPacketWindow& win);
+
         //!
         //! Get the content of the --only-label and --except-label options.
         //! The values of these options are fetched each time this method is called.
@@ -144,10 +193,23 @@ namespace ts {
         //!
         void getOnlyExceptLabelOption(TSPacketLabelSet& only, TSPacketLabelSet& except) const;
 
+        //!
+        //! Get the content of the --parallel option.
+        //! The value of this option is fetched each time this method is called.
+        //! @return The requested number of threads for parallel processing, 1 by default.
+        //!
+        size_t getParallelOption() const;
+
         // Implementation of inherited interface.
         virtual PluginType type() const override;
 
     protected:
+        //!
+        //! Default number of packets to process at once in offline mode, with option -\-packet-window.
+        //! @see definePacketWindowOption()
+        //!
+        static constexpr size_t DEFAULT_PACKET_WINDOW = 512;
+
         //!
         //! Constructor.
         //!
@@ -156,5 +218,22 @@ namespace ts {
         //! @param [in] syntax A short one-line syntax summary, eg. "[options] filename ...".
         //!
         ProcessorPlugin(TSP* tsp_, const UString& description = UString(), const UString& syntax = UString());
+
+        //!
+        //! Define the option -\-packet-window in a plugin which uses the "packet window method".
+        //! The text of the help for this option is made of the plugin-specific description of the
+        //! option, followed by the description of the default value which is common to all plugins.
+        //! @param [in] description Plugin-specific description of the option.
+        //! @see getPacketWindowOption()
+        //!
+        void definePacketWindowOption(const UString& description);
+
+        //!
+        //! Get the value of the option -\-packet-window, as defined by definePacketWindowOption().
+        //! The default value is zero (packets are processed one by one) in real-time mode, to avoid
+        //! adding latency, and DEFAULT_PACKET_WINDOW in offline mode.
+        //! @return The number of packets to process at once.
+        //!
+        size_t getPacketWindowOption() const;
     };
 }
@@ -0,0 +1,95 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsShmInputPlugin.h"
+#include "tsPluginRepository.h"
+
+TS_REGISTER_INPUT_PLUGIN(u"shm", ts::ShmInputPlugin);
+
+
+//----------------------------------------------------------------------------
+// Constructor
+//----------------------------------------------------------------------------
+
+ts::ShmInputPlugin::ShmInputPlugin(TSP* tsp_) :
+    InputPlugin(tsp_, u"Receive TS packets from a shared memory ring", u"[options] name")
+{
+    option(u"", 0, STRING, 1, 1);
+    help(u"", u"Name of the shared memory ring. The ring must have been created by an output plugin 'shm' in another process.");
+
+    option<cn::milliseconds>(u"poll-interval", 'p');
+    help(u"poll-interval",
+         u"Interval between two checks of the shared memory ring when it is empty. "
+         u"The default is 2 milliseconds.");
+}
+
+
+//----------------------------------------------------------------------------
+// Input methods
+//----------------------------------------------------------------------------
+
+bool ts::ShmInputPlugin::getOptions()
+{
+    getValue(_name, u"");
+    getChronoValue(_poll_interval, u"poll-interval", cn::milliseconds(2));
+    return true;
+}
+
+bool ts::ShmInputPlugin::start()
+{
+    _abort = false;
+    _lost_count = 0;
+    return _ring.openReader(_name, *this);
+}
+
+bool ts::ShmInputPlugin::stop()
+{
+    if (_lost_count > 0) {
+        verbose(u"total lost packets: %'d", _lost_count);
+    }
+    return _ring.close(*this);
+}
+
+bool ts::ShmInputPlugin::abortInput()
+{
+    _abort = true;
+    return true;
+}
+
+ts::BitRate ts::ShmInputPlugin::getBitrate()
+{
+    return _ring.bitrate();
+}
+
+ts::BitRateConfidence ts::ShmInputPlugin::getBitrateConfidence()
+{
+    return _ring.bitrateConfidence();
+}
+
+size_t ts::ShmInputPlugin::receive(TSPacket* buffer, TSPacketMetadata* pkt_data, size_t max_packets)
+{
+    while (!_abort) {
+        // Check end of stream before reading to avoid missing the last packets.
+        const bool eof = _ring.endOfStream();
+        uint64_t lost = 0;
+        const size_t count = _ring.read(buffer, pkt_data, max_packets, lost);
+        if (lost > 0) {
+            _lost_count += lost;
+            warning(u"lost %'d packets, reader is too slow, total lost: %'d", lost, _lost_count);
+        }
+        if (count > 0) {
+            return count;
+        }
+        if (eof) {
+            debug(u"end of stream in shared memory ring");
+            break;
+        }
+        std::this_thread::sleep_for(_poll_interval);
+    }
+    return 0;
+}
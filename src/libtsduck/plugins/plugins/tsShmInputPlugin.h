@@ -0,0 +1,45 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Shared memory input plugin for tsp.
+//!  Receive packets from a shared memory ring which is written by another process.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsInputPlugin.h"
+#include "tsTSSharedMemoryRing.h"
+
+namespace ts {
+    //!
+    //! Shared memory input plugin for tsp.
+    //! Receive packets from a shared memory ring which is written by another process.
+    //! @ingroup libtsduck plugin
+    //!
+    class TSDUCKDLL ShmInputPlugin: public InputPlugin
+    {
+        TS_PLUGIN_CONSTRUCTORS(ShmInputPlugin);
+    public:
+        // Implementation of plugin API
+        virtual bool getOptions() override;
+        virtual bool start() override;
+        virtual bool stop() override;
+        virtual size_t receive(TSPacket*, TSPacketMetadata*, size_t) override;
+        virtual bool abortInput() override;
+        virtual BitRate getBitrate() override;
+        virtual BitRateConfidence getBitrateConfidence() override;
+
+    private:
+        UString            _name {};             // Name of the shared memory ring.
+        cn::milliseconds   _poll_interval {};    // Polling interval when the ring is empty.
+        TSSharedMemoryRing _ring {};             // The shared memory ring.
+        uint64_t           _lost_count = 0;      // Total number of lost packets.
+        std::atomic_bool   _abort {false};       // Input was aborted.
+    };
+}
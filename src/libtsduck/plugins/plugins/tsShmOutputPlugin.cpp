@@ -0,0 +1,57 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsShmOutputPlugin.h"
+#include "tsPluginRepository.h"
+
+TS_REGISTER_OUTPUT_PLUGIN(u"shm", ts::ShmOutputPlugin);
+
+
+//----------------------------------------------------------------------------
+// Constructor
+//----------------------------------------------------------------------------
+
+ts::ShmOutputPlugin::ShmOutputPlugin(TSP* tsp_) :
+    OutputPlugin(tsp_, u"Send TS packets to a shared memory ring", u"[options] name")
+{
+    option(u"", 0, STRING, 1, 1);
+    help(u"", u"Name of the shared memory ring. Other processes use the same name with the input plugin 'shm'.");
+
+    option(u"buffered-packets", 'b', POSITIVE);
+    help(u"buffered-packets",
+         u"Size of the shared memory ring in number of TS packets. "
+         u"The default is " + UString::Decimal(TSSharedMemoryRing::DEFAULT_PACKET_COUNT) + u" packets.");
+}
+
+
+//----------------------------------------------------------------------------
+// Output methods
+//----------------------------------------------------------------------------
+
+bool ts::ShmOutputPlugin::getOptions()
+{
+    getValue(_name, u"");
+    getIntValue(_ring_size, u"buffered-packets", TSSharedMemoryRing::DEFAULT_PACKET_COUNT);
+    return true;
+}
+
+bool ts::ShmOutputPlugin::start()
+{
+    return _ring.openWriter(_name, _ring_size, *this);
+}
+
+bool ts::ShmOutputPlugin::stop()
+{
+    return _ring.close(*this);
+}
+
+bool ts::ShmOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata* pkt_data, size_t packet_count)
+{
+    _ring.setBitrate(tsp->bitrate(), tsp->bitrateConfidence());
+    return _ring.write(buffer, pkt_data, packet_count);
+}
@@ -0,0 +1,40 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Shared memory output plugin for tsp.
+//!  Send packets to a shared memory ring which is read by other processes.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsOutputPlugin.h"
+#include "tsTSSharedMemoryRing.h"
+
+namespace ts {
+    //!
+    //! Shared memory output plugin for tsp.
+    //! Send packets to a shared memory ring which is read by other processes.
+    //! @ingroup libtsduck plugin
+    //!
+    class TSDUCKDLL ShmOutputPlugin: public OutputPlugin
+    {
+        TS_PLUGIN_CONSTRUCTORS(ShmOutputPlugin);
+    public:
+        // Implementation of plugin API
+        virtual bool getOptions() override;
+        virtual bool start() override;
+        virtual bool stop() override;
+        virtual bool send(const TSPacket*, const TSPacketMetadata*, size_t) override;
+
+    private:
+        UString            _name {};          // Name of the shared memory ring.
+        size_t             _ring_size = 0;    // Ring size in packets.
+        TSSharedMemoryRing _ring {};          // The shared memory ring.
+    };
+}
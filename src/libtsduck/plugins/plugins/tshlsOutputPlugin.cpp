@@ -128,6 +128,14 @@ ts::hls::OutputPlugin::OutputPlugin(TSP* tsp_) :
     help(u"start-media-sequence",
          u"Initial media sequence number in #EXT-X-MEDIA-SEQUENCE directive in the playlist. "
          u"The default is zero.");
+
+    option(u"write-behind", 0, POSITIVE);
+    help(u"write-behind", u"bytes",
+         u"Write the segment files asynchronously in a separate thread. "
+         u"The value is the maximum size in bytes of the queue of data waiting to be written. "
+         u"When the queue is full, the output is blocked until some data are written. "
+         u"A segment file is completely written before being referenced in the playlist. "
+         u"This option is supported on UNIX systems only.");
 }
 
 
@@ -161,6 +169,7 @@ bool ts::hls::OutputPlugin::getOptions()
     getIntValue(_initialMediaSeq, u"start-media-sequence", 0);
     getIntValues(_closeLabels, u"label-close");
     getValues(_customTags, u"custom-tag");
+    getIntValue(_writeBehind, u"write-behind", 0);
 
     if (present(u"event")) {
         _playlistType = hls::PlayListType::EVENT;
@@ -260,6 +269,7 @@ bool ts::hls::OutputPlugin::createNextSegment()
 
     // Create the segment file.
     verbose(u"creating media segment %s", fileName);
+    _segmentFile.setWriteBehind(_writeBehind);
     if (!_segmentFile.open(fileName, TSFile::WRITE | TSFile::SHARED, *this)) {
         return false;
     }
@@ -60,6 +60,7 @@ namespace ts {
             size_t             _initialMediaSeq = 0;        // Initial media sequence value.
             UStringVector      _customTags {};              // Additional custom tags.
             TSPacketLabelSet   _closeLabels {};             // Close segment on packets with any of these labels.
+            size_t             _writeBehind = 0;            // Write-behind queue size in bytes for segment files.
 
             // Working data.
             FileNameGenerator  _nameGenerator {};           // Generate the segment file names.
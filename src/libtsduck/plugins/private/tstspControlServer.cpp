@@ -12,6 +12,8 @@
 #include "tsReportBuffer.h"
 #include "tsTelnetConnection.h"
 #include "tsSysUtils.h"
+#include "tsSysInfo.h"
+#include "tsjsonArray.h"
 
 
 //----------------------------------------------------------------------------
@@ -49,6 +51,7 @@ ts::tsp::ControlServer::ControlServer(TSProcessorArgs& options, Report& log, std
     _reference.setCommandLineHandler(this, &ControlServer::executeSuspend, u"suspend");
     _reference.setCommandLineHandler(this, &ControlServer::executeResume, u"resume");
     _reference.setCommandLineHandler(this, &ControlServer::executeRestart, u"restart");
+    _reference.setCommandLineHandler(this, &ControlServer::executeStats, u"stats");
 }
 
 ts::tsp::ControlServer::~ControlServer()
@@ -232,9 +235,18 @@ void ts::tsp::ControlServer::listOnePlugin(size_t index, UChar type, PluginExecu
 {
     const bool verbose = report.verbose();
     const bool suspended = plugin->getSuspended();
-    report.info(u"%2d: %s-%c %s",
+    UString cpus;
+    if (verbose) {
+        ThreadAttributes attr;
+        plugin->getAttributes(attr);
+        if (!attr.getCPUs().empty()) {
+            cpus.format(u"(cpu %s) ", SysInfo::FormatCPUList(attr.getCPUs()));
+        }
+    }
+    report.info(u"%2d: %s%s-%c %s",
                 index,
                 verbose && suspended ? u"(suspended) " : u"",
+                cpus,
                 type,
                 verbose ? plugin->plugin()->commandLine() : plugin->pluginName());
 }
@@ -299,23 +311,100 @@ ts::CommandStatus ts::tsp::ControlServer::executeRestart(const UString& command,
     }
 
     // Get the target plugin.
-    PluginExecutor* plugin = nullptr;
+    PluginExecutor* plugin = getPlugin(index);
+
+    // Restart the plugin.
+    if (same) {
+        plugin->restart(args);
+    }
+    else {
+        plugin->restart(params, args);
+    }
+    return CommandStatus::SUCCESS;
+}
+
+
+//----------------------------------------------------------------------------
+// Get a plugin executor by index in the chain, null if out of range.
+//----------------------------------------------------------------------------
+
+ts::tsp::PluginExecutor* ts::tsp::ControlServer::getPlugin(size_t index) const
+{
     if (index == 0) {
-        plugin = _input;
+        return _input;
     }
     else if (index <= _plugins.size()) {
-        plugin = _plugins[index-1];
+        return _plugins[index-1];
+    }
+    else if (index == _plugins.size() + 1) {
+        return _output;
     }
     else {
-        plugin = _output;
+        return nullptr;
     }
+}
 
-    // Restart the plugin.
-    if (same) {
-        plugin->restart(args);
+
+//----------------------------------------------------------------------------
+// Stats command.
+//----------------------------------------------------------------------------
+
+ts::CommandStatus ts::tsp::ControlServer::executeStats(const UString& command, Args& args)
+{
+    // Statistics are either enabled on all plugins or none.
+    if (_input->statistics() == nullptr) {
+        args.error(u"plugin statistics are not collected, use tsp option --plugin-statistics");
+        return CommandStatus::ERROR;
+    }
+
+    // Get the list of plugins, all plugins by default.
+    std::vector<size_t> indexes;
+    args.getIntValues(indexes, u"");
+    if (indexes.empty()) {
+        for (size_t i = 0; i <= _plugins.size() + 1; ++i) {
+            indexes.push_back(i);
+        }
+    }
+    for (size_t index : indexes) {
+        if (getPlugin(index) == nullptr) {
+            args.error(u"invalid plugin index %d, specify 0 to %d", index, _plugins.size() + 1);
+            return CommandStatus::ERROR;
+        }
+    }
+
+    const bool reset = args.present(u"reset");
+    if (args.present(u"json")) {
+        // One JSON line for all plugins.
+        json::Object root;
+        root.add(u"type", u"plugin-statistics");
+        const auto plugins = std::make_shared<json::Array>();
+        for (size_t index : indexes) {
+            const auto obj = std::make_shared<json::Object>();
+            getPlugin(index)->statisticsToJSON(*obj);
+            plugins->set(obj);
+        }
+        root.add(u"plugins", plugins);
+        args.info(root.oneLiner(args));
     }
     else {
-        plugin->restart(params, args);
+        // One text line per plugin, plus histograms in verbose mode.
+        UStringVector lines;
+        for (size_t index : indexes) {
+            PluginExecutor* plugin = getPlugin(index);
+            args.info(u"%2d: %s: %s", index, plugin->pluginName(), plugin->statistics()->toString());
+            if (args.verbose()) {
+                plugin->statistics()->histograms(lines);
+                for (const auto& line : lines) {
+                    args.info(u"    %s", line);
+                }
+            }
+        }
+    }
+
+    if (reset) {
+        for (size_t index : indexes) {
+            getPlugin(index)->statistics()->reset();
+        }
     }
     return CommandStatus::SUCCESS;
 }
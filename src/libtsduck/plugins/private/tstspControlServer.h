@@ -80,6 +80,8 @@ namespace ts {
             CommandStatus executeResume(const UString&, Args&);
             CommandStatus executeSuspendResume(bool state, Args&);
             CommandStatus executeRestart(const UString&, Args&);
+            CommandStatus executeStats(const UString&, Args&);
+            PluginExecutor* getPlugin(size_t index) const;
         };
     }
 }
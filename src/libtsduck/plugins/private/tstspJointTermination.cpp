@@ -36,6 +36,18 @@ ts::tsp::JointTermination::JointTermination(const TSProcessorArgs& options,
 }
 
 
+//----------------------------------------------------------------------------
+// Reset the "joint termination" state before a new TS processing session.
+//----------------------------------------------------------------------------
+
+void ts::tsp::JointTermination::ResetJointTermination()
+{
+    _jt_users = 0;
+    _jt_remaining = 0;
+    _jt_highest_pkt = 0;
+}
+
+
 //----------------------------------------------------------------------------
 // Implementation of "joint termination", inherited from TSP.
 //----------------------------------------------------------------------------
@@ -49,6 +49,13 @@ namespace ts {
             virtual bool useJointTermination() const override;
             virtual bool thisJointTerminated() const override;
 
+            //!
+            //! Reset the "joint termination" state before starting a new TS processing session.
+            //! The state is static and would otherwise remain from a previous session in the same process.
+            //! Must be called under the protection of the global mutex, before creating the plugin executors.
+            //!
+            static void ResetJointTermination();
+
         protected:
             std::recursive_mutex& _global_mutex;
             const TSProcessorArgs& _options;
@@ -58,6 +58,10 @@ void ts::tsp::OutputExecutor::main()
     bool aborted = false;
     bool restarted = false;
 
+    // Periodic log of plugin statistics.
+    const bool log_stats = statistics() != nullptr && _options.plugin_stats_interval > cn::seconds::zero();
+    monotonic_time next_stats_log = monotonic_time::clock::now() + _options.plugin_stats_interval;
+
     do {
         // Wait for packets to output
         size_t pkt_first = 0;
@@ -89,11 +93,12 @@ void ts::tsp::OutputExecutor::main()
             break;
         }
 
-        // Check if "joint termination" agreed on a last packet to output
+        // Check if "joint termination" agreed on a last packet to output.
+        // The packets up to that limit are still output before terminating.
         const PacketCounter jt_limit = totalPacketsBeforeJointTermination();
-        if (totalPacketsInThread() + pkt_cnt > jt_limit) {
+        const bool jt_reached = totalPacketsInThread() + pkt_cnt > jt_limit;
+        if (jt_reached) {
             pkt_cnt = totalPacketsInThread() > jt_limit ? 0 : size_t (jt_limit - totalPacketsInThread());
-            aborted = true;
         }
 
         // Output the packets. Output may be segmented if dropped packets
@@ -145,13 +150,28 @@ void ts::tsp::OutputExecutor::main()
 
         // Pass free buffers to input processor.
         // Do not transmit bitrate or input end to next (since next is input processor).
+        aborted = aborted || jt_reached;
         aborted = !passPackets(pkt_cnt, 0, BitRateConfidence::LOW, false, aborted);
 
+        // The output thread logs the statistics of all plugins.
+        if (log_stats) {
+            const monotonic_time now = monotonic_time::clock::now();
+            if (now >= next_stats_log) {
+                logAllStatistics();
+                next_stats_log = now + _options.plugin_stats_interval;
+            }
+        }
+
     } while (!aborted);
 
     // Close the output processor.
     debug(u"stopping the output plugin");
     _output->stop();
 
+    // Final statistics.
+    if (log_stats) {
+        logAllStatistics();
+    }
+
     debug(u"output thread %s after %'d packets (%'d output)", aborted ? u"aborted" : u"terminated", totalPacketsInThread(), output_packets);
 }
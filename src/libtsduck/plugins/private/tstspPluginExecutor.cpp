@@ -8,6 +8,7 @@
 
 #include "tstspPluginExecutor.h"
 #include "tsPluginRepository.h"
+#include "tsjsonArray.h"
 
 
 //----------------------------------------------------------------------------
@@ -67,7 +68,26 @@ void ts::tsp::PluginExecutor::setAbort()
 {
     std::lock_guard<std::recursive_mutex> lock(_global_mutex);
     _tsp_aborting = true;
-    ringPrevious<PluginExecutor>()->_to_do.notify_one();
+    ringPrevious<PluginExecutor>()->notifyWork(true);
+}
+
+
+//----------------------------------------------------------------------------
+// Notify this executor that something happened.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::notifyWork(bool always)
+{
+    if (!_options.lock_free) {
+        // Must be called under the protection of the global mutex.
+        _to_do.notify_one();
+    }
+    else if (always || _lf_waiting) {
+        // Acquiring the local mutex guarantees that the executor thread is either
+        // already waiting on the condition or will check its state before waiting.
+        std::lock_guard<std::mutex> lock(_lf_mutex);
+        _lf_to_do.notify_one();
+    }
 }
 
 
@@ -105,8 +125,17 @@ void ts::tsp::PluginExecutor::initBuffer(PacketBuffer*         buffer,
     _tsp_aborting = aborted;
     _bitrate = bitrate;
     _br_confidence = br_confidence;
+    _lf_bitrate = bitrate;
+    _lf_br_confidence = br_confidence;
+    _lf_next_bitrate = bitrate;
+    _lf_next_br_confidence = br_confidence;
     _tsp_bitrate = bitrate;
     _tsp_bitrate_confidence = br_confidence;
+
+    // Execution statistics are allocated only when required.
+    if (_options.plugin_stats) {
+        _stats = std::make_unique<PluginStatistics>(buffer->count());
+    }
 }
 
 
@@ -120,6 +149,14 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
 
     log(10, u"passPackets(count = %'d, bitrate = %'d, input_end = %s, aborted = %s)", count, bitrate, input_end, aborted);
 
+    if (_stats != nullptr) {
+        _stats->addPackets(count);
+    }
+
+    if (_options.lock_free) {
+        return passPacketsLockFree(count, bitrate, br_confidence, input_end, aborted);
+    }
+
     // We access data under the protection of the global mutex.
     std::lock_guard<std::recursive_mutex> lock(_global_mutex);
 
@@ -127,18 +164,19 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
     _pkt_first = (_pkt_first + count) % _buffer->count();
     _pkt_cnt -= count;
 
-    // Update next processor's buffer: add 'count' packets at the end of its slice of the buffer.
+    // Propagate bitrate to next processor.
     PluginExecutor* next = ringNext<PluginExecutor>();
-    next->_pkt_cnt += count;
-
-    // Propagate bitrate and end of input flag to next processor.
     next->_bitrate = bitrate;
     next->_br_confidence = br_confidence;
+
+    // Update next processor's buffer: add 'count' packets at the end of its slice of the buffer.
+    // Then propagate end of input flag.
+    next->_pkt_cnt += count;
     next->_input_end = next->_input_end || input_end;
 
     // Wake the next processor when there is some new input data or end of input.
     if (count > 0 || input_end) {
-        next->_to_do.notify_one();
+        next->notifyWork(true);
     }
 
     // Force to abort our processor when the next one is aborting. Already done in waitWork() but force immediately.
@@ -150,7 +188,62 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
     // Wake the previous processor when we abort (propagate abort conditions backward).
     if (aborted) {
         _tsp_aborting = true; // volatile bool in TSP superclass
-        ringPrevious<PluginExecutor>()->_to_do.notify_one();
+        ringPrevious<PluginExecutor>()->notifyWork(true);
+    }
+
+    // Return false when the current processor shall stop.
+    return !input_end && !aborted;
+}
+
+
+//----------------------------------------------------------------------------
+// Signal that the specified number of packets have been processed.
+// Lock-free version: only this thread and the next one access the boundary.
+//----------------------------------------------------------------------------
+
+bool ts::tsp::PluginExecutor::passPacketsLockFree(size_t count, const BitRate& bitrate, BitRateConfidence br_confidence, bool input_end, bool aborted)
+{
+    PluginExecutor* next = ringNext<PluginExecutor>();
+
+    // Publish a new bitrate to the next processor only when it changes.
+    // The bitrate is published before the packets, the next processor will see it with them.
+    if (bitrate != _lf_next_bitrate || br_confidence != _lf_next_br_confidence) {
+        _lf_next_bitrate = bitrate;
+        _lf_next_br_confidence = br_confidence;
+        std::lock_guard<std::mutex> lock(next->_lf_mutex);
+        next->_bitrate = bitrate;
+        next->_br_confidence = br_confidence;
+        next->_lf_br_version++;
+    }
+
+    // Update our buffer: we remove the first 'count' packets from the beginning of our slice of the buffer.
+    // Only this thread updates _pkt_first. The previous processor concurrently increments _pkt_cnt.
+    _pkt_first = (_pkt_first + count) % _buffer->count();
+    _pkt_cnt -= count;
+
+    // Update next processor's buffer: add 'count' packets at the end of its slice of the buffer.
+    // The end of input flag must be set after the packets: when the next processor sees
+    // the end of input, all packets from this processor are already in its slice.
+    next->_pkt_cnt += count;
+    if (input_end) {
+        next->_input_end = true;
+    }
+
+    // Wake the next processor when there is some new input data or end of input.
+    if (count > 0 || input_end) {
+        next->notifyWork(false);
+    }
+
+    // Force to abort our processor when the next one is aborting (see passPackets()).
+    if (plugin()->type() != PluginType::OUTPUT) {
+        aborted = aborted || next->_tsp_aborting;
+    }
+
+    // Wake the previous processor when we abort (propagate abort conditions backward).
+    // Aborting is rare, always notify the previous processor.
+    if (aborted) {
+        _tsp_aborting = true; // volatile bool in TSP superclass
+        ringPrevious<PluginExecutor>()->notifyWork(true);
     }
 
     // Return false when the current processor shall stop.
@@ -174,6 +267,32 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
         min_pkt_cnt = _buffer->count();
     }
 
+    if (_stats != nullptr) {
+        _stats->startWait();
+    }
+
+    if (_options.lock_free) {
+        waitWorkLockFree(min_pkt_cnt, pkt_first, pkt_cnt, bitrate, br_confidence, input_end, aborted, timeout);
+    }
+    else {
+        waitWorkGlobalMutex(min_pkt_cnt, pkt_first, pkt_cnt, bitrate, br_confidence, input_end, aborted, timeout);
+    }
+
+    if (_stats != nullptr) {
+        _stats->endWait(pkt_cnt);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Wait for packets to process or some error condition.
+// Version with the global mutex.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::waitWorkGlobalMutex(size_t min_pkt_cnt, size_t& pkt_first, size_t& pkt_cnt,
+                                                  BitRate& bitrate, BitRateConfidence& br_confidence,
+                                                  bool& input_end, bool& aborted, bool &timeout)
+{
     // We access data under the protection of the global mutex.
     std::unique_lock<std::recursive_mutex> lock(_global_mutex);
 
@@ -204,7 +323,7 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
     }
     else if (_pkt_first + min_pkt_cnt <= _buffer->count()) {
         // Return up to the wrap-up point. This will satisfy the requested minimum.
-        pkt_cnt = std::min(_pkt_cnt, _buffer->count() - _pkt_first);
+        pkt_cnt = std::min<size_t>(_pkt_cnt, _buffer->count() - _pkt_first);
     }
     else {
         // The requested minimum does not fit into a contiguous area.
@@ -226,6 +345,75 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
 }
 
 
+//----------------------------------------------------------------------------
+// Wait for packets to process or some error condition.
+// Lock-free version: only this thread and the previous one access the boundary.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::waitWorkLockFree(size_t min_pkt_cnt, size_t& pkt_first, size_t& pkt_cnt,
+                                               BitRate& bitrate, BitRateConfidence& br_confidence,
+                                               bool& input_end, bool& aborted, bool &timeout)
+{
+    PluginExecutor* next = ringNext<PluginExecutor>();
+    timeout = false;
+
+    // Same wakeup condition as with the global mutex.
+    const auto ready = [this, next, min_pkt_cnt]() {
+        return _pkt_cnt >= min_pkt_cnt || _input_end || next->_tsp_aborting;
+    };
+
+    if (!ready()) {
+        // Declare that we are waiting before checking the condition again, under the protection of the local mutex.
+        // A thread which updates the condition checks _lf_waiting after the update and notifies us under the same mutex.
+        std::unique_lock<std::mutex> lock(_lf_mutex);
+        _lf_waiting = true;
+        while (!ready() && !timeout) {
+            if (_tsp_timeout.count() < 0) {
+                // No timeout.
+                _lf_to_do.wait(lock);
+            }
+            else {
+                timeout = _lf_to_do.wait_for(lock, _tsp_timeout) == std::cv_status::timeout && !plugin()->handlePacketTimeout();
+            }
+        }
+        _lf_waiting = false;
+    }
+
+    // Read the end of input before the packet count. When the end of input is set, the count is final.
+    const bool end = _input_end;
+    const size_t available = _pkt_cnt;
+
+    // The number of returned packets is limited up to the wrap-up point of the circular buffer,
+    // if allowed by the requested minimum number of packets.
+    if (timeout) {
+        pkt_cnt = 0;
+    }
+    else if (_pkt_first + min_pkt_cnt <= _buffer->count()) {
+        pkt_cnt = std::min(available, _buffer->count() - _pkt_first);
+    }
+    else {
+        pkt_cnt = available;
+    }
+
+    // Get the latest bitrate only when the previous processor published a new one.
+    if (_lf_br_version != _lf_br_version_seen) {
+        std::lock_guard<std::mutex> lock(_lf_mutex);
+        _lf_br_version_seen = _lf_br_version;
+        _lf_bitrate = _bitrate;
+        _lf_br_confidence = _br_confidence;
+    }
+    bitrate = _lf_bitrate;
+    br_confidence = _lf_br_confidence;
+
+    pkt_first = _pkt_first;
+    input_end = end && pkt_cnt == available;
+    aborted = plugin()->type() != PluginType::OUTPUT && next->_tsp_aborting;
+
+    log(10, u"waitWork(min_pkt_cnt = %'d, pkt_first = %'d, pkt_cnt = %'d, bitrate = %'d, input_end = %s, aborted = %s, timeout = %s)",
+        min_pkt_cnt, pkt_first, pkt_cnt, bitrate, input_end, aborted, timeout);
+}
+
+
 //----------------------------------------------------------------------------
 // Description of a restart operation (constructor).
 //----------------------------------------------------------------------------
@@ -273,7 +461,7 @@ void ts::tsp::PluginExecutor::restart(const RestartDataPtr& rd)
         _restart = true;
 
         // Signal the plugin thread that there is something to do.
-        _to_do.notify_one();
+        notifyWork(true);
     }
 
     // Now wait for the restart operation to complete.
@@ -288,6 +476,10 @@ void ts::tsp::PluginExecutor::restart(const RestartDataPtr& rd)
 
 bool ts::tsp::PluginExecutor::pendingRestart()
 {
+    // Fast path, without locking the global mutex.
+    if (!_restart) {
+        return false;
+    }
     std::lock_guard<std::recursive_mutex> lock(_global_mutex);
     return _restart && _restart_data != nullptr;
 }
@@ -299,6 +491,13 @@ bool ts::tsp::PluginExecutor::pendingRestart()
 
 bool ts::tsp::PluginExecutor::processPendingRestart(bool& restarted)
 {
+    // Fast path, without locking the global mutex. This method is called for each packet.
+    // The flag is set under the protection of the global mutex and checked again below.
+    if (!_restart) {
+        restarted = false;
+        return true;
+    }
+
     // Run under the protection of the global mutex.
     // To avoid deadlocks, always acquire the global mutex first, then a RestartData mutex.
     // Need improvement: the global mutex remains locked during the complete restart operation.
@@ -370,3 +569,42 @@ bool ts::tsp::PluginExecutor::processPendingRestart(bool& restarted)
     debug(u"restarted plugin %s, status: %s", pluginName(), success);
     return success;
 }
+
+
+//----------------------------------------------------------------------------
+// Build a JSON description of the plugin and its execution statistics.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::statisticsToJSON(json::Object& obj) const
+{
+    obj.add(u"index", pluginIndex());
+    obj.add(u"name", pluginName());
+    obj.add(u"plugin", PluginTypeNames().name(plugin()->type()));
+    if (_stats != nullptr) {
+        _stats->toJSON(obj);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Log the execution statistics of all plugins in the chain as one JSON line.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::logAllStatistics()
+{
+    if (_stats != nullptr) {
+        json::Object root;
+        root.add(u"type", u"plugin-statistics");
+        const auto plugins = std::make_shared<json::Array>();
+        // The chain of executors is never modified while the plugin threads are running.
+        PluginExecutor* proc = this;
+        do {
+            proc = proc->ringNext<PluginExecutor>();
+            const auto obj = std::make_shared<json::Object>();
+            proc->statisticsToJSON(*obj);
+            plugins->set(obj);
+        } while (proc != this);
+        root.add(u"plugins", plugins);
+        info(root.oneLiner(*this));
+    }
+}
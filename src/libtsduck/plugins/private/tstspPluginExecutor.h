@@ -13,6 +13,7 @@
 
 #pragma once
 #include "tstspJointTermination.h"
+#include "tstspPluginStatistics.h"
 #include "tsRingNode.h"
 #include "tsTSProcessorArgs.h"
 #include "tsPluginEventHandlerRegistry.h"
@@ -120,6 +121,18 @@ namespace ts {
             //!
             void restart(Report& report);
 
+            //!
+            //! Get the execution statistics of the plugin.
+            //! @return Address of the statistics or null when statistics are not collected (tsp option --plugin-statistics).
+            //!
+            PluginStatistics* statistics() const { return _stats.get(); }
+
+            //!
+            //! Build a JSON description of the plugin and its execution statistics.
+            //! @param [in,out] obj A JSON object where the description is added.
+            //!
+            void statisticsToJSON(json::Object& obj) const;
+
             // Implementation of TSP virtual methods.
             virtual size_t pluginCount() const override;
             virtual void signalPluginEvent(uint32_t event_code, Object* plugin_data = nullptr) const override;
@@ -192,6 +205,12 @@ namespace ts {
             //!
             bool processPendingRestart(bool& restarted);
 
+            //!
+            //! Log the execution statistics of all plugins in the chain as one JSON line.
+            //! Does nothing if statistics are not collected.
+            //!
+            void logAllStatistics();
+
         private:
             // Registry of plugin event handlers.
             const PluginEventHandlerRegistry& _handlers;
@@ -203,14 +222,47 @@ namespace ts {
             // The following private data must be accessed exclusively under the protection of the global mutex.
             // Implementation details: see the file src/docs/developing-plugins.dox.
             // [*] After initialization, these fields are read/written only in passPackets() and waitWork().
+            // [LF] In lock-free mode, these fields are accessed without the global mutex (see below).
             std::condition_variable_any _to_do {}; // Notify the processor thread to do something.
-            size_t            _pkt_first = 0;      // Starting index of packets area [*]
-            size_t            _pkt_cnt = 0;        // Size of packets area [*]
-            bool              _input_end = false;  // No more packet after current ones [*]
-            BitRate           _bitrate = 0;        // Input bitrate (set by previous plugin) [*]
-            BitRateConfidence _br_confidence = BitRateConfidence::LOW;  // Input bitrate confidence (set by previous plugin) [*]
-            bool              _restart = false;    // Restart the plugin asap using _restart_data
+            size_t              _pkt_first = 0;    // Starting index of packets area [*] [LF: written by this thread only]
+            std::atomic<size_t> _pkt_cnt {0};      // Size of packets area [*] [LF: atomic]
+            std::atomic<bool>   _input_end {false}; // No more packet after current ones [*] [LF: atomic]
+            BitRate           _bitrate = 0;        // Input bitrate (set by previous plugin) [*] [LF: under _lf_mutex]
+            BitRateConfidence _br_confidence = BitRateConfidence::LOW;  // Input bitrate confidence (set by previous plugin) [*] [LF: under _lf_mutex]
+            std::atomic<bool> _restart {false};    // Restart the plugin asap using _restart_data
             RestartDataPtr    _restart_data {};    // How to restart the plugin
+            std::unique_ptr<PluginStatistics> _stats {}; // Execution statistics, allocated in initBuffer() when enabled.
+
+            // Lock-free mode (tsp option --lock-free): each boundary between two executors is a
+            // single-producer / single-consumer cursor on the packet buffer. The previous executor
+            // increments _pkt_cnt, this executor decrements it. The global mutex is not used when
+            // passing packets. A local mutex and condition variable are used only to sleep when there
+            // is nothing to do (the waker checks _lf_waiting first) and to exchange bitrates, which
+            // is done only when the bitrate changes (notified through _lf_br_version).
+            std::mutex              _lf_mutex {};            // Protect sleep/wakeup and bitrate exchange.
+            std::condition_variable _lf_to_do {};            // Notify the processor thread to do something.
+            std::atomic<bool>       _lf_waiting {false};     // This thread is waiting on _lf_to_do.
+            std::atomic<uint32_t>   _lf_br_version {0};      // Incremented by previous plugin on each new bitrate.
+            uint32_t                _lf_br_version_seen = 0; // Last _lf_br_version read by this thread.
+            BitRate                 _lf_bitrate = 0;         // Last input bitrate read by this thread.
+            BitRateConfidence       _lf_br_confidence = BitRateConfidence::LOW; // Last input bitrate confidence read by this thread.
+            BitRate                 _lf_next_bitrate = 0;    // Last bitrate passed to next plugin (this thread only).
+            BitRateConfidence       _lf_next_br_confidence = BitRateConfidence::LOW; // Last confidence passed to next plugin.
+
+            // Notify this executor that something happened. When always is false in lock-free mode,
+            // the notification is skipped if the executor thread is not waiting.
+            void notifyWork(bool always);
+
+            // Implementation of waitWork() with the global mutex.
+            void waitWorkGlobalMutex(size_t min_pkt_cnt, size_t& pkt_first, size_t& pkt_cnt,
+                                     BitRate& bitrate, BitRateConfidence& br_confidence,
+                                     bool& input_end, bool& aborted, bool &timeout);
+
+            // Implementation of passPackets() and waitWork() in lock-free mode.
+            bool passPacketsLockFree(size_t count, const BitRate& bitrate, BitRateConfidence br_confidence, bool input_end, bool aborted);
+            void waitWorkLockFree(size_t min_pkt_cnt, size_t& pkt_first, size_t& pkt_cnt,
+                                  BitRate& bitrate, BitRateConfidence& br_confidence,
+                                  bool& input_end, bool& aborted, bool &timeout);
 
             // Description of a restart operation.
             class RestartData
@@ -0,0 +1,119 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tstspPluginStatistics.h"
+#include "tsSysUtils.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor and reset.
+//----------------------------------------------------------------------------
+
+ts::tsp::PluginStatistics::PluginStatistics(size_t buffer_count) :
+    _buffer_count(buffer_count)
+{
+    reset();
+}
+
+void ts::tsp::PluginStatistics::reset()
+{
+    _process_us.reset();
+    _cpu_us.reset();
+    _wait_us.reset();
+    _buffer_pkt.reset();
+    _packets.store(0, std::memory_order_relaxed);
+    _start.store(monotonic_time::clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+cn::microseconds ts::tsp::PluginStatistics::elapsed() const
+{
+    const monotonic_time start {monotonic_time::duration(_start.load(std::memory_order_relaxed))};
+    return cn::duration_cast<cn::microseconds>(monotonic_time::clock::now() - start);
+}
+
+
+//----------------------------------------------------------------------------
+// Collect statistics in the executor thread.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginStatistics::startWait()
+{
+    _wait_start = monotonic_time::clock::now();
+    if (_in_batch) {
+        _in_batch = false;
+        _process_us.feed(uint64_t(cn::duration_cast<cn::microseconds>(_wait_start - _batch_start).count()));
+        _cpu_us.feed(uint64_t(std::max(cn::microseconds::zero(), GetThreadCpuTime() - _batch_cpu).count()));
+    }
+}
+
+void ts::tsp::PluginStatistics::endWait(size_t pkt_cnt)
+{
+    _batch_start = monotonic_time::clock::now();
+    _batch_cpu = GetThreadCpuTime();
+    _in_batch = true;
+    _wait_us.feed(uint64_t(cn::duration_cast<cn::microseconds>(_batch_start - _wait_start).count()));
+    _buffer_pkt.feed(pkt_cnt);
+}
+
+
+//----------------------------------------------------------------------------
+// Build a JSON description of the statistics.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginStatistics::HistogramToJSON(json::Object& obj, const UString& name, const LogHistogram& hist)
+{
+    json::Value& jv(obj.query(name, true));
+    jv.add(u"count", hist.count());
+    jv.add(u"mean", hist.mean());
+    jv.add(u"p50", hist.percentile(50));
+    jv.add(u"p90", hist.percentile(90));
+    jv.add(u"p99", hist.percentile(99));
+    jv.add(u"max", hist.maximum());
+}
+
+void ts::tsp::PluginStatistics::toJSON(json::Object& obj) const
+{
+    const cn::microseconds duration = elapsed();
+    const uint64_t packets = _packets.load(std::memory_order_relaxed);
+    obj.add(u"elapsed-ms", duration.count() / 1000);
+    obj.add(u"packets", packets);
+    obj.add(u"packets-per-second", duration.count() <= 0 ? 0 : (packets * 1'000'000) / uint64_t(duration.count()));
+    obj.add(u"cpu-percent", duration.count() <= 0 ? 0.0 : (100.0 * double(_cpu_us.sum())) / double(duration.count()));
+    obj.add(u"buffer-size", _buffer_count);
+    HistogramToJSON(obj, u"process-us", _process_us);
+    HistogramToJSON(obj, u"cpu-us", _cpu_us);
+    HistogramToJSON(obj, u"wait-us", _wait_us);
+    HistogramToJSON(obj, u"buffer-packets", _buffer_pkt);
+}
+
+
+//----------------------------------------------------------------------------
+// Build text descriptions of the statistics.
+//----------------------------------------------------------------------------
+
+ts::UString ts::tsp::PluginStatistics::toString() const
+{
+    const cn::microseconds duration = elapsed();
+    const uint64_t packets = _packets.load(std::memory_order_relaxed);
+    return UString::Format(u"%'d pkt/s, cpu: %.1f%%, process: %.1f/%d/%d us, wait: %.1f/%d/%d us, buffer: %.1f%%/%.1f%%",
+                           duration.count() <= 0 ? 0 : (packets * 1'000'000) / uint64_t(duration.count()),
+                           duration.count() <= 0 ? 0.0 : (100.0 * double(_cpu_us.sum())) / double(duration.count()),
+                           _process_us.mean(), _process_us.percentile(99), _process_us.maximum(),
+                           _wait_us.mean(), _wait_us.percentile(99), _wait_us.maximum(),
+                           _buffer_count == 0 ? 0.0 : (100.0 * _buffer_pkt.mean()) / double(_buffer_count),
+                           _buffer_count == 0 ? 0.0 : (100.0 * double(_buffer_pkt.maximum())) / double(_buffer_count));
+}
+
+void ts::tsp::PluginStatistics::histograms(UStringVector& lines) const
+{
+    lines.clear();
+    lines.push_back(u"process (us): " + _process_us.bucketsString());
+    lines.push_back(u"cpu (us): " + _cpu_us.bucketsString());
+    lines.push_back(u"wait (us): " + _wait_us.bucketsString());
+    lines.push_back(u"buffer (packets): " + _buffer_pkt.bucketsString());
+}
@@ -0,0 +1,101 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Transport stream processor: Execution statistics of a plugin
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsLogHistogram.h"
+#include "tsjsonObject.h"
+
+namespace ts {
+    namespace tsp {
+        //!
+        //! Execution statistics of a tsp plugin (tsp option --plugin-statistics).
+        //! This class is internal to the TSDuck library and cannot be called by applications.
+        //! @ingroup libtsduck plugin
+        //!
+        //! The statistics are collected by the plugin executor thread, around each wait for work.
+        //! A "batch" is the processing of the packets which are returned by one wait for work.
+        //! The statistics can be read or reset by any other thread, without synchronization.
+        //!
+        class PluginStatistics
+        {
+            TS_NOBUILD_NOCOPY(PluginStatistics);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] buffer_count Size in packets of the global packet buffer.
+            //!
+            PluginStatistics(size_t buffer_count);
+
+            //!
+            //! Reset all statistics. Can be called from any thread.
+            //!
+            void reset();
+
+            //!
+            //! Mark the end of a batch and the start of a wait for work (executor thread only).
+            //!
+            void startWait();
+
+            //!
+            //! Mark the end of a wait for work and the start of a batch (executor thread only).
+            //! @param [in] pkt_cnt Number of packets which are available to the plugin.
+            //!
+            void endWait(size_t pkt_cnt);
+
+            //!
+            //! Count packets which are passed to the next plugin (executor thread only).
+            //! @param [in] count Number of packets.
+            //!
+            void addPackets(size_t count) { _packets.fetch_add(count, std::memory_order_relaxed); }
+
+            //!
+            //! Build a JSON description of the statistics.
+            //! @param [in,out] obj A JSON object where the statistics are added.
+            //!
+            void toJSON(json::Object& obj) const;
+
+            //!
+            //! Build a one-line text description of the statistics.
+            //! @return A one-line text description of the statistics.
+            //!
+            UString toString() const;
+
+            //!
+            //! Build a multi-line text description of the histograms.
+            //! @param [out] lines Text lines, one per histogram.
+            //!
+            void histograms(UStringVector& lines) const;
+
+        private:
+            const size_t _buffer_count;
+            LogHistogram _process_us {};            // Processing time per batch, in microseconds.
+            LogHistogram _cpu_us {};                // Thread CPU time per batch, in microseconds.
+            LogHistogram _wait_us {};               // Wait time for work, in microseconds.
+            LogHistogram _buffer_pkt {};            // Packets which are available in the buffer after each wait.
+            std::atomic<uint64_t> _packets {0};     // Packets passed to next plugin.
+            std::atomic<monotonic_time::rep> _start {0};  // Time of last reset.
+
+            // Accessed by the executor thread only.
+            bool             _in_batch = false;
+            monotonic_time   _wait_start {};
+            monotonic_time   _batch_start {};
+            cn::microseconds _batch_cpu {};
+
+            // Elapsed time since last reset.
+            cn::microseconds elapsed() const;
+
+            // Add the description of a histogram in a JSON object.
+            static void HistogramToJSON(json::Object& obj, const UString& name, const LogHistogram& hist);
+        };
+    }
+}
@@ -69,6 +69,9 @@ void ts::tsp::ProcessorExecutor::main()
         window_size = _processor->getPacketWindowSize();
     }
 
+    // Check if the plugin shall process packet windows in parallel.
+    setupWorkers(window_size);
+
     // Perform the complete packet processing in individual-packet or packet-window mode.
     if (window_size == 0) {
         processIndividualPackets();
@@ -77,6 +80,9 @@ void ts::tsp::ProcessorExecutor::main()
         processPacketWindows(window_size);
     }
 
+    // Terminate the worker threads, if any.
+    _workers.reset();
+
     // Close the packet processor.
     debug(u"stopping the plugin");
     _processor->stop();
@@ -311,6 +317,7 @@ void ts::tsp::ProcessorExecutor::processPacketWindows(size_t window_size)
                 // Don't let window size be zero, we are in packet window mode.
                 _processor->getOnlyExceptLabelOption(only_labels, except_labels);
                 window_size = std::max<size_t>(1, _processor->getPacketWindowSize());
+                setupWorkers(window_size);
             }
 
             // If the plugin is suspended, simply pass the packets to the next plugin.
@@ -357,8 +364,19 @@ void ts::tsp::ProcessorExecutor::processPacketWindows(size_t window_size)
             request_packets += window_size - win.size();
         }
 
-        // Let the plugin process the packet window.
-        const size_t processed_packets = _processor->processPacketWindow(win);
+        // Let the plugin process the packet window, possibly in parallel.
+        // In parallel mode, even small windows go through processParallelWindow() to be analyzed first.
+        size_t processed_packets = 0;
+        size_t drop_count = 0;
+        size_t nullify_count = 0;
+        if (_workers != nullptr) {
+            processed_packets = processParallelWindow(win, drop_count, nullify_count);
+        }
+        else {
+            processed_packets = _processor->processPacketWindow(win);
+            drop_count = win.dropCount();
+            nullify_count = win.nullifyCount();
+        }
 
         // If not all packets from the window were processed, the plugin want to terminate the stream processing.
         if (processed_packets < win.size()) {
@@ -386,9 +404,9 @@ void ts::tsp::ProcessorExecutor::processPacketWindows(size_t window_size)
         }
 
         // Count packets which were processed in the plugin.
-        passed_packets += processed_packets - win.dropCount();
-        dropped_packets += win.dropCount();
-        nullified_packets += win.nullifyCount();
+        passed_packets += processed_packets - drop_count;
+        dropped_packets += drop_count;
+        nullified_packets += nullify_count;
         addPluginPackets(processed_packets);
         addNonPluginPackets(allocated_packets - processed_packets);
 
@@ -420,3 +438,123 @@ void ts::tsp::ProcessorExecutor::processPacketWindows(size_t window_size)
     debug(u"packet processing thread %s after %'d packets, %'d passed, %'d dropped, %'d nullified",
           input_end ? u"terminated" : u"aborted", pluginPackets(), passed_packets, dropped_packets, nullified_packets);
 }
+
+
+//----------------------------------------------------------------------------
+// Setup the worker threads for parallel processing.
+//----------------------------------------------------------------------------
+
+void ts::tsp::ProcessorExecutor::setupWorkers(size_t window_size)
+{
+    const size_t count = _processor->getParallelOption();
+    _parallel_mode = _processor->getParallelMode();
+
+    if (count <= 1 || window_size == 0 || _parallel_mode == ProcessorPlugin::ParallelMode::NONE) {
+        if (count > 1) {
+            warning(u"parallel processing is not supported by this plugin in this configuration, --parallel ignored");
+        }
+        _workers.reset();
+    }
+    else if (_workers == nullptr || _workers->count() != count) {
+        // The worker threads inherit the attributes (priority, CPU affinity) of the plugin thread.
+        ThreadAttributes attributes;
+        getAttributes(attributes);
+        _workers.reset();
+        _workers = std::make_unique<WorkerPool>(count, attributes);
+        _slices.resize(count);
+        for (auto& slice : _slices) {
+            if (slice == nullptr) {
+                slice = std::make_unique<TSPacketWindow>();
+            }
+        }
+        _slice_indexes.resize(count);
+        _slice_processed.resize(count);
+        _pid_packets.assign(PID_MAX, 0);
+        _pid_slice.assign(PID_MAX, 0);
+        verbose(u"parallel packet processing using %d threads, %s", count, _parallel_mode == ProcessorPlugin::ParallelMode::PER_PID ? u"per PID" : u"per packet");
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Process a packet window in parallel.
+//----------------------------------------------------------------------------
+
+size_t ts::tsp::ProcessorExecutor::processParallelWindow(TSPacketWindow& win, size_t& drop_count, size_t& nullify_count)
+{
+    const size_t count = _workers->count();
+    for (size_t i = 0; i < count; ++i) {
+        _slices[i]->clear();
+        _slice_indexes[i].clear();
+    }
+
+    // Let the plugin analyze the complete packet window in sequence first.
+    // Only the analyzed packets are processed in parallel.
+    const size_t analyzed = std::min(win.size(), _processor->analyzePacketWindow(win));
+
+    // Build the slices of the packet window.
+    if (_parallel_mode == ProcessorPlugin::ParallelMode::PER_PACKET) {
+        // Split the window in contiguous slices of similar sizes.
+        for (size_t i = 0; i < analyzed; ++i) {
+            TSPacket* pkt = win.packet(i);
+            if (pkt != nullptr) {
+                const size_t index = (i * count) / analyzed;
+                _slices[index]->addPacketsReference(pkt, win.metadata(i), 1);
+                _slice_indexes[index].push_back(i);
+            }
+        }
+    }
+    else {
+        // All packets of a PID are in the same slice. To balance the load between slices,
+        // the PID's with most packets are first assigned to the least loaded slice.
+        _pids.clear();
+        for (size_t i = 0; i < analyzed; ++i) {
+            const TSPacket* pkt = win.packet(i);
+            if (pkt != nullptr && _pid_packets[pkt->getPID()]++ == 0) {
+                _pids.push_back(pkt->getPID());
+            }
+        }
+        std::sort(_pids.begin(), _pids.end(), [this](PID p1, PID p2) { return _pid_packets[p1] > _pid_packets[p2]; });
+        std::fill(_slice_processed.begin(), _slice_processed.end(), 0); // used as slice load here
+        for (PID pid : _pids) {
+            const size_t index = std::min_element(_slice_processed.begin(), _slice_processed.end()) - _slice_processed.begin();
+            _pid_slice[pid] = index;
+            _slice_processed[index] += _pid_packets[pid];
+            _pid_packets[pid] = 0;
+        }
+        for (size_t i = 0; i < analyzed; ++i) {
+            TSPacket* pkt = win.packet(i);
+            if (pkt != nullptr) {
+                const size_t index = _pid_slice[pkt->getPID()];
+                _slices[index]->addPacketsReference(pkt, win.metadata(i), 1);
+                _slice_indexes[index].push_back(i);
+            }
+        }
+    }
+
+    // Process all slices in parallel.
+    _workers->run(*this);
+
+    // If a slice was not completely processed, the processing terminates before its first unprocessed packet.
+    // The packets after this point in other slices may have been processed but they are not passed.
+    size_t processed = analyzed;
+    drop_count = nullify_count = 0;
+    for (size_t i = 0; i < count; ++i) {
+        drop_count += _slices[i]->dropCount();
+        nullify_count += _slices[i]->nullifyCount();
+        if (_slice_processed[i] < _slices[i]->size()) {
+            processed = std::min(processed, _slice_indexes[i][_slice_processed[i]]);
+        }
+    }
+    return processed;
+}
+
+
+//----------------------------------------------------------------------------
+// Process one slice of packet window in a worker thread.
+//----------------------------------------------------------------------------
+
+void ts::tsp::ProcessorExecutor::executeJob(size_t index)
+{
+    _slice_processed[index] = _slices[index]->size() == 0 ? 0 : _processor->processPacketWindow(*_slices[index]);
+}
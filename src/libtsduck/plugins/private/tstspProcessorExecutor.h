@@ -13,6 +13,7 @@
 
 #pragma once
 #include "tstspPluginExecutor.h"
+#include "tstspWorkerPool.h"
 #include "tsProcessorPlugin.h"
 
 namespace ts {
@@ -22,7 +23,7 @@ namespace ts {
         //! This class is internal to the TSDuck library and cannot be called by applications.
         //! @ingroup libtsduck plugin
         //!
-        class ProcessorExecutor: public PluginExecutor
+        class ProcessorExecutor: public PluginExecutor, private WorkerPool::JobInterface
         {
             TS_NOBUILD_NOCOPY(ProcessorExecutor);
         public:
@@ -54,12 +55,31 @@ namespace ts {
             ProcessorPlugin* _processor = nullptr;
             const size_t _plugin_index;
 
+            // Parallel processing of packet windows (option --parallel).
+            ProcessorPlugin::ParallelMode _parallel_mode = ProcessorPlugin::ParallelMode::NONE;
+            std::unique_ptr<WorkerPool> _workers {};
+            std::vector<std::unique_ptr<TSPacketWindow>> _slices {};  // One slice of packet window per worker.
+            std::vector<std::vector<size_t>> _slice_indexes {};       // Index in complete window of each packet in slices.
+            std::vector<size_t> _slice_processed {};                  // Number of processed packets per slice.
+            std::vector<size_t> _pid_packets {};                      // Number of packets per PID in current window.
+            std::vector<size_t> _pid_slice {};                        // Slice index per PID in current window.
+            std::vector<PID> _pids {};                                // List of PID's in current window.
+
             // Inherited from Thread
             virtual void main() override;
 
             // Process packets one by one or using packet windows.
             void processIndividualPackets();
             void processPacketWindows(size_t window_size);
+
+            // Setup the worker threads for parallel processing, according to the plugin options.
+            void setupWorkers(size_t window_size);
+
+            // Process a packet window in parallel, same interface as ProcessorPlugin::processPacketWindow().
+            size_t processParallelWindow(TSPacketWindow& win, size_t& drop_count, size_t& nullify_count);
+
+            // Implementation of WorkerPool::JobInterface: process one slice of packet window.
+            virtual void executeJob(size_t index) override;
         };
     }
 }
@@ -0,0 +1,99 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tstspWorkerPool.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::tsp::WorkerPool::WorkerPool(size_t count, const ThreadAttributes& attributes)
+{
+    for (size_t index = 1; index < count; ++index) {
+        _workers.push_back(std::make_unique<Worker>(*this, index, attributes));
+        _workers.back()->start();
+    }
+}
+
+ts::tsp::WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _terminate = true;
+        _work_cond.notify_all();
+    }
+    // The destructors of the workers wait for their termination.
+    _workers.clear();
+}
+
+ts::tsp::WorkerPool::JobInterface::~JobInterface()
+{
+}
+
+ts::tsp::WorkerPool::Worker::Worker(WorkerPool& pool, size_t index, const ThreadAttributes& attributes) :
+    Thread(attributes),
+    _pool(pool),
+    _index(index)
+{
+}
+
+ts::tsp::WorkerPool::Worker::~Worker()
+{
+    waitForTermination();
+}
+
+
+//----------------------------------------------------------------------------
+// Execute a job in all threads of the pool.
+//----------------------------------------------------------------------------
+
+void ts::tsp::WorkerPool::run(JobInterface& job)
+{
+    // Wake up all workers.
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _job = &job;
+        _pending = _workers.size();
+        _generation++;
+        _work_cond.notify_all();
+    }
+
+    // The calling thread executes the first part of the job.
+    job.executeJob(0);
+
+    // Wait for all workers to complete.
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done_cond.wait(lock, [this]() { return _pending == 0; });
+    _job = nullptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Worker thread main code.
+//----------------------------------------------------------------------------
+
+void ts::tsp::WorkerPool::Worker::main()
+{
+    uint64_t generation = 0;
+    std::unique_lock<std::mutex> lock(_pool._mutex);
+    for (;;) {
+        _pool._work_cond.wait(lock, [this, generation]() { return _pool._terminate || _pool._generation != generation; });
+        if (_pool._terminate) {
+            break;
+        }
+        generation = _pool._generation;
+        JobInterface* job = _pool._job;
+        lock.unlock();
+        job->executeJob(_index);
+        lock.lock();
+        if (--_pool._pending == 0) {
+            _pool._done_cond.notify_one();
+        }
+    }
+}
@@ -0,0 +1,97 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Transport stream processor: Pool of worker threads for a plugin
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsThread.h"
+
+namespace ts {
+    namespace tsp {
+        //!
+        //! Pool of worker threads which execute the same job in parallel (tsp plugin option -\-parallel).
+        //! This class is internal to the TSDuck library and cannot be called by applications.
+        //! @ingroup libtsduck plugin
+        //!
+        //! The calling thread is part of the pool and executes the job with index zero.
+        //! All methods shall be called from the same calling thread.
+        //!
+        class WorkerPool
+        {
+            TS_NOBUILD_NOCOPY(WorkerPool);
+        public:
+            //!
+            //! Interface for classes which execute jobs in the pool.
+            //!
+            class JobInterface
+            {
+            public:
+                //!
+                //! Execute the job in one thread of the pool.
+                //! @param [in] index Index of the thread in the pool, from zero to count() - 1.
+                //!
+                virtual void executeJob(size_t index) = 0;
+
+                //!
+                //! Virtual destructor.
+                //!
+                virtual ~JobInterface();
+            };
+
+            //!
+            //! Constructor.
+            //! @param [in] count Number of threads in the pool, including the calling thread.
+            //! @param [in] attributes Creation attributes for the worker threads.
+            //!
+            WorkerPool(size_t count, const ThreadAttributes& attributes);
+
+            //!
+            //! Destructor, terminate all worker threads.
+            //!
+            ~WorkerPool();
+
+            //!
+            //! Get the number of threads in the pool, including the calling thread.
+            //! @return The number of threads in the pool.
+            //!
+            size_t count() const { return _workers.size() + 1; }
+
+            //!
+            //! Execute a job in all threads of the pool and wait for all of them to complete.
+            //! @param [in] job The job to execute. Its method executeJob() is called once in each thread.
+            //!
+            void run(JobInterface& job);
+
+        private:
+            // Each worker thread executes the jobs with the same index.
+            class Worker: public Thread
+            {
+                TS_NOBUILD_NOCOPY(Worker);
+            public:
+                Worker(WorkerPool& pool, size_t index, const ThreadAttributes& attributes);
+                virtual ~Worker() override;
+            private:
+                WorkerPool&  _pool;
+                const size_t _index;
+                virtual void main() override;
+            };
+
+            std::mutex              _mutex {};          // Protect all fields below.
+            std::condition_variable _work_cond {};      // Signaled when a new job is available or on termination.
+            std::condition_variable _done_cond {};      // Signaled when all workers have completed the job.
+            JobInterface*           _job = nullptr;     // Current job.
+            uint64_t                _generation = 0;    // Incremented at each new job.
+            size_t                  _pending = 0;       // Number of workers which are still executing the current job.
+            bool                    _terminate = false; // Worker threads shall terminate.
+            std::vector<std::unique_ptr<Worker>> _workers {};
+        };
+    }
+}
@@ -43,20 +43,51 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
+        virtual ParallelMode getParallelMode() override;
+        virtual size_t analyzePacketWindow(TSPacketWindow&) override;
 
     private:
         using CipherPtr = std::shared_ptr<BlockCipher>;
 
+        // Cipher chaining modes.
+        enum class Chaining {ECB, CBC, CTS1, CTS2, CTS3, CTS4, DVS042};
+
+        // Context of the processing of a packet window. With --parallel, several packet
+        // windows are processed at the same time and each one needs its own cipher instance.
+        class WindowContext
+        {
+        public:
+            CipherPtr chain {};                          // Cipher instance with the same key and IV as _chain
+            std::vector<BlockCipher::InPlaceArea> areas {};  // Payloads to (de)scramble in a packet window
+            std::vector<TSPacket*> packets {};               // Corresponding packets
+        };
+
         // Command line options:
-        bool      _descramble = false; // Descramble instead of scramble
-        Service   _service_arg {};     // Service name & id
-        PIDSet    _scrambled {};       // List of PID's to (de)scramble
-        CipherPtr _chain {};           // Selected cipher chaining mode
+        bool      _descramble = false;           // Descramble instead of scramble
+        Service   _service_arg {};               // Service name & id
+        PIDSet    _scrambled {};                 // List of PID's to (de)scramble
+        Chaining  _chaining = Chaining::ECB;     // Selected cipher chaining mode
+        ByteBlock _key {};                       // AES key
+        ByteBlock _iv {};                        // Initialization vector
+        size_t    _packet_window = 0;            // Number of packets to process at once
 
         // Working data:
+        CipherPtr    _chain {};           // Cipher instance for packet processing
+        std::mutex   _mutex {};           // Protect working data when packet windows are processed in parallel
         bool         _abort = false;      // Error (service not found, etc)
         Service      _service {};         // Service name & id
         SectionDemux _demux {duck, this}; // Section demux
+        std::vector<std::unique_ptr<WindowContext>> _contexts {};  // Currently unused packet window contexts
+        bool         _analyzed = false;   // Packet windows are analyzed in analyzePacketWindow() before processing
+        std::vector<std::pair<const TSPacket*, size_t>> _payloads {};  // Sorted packets and payload sizes of analyzed window
+
+        // Allocate a new cipher instance in the selected chaining mode, without key.
+        CipherPtr newChain() const;
+
+        // Analyze a packet, return the size of the payload to (de)scramble, zero if none.
+        Status analyzePacket(TSPacket& pkt, size_t& pl_size);
 
         // Invoked by the demux when a complete table is available.
         virtual void handleTable(SectionDemux&, const BinaryTable&) override;
@@ -141,6 +172,10 @@ ts::AESPlugin::AESPlugin(TSP* tsp_) :
          u"must be a string of 32 or 64 hexadecimal digits. This is a mandatory "
          u"parameter.");
 
+    definePacketWindowOption(u"Number of packets to process at once. "
+                             u"All packets in a window are (de)scrambled together, which is faster with some chaining modes. "
+                             u"The value zero means that packets are processed one by one.");
+
     option(u"pid", 'p', PIDVAL, 0, UNLIMITED_COUNT);
     help(u"pid", u"pid1[-pid2]",
          u"Specifies a PID to scramble. Can be used instead of specifying a service. "
@@ -157,61 +192,92 @@ bool ts::AESPlugin::getOptions()
     duck.loadArgs(*this);
     _descramble = present(u"descramble");
     getIntValues(_scrambled, u"pid");
+    _packet_window = getPacketWindowOption();
     if (present(u"")) {
         _service_arg.set(value(u""));
     }
 
     // Get key and chaining mode.
-    const ByteBlock key(hexaValue(u"key"));
+    _key = hexaValue(u"key");
     if (present(u"ecb") + present(u"cbc") + present(u"cts1") + present(u"cts2") + present(u"cts3") + present(u"cts4") + present(u"dvs042") > 1) {
         error(u"options --cbc, --cts1, --cts2, --cts3, --cts4, --dvs042 and --ecb are mutually exclusive");
         return false;
     }
     if (present(u"cbc")) {
-        _chain = key.size() == AES128::KEY_SIZE ? CipherPtr(new CBC<AES128>) : CipherPtr(new CBC<AES256>);
+        _chaining = Chaining::CBC;
     }
     else if (present(u"cts1")) {
-        _chain = key.size() == AES128::KEY_SIZE ? CipherPtr(new CTS1<AES128>) : CipherPtr(new CTS1<AES256>);
+        _chaining = Chaining::CTS1;
     }
     else if (present(u"cts2")) {
-        _chain = key.size() == AES128::KEY_SIZE ? CipherPtr(new CTS2<AES128>) : CipherPtr(new CTS2<AES256>);
+        _chaining = Chaining::CTS2;
     }
     else if (present(u"cts3")) {
-        _chain = key.size() == AES128::KEY_SIZE ? CipherPtr(new CTS3<AES128>) : CipherPtr(new CTS3<AES256>);
+        _chaining = Chaining::CTS3;
     }
     else if (present(u"cts4")) {
-        _chain = key.size() == AES128::KEY_SIZE ? CipherPtr(new CTS4<AES128>) : CipherPtr(new CTS4<AES256>);
+        _chaining = Chaining::CTS4;
     }
     else if (present(u"dvs042")) {
-        _chain = key.size() == AES128::KEY_SIZE ? CipherPtr(new DVS042<AES128>) : CipherPtr(new DVS042<AES256>);
+        _chaining = Chaining::DVS042;
     }
     else {
-        _chain = key.size() == AES128::KEY_SIZE ? CipherPtr(new ECB<AES128>) : CipherPtr(new ECB<AES256>);
+        _chaining = Chaining::ECB;
     }
+    _chain = newChain();
 
     // Get AES key
-    if (!_chain->isValidKeySize(key.size())) {
-        error(u"%d bytes is an invalid AES key size", key.size());
+    if (!_chain->isValidKeySize(_key.size())) {
+        error(u"%d bytes is an invalid AES key size", _key.size());
         return false;
     }
-    if (!_chain->setKey(key.data(), key.size())) {
+    if (!_chain->setKey(_key.data(), _key.size())) {
         error(u"error in AES key schedule");
         return false;
     }
-    verbose(u"using %d bits key: %s", key.size() * 8, UString::Dump(key, UString::SINGLE_LINE));
+    verbose(u"using %d bits key: %s", _key.size() * 8, UString::Dump(_key, UString::SINGLE_LINE));
 
     // Get IV, default IV is all zeroes
-    const ByteBlock iv(hexaValue(u"iv", ByteBlock(_chain->minIVSize(), 0)));
-    if (!_chain->setIV(iv.data(), iv.size())) {
+    _iv = hexaValue(u"iv", ByteBlock(_chain->minIVSize(), 0));
+    if (!_chain->setIV(_iv.data(), _iv.size())) {
         error(u"incorrect initialization vector");
         return false;
     }
-    verbose(u"using %d bits IV: %s", iv.size() * 8, UString::Dump(iv, UString::SINGLE_LINE));
+    verbose(u"using %d bits IV: %s", _iv.size() * 8, UString::Dump(_iv, UString::SINGLE_LINE));
 
+    // Packet window contexts use the previous key and IV, if any.
+    _contexts.clear();
     return true;
 }
 
 
+//----------------------------------------------------------------------------
+// Allocate a new cipher instance in the selected chaining mode.
+//----------------------------------------------------------------------------
+
+ts::AESPlugin::CipherPtr ts::AESPlugin::newChain() const
+{
+    const bool aes128 = _key.size() == AES128::KEY_SIZE;
+    switch (_chaining) {
+        case Chaining::CBC:
+            return aes128 ? CipherPtr(new CBC<AES128>) : CipherPtr(new CBC<AES256>);
+        case Chaining::CTS1:
+            return aes128 ? CipherPtr(new CTS1<AES128>) : CipherPtr(new CTS1<AES256>);
+        case Chaining::CTS2:
+            return aes128 ? CipherPtr(new CTS2<AES128>) : CipherPtr(new CTS2<AES256>);
+        case Chaining::CTS3:
+            return aes128 ? CipherPtr(new CTS3<AES128>) : CipherPtr(new CTS3<AES256>);
+        case Chaining::CTS4:
+            return aes128 ? CipherPtr(new CTS4<AES128>) : CipherPtr(new CTS4<AES256>);
+        case Chaining::DVS042:
+            return aes128 ? CipherPtr(new DVS042<AES128>) : CipherPtr(new DVS042<AES256>);
+        case Chaining::ECB:
+        default:
+            return aes128 ? CipherPtr(new ECB<AES128>) : CipherPtr(new ECB<AES256>);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Start method
 //----------------------------------------------------------------------------
@@ -232,6 +298,8 @@ bool ts::AESPlugin::start()
     // Reset other states.
     _service = _service_arg;
     _abort = false;
+    _analyzed = false;
+    _payloads.clear();
 
     return true;
 }
@@ -355,8 +423,161 @@ void ts::AESPlugin::processPMT(PMT& pmt)
 //----------------------------------------------------------------------------
 
 ts::ProcessorPlugin::Status ts::AESPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    size_t pl_size = 0;
+    const Status status = analyzePacket(pkt, pl_size);
+    if (status != TSP_OK || pl_size == 0) {
+        return status;
+    }
+
+    // Now (de)scramble the packet
+    uint8_t* pl = pkt.getPayload();
+    uint8_t tmp[PKT_SIZE];
+    assert (pl_size < sizeof(tmp));
+    if (_descramble) {
+        if (!_chain->decrypt(pl, pl_size, tmp, pl_size)) {
+            error(u"AES decrypt error");
+            return TSP_END;
+        }
+    }
+    else {
+        if (!_chain->encrypt(pl, pl_size, tmp, pl_size)) {
+            error(u"AES encrypt error");
+            return TSP_END;
+        }
+    }
+    MemCopy(pl, tmp, pl_size);
+
+    // Mark "even key" (there is only one key but we must set something).
+    pkt.setScrambling(uint8_t(_descramble ? SC_CLEAR : SC_EVEN_KEY));
+
+    return TSP_OK;
+}
+
+
+//----------------------------------------------------------------------------
+// Packet window processing methods
+//----------------------------------------------------------------------------
+
+size_t ts::AESPlugin::getPacketWindowSize()
+{
+    return _packet_window;
+}
+
+ts::ProcessorPlugin::ParallelMode ts::AESPlugin::getParallelMode()
+{
+    // The packets of each PID are (de)scrambled independently.
+    // The PSI are analyzed in packet order in analyzePacketWindow().
+    return ParallelMode::PER_PID;
+}
+
+size_t ts::AESPlugin::analyzePacketWindow(TSPacketWindow& win)
+{
+    // With --parallel, all packets are analyzed here in their original order, before the slices
+    // of the window are processed. The service PSI are consequently demuxed in sequence and the
+    // PID's to (de)scramble are selected exactly as in a sequential processing.
+    _analyzed = true;
+    _payloads.clear();
+    size_t end = win.size();
+    for (size_t i = 0; i < win.size(); ++i) {
+        TSPacket* pkt = win.packet(i);
+        size_t pl_size = 0;
+        if (pkt == nullptr) {
+            // Previously dropped packet.
+            continue;
+        }
+        if (analyzePacket(*pkt, pl_size) != TSP_OK) {
+            end = i;
+            break;
+        }
+        if (pl_size > 0) {
+            _payloads.emplace_back(pkt, pl_size);
+        }
+    }
+    std::sort(_payloads.begin(), _payloads.end());
+    return end;
+}
+
+size_t ts::AESPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // With --parallel, this method is concurrently invoked from several threads.
+    // The packets were previously analyzed in analyzePacketWindow() and their payload sizes are read-only here.
+    // Otherwise, the analysis of the packets uses the shared working data and is serialized.
+    std::unique_ptr<WindowContext> ctx;
+    size_t end = win.size();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // Get a free packet window context or allocate a new one.
+        if (_contexts.empty()) {
+            ctx = std::make_unique<WindowContext>();
+            ctx->chain = newChain();
+            if (!ctx->chain->setKey(_key.data(), _key.size()) || !ctx->chain->setIV(_iv.data(), _iv.size())) {
+                error(u"error in AES key schedule");
+                return 0;
+            }
+        }
+        else {
+            ctx = std::move(_contexts.back());
+            _contexts.pop_back();
+        }
+
+        // Collect the payloads of all packets to (de)scramble in the window.
+        ctx->areas.clear();
+        ctx->packets.clear();
+        for (size_t i = 0; i < win.size(); ++i) {
+            TSPacket* pkt = win.packet(i);
+            size_t pl_size = 0;
+            if (pkt == nullptr) {
+                // Previously dropped packet.
+                continue;
+            }
+            if (_analyzed) {
+                const auto it = std::lower_bound(_payloads.begin(), _payloads.end(), std::pair<const TSPacket*, size_t>(pkt, 0));
+                pl_size = it != _payloads.end() && it->first == pkt ? it->second : 0;
+            }
+            else if (analyzePacket(*pkt, pl_size) != TSP_OK) {
+                end = i;
+                break;
+            }
+            if (pl_size > 0) {
+                ctx->areas.push_back({pkt->getPayload(), pl_size});
+                ctx->packets.push_back(pkt);
+            }
+        }
+    }
+
+    // (De)scramble all payloads at once, using the same key and IV.
+    bool ok = true;
+    if (!ctx->areas.empty()) {
+        ok = _descramble ?
+            ctx->chain->decryptInPlace(ctx->areas.data(), ctx->areas.size()) :
+            ctx->chain->encryptInPlace(ctx->areas.data(), ctx->areas.size());
+        if (!ok) {
+            error(u"AES %s error", _descramble ? u"decrypt" : u"encrypt");
+        }
+        else {
+            for (auto pkt : ctx->packets) {
+                pkt->setScrambling(uint8_t(_descramble ? SC_CLEAR : SC_EVEN_KEY));
+            }
+        }
+    }
+
+    // Release the packet window context for a subsequent window.
+    std::lock_guard<std::mutex> lock(_mutex);
+    _contexts.push_back(std::move(ctx));
+    return ok ? end : 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Analyze a packet, return the size of the payload to (de)scramble.
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::Status ts::AESPlugin::analyzePacket(TSPacket& pkt, size_t& pl_size)
 {
     const PID pid = pkt.getPID();
+    pl_size = 0;
 
     // Filter interesting sections
     _demux.feedPacket(pkt);
@@ -383,8 +604,7 @@ ts::ProcessorPlugin::Status ts::AESPlugin::processPacket(TSPacket& pkt, TSPacket
     }
 
     // Locate the packet payload
-    uint8_t* pl = pkt.getPayload();
-    size_t pl_size = pkt.getPayloadSize();
+    pl_size = pkt.getPayloadSize();
     if (!_chain->residueAllowed()) {
         // The chaining mode does not allow a residue.
         // Round the payload size down to a multiple of the block size.
@@ -393,28 +613,7 @@ ts::ProcessorPlugin::Status ts::AESPlugin::processPacket(TSPacket& pkt, TSPacket
     }
     if (pl_size < _chain->minMessageSize()) {
         // The payload is too short to be scrambled, leave the packet clear
-        return TSP_OK;
-    }
-
-    // Now (de)scramble the packet
-    uint8_t tmp[PKT_SIZE];
-    assert (pl_size < sizeof(tmp));
-    if (_descramble) {
-        if (!_chain->decrypt(pl, pl_size, tmp, pl_size)) {
-            error(u"AES decrypt error");
-            return TSP_END;
-        }
+        pl_size = 0;
     }
-    else {
-        if (!_chain->encrypt(pl, pl_size, tmp, pl_size)) {
-            error(u"AES encrypt error");
-            return TSP_END;
-        }
-    }
-    MemCopy(pl, tmp, pl_size);
-
-    // Mark "even key" (there is only one key but we must set something).
-    pkt.setScrambling(uint8_t(_descramble ? SC_CLEAR : SC_EVEN_KEY));
-
     return TSP_OK;
 }
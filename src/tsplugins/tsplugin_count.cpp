@@ -29,7 +29,9 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual bool stop() override;
+        virtual size_t getPacketWindowSize() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
         // This structure is used at each --interval.
@@ -53,11 +55,13 @@ namespace ts {
         bool           _report_total = false;    // Report total of all PIDs
         PacketCounter  _report_interval = 0;     // If non-zero, report time-stamp at this packet interval
         fs::path       _outfile_name {};         // Output file name.
+        size_t         _packet_window = 0;       // Number of packets to process at once
 
         // Working data:
         std::ofstream  _outfile {};              // User-specified output file
         IntervalReport _last_report {};          // Last report content
         PacketCounter  _counters[PID_MAX] {};    // Packet counter per PID
+        std::vector<PID> _window_pids {};        // PID's of packets in a packet window
 
         // Report a line
         template <class... Args>
@@ -106,6 +110,11 @@ ts::CountPlugin::CountPlugin(TSP* tsp_) :
          u"Specify the output file for reporting packet counters. By default, report "
          u"on standard error using the tsp logging mechanism.");
 
+    definePacketWindowOption(u"Number of packets to process at once. "
+                             u"The PID's of all packets in a window are extracted together, which is faster. "
+                             u"This option is ignored with --all or --interval, where packets are processed one by one. "
+                             u"The value zero means that packets are always processed one by one.");
+
     option(u"pid", 'p', PIDVAL, 0, UNLIMITED_COUNT);
     help(u"pid", u"pid1[-pid2]",
          u"PID filter: select packets with these PID values. Several -p or --pid "
@@ -143,6 +152,7 @@ bool ts::CountPlugin::getOptions()
     getIntValue(_report_interval, u"interval");
     getIntValues(_pids, u"pid");
     getPathValue(_outfile_name, u"output-file");
+    _packet_window = getPacketWindowOption();
     _tag = value(u"tag");
     if (!_tag.empty()) {
         _tag += u": ";
@@ -152,6 +162,11 @@ bool ts::CountPlugin::getOptions()
     if (!present(u"pid")) {
         _pids.set();
     }
+
+    // Per-packet reports need the packet index, packet windows are not used.
+    if (_report_all || _report_interval > 0) {
+        _packet_window = 0;
+    }
     return true;
 }
 
@@ -221,9 +236,26 @@ bool ts::CountPlugin::stop()
 
 
 //----------------------------------------------------------------------------
-// Packet processing method
+// Packet processing methods
 //----------------------------------------------------------------------------
 
+size_t ts::CountPlugin::getPacketWindowSize()
+{
+    return _packet_window;
+}
+
+size_t ts::CountPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // Only used without per-packet reports, just count packets per PID.
+    win.getPIDs(_window_pids);
+    for (PID pid : _window_pids) {
+        if (pid < PID_MAX && _pids[pid] != _negate) {
+            _counters[pid]++;
+        }
+    }
+    return win.size();
+}
+
 ts::ProcessorPlugin::Status ts::CountPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
 {
     // Check if the packet must be counted
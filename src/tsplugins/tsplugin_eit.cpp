@@ -183,6 +183,9 @@ bool ts::EITPlugin::start()
         }
     }
 
+    // The tables are analyzed in this thread only and few descriptors are used: build descriptors on demand.
+    duck.setLazyDescriptors(true);
+
     // Reset analysis state
     _last_utc = Time::Epoch;
     _eitpf_act_count = 0;
@@ -612,22 +615,22 @@ void ts::EITPlugin::handleSection(SectionDemux& demux, const Section& sect)
             ed.start_time = event.second.start_time;
             ed.duration = event.second.duration;
 
-            // Search name and description in the descriptor list.
+            // Search name and description in the descriptor list. Use searches by tag to
+            // avoid building the other descriptors, which are not used here.
             // The extended text is the concatenation of the texts in all extended_event_descriptor.
+            const DescriptorList& descs(event.second.descs);
             UString extended_text;
-            for (const auto& desc : event.second.descs) {
-                if (desc.tag() == DID_DVB_SHORT_EVENT) {
-                    ShortEventDescriptor sed(duck, desc);
-                    if (sed.isValid()) {
-                        ed.title = sed.event_name;
-                        ed.short_text = sed.text;
-                    }
+            for (size_t index = descs.search(DID_DVB_SHORT_EVENT); index < descs.count(); index = descs.search(DID_DVB_SHORT_EVENT, index + 1)) {
+                ShortEventDescriptor sed(duck, descs[index]);
+                if (sed.isValid()) {
+                    ed.title = sed.event_name;
+                    ed.short_text = sed.text;
                 }
-                else if (desc.tag() == DID_DVB_EXTENDED_EVENT) {
-                    ExtendedEventDescriptor eed(duck, desc);
-                    if (eed.isValid()) {
-                        extended_text.append(eed.text);
-                    }
+            }
+            for (size_t index = descs.search(DID_DVB_EXTENDED_EVENT); index < descs.count(); index = descs.search(DID_DVB_EXTENDED_EVENT, index + 1)) {
+                ExtendedEventDescriptor eed(duck, descs[index]);
+                if (eed.isValid()) {
+                    extended_text.append(eed.text);
                 }
             }
             if (!extended_text.empty()) {
@@ -31,7 +31,9 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual bool stop() override;
+        virtual size_t getPacketWindowSize() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
         // Packet intervals and list of them.
@@ -84,12 +86,14 @@ namespace ts {
         TSPacketLabelSet   _reset_labels {};            // Labels to reset on filtered packets
         TSPacketLabelSet   _set_perm_labels {};         // Labels to set on all packets after getting one packet
         TSPacketLabelSet   _reset_perm_labels {};       // Labels to reset on all packets after getting one packet
+        size_t             _packet_window = 0;          // Number of packets to process at once
 
         // Working data:
         PacketCounter      _filtered_packets = 0;       // Number of filtered packets
         PIDSet             _stream_id_pid {};           // PID values selected from stream ids
         std::set<uint16_t> _all_service_ids {};         // All service ids to filter, after service name resolution
         SignalizationDemux _demux {duck};               // Full signalization demux
+        std::vector<size_t> _indexes {};                // Indexes of selected packets in a packet window
 
         // Implementation of SignalizationHandlerInterface
         virtual void handleService(uint16_t ts_id, const Service& service, const PMT& pmt, bool removed) override;
@@ -220,6 +224,10 @@ ts::FilterPlugin::FilterPlugin(TSP* tsp_) :
          u"Select packets which were explicitly turned into null packets by some previous "
          u"plugin in the chain (typically using a --stuffing option).");
 
+    definePacketWindowOption(u"Number of packets to process at once when --pid is the only selection criterion. "
+                             u"The PID's of all packets in a window are checked together, which is faster. "
+                             u"The value zero means that packets are processed one by one.");
+
     option(u"pattern", 0, HEXADATA);
     help(u"pattern",
          u"Select packets containing the specified pattern bytes. "
@@ -369,6 +377,7 @@ bool ts::FilterPlugin::getOptions()
     _use_search_offset = present(u"search-offset");
     getIntValue(_search_offset, u"search-offset");
     getHexaValue(_pattern, u"pattern");
+    _packet_window = getPacketWindowOption();
 
     // Decode all index ranges.
     _ranges.clear();
@@ -435,6 +444,19 @@ bool ts::FilterPlugin::getOptions()
     // If we look for service names, we also need to be notified of changes in service list.
     _demux.setHandler(_service_names.empty() ? nullptr : this);
 
+    // Packet windows are used only when the PID is the only selection criterion.
+    const bool pid_only =
+        !_need_demux && !_with_payload && !_with_af && !_with_pes && !_with_pcr && !_with_splice &&
+        !_unit_start && !_nullified && !_input_stuffing && !_valid && _scrambling_ctrl < 0 &&
+        _min_payload < 0 && _max_payload < 0 && _min_af < 0 && _max_af < 0 &&
+        _splice < -128 && _min_splice < -128 && _max_splice < -128 &&
+        _after_packets == 0 && _every_packets == 0 && _pattern.empty() && _ranges.empty() &&
+        _stream_ids.empty() && _isdb_layers.empty() && _labels.none() &&
+        _set_perm_labels.none() && _reset_perm_labels.none();
+    if (!pid_only) {
+        _packet_window = 0;
+    }
+
     return true;
 }
 
@@ -464,6 +486,49 @@ bool ts::FilterPlugin::stop()
 }
 
 
+//----------------------------------------------------------------------------
+// Get requested window size, called between start() and first packet.
+//----------------------------------------------------------------------------
+
+size_t ts::FilterPlugin::getPacketWindowSize()
+{
+    return _packet_window;
+}
+
+
+//----------------------------------------------------------------------------
+// Packet window processing method, when --pid is the only criterion.
+//----------------------------------------------------------------------------
+
+size_t ts::FilterPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // Set/reset labels on filtered packets.
+    const size_t filtered = win.selectPIDs(_indexes, _explicit_pid, !_negate);
+    _filtered_packets += filtered;
+    if (_set_labels.any() || _reset_labels.any()) {
+        for (size_t i : _indexes) {
+            TSPacketMetadata* pkt_data = win.metadata(i);
+            pkt_data->setLabels(_set_labels);
+            pkt_data->clearLabels(_reset_labels);
+        }
+    }
+
+    // Drop or nullify unselected packets.
+    if (_drop_status != TSP_OK && filtered < win.size()) {
+        win.selectPIDs(_indexes, _explicit_pid, _negate);
+        for (size_t i : _indexes) {
+            if (_drop_status == TSP_NULL) {
+                win.nullify(i);
+            }
+            else {
+                win.drop(i);
+            }
+        }
+    }
+    return win.size();
+}
+
+
 //----------------------------------------------------------------------------
 // Packet processing method
 //----------------------------------------------------------------------------
@@ -94,12 +94,22 @@ namespace ts {
         // Process dump count. Return true when terminated. Also process error on output.
         bool lastDump(std::ostream&);
 
+        // Report the description and header of a valid PES packet. Return true when terminated.
+        bool tracePESHeader(const DemuxedData& data, const uint8_t* header, size_t header_size, size_t size, size_t raw_size);
+
+        // Report an invalid PES packet. The data can be truncated to data_size (header-only mode).
+        void traceInvalidPESPacket(const DemuxedData& data, size_t data_size);
+
+        // Report a video PES packet with an invalid start of payload.
+        void reportInvalidVideoStart(PID pid, const uint8_t* payload, size_t payload_size);
+
         // Save one file using --multiple-file. Set _abort on error.
         void saveOnePES(FileNameGenerator& namegen, const uint8_t* data, size_t size);
 
         // Implementation of PESHandlerInterface.
         virtual void handlePESPacket(PESDemux&, const PESPacket&) override;
         virtual void handleInvalidPESPacket(PESDemux&, const DemuxedData&) override;
+        virtual void handlePESHeader(PESDemux&, const DemuxedData&, size_t) override;
         virtual void handleIntraImage(PESDemux&, const PESPacket&, size_t) override;
         virtual void handleVideoStartCode(PESDemux&, const PESPacket&, uint8_t, size_t, size_t) override;
         virtual void handleNewMPEG2VideoAttributes(PESDemux&, const PESPacket&, const MPEG2VideoAttributes&) override;
@@ -356,6 +366,11 @@ bool ts::PESPlugin::start()
     _demux.setPIDFilter(_pids);
     _demux.setDefaultCodec(_default_h26x);
 
+    // When only the PES headers are used, don't let the demux accumulate the PES payloads.
+    _demux.setHeaderOnly(!_dump_pes_payload && !_dump_start_code && !_dump_nal_units && !_dump_avc_sei &&
+                         !_video_attributes && !_audio_attributes && !_intra_images &&
+                         _pes_filename.empty() && _es_filename.empty());
+
     // Create output files.
     bool ok = openOutput(_out_filename, &_out_file, &_out, false);
     if (_multiple_files) {
@@ -498,15 +513,20 @@ ts::UString ts::PESPlugin::prefix(const DemuxedData& pkt) const
 //----------------------------------------------------------------------------
 
 void ts::PESPlugin::handleInvalidPESPacket(PESDemux&, const DemuxedData& data)
+{
+    traceInvalidPESPacket(data, data.size());
+}
+
+void ts::PESPlugin::traceInvalidPESPacket(const DemuxedData& data, size_t data_size)
 {
     // Report invalid packets with --trace-packets
     if (_trace_packets) {
-        *_out << UString::Format(u"* %s, invalid PES packet, data size: %d bytes", prefix(data), data.size());
+        *_out << UString::Format(u"* %s, invalid PES packet, data size: %d bytes", prefix(data), data_size);
         const size_t hsize = PESPacket::HeaderSize(data.content(), data.size());
         if (hsize == 0) {
             *_out << ", no PES header found";
         }
-        else if (data.size() < hsize) {
+        else if (data_size < hsize) {
             *_out << UString::Format(u", expected header size: %d bytes", hsize);
         }
         else {
@@ -517,8 +537,8 @@ void ts::PESPlugin::handleInvalidPESPacket(PESDemux&, const DemuxedData& data)
                 if (psize < hsize) {
                     *_out << UString::Format(u", expected header size: %d bytes", hsize);
                 }
-                if (data.size() < psize) {
-                    *_out << UString::Format(u", truncated, missing %d bytes", psize - data.size());
+                if (data_size < psize) {
+                    *_out << UString::Format(u", truncated, missing %d bytes", psize - data_size);
                 }
             }
         }
@@ -527,6 +547,90 @@ void ts::PESPlugin::handleInvalidPESPacket(PESDemux&, const DemuxedData& data)
 }
 
 
+//----------------------------------------------------------------------------
+// Invoked by the demux in header-only mode when a PES packet is complete.
+//----------------------------------------------------------------------------
+
+void ts::PESPlugin::handlePESHeader(PESDemux& demux, const DemuxedData& data, size_t data_size)
+{
+    // Same validation as a complete PES packet, using the total data size.
+    const uint8_t* const header = data.content();
+    const size_t header_size = PESPacket::HeaderSize(header, data.size());
+    const size_t psize = header_size == 0 ? 0 : 6 + size_t(GetUInt16(header + 4));
+    if (header_size == 0 || (psize != 6 && (psize < header_size || psize > data_size))) {
+        traceInvalidPESPacket(data, data_size);
+        return;
+    }
+
+    // Skip PES packets without appropriate payload size
+    const size_t size = psize == 6 ? data_size : psize;
+    if (int(size - header_size) < _min_payload || (_max_payload >= 0 && int(size - header_size) > _max_payload)) {
+        return;
+    }
+
+    // Report packet description, only the beginning of the payload is available.
+    if (_trace_packets && !tracePESHeader(data, header, header_size, size, data_size)) {
+        const size_t avail = std::min(size, data.size());
+        const uint8_t stype = demux.getStreamType(data.sourcePID());
+        if (IsVideoSID(header[3]) &&
+            !PESPacket::IsMPEG2Video(header, avail, stype) &&
+            !PESPacket::IsAVC(header, avail, stype) &&
+            !PESPacket::IsHEVC(header, avail, stype) &&
+            !PESPacket::IsVVC(header, avail, stype) &&
+            !PESPacket::HasCommonVideoHeader(header + header_size, avail - header_size))
+        {
+            reportInvalidVideoStart(data.sourcePID(), header + header_size, avail - header_size);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Report the description and header of a valid PES packet.
+//----------------------------------------------------------------------------
+
+bool ts::PESPlugin::tracePESHeader(const DemuxedData& data, const uint8_t* header, size_t header_size, size_t size, size_t raw_size)
+{
+    *_out << "* " << prefix(data)
+          << ", stream_id " << NameFromSection(u"dtv", u"pes.stream_id", header[3], NamesFlags::VALUE_NAME)
+          << UString::Format(u", size: %d bytes (header: %d, payload: %d)", size, header_size, size - header_size);
+    if (raw_size > size) {
+        *_out << UString::Format(u", raw data: %d bytes, %d spurious trailing bytes", raw_size, raw_size - size);
+    }
+    *_out << std::endl;
+    if (lastDump(*_out)) {
+        return true;
+    }
+
+    // Report PES header
+    if (_dump_pes_header) {
+        size_t dsize = header_size;
+        *_out << "  PES header";
+        if (_max_dump_size > 0 && dsize > _max_dump_size) {
+            dsize = _max_dump_size;
+            *_out << " (truncated)";
+        }
+        *_out << ":" << std::endl << UString::Dump(header, dsize, _hexa_flags, 4, _hexa_bpl);
+        if (lastDump (*_out)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Report a video PES packet with an invalid start of payload.
+//----------------------------------------------------------------------------
+
+void ts::PESPlugin::reportInvalidVideoStart(PID pid, const uint8_t* payload, size_t payload_size)
+{
+    *_out << UString::Format(u"WARNING: PID 0x%X, invalid start of video PES payload: ", pid)
+          << UString::Dump(payload, std::min<size_t>(8, payload_size), UString::SINGLE_LINE)
+          << std::endl;
+}
+
+
 //----------------------------------------------------------------------------
 // Invoked by the demux when a complete PES packet is available.
 //----------------------------------------------------------------------------
@@ -538,34 +642,12 @@ void ts::PESPlugin::handlePESPacket(PESDemux&, const PESPacket& pkt)
         return;
     }
 
-    // Report packet description
+    // Report packet description and header
     if (_trace_packets) {
-        *_out << "* " << prefix(pkt)
-              << ", stream_id " << NameFromSection(u"dtv", u"pes.stream_id", pkt.getStreamId(), NamesFlags::VALUE_NAME)
-              << UString::Format(u", size: %d bytes (header: %d, payload: %d)", pkt.size(), pkt.headerSize(), pkt.payloadSize());
-        const size_t spurious = pkt.spuriousDataSize();
-        if (spurious > 0) {
-            *_out << UString::Format(u", raw data: %d bytes, %d spurious trailing bytes", pkt.rawDataSize(), spurious);
-        }
-        *_out << std::endl;
-        if (lastDump(*_out)) {
+        if (tracePESHeader(pkt, pkt.header(), pkt.headerSize(), pkt.size(), pkt.rawDataSize())) {
             return;
         }
 
-        // Report PES header
-        if (_dump_pes_header) {
-            size_t size = pkt.headerSize();
-            *_out << "  PES header";
-            if (_max_dump_size > 0 && size > _max_dump_size) {
-                size = _max_dump_size;
-                *_out << " (truncated)";
-            }
-            *_out << ":" << std::endl << UString::Dump(pkt.header(), size, _hexa_flags, 4, _hexa_bpl);
-            if (lastDump (*_out)) {
-                return;
-            }
-        }
-
         // Check that video packets start with either 00 00 01 (ISO 11172-2, MPEG-1, or ISO 13818-2, MPEG-2)
         // or 00 00 00 .. 01 (ISO 14496-10, MPEG-4 AVC). Don't know how ISO 14496-2 (MPEG-4 video) should start.
         if (IsVideoSID(pkt.getStreamId()) &&
@@ -575,9 +657,7 @@ void ts::PESPlugin::handlePESPacket(PESDemux&, const PESPacket& pkt)
             !pkt.isVVC() &&
             !PESPacket::HasCommonVideoHeader(pkt.payload(), pkt.payloadSize()))
         {
-            *_out << UString::Format(u"WARNING: PID 0x%X, invalid start of video PES payload: ", pkt.sourcePID())
-                  << UString::Dump(pkt.payload(), std::min<size_t>(8, pkt.payloadSize()), UString::SINGLE_LINE)
-                  << std::endl;
+            reportInvalidVideoStart(pkt.sourcePID(), pkt.payload(), pkt.payloadSize());
         }
 
         // Report PES payload
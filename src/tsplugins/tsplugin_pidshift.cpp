@@ -28,7 +28,9 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual bool stop() override;
+        virtual size_t getPacketWindowSize() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
         // Command line options:
@@ -37,11 +39,16 @@ namespace ts {
         cn::milliseconds _shift_ms {};            // Shift buffer size in milliseconds.
         cn::milliseconds _eval_ms {};             // Initial evaluation phase duration in milliseconds.
         PIDSet           _pids {};                // List of PID's to shift forward.
+        size_t           _packet_window = 0;      // Number of packets to process at once.
 
         // Working data:
         bool             _pass_all = false;       // Pass all packets after an error.
         PacketCounter    _init_packets = 0;       // Count packets in PID's to shift during initial evaluation phase.
         TimeShiftBuffer  _buffer {};              // The timeshift buffer logic.
+        std::vector<size_t> _indexes {};          // Indexes of packets to shift in a packet window.
+
+        // Process one packet, with its index in the plugin.
+        Status shiftPacket(TSPacket& pkt, TSPacketMetadata& pkt_data, PacketCounter pkt_index);
 
         static constexpr cn::milliseconds DEF_EVAL_MS = cn::milliseconds(1000);  // Default initial evaluation duration in milliseconds.
         static constexpr PacketCounter MAX_EVAL_PACKETS = 30000;                 // Max number of packets after which the bitrate must be known.
@@ -68,6 +75,11 @@ ts::PIDShiftPlugin::PIDShiftPlugin (TSP* tsp_) :
          u"Revert the list of PID's, meaning shift forward all PID's except those in -p or --pid options. "
          u"In practice, this can be seen as shifting backward the selected PID's from the rest of the transport stream.");
 
+    definePacketWindowOption(u"Number of packets to process at once. "
+                             u"The PID's of all packets in a window are checked together and only the packets "
+                             u"from the PID's to shift are individually processed, which is faster. "
+                             u"The value zero means that packets are processed one by one.");
+
     option(u"packets", 0, POSITIVE);
     help(u"packets", u"count",
          u"Specify the size of the shift buffer in packets. "
@@ -122,6 +134,7 @@ bool ts::PIDShiftPlugin::getOptions()
     getChronoValue(_shift_ms, u"time");
     getChronoValue(_eval_ms, u"initial-evaluation", DEF_EVAL_MS);
     getIntValues(_pids, u"pid");
+    _packet_window = getPacketWindowOption();
 
     _buffer.setBackupDirectory(value(u"directory"));
     _buffer.setMemoryPackets(intValue<size_t>(u"memory-packets", TimeShiftBuffer::DEFAULT_MEMORY_PACKETS));
@@ -171,10 +184,44 @@ bool ts::PIDShiftPlugin::stop()
 
 
 //----------------------------------------------------------------------------
-// Packet processing method
+// Packet processing methods
 //----------------------------------------------------------------------------
 
+size_t ts::PIDShiftPlugin::getPacketWindowSize()
+{
+    return _packet_window;
+}
+
 ts::ProcessorPlugin::Status ts::PIDShiftPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    return shiftPacket(pkt, pkt_data, tsp->pluginPackets());
+}
+
+size_t ts::PIDShiftPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // During the initial evaluation phase, all packets are processed one by one.
+    size_t index = 0;
+    for (; index < win.size() && !_pass_all && !_buffer.isOpen(); ++index) {
+        TSPacket* pkt = nullptr;
+        TSPacketMetadata* pkt_data = nullptr;
+        if (win.get(index, pkt, pkt_data) && shiftPacket(*pkt, *pkt_data, tsp->pluginPackets() + index) == TSP_END) {
+            return index;
+        }
+    }
+
+    // After that, only the packets from the PID's to shift are processed.
+    if (index < win.size() && !_pass_all) {
+        win.selectPIDs(_indexes, _pids);
+        for (size_t i : _indexes) {
+            if (i >= index && !_pass_all && shiftPacket(*win.packet(i), *win.metadata(i), tsp->pluginPackets() + i) == TSP_END) {
+                return i;
+            }
+        }
+    }
+    return win.size();
+}
+
+ts::ProcessorPlugin::Status ts::PIDShiftPlugin::shiftPacket(TSPacket& pkt, TSPacketMetadata& pkt_data, PacketCounter pkt_index)
 {
     const PID pid = pkt.getPID();
 
@@ -193,7 +240,7 @@ ts::ProcessorPlugin::Status ts::PIDShiftPlugin::processPacket(TSPacket& pkt, TSP
 
         // Evaluate the duration from the beginning of the TS (zero if bitrate is unknown).
         const BitRate ts_bitrate = tsp->bitrate();
-        const PacketCounter ts_packets = tsp->pluginPackets() + 1;
+        const PacketCounter ts_packets = pkt_index + 1;
         const cn::milliseconds ms = PacketInterval(ts_bitrate, ts_packets);
 
         if (ms >= _eval_ms) {
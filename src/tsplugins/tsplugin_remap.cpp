@@ -33,7 +33,9 @@ namespace ts {
         // Implementation of plugin API
         virtual bool getOptions() override;
         virtual bool start() override;
+        virtual size_t getPacketWindowSize() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
         using CyclingPacketizerPtr = std::shared_ptr<CyclingPacketizer>;
@@ -41,8 +43,11 @@ namespace ts {
 
         bool          _update_psi = false;  // Update all PSI
         bool          _pmt_ready = false;   // All PMT PID's are known
+        size_t        _packet_window = 0;   // Number of packets to process at once
         SectionDemux  _demux {duck, this};  // Section demux
         PacketizerMap _pzer {};             // Packetizer for sections
+        PIDSet        _active_pids {};      // PID's which need processing: remapped, checked, PSI
+        std::vector<PID> _window_pids {};   // PID's of all packets in a packet window
 
         // Invoked by the demux when a complete table is available.
         virtual void handleTable(SectionDemux&, const BinaryTable&) override;
@@ -73,6 +78,11 @@ ts::RemapPlugin::RemapPlugin(TSP* tsp_) :
          u"Do not modify the PSI. By default, the PAT, CAT and PMT's are "
          u"modified so that previous references to the remapped PID's will "
          u"point to the new PID values.");
+
+    definePacketWindowOption(u"Number of packets to process at once. "
+                             u"The PID's of all packets in a window are checked together and only the packets "
+                             u"which need to be modified are individually processed, which is faster. "
+                             u"The value zero means that packets are processed one by one.");
 }
 
 
@@ -84,6 +94,7 @@ bool ts::RemapPlugin::getOptions()
 {
     // Options from this class.
     _update_psi = !present(u"no-psi");
+    _packet_window = getPacketWindowOption();
 
     // Options from superclass.
     return AbstractDuplicateRemapPlugin::getOptions();
@@ -99,6 +110,15 @@ bool ts::RemapPlugin::start()
     // Clear the list of packetizers
     _pzer.clear();
 
+    // PID's which need processing in packet window mode. PSI PID's are added with their packetizer.
+    _active_pids.reset();
+    for (const auto& it : _pidMap) {
+        _active_pids.set(it.first);
+    }
+    if (!_unchecked) {
+        _active_pids |= _newPIDs;
+    }
+
     // Initialize the demux
     _demux.reset();
     if (_update_psi) {
@@ -140,6 +160,7 @@ ts::RemapPlugin::CyclingPacketizerPtr ts::RemapPlugin::getPacketizer(PID pid, bo
     else if (create) {
         const CyclingPacketizerPtr ptr(new CyclingPacketizer(duck, pid, CyclingPacketizer::StuffingPolicy::ALWAYS));
         _pzer.insert(std::make_pair(pid, ptr));
+        _active_pids.set(pid);
         return ptr;
     }
     else {
@@ -266,3 +287,44 @@ ts::ProcessorPlugin::Status ts::RemapPlugin::processPacket(TSPacket& pkt, TSPack
 
     return TSP_OK;
 }
+
+
+//----------------------------------------------------------------------------
+// Packet window processing method
+//----------------------------------------------------------------------------
+
+size_t ts::RemapPlugin::getPacketWindowSize()
+{
+    return _packet_window;
+}
+
+size_t ts::RemapPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    win.getPIDs(_window_pids);
+
+    for (size_t i = 0; i < _window_pids.size(); ++i) {
+        // Until all PMT's are known, all packets are processed (and possibly nullified).
+        // After that, packets which are neither remapped, nor checked, nor PSI are left unmodified.
+        // The set of active PID's is checked one packet at a time since new PMT PID's can be found in the window.
+        const PID pid = _window_pids[i];
+        if (pid < PID_MAX && (!_pmt_ready || _active_pids.test(pid))) {
+            TSPacket* pkt = nullptr;
+            TSPacketMetadata* pkt_data = nullptr;
+            win.get(i, pkt, pkt_data);
+            switch (processPacket(*pkt, *pkt_data)) {
+                case TSP_NULL:
+                    win.nullify(i);
+                    break;
+                case TSP_DROP:
+                    win.drop(i);
+                    break;
+                case TSP_END:
+                    return i;
+                case TSP_OK:
+                default:
+                    break;
+            }
+        }
+    }
+    return win.size();
+}
@@ -82,6 +82,8 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
         // Description of a crypto-period.
@@ -154,6 +156,7 @@ namespace ts {
         PID               _ecm_pid = PID_NULL;          // PID for ECM
         PacketCounter     _partial_scrambling = 0;      // Do not scramble all packets if > 1
         cn::seconds       _clear_period {0};            // Clear period before scrambling commences
+        size_t            _packet_window = 0;           // Number of packets to process at once
         ECMGClientArgs    _ecmg_args {};                // Parameters for ECMG client
         tlv::Logger       _logger {Severity::Debug, this}; // Message logger for ECMG <=> SCS protocol
         ecmgscs::Protocol      _ecmgscs {};                // ECMG <=> SCS protocol instance.
@@ -182,6 +185,13 @@ namespace ts {
         size_t            _current_ecm = 0;             // Index to current ECM (ECM being broadcast)
         TSScrambling      _scrambling {*this};          // Scrambler
         CyclingPacketizer _pzer_pmt {duck};             // Packetizer for modified PMT
+        std::vector<TSPacket*> _batch_packets {};       // Packets to scramble together with the current CW
+
+        // Analyze a packet, check if it must be scrambled (without scrambling it).
+        Status analyzePacket(TSPacket& pkt, bool& scramble);
+
+        // Scramble all packets in the current batch.
+        bool flushBatch();
 
         // Initialize ECM and CP scheduling.
         void initializeScheduling();
@@ -270,6 +280,10 @@ ts::ScramblerPlugin::ScramblerPlugin(TSP* tsp_) :
          u"Only scramble the component from the selected service which matches the given PID. "
          u"By default, all audio and video components of the service are scrambled.");
 
+    definePacketWindowOption(u"Number of packets to process at once. Packets which use the same control word "
+                             u"are scrambled together, which is faster with some algorithms such as DVB-CSA2 or AES. "
+                             u"The value zero means that packets are processed one by one.");
+
     option(u"partial-scrambling", 0, POSITIVE);
     help(u"partial-scrambling", u"count",
          u"Do not scramble all packets, only one packet every \"count\" packets. "
@@ -342,6 +356,7 @@ bool ts::ScramblerPlugin::getOptions()
     _pre_reduce_cw = present(u"pre-reduce-cw");
     getChronoValue(_clear_period, u"clear-period", cn::seconds(0));
     getIntValue(_partial_scrambling, u"partial-scrambling", 1);
+    _packet_window = getPacketWindowOption();
     getIntValue(_ecm_pid, u"pid-ecm", PID_NULL);
     getValue(_ecm_bitrate, u"bitrate-ecm", DEFAULT_ECM_BITRATE);
     getHexaValue(_ca_desc_private, u"private-data");
@@ -401,6 +416,7 @@ bool ts::ScramblerPlugin::start()
     _delay_start = cn::milliseconds(0);
     _current_cw = 0;
     _current_ecm = 0;
+    _batch_packets.clear();
 
     // As long as the bitrate is unknown, delay changes to infinite.
     _pkt_insert_ecm = _pkt_change_cw = _pkt_change_ecm = std::numeric_limits<PacketCounter>::max();
@@ -680,6 +696,11 @@ bool ts::ScramblerPlugin::tryExitDegradedMode()
 
 bool ts::ScramblerPlugin::changeCW()
 {
+    // Previously collected packets must be scrambled with the previous CW.
+    if (!flushBatch()) {
+        return false;
+    }
+
     if (_scrambling.hasFixedCW()) {
         // A list of fixed CW was loaded from a file.
 
@@ -744,6 +765,83 @@ void ts::ScramblerPlugin::changeECM()
 
 ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
 {
+    bool scramble = false;
+    const Status status = analyzePacket(pkt, scramble);
+    if (status == TSP_OK && scramble) {
+        if (!_scrambling.encrypt(pkt)) {
+            return TSP_END;
+        }
+        _scrambled_count++;
+    }
+    return status;
+}
+
+
+//----------------------------------------------------------------------------
+// Packet window processing methods
+//----------------------------------------------------------------------------
+
+size_t ts::ScramblerPlugin::getPacketWindowSize()
+{
+    return _packet_window;
+}
+
+size_t ts::ScramblerPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // Packets to scramble are collected in a batch, until the end of the window or a CW change.
+    size_t first = 0;  // Index in window of first packet in current batch.
+    for (size_t i = 0; i < win.size(); ++i) {
+        TSPacket* pkt = win.packet(i);
+        bool scramble = false;
+        if (pkt == nullptr) {
+            // Previously dropped packet.
+            continue;
+        }
+        switch (analyzePacket(*pkt, scramble)) {
+            case TSP_OK:
+                break;
+            case TSP_NULL:
+                win.nullify(i);
+                break;
+            case TSP_DROP:
+                win.drop(i);
+                break;
+            case TSP_END:
+            default:
+                return flushBatch() ? i : first;
+        }
+        if (scramble) {
+            if (_batch_packets.empty()) {
+                first = i;
+            }
+            _batch_packets.push_back(pkt);
+        }
+    }
+    return flushBatch() ? win.size() : first;
+}
+
+
+//----------------------------------------------------------------------------
+// Scramble all packets in the current batch.
+//----------------------------------------------------------------------------
+
+bool ts::ScramblerPlugin::flushBatch()
+{
+    const bool ok = _batch_packets.empty() || _scrambling.encrypt(_batch_packets.data(), _batch_packets.size());
+    _scrambled_count += _batch_packets.size();
+    _batch_packets.clear();
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Analyze a packet, check if it must be scrambled.
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::Status ts::ScramblerPlugin::analyzePacket(TSPacket& pkt, bool& scramble)
+{
+    scramble = false;
+
     // Count packets
     _packet_count++;
 
@@ -848,12 +946,8 @@ ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TS
         _partial_clear = _partial_scrambling - 1;
     }
 
-    // Scramble the packet payload.
-    if (!_scrambling.encrypt(pkt)) {
-        return TSP_END;
-    }
-    _scrambled_count++;
-
+    // The packet payload shall be scrambled.
+    scramble = true;
     return TSP_OK;
 }
 
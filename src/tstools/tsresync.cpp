@@ -15,6 +15,7 @@
 #include "tsOutputRedirector.h"
 #include "tsByteBlock.h"
 #include "tsTS.h"
+#include "tsTSPacket.h"
 TS_MAIN(MainCode);
 
 #define MIN_SYNC_SIZE       (1024)              // 1 kB
@@ -129,11 +130,12 @@ public:
     }
 
     // Look for MPEG packets in a buffer, according to an assumed packet size.
-    // If the complete buffer matches the packet size, set input and output packet
-    // sizes and return true. Return false otherwise.
-    bool checkSync(const uint8_t* buf, size_t buf_size, size_t pkt_size, size_t header_size);
+    // Find the first index in the buffer where a range of search_size bytes contains
+    // only valid packets. If this index is lower than start_index, update start_index,
+    // set input and output packet sizes and return true. Return false otherwise.
+    bool findSync(size_t& start_index, const uint8_t* buf, size_t buf_size, size_t search_size, size_t pkt_size, size_t header_size);
 
-    // Get packet sizes, as determined by checkSync(). Size is zero if no valid packet size found.
+    // Get packet sizes, as determined by findSync(). Size is zero if no valid packet size found.
     size_t inputPacketSize() const {return _in_pkt_size;}
     size_t inputHeaderSize() const {return _in_header_size;}
     size_t outputPacketSize() const {return _out_pkt_size;}
@@ -224,20 +226,27 @@ bool Resynchronizer::writePacket(const uint8_t* input_packet)
 //  Look for MPEG packets in a buffer, according to an assumed packet size.
 //----------------------------------------------------------------------------
 
-bool Resynchronizer::checkSync(const uint8_t* buf, size_t buf_size, size_t pkt_size, size_t header_size)
+bool Resynchronizer::findSync(size_t& start_index, const uint8_t* buf, size_t buf_size, size_t search_size, size_t pkt_size, size_t header_size)
 {
     assert(pkt_size >= header_size + ts::PKT_SIZE);
-    const uint8_t* end = buf + buf_size - pkt_size + 1;
+    assert(search_size <= buf_size);
 
-    // Check if the buffer contains packets with the appropriate size
-    while (buf < end) {
-        if (buf[header_size] != ts::SYNC_BYTE) {
-            return false; // not found
-        }
-        buf += pkt_size;
+    // All packets in a range of search_size bytes must be valid. The range may start
+    // anywhere in the buffer, as long as it does not go beyond the end of the buffer.
+    // Don't search after a range which was already found with another packet size.
+    // A range which is smaller than one packet is always valid (end of input file).
+    if (start_index == 0) {
+        return false;
+    }
+    const size_t min_packets = search_size / pkt_size;
+    const size_t last_index = std::min(buf_size - search_size, start_index - 1);
+    const size_t index = min_packets == 0 ? 0 : ts::TSPacket::FindSync(buf, last_index + min_packets * pkt_size, pkt_size, header_size, min_packets);
+    if (index == ts::NPOS) {
+        return false;
     }
 
-    // Packets found all along the buffer
+    // Packets found all along the range
+    start_index = index;
     _in_pkt_size = pkt_size;
     _in_header_size = header_size;
     _out_pkt_size = _keep_packet_size ? pkt_size : ts::PKT_SIZE;
@@ -283,31 +292,21 @@ int MainCode(int argc, char *argv[])
 
         // Look for a range of packets for at least --min-contiguous bytes
         size_t const search_size = std::min(opt.contig_size, sync_size);
-        uint8_t* const end_search = sync_end - search_size + 1;
-
-        // Search a range of valid packets. Try all expected packet sizes.
-        const uint8_t* start;
-        for (start = sync_buf; start < end_search; start++) {
-            if (opt.packet_size > 0) {
-                if (resync.checkSync(start, search_size, opt.packet_size, opt.header_size)) {
-                    // Found user-specified encapsulation of TS packets
-                    break;
-                }
-            }
-            else {
-                if (resync.checkSync(start, search_size, ts::PKT_SIZE, 0)) {
-                    // Found standard TS packets
-                    break;
-                }
-                if (resync.checkSync(start, search_size, ts::PKT_RS_SIZE, 0)) {
-                    // Found TS packets with trailing Reed-Solomon outer FEC
-                    break;
-                }
-                if (resync.checkSync(start, search_size, ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE)) {
-                    // Found TS packets with leading 4-byte timestamp (M2TS format, blu-ray discs)
-                    break;
-                }
-            }
+
+        // Search a range of valid packets. Try all expected packet sizes and keep the first
+        // range in the buffer. At the same position, the first packet size in this list wins.
+        size_t start_index = ts::NPOS;
+        if (opt.packet_size > 0) {
+            // User-specified encapsulation of TS packets
+            resync.findSync(start_index, sync_buf, sync_size, search_size, opt.packet_size, opt.header_size);
+        }
+        else {
+            // Standard TS packets
+            resync.findSync(start_index, sync_buf, sync_size, search_size, ts::PKT_SIZE, 0);
+            // TS packets with trailing Reed-Solomon outer FEC
+            resync.findSync(start_index, sync_buf, sync_size, search_size, ts::PKT_RS_SIZE, 0);
+            // TS packets with leading 4-byte timestamp (M2TS format, blu-ray discs)
+            resync.findSync(start_index, sync_buf, sync_size, search_size, ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE);
         }
         if (resync.inputPacketSize() == 0) {
             std::cerr << "* Cannot find MPEG TS packets after " << ts::UString::Decimal(search_size) << " bytes" << std::endl;
@@ -315,7 +314,7 @@ int MainCode(int argc, char *argv[])
             break;
         }
         if (opt.verbose()) {
-            std::cerr << "* Found synchronization after " << ts::UString::Decimal(start - sync_buf) << " bytes" << std::endl
+            std::cerr << "* Found synchronization after " << ts::UString::Decimal(start_index) << " bytes" << std::endl
                       << "* Packet size is " << resync.inputPacketSize() << " bytes";
             if (resync.inputHeaderSize() > 0) {
                 std::cerr << " (" << resync.inputHeaderSize() << "-byte header)";
@@ -324,6 +323,7 @@ int MainCode(int argc, char *argv[])
         }
 
         // Output initial sync buffer, starting at first valid packet, writing all valid packets
+        const uint8_t* start = sync_buf + start_index;
         while (start <= sync_end - resync.inputPacketSize() && start[resync.inputHeaderSize()] == ts::SYNC_BYTE) {
             if (!resync.writePacket(start)) {
                 break;
@@ -20,9 +20,26 @@
 //----------------------------------------------------------------------------
 
 #include "tsunit.h"
+#include "tsFileUtils.h"
+#include "tsEnvironment.h"
+#include "tsErrCodeReport.h"
 
 int main(int argc, char* argv[])
 {
+    // The caches of names files and the plugin index are created in the user's home directory.
+    // Use a temporary one during the tests, the test suite shall not modify the user's environment.
+#if defined(TS_WINDOWS)
+    const ts::UString home_var(u"APPDATA");
+#else
+    const ts::UString home_var(u"HOME");
+#endif
+    const fs::path home(ts::TempFile(u""));
+    fs::create_directories(home, &ts::ErrCodeReport());
+    ts::SetEnvironment(home_var, home);
+
     tsunit::Main test(argc, argv);
-    return test.run();
+    const int status = test.run();
+
+    fs::remove_all(home, &ts::ErrCodeReport());
+    return status;
 }
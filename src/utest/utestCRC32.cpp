@@ -11,6 +11,8 @@
 //----------------------------------------------------------------------------
 
 #include "tsCRC32.h"
+#include "tsByteBlock.h"
+#include "tsSysInfo.h"
 #include "tsunit.h"
 #include "utestTSUnitBenchmark.h"
 
@@ -22,6 +24,12 @@
 class CRC32Test: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(CRC);
+    TSUNIT_DECLARE_TEST(Sizes);
+    TSUNIT_DECLARE_TEST(Benchmark);
+
+private:
+    // Reference bit-by-bit implementation of the MPEG CRC32.
+    static uint32_t ReferenceCRC(const uint8_t* data, size_t size);
 };
 
 TSUNIT_REGISTER(CRC32Test);
@@ -160,3 +168,62 @@ TSUNIT_DEFINE_TEST(CRC)
 
     bench.report(u"CRC32Test::testCRC");
 }
+
+// Reference bit-by-bit implementation of the MPEG CRC32.
+uint32_t CRC32Test::ReferenceCRC(const uint8_t* data, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    while (size-- > 0) {
+        crc ^= uint32_t(*data++) << 24;
+        for (int i = 0; i < 8; ++i) {
+            crc = (crc & 0x80000000) != 0 ? (crc << 1) ^ 0x04C11DB7 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+// Check all sizes and alignments against the reference implementation.
+// This exercises the boundaries of the slice-by-N and folding methods.
+TSUNIT_DEFINE_TEST(Sizes)
+{
+    ts::ByteBlock data(1100);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = uint8_t(i * 7 + (i >> 3));
+    }
+
+    for (size_t offset = 0; offset < 4; ++offset) {
+        for (size_t size = 0; size + offset <= data.size(); size += size < 300 ? 1 : 37) {
+            const uint32_t crc = ReferenceCRC(data.data() + offset, size);
+            TSUNIT_EQUAL(crc, ts::CRC32(data.data() + offset, size).value());
+
+            // Same in two chunks.
+            ts::CRC32 c;
+            c.add(data.data() + offset, size / 3);
+            c.add(data.data() + offset + size / 3, size - size / 3);
+            TSUNIT_EQUAL(crc, c.value());
+        }
+    }
+}
+
+// Benchmark on typical section sizes and on large data areas.
+TSUNIT_DEFINE_TEST(Benchmark)
+{
+    ts::ByteBlock data(65536);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = uint8_t(i ^ (i >> 8));
+    }
+
+    debug() << "CRC32Test::testBenchmark: accelerated: " << ts::UString::YesNo(ts::SysInfo::Instance().crcInstructions()) << std::endl;
+    for (size_t size : {184, 1024, 4096, 65536}) {
+        utest::TSUnitBenchmark bench(u"TSUNIT_CRC32_ITERATIONS");
+        ts::CRC32 c;
+        bench.start();
+        for (size_t iter = 0; iter < bench.iterations; ++iter) {
+            c.reset();
+            c.add(data.data(), size);
+        }
+        bench.stop();
+        TSUNIT_EQUAL(ReferenceCRC(data.data(), size), c.value());
+        bench.report(ts::UString::Format(u"CRC32Test::testBenchmark, %d bytes", size));
+    }
+}
@@ -24,6 +24,7 @@
 #include "tsCTS2.h"
 #include "tsCTS3.h"
 #include "tsCTS4.h"
+#include "tsDVS042.h"
 #include "tsSCTE52.h"
 #include "tsDVBCSA2.h"
 #include "tsDVBCISSA.h"
@@ -62,10 +63,12 @@ class CryptoTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(AES_CTS3);
     TSUNIT_DECLARE_TEST(AES_CTS4);
     TSUNIT_DECLARE_TEST(AES_DVS042);
+    TSUNIT_DECLARE_TEST(AES_Multiple);
     TSUNIT_DECLARE_TEST(DES);
     TSUNIT_DECLARE_TEST(TDES);
     TSUNIT_DECLARE_TEST(TDES_CBC);
     TSUNIT_DECLARE_TEST(DVBCSA2);
+    TSUNIT_DECLARE_TEST(DVBCSA2_Multiple);
     TSUNIT_DECLARE_TEST(DVBCISSA);
     TSUNIT_DECLARE_TEST(IDSA);
     TSUNIT_DECLARE_TEST(SCTE52_2003);
@@ -101,6 +104,8 @@ private:
 
     void testChainingSizes(ts::BlockCipher& algo, int sizes, ...);
 
+    void testMultiple(ts::BlockCipher& algo1, ts::BlockCipher& algo2, bool set_iv, bool full_blocks);
+
     void testHash(utest::TSUnitBenchmark& bench,
                   ts::Hash& algo,
                   size_t tv_index,
@@ -571,6 +576,118 @@ TSUNIT_DEFINE_TEST(DVBCSA2)
     bench.report(u"CryptoTest::testDVBCSA2");
 }
 
+TSUNIT_DEFINE_TEST(AES_Multiple)
+{
+    ts::ECB<ts::AES128> ecb1, ecb2;
+    ts::ECB<ts::AES256> ecb3, ecb4;
+    ts::CBC<ts::AES128> cbc1, cbc2;
+    ts::CBC<ts::AES256> cbc3, cbc4;
+    ts::CTR<ts::AES128> ctr1, ctr2;
+    ts::CTR<ts::AES256> ctr3, ctr4;
+    ts::DVS042<ts::AES128> dvs1, dvs2;
+    ts::DVBCISSA cissa1, cissa2;
+    ts::IDSA idsa1, idsa2;
+
+    testMultiple(ecb1, ecb2, false, true);
+    testMultiple(ecb3, ecb4, false, true);
+    testMultiple(cbc1, cbc2, true, true);
+    testMultiple(cbc3, cbc4, true, true);
+    testMultiple(ctr1, ctr2, true, false);
+    testMultiple(ctr3, ctr4, true, false);
+    testMultiple(dvs1, dvs2, true, false);
+    testMultiple(cissa1, cissa2, false, true);
+    testMultiple(idsa1, idsa2, false, false);
+}
+
+// Multiple in-place encryption/decryption must be identical to individual ones.
+void CryptoTest::testMultiple(ts::BlockCipher& algo1, ts::BlockCipher& algo2, bool set_iv, bool full_blocks)
+{
+    ts::SystemRandomGenerator prng;
+    ts::ByteBlock key(algo1.minKeySize());
+    ts::ByteBlock iv(algo1.minIVSize());
+    TSUNIT_ASSERT(prng.read(key.data(), key.size()));
+    TSUNIT_ASSERT(prng.read(iv.data(), iv.size()));
+    TSUNIT_ASSERT(algo1.setKey(key.data(), key.size()));
+    TSUNIT_ASSERT(algo2.setKey(key.data(), key.size()));
+    if (set_iv) {
+        TSUNIT_ASSERT(algo1.setIV(iv.data(), iv.size()));
+        TSUNIT_ASSERT(algo2.setIV(iv.data(), iv.size()));
+    }
+
+    const size_t bsize = algo1.blockSize();
+    for (size_t count : {1, 2, 7, 100, 600}) {
+        ts::ByteBlockVector plain(count);
+        ts::ByteBlockVector cipher(count);
+        ts::ByteBlockVector data(count);
+        std::vector<ts::BlockCipher::InPlaceArea> areas(count);
+        for (size_t i = 0; i < count; ++i) {
+            uint8_t size = 0;
+            TSUNIT_ASSERT(prng.read(&size, 1));
+            size_t psize = i % 3 == 0 ? 184 : 1 + size % 184;
+            if (full_blocks) {
+                psize = std::max(bsize, psize - psize % bsize);
+            }
+            plain[i].resize(psize);
+            TSUNIT_ASSERT(prng.read(plain[i].data(), plain[i].size()));
+            cipher[i].resize(plain[i].size());
+            TSUNIT_ASSERT(algo1.encrypt(plain[i].data(), plain[i].size(), cipher[i].data(), cipher[i].size()));
+            data[i] = plain[i];
+            areas[i].data = data[i].data();
+            areas[i].size = data[i].size();
+        }
+        debug() << "CryptoTest::testMultiple: " << algo2.name() << ", " << count << " areas" << std::endl;
+        TSUNIT_ASSERT(algo2.encryptInPlace(areas.data(), areas.size()));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_ASSERT(cipher[i] == data[i]);
+        }
+        TSUNIT_ASSERT(algo2.decryptInPlace(areas.data(), areas.size()));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_ASSERT(plain[i] == data[i]);
+        }
+    }
+}
+
+TSUNIT_DEFINE_TEST(DVBCSA2_Multiple)
+{
+    // Multiple in-place encryption/decryption must be identical to individual ones.
+    ts::SystemRandomGenerator prng;
+    ts::DVBCSA2 csa1;
+    ts::DVBCSA2 csa2;
+    uint8_t key[ts::DVBCSA2::KEY_SIZE];
+    TSUNIT_ASSERT(prng.read(key, sizeof(key)));
+    TSUNIT_ASSERT(csa1.setKey(key, sizeof(key)));
+    TSUNIT_ASSERT(csa2.setKey(key, sizeof(key)));
+
+    // Test batches below and above all bitsliced widths. Include small areas and residues,
+    // up to the largest accepted size (23 blocks and a residue of 7 bytes), including in the last area of a batch.
+    for (size_t count : {1, 3, 4, 63, 64, 65, 128, 129, 200, 256, 257, 600}) {
+        ts::ByteBlockVector plain(count);
+        ts::ByteBlockVector cipher(count);
+        ts::ByteBlockVector data(count);
+        std::vector<ts::BlockCipher::InPlaceArea> areas(count);
+        for (size_t i = 0; i < count; ++i) {
+            uint8_t size = 0;
+            TSUNIT_ASSERT(prng.read(&size, 1));
+            plain[i].resize(i % 3 == 0 ? 184 + i % 8 : 1 + size % 191);
+            TSUNIT_ASSERT(prng.read(plain[i].data(), plain[i].size()));
+            cipher[i].resize(plain[i].size());
+            TSUNIT_ASSERT(csa1.encrypt(plain[i].data(), plain[i].size(), cipher[i].data(), cipher[i].size()));
+            data[i] = plain[i];
+            areas[i].data = data[i].data();
+            areas[i].size = data[i].size();
+        }
+        debug() << "CryptoTest::testDVBCSA2_Multiple: " << count << " areas" << std::endl;
+        TSUNIT_ASSERT(csa2.encryptInPlace(areas.data(), areas.size()));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_ASSERT(cipher[i] == data[i]);
+        }
+        TSUNIT_ASSERT(csa2.decryptInPlace(areas.data(), areas.size()));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_ASSERT(plain[i] == data[i]);
+        }
+    }
+}
+
 TSUNIT_DEFINE_TEST(DVBCISSA)
 {
     utest::TSUnitBenchmark bench(u"TSUNIT_DVBCISSA_ITERATIONS");
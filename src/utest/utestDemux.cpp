@@ -66,6 +66,7 @@ class DemuxTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(TDT);
     TSUNIT_DECLARE_TEST(TOT);
     TSUNIT_DECLARE_TEST(HEVC);
+    TSUNIT_DECLARE_TEST(RecycledSections);
 
 private:
     // Compare a table with the list of reference sections
@@ -434,3 +435,75 @@ TSUNIT_DEFINE_TEST(HEVC)
 {
     TEST_TABLE("PMT with HEVC descriptor", pmt_hevc);
 }
+
+
+//----------------------------------------------------------------------------
+// Sections are recycled by the demux, unless they are kept by the handlers.
+//----------------------------------------------------------------------------
+
+namespace {
+    class RecycleHandler : public ts::SectionHandlerInterface, public ts::TableHandlerInterface
+    {
+    public:
+        std::vector<ts::ByteBlock> contents {};    // Contents of all sections, as notified
+        std::vector<ts::SectionPtr> kept {};       // Shared copies of one section every two
+        std::vector<ts::BinaryTable> tables {};    // Shared copies of all tables
+
+        virtual void handleSection(ts::SectionDemux&, const ts::Section& sect) override
+        {
+            contents.push_back(ts::ByteBlock(sect.content(), sect.size()));
+            if (contents.size() % 2 == 0) {
+                kept.push_back(std::make_shared<ts::Section>(sect, ts::ShareMode::SHARE));
+            }
+        }
+
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable& table) override
+        {
+            tables.emplace_back(table, ts::ShareMode::SHARE);
+        }
+    };
+}
+
+TSUNIT_DEFINE_TEST(RecycledSections)
+{
+    ts::DuckContext duck;
+    ts::OneShotPacketizer pzer(duck, 100, true);
+    ts::SectionPtrVector sections;
+
+    // Alternate short sections and long sections with a new version each time.
+    for (uint8_t i = 0; i < 20; ++i) {
+        const uint8_t payload[] {i, uint8_t(i + 1), uint8_t(i + 2), uint8_t(i * 3)};
+        if (i % 2 == 0) {
+            sections.push_back(std::make_shared<ts::Section>(0x70, true, payload, sizeof(payload)));
+        }
+        else {
+            sections.push_back(std::make_shared<ts::Section>(0x80, true, 0x1234, uint8_t(i % 32), true, 0, 0, payload, sizeof(payload)));
+        }
+        pzer.addSection(sections.back());
+    }
+    ts::TSPacketVector packets;
+    pzer.getPackets(packets);
+
+    RecycleHandler handler;
+    ts::SectionDemux demux(duck, &handler, &handler, ts::AllPIDs());
+    for (const auto& pkt : packets) {
+        demux.feedPacket(pkt);
+    }
+
+    // All sections are notified with their original content.
+    TSUNIT_EQUAL(sections.size(), handler.contents.size());
+    for (size_t i = 0; i < sections.size(); ++i) {
+        TSUNIT_ASSERT(handler.contents[i] == ts::ByteBlock(sections[i]->content(), sections[i]->size()));
+    }
+
+    // Sections and tables which were kept by the handler were not overwritten by recycled sections.
+    TSUNIT_EQUAL(sections.size() / 2, handler.kept.size());
+    for (size_t i = 0; i < handler.kept.size(); ++i) {
+        TSUNIT_ASSERT(*handler.kept[i] == *sections[2 * i + 1]);
+    }
+    TSUNIT_EQUAL(sections.size(), handler.tables.size());
+    for (size_t i = 0; i < handler.tables.size(); ++i) {
+        TSUNIT_EQUAL(1, handler.tables[i].sectionCount());
+        TSUNIT_ASSERT(*handler.tables[i].sectionAt(0) == *sections[i]);
+    }
+}
@@ -28,6 +28,7 @@
 #include "tsAudioComponentDescriptor.h"
 #include "tsDataContentDescriptor.h"
 #include "tsDuckContext.h"
+#include "tsPSIBuffer.h"
 #include "tsunit.h"
 
 
@@ -39,6 +40,7 @@ class DescriptorTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(Iterator);
     TSUNIT_DECLARE_TEST(Language);
+    TSUNIT_DECLARE_TEST(Lazy);
 };
 
 TSUNIT_REGISTER(DescriptorTest);
@@ -265,3 +267,80 @@ TSUNIT_DEFINE_TEST(Language)
     TSUNIT_EQUAL(13, dlist.searchLanguage(duck, u"l42"));
     TSUNIT_EQUAL(14, dlist.searchLanguage(duck, u"l51"));
 }
+
+TSUNIT_DEFINE_TEST(Lazy)
+{
+    ts::DuckContext duck;
+    ts::DescriptorList eager(nullptr);
+    ts::DescriptorList lazy(nullptr);
+
+    static const uint8_t data[] {
+        0x52, 0x01, 0x07,                          // stream_identifier_descriptor
+        0x5F, 0x04, 0x00, 0x00, 0x00, 0x28,        // private_data_specifier_descriptor
+        0x83, 0x02, 0xAB, 0xCD,                    // private descriptor
+        0x0A, 0x04, 'f', 'r', 'a', 0x00,           // ISO_639_language_descriptor
+        0x52, 0x01, 0x0C,                          // stream_identifier_descriptor
+    };
+
+    TSUNIT_ASSERT(eager.add(data, sizeof(data)));
+    TSUNIT_ASSERT(lazy.addLazy(data, sizeof(data)));
+    TSUNIT_EQUAL(5, lazy.count());
+    TSUNIT_ASSERT(lazy == eager);
+    TSUNIT_EQUAL(sizeof(data), lazy.binarySize());
+
+    // Search and inspect without building descriptors.
+    TSUNIT_EQUAL(0, lazy.search(ts::DID_DVB_STREAM_ID));
+    TSUNIT_EQUAL(4, lazy.search(ts::DID_DVB_STREAM_ID, 1));
+    TSUNIT_EQUAL(2, lazy.search(0x83, 0, 0x28));
+    TSUNIT_EQUAL(5, lazy.search(0x83, 0, 0x29));
+    TSUNIT_EQUAL(0x28, lazy.privateDataSpecifier(2));
+    TSUNIT_EQUAL(3, lazy.searchLanguage(duck, u"FRA"));
+
+    // Typed access.
+    ts::StreamIdentifierDescriptor sid;
+    TSUNIT_EQUAL(4, lazy.search(duck, ts::DID_DVB_STREAM_ID, sid, 1));
+    TSUNIT_EQUAL(12, sid.component_tag);
+
+    // Serialization of partially built list.
+    ts::ByteBlock bb;
+    TSUNIT_EQUAL(sizeof(data), lazy.serialize(bb));
+    TSUNIT_EQUAL(ts::ByteBlock(data, sizeof(data)), bb);
+
+    // Mix lazily added descriptors and regular descriptors.
+    lazy.add(duck, ts::StreamIdentifierDescriptor(21));
+    TSUNIT_ASSERT(lazy.addLazy(data, 3));
+    TSUNIT_EQUAL(7, lazy.count());
+    TSUNIT_EQUAL(21, lazy[5].payload()[0]);
+    TSUNIT_EQUAL(7, lazy[6].payload()[0]);
+
+    // Copies share the binary data but not the modifications.
+    ts::DescriptorList copy(nullptr, lazy);
+    TSUNIT_ASSERT(copy == lazy);
+    TSUNIT_EQUAL(1, lazy.removeByTag(ts::DID_MPEG_LANGUAGE));
+    TSUNIT_EQUAL(6, lazy.count());
+    TSUNIT_EQUAL(7, copy.count());
+    TSUNIT_EQUAL(3, copy.searchLanguage(duck, u"fra"));
+    TSUNIT_EQUAL(3, lazy.search(ts::DID_DVB_STREAM_ID, 1));
+
+    size_t index = 0;
+    for (const auto& d : copy) {
+        TSUNIT_ASSERT(&d == &copy[index]);
+        index++;
+    }
+    TSUNIT_EQUAL(7, index);
+
+    // Truncated descriptor.
+    ts::DescriptorList trunc(nullptr);
+    TSUNIT_ASSERT(!trunc.addLazy(data, 11));
+    TSUNIT_EQUAL(2, trunc.count());
+
+    // Lazy deserialization of descriptor lists in tables is disabled by default.
+    TSUNIT_ASSERT(!duck.lazyDescriptors());
+    for (bool on : {false, true}) {
+        duck.setLazyDescriptors(on);
+        ts::PSIBuffer buf(duck, data, sizeof(data));
+        ts::DescriptorList dlist(nullptr);
+        TSUNIT_ASSERT(buf.getDescriptorList(dlist));
+        TSUNIT_ASSERT(dlist == eager);
+    }
+}
@@ -0,0 +1,409 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::EITGenerator
+//
+//----------------------------------------------------------------------------
+
+#include "tsEITGenerator.h"
+#include "tsEIT.h"
+#include "tsSectionDemux.h"
+#include "tsDuckContext.h"
+#include "tsMJD.h"
+#include "tsBCD.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class EITGeneratorTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Regeneration);
+    TSUNIT_DECLARE_TEST(Injection);
+    TSUNIT_DECLARE_TEST(DeleteReplace);
+};
+
+TSUNIT_REGISTER(EITGeneratorTest);
+
+
+//----------------------------------------------------------------------------
+// Test environment.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // The actual TS contains three services, another TS contains one service.
+    constexpr uint16_t ACTUAL_TS = 0x0001;
+    constexpr uint16_t OTHER_TS = 0x0003;
+    constexpr uint16_t NETWORK = 0x0002;
+
+    const ts::ServiceIdTriplet SERVICES[] {
+        {0x0101, ACTUAL_TS, NETWORK},
+        {0x0102, ACTUAL_TS, NETWORK},
+        {0x0103, ACTUAL_TS, NETWORK},
+        {0x0201, OTHER_TS, NETWORK},
+    };
+
+    // Each service has seven consecutive one-hour events, ids 1000 to 1006, the first one starting at 09:30.
+    // The stream starts at 10:00, during the first event.
+    const ts::Time START_TIME(2025, 1, 10, 10, 0);
+    const ts::Time FIRST_EVENT(2025, 1, 10, 9, 30);
+    constexpr uint16_t FIRST_EVENT_ID = 1000;
+    constexpr uint16_t EVENT_COUNT = 7;
+
+    // The TS bitrate is 100 packets per second, 10 ms per packet.
+    constexpr ts::PacketCounter PACKETS_PER_SECOND = 100;
+    const ts::BitRate TS_BITRATE(PACKETS_PER_SECOND * ts::PKT_SIZE_BITS);
+
+    // Append the binary description of an event without descriptor, as in an EIT section.
+    void AppendEvent(ts::ByteBlock& data, uint16_t event_id, const ts::Time& start, cn::minutes duration)
+    {
+        uint8_t mjd[ts::MJD_FULL];
+        ts::EncodeMJD(start, mjd, ts::MJD_FULL);
+        data.appendUInt16(event_id);
+        data.append(mjd, sizeof(mjd));
+        data.appendUInt8(ts::EncodeBCD(int(duration.count() / 60)));
+        data.appendUInt8(ts::EncodeBCD(int(duration.count() % 60)));
+        data.appendUInt8(0);
+        data.appendUInt16(0x0000); // running status undefined, not scrambled, no descriptor
+    }
+
+    // Description of an event in an EIT section.
+    class EventInfo
+    {
+    public:
+        uint16_t event_id = 0;
+        ts::Time start {};
+    };
+
+    // Get the list of events in an EIT section.
+    std::vector<EventInfo> GetEvents(const ts::Section& section)
+    {
+        std::vector<EventInfo> events;
+        if (section.payloadSize() >= ts::EIT::EIT_PAYLOAD_FIXED_SIZE) {
+            const uint8_t* data = section.payload() + ts::EIT::EIT_PAYLOAD_FIXED_SIZE;
+            size_t size = section.payloadSize() - ts::EIT::EIT_PAYLOAD_FIXED_SIZE;
+            while (size >= ts::EIT::EIT_EVENT_FIXED_SIZE) {
+                EventInfo ev;
+                ev.event_id = ts::GetUInt16(data);
+                ts::DecodeMJD(data + 2, ts::MJD_FULL, ev.start);
+                const size_t len = std::min(size, ts::EIT::EIT_EVENT_FIXED_SIZE + (ts::GetUInt16(data + 10) & 0x0FFF));
+                data += len;
+                size -= len;
+                events.push_back(ev);
+            }
+        }
+        return events;
+    }
+
+    // A section which was injected in the TS.
+    class InjectedSection
+    {
+    public:
+        ts::PacketCounter packet = 0;  // Index of the packet where the section ends.
+        ts::SectionPtr section {};
+    };
+
+    // A section handler which collects all injected EIT sections, including repetitions.
+    class EITCollector : public ts::SectionHandlerInterface
+    {
+    public:
+        ts::PacketCounter packet = 0;
+        std::vector<InjectedSection> sections {};
+
+        virtual void handleSection(ts::SectionDemux& demux, const ts::Section& section) override
+        {
+            sections.push_back({packet, std::make_shared<ts::Section>(section, ts::ShareMode::COPY)});
+        }
+    };
+
+    // An EIT generator with its EPG and its output.
+    class EITContext
+    {
+        TS_NOCOPY(EITContext);
+    public:
+        ts::DuckContext   duck;
+        ts::EITGenerator  gen;
+        EITCollector      collector {};
+        ts::SectionDemux  demux;
+        ts::PacketCounter packets = 0;
+        bool              loaded = true;
+
+        EITContext() :
+            duck(),
+            gen(duck, ts::PID_EIT, ts::EITOptions::GEN_ALL),
+            demux(duck, nullptr, &collector)
+        {
+            demux.addPID(ts::PID_EIT);
+            gen.setTransportStreamId(ACTUAL_TS);
+            gen.setTransportStreamBitRate(TS_BITRATE);
+            gen.setCurrentTime(START_TIME);
+            for (const auto& srv : SERVICES) {
+                ts::ByteBlock data;
+                for (uint16_t i = 0; i < EVENT_COUNT; ++i) {
+                    AppendEvent(data, FIRST_EVENT_ID + i, FIRST_EVENT + cn::hours(i), cn::minutes(60));
+                }
+                loaded = gen.loadEvents(srv, data.data(), data.size()) && loaded;
+            }
+        }
+
+        // Run the generator on null packets during some time and collect the injected sections.
+        void run(cn::seconds duration)
+        {
+            for (ts::PacketCounter count = duration.count() * PACKETS_PER_SECOND; count > 0; --count) {
+                ts::TSPacket pkt(ts::NullPacket);
+                gen.processPacket(pkt);
+                collector.packet = packets++;
+                demux.feedPacket(pkt);
+            }
+        }
+
+        // Get the current EIT sections of a service in a range of table ids.
+        ts::SectionPtrVector sections(const ts::ServiceIdTriplet& srv, ts::TID tid_min, ts::TID tid_max)
+        {
+            ts::SectionPtrVector all, result;
+            gen.saveEITs(all);
+            for (const auto& sec : all) {
+                if (sec->tableId() >= tid_min && sec->tableId() <= tid_max && sec->tableIdExtension() == srv.service_id) {
+                    result.push_back(sec);
+                }
+            }
+            return result;
+        }
+
+        // Get the present or following event of a service in the current EIT p/f.
+        EventInfo pf(const ts::ServiceIdTriplet& srv, bool following)
+        {
+            const ts::TID tid = srv.transport_stream_id == ACTUAL_TS ? ts::TID_EIT_PF_ACT : ts::TID_EIT_PF_OTH;
+            for (const auto& sec : sections(srv, tid, tid)) {
+                if (sec->sectionNumber() == uint8_t(following)) {
+                    const auto events(GetEvents(*sec));
+                    return events.empty() ? EventInfo() : events.front();
+                }
+            }
+            return EventInfo();
+        }
+
+        // Get the list of events in the current EIT schedule of a service.
+        std::vector<EventInfo> schedule(const ts::ServiceIdTriplet& srv)
+        {
+            const bool actual = srv.transport_stream_id == ACTUAL_TS;
+            std::vector<EventInfo> events;
+            for (const auto& sec : sections(srv, actual ? ts::TID_EIT_S_ACT_MIN : ts::TID_EIT_S_OTH_MIN, actual ? ts::TID_EIT_S_ACT_MAX : ts::TID_EIT_S_OTH_MAX)) {
+                const auto sec_events(GetEvents(*sec));
+                events.insert(events.end(), sec_events.begin(), sec_events.end());
+            }
+            return events;
+        }
+
+        // Get the list of event ids in the current EIT schedule of a service.
+        std::vector<uint16_t> scheduleIds(const ts::ServiceIdTriplet& srv)
+        {
+            std::vector<uint16_t> ids;
+            for (const auto& ev : schedule(srv)) {
+                ids.push_back(ev.event_id);
+            }
+            return ids;
+        }
+
+        // Get the event in the last injected EIT p/f section of a service before a given packet.
+        EventInfo injectedPF(const ts::ServiceIdTriplet& srv, bool following, ts::PacketCounter before)
+        {
+            const ts::TID tid = srv.transport_stream_id == ACTUAL_TS ? ts::TID_EIT_PF_ACT : ts::TID_EIT_PF_OTH;
+            EventInfo result;
+            for (const auto& inj : collector.sections) {
+                if (inj.packet < before &&
+                    inj.section->tableId() == tid &&
+                    inj.section->tableIdExtension() == srv.service_id &&
+                    inj.section->sectionNumber() == uint8_t(following))
+                {
+                    const auto events(GetEvents(*inj.section));
+                    result = events.empty() ? EventInfo() : events.front();
+                }
+            }
+            return result;
+        }
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Test cases
+//----------------------------------------------------------------------------
+
+// EIT p/f and schedule are regenerated when time crosses event and segment boundaries.
+TSUNIT_DEFINE_TEST(Regeneration)
+{
+    EITContext ctx;
+    TSUNIT_ASSERT(ctx.loaded);
+
+    // At 10:00, present event is 1000, following is 1001, all events are in the schedule.
+    for (const auto& srv : SERVICES) {
+        TSUNIT_EQUAL(1000, ctx.pf(srv, false).event_id);
+        TSUNIT_EQUAL(1001, ctx.pf(srv, true).event_id);
+        TSUNIT_ASSERT(ctx.scheduleIds(srv) == std::vector<uint16_t>({1000, 1001, 1002, 1003, 1004, 1005, 1006}));
+    }
+
+    // At 10:40, after the end of the first event.
+    ctx.run(cn::minutes(40));
+    TSUNIT_ASSERT(START_TIME + cn::minutes(40) == ctx.gen.getCurrentTime());
+    for (const auto& srv : SERVICES) {
+        TSUNIT_EQUAL(1001, ctx.pf(srv, false).event_id);
+        TSUNIT_ASSERT(FIRST_EVENT + cn::hours(1) == ctx.pf(srv, false).start);
+        TSUNIT_EQUAL(1002, ctx.pf(srv, true).event_id);
+        TSUNIT_ASSERT(ctx.scheduleIds(srv) == std::vector<uint16_t>({1001, 1002, 1003, 1004, 1005, 1006}));
+    }
+
+    // The injected EIT p/f were updated in the stream: before 10:30, after 10:31.
+    for (const auto& srv : SERVICES) {
+        TSUNIT_EQUAL(1000, ctx.injectedPF(srv, false, 30 * 60 * PACKETS_PER_SECOND).event_id);
+        TSUNIT_EQUAL(1001, ctx.injectedPF(srv, true, 30 * 60 * PACKETS_PER_SECOND).event_id);
+        TSUNIT_EQUAL(1001, ctx.injectedPF(srv, false, 31 * 60 * PACKETS_PER_SECOND).event_id);
+        TSUNIT_EQUAL(1002, ctx.injectedPF(srv, true, 31 * 60 * PACKETS_PER_SECOND).event_id);
+    }
+
+    // At 12:40, after crossing the 12:00 segment boundary and the end of two events.
+    ctx.run(cn::minutes(120));
+    TSUNIT_ASSERT(START_TIME + cn::minutes(160) == ctx.gen.getCurrentTime());
+    for (const auto& srv : SERVICES) {
+        TSUNIT_EQUAL(1003, ctx.pf(srv, false).event_id);
+        TSUNIT_EQUAL(1004, ctx.pf(srv, true).event_id);
+        TSUNIT_ASSERT(ctx.scheduleIds(srv) == std::vector<uint16_t>({1003, 1004, 1005, 1006}));
+        TSUNIT_EQUAL(1003, ctx.injectedPF(srv, false, ctx.packets).event_id);
+        TSUNIT_EQUAL(1004, ctx.injectedPF(srv, true, ctx.packets).event_id);
+    }
+}
+
+// Injection order and repetition rates of EIT sections.
+TSUNIT_DEFINE_TEST(Injection)
+{
+    EITContext ctx;
+    TSUNIT_ASSERT(ctx.loaded);
+    ctx.run(cn::seconds(60));
+
+    const auto& injected(ctx.collector.sections);
+    TSUNIT_ASSERT(!injected.empty());
+
+    // The EIT p/f actual have the highest priority: the first injected section is an EIT p/f actual and
+    // the present section of each service in the actual TS is injected before any other type of EIT.
+    TSUNIT_EQUAL(ts::TID_EIT_PF_ACT, injected.front().section->tableId());
+    size_t first_other = 0;
+    while (first_other < injected.size() && injected[first_other].section->tableId() == ts::TID_EIT_PF_ACT) {
+        first_other++;
+    }
+    TSUNIT_ASSERT(first_other < injected.size());
+    for (const auto& srv : SERVICES) {
+        if (srv.transport_stream_id == ACTUAL_TS) {
+            bool found = false;
+            for (size_t i = 0; !found && i < first_other; ++i) {
+                found = injected[i].section->tableIdExtension() == srv.service_id && injected[i].section->sectionNumber() == 0;
+            }
+            TSUNIT_ASSERT(found);
+        }
+    }
+
+    // Packet indexes of each injected section, indexed by table id, service id, section number.
+    std::map<std::tuple<ts::TID, uint16_t, uint8_t>, std::vector<ts::PacketCounter>> repetitions;
+    for (const auto& inj : injected) {
+        repetitions[{inj.section->tableId(), inj.section->tableIdExtension(), inj.section->sectionNumber()}].push_back(inj.packet);
+    }
+
+    // All EIT p/f and schedule sections are injected in the first cycle.
+    for (const auto& srv : SERVICES) {
+        const bool actual = srv.transport_stream_id == ACTUAL_TS;
+        const ts::TID pf_tid = actual ? ts::TID_EIT_PF_ACT : ts::TID_EIT_PF_OTH;
+        const ts::TID sched_tid = actual ? ts::TID_EIT_S_ACT_MIN : ts::TID_EIT_S_OTH_MIN;
+        for (uint8_t secnum = 0; secnum < 2; ++secnum) {
+            TSUNIT_ASSERT(repetitions.contains({pf_tid, srv.service_id, secnum}));
+        }
+        for (const auto& sec : ctx.sections(srv, sched_tid, sched_tid + 15)) {
+            TSUNIT_ASSERT(repetitions.contains({sec->tableId(), srv.service_id, sec->sectionNumber()}));
+        }
+    }
+
+    // Check the repetition rates of the default profile: 2 seconds for EIT p/f actual, 10 seconds for the others.
+    // Sections are never injected before their due time. They can be delayed by a few packets when many
+    // sections are due at the same time, and by 30 ms between two sections of the same service.
+    for (const auto& rep : repetitions) {
+        const ts::TID tid = std::get<0>(rep.first);
+        const ts::PacketCounter cycle = (tid == ts::TID_EIT_PF_ACT ? 2 : 10) * PACKETS_PER_SECOND;
+        const auto& packets(rep.second);
+        debug() << "EITGeneratorTest::Injection: tid 0x" << ts::UString::Hexa(tid) << ", service 0x"
+                << ts::UString::Hexa(std::get<1>(rep.first)) << ", section " << int(std::get<2>(rep.first))
+                << ", first packet " << packets.front() << ", " << packets.size() << " times" << std::endl;
+        TSUNIT_ASSERT(packets.front() < PACKETS_PER_SECOND);
+        TSUNIT_ASSERT(packets.size() >= 60 * PACKETS_PER_SECOND / cycle - 1);
+        for (size_t i = 1; i < packets.size(); ++i) {
+            TSUNIT_ASSERT(packets[i] - packets[i-1] + 2 >= cycle);
+            TSUNIT_ASSERT(packets[i] - packets[i-1] <= cycle + PACKETS_PER_SECOND / 2);
+        }
+    }
+}
+
+// Deletion and replacement of events.
+TSUNIT_DEFINE_TEST(DeleteReplace)
+{
+    EITContext ctx;
+    TSUNIT_ASSERT(ctx.loaded);
+
+    // At 10:40, present event is 1001, following is 1002.
+    ctx.run(cn::minutes(40));
+    const ts::ServiceIdTriplet& srv(SERVICES[0]);
+    TSUNIT_EQUAL(1001, ctx.pf(srv, false).event_id);
+    TSUNIT_EQUAL(1002, ctx.pf(srv, true).event_id);
+
+    // Delete the following event, the EIT p/f is updated.
+    TSUNIT_ASSERT(ctx.gen.deleteEvent(srv, 1002));
+    TSUNIT_ASSERT(!ctx.gen.deleteEvent(srv, 1002));
+    TSUNIT_ASSERT(!ctx.gen.deleteEvent(ts::ServiceIdTriplet(0x0999, ACTUAL_TS, NETWORK), 1003));
+    TSUNIT_EQUAL(1001, ctx.pf(srv, false).event_id);
+    TSUNIT_EQUAL(1003, ctx.pf(srv, true).event_id);
+    TSUNIT_ASSERT(ctx.scheduleIds(srv) == std::vector<uint16_t>({1001, 1003, 1004, 1005, 1006}));
+
+    // Other services are unchanged.
+    for (size_t i = 1; i < std::size(SERVICES); ++i) {
+        TSUNIT_EQUAL(1002, ctx.pf(SERVICES[i], true).event_id);
+        TSUNIT_ASSERT(ctx.scheduleIds(SERVICES[i]) == std::vector<uint16_t>({1001, 1002, 1003, 1004, 1005, 1006}));
+    }
+
+    // Move event 1004 from 13:30 to 18:00, in another segment. It is replaced, not duplicated.
+    const ts::Time new_start(2025, 1, 10, 18, 0);
+    ts::ByteBlock data;
+    AppendEvent(data, 1004, new_start, cn::minutes(30));
+    TSUNIT_ASSERT(ctx.gen.loadEvents(srv, data.data(), data.size()));
+    const auto events(ctx.schedule(srv));
+    TSUNIT_EQUAL(5, events.size());
+    TSUNIT_EQUAL(1005, events[2].event_id);
+    TSUNIT_EQUAL(1006, events[3].event_id);
+    TSUNIT_EQUAL(1004, events[4].event_id);
+    TSUNIT_ASSERT(new_start == events[4].start);
+
+    // Move the following event 1003 in the same segment, the EIT p/f is updated.
+    const ts::Time delayed(2025, 1, 10, 12, 45);
+    data.clear();
+    AppendEvent(data, 1003, delayed, cn::minutes(45));
+    TSUNIT_ASSERT(ctx.gen.loadEvents(srv, data.data(), data.size()));
+    TSUNIT_EQUAL(1003, ctx.pf(srv, true).event_id);
+    TSUNIT_ASSERT(delayed == ctx.pf(srv, true).start);
+    TSUNIT_ASSERT(ctx.scheduleIds(srv) == std::vector<uint16_t>({1001, 1003, 1005, 1006, 1004}));
+
+    // Replaced events can be deleted.
+    TSUNIT_ASSERT(ctx.gen.deleteEvent(srv, 1004));
+    TSUNIT_ASSERT(!ctx.gen.deleteEvent(srv, 1004));
+    TSUNIT_ASSERT(ctx.scheduleIds(srv) == std::vector<uint16_t>({1001, 1003, 1005, 1006}));
+
+    // The new EIT p/f is injected.
+    const ts::PacketCounter start = ctx.packets;
+    ctx.run(cn::seconds(5));
+    TSUNIT_EQUAL(1003, ctx.injectedPF(srv, true, ctx.packets).event_id);
+    TSUNIT_ASSERT(delayed == ctx.injectedPF(srv, true, ctx.packets).start);
+    TSUNIT_EQUAL(1002, ctx.injectedPF(SERVICES[1], true, ctx.packets).event_id);
+    TSUNIT_ASSERT(ctx.injectedPF(srv, true, start).event_id != ctx.injectedPF(srv, true, ctx.packets).event_id);
+}
@@ -0,0 +1,107 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::LogHistogram
+//
+//----------------------------------------------------------------------------
+
+#include "tsLogHistogram.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class LogHistogramTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Buckets);
+    TSUNIT_DECLARE_TEST(Statistics);
+    TSUNIT_DECLARE_TEST(Concurrent);
+};
+
+TSUNIT_REGISTER(LogHistogramTest);
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(Buckets)
+{
+    TSUNIT_EQUAL(0, ts::LogHistogram::BucketIndex(0));
+    TSUNIT_EQUAL(1, ts::LogHistogram::BucketIndex(1));
+    TSUNIT_EQUAL(2, ts::LogHistogram::BucketIndex(2));
+    TSUNIT_EQUAL(2, ts::LogHistogram::BucketIndex(3));
+    TSUNIT_EQUAL(3, ts::LogHistogram::BucketIndex(4));
+    TSUNIT_EQUAL(10, ts::LogHistogram::BucketIndex(1000));
+    TSUNIT_EQUAL(64, ts::LogHistogram::BucketIndex(~uint64_t(0)));
+
+    TSUNIT_EQUAL(0, ts::LogHistogram::BucketUpperBound(0));
+    TSUNIT_EQUAL(1, ts::LogHistogram::BucketUpperBound(1));
+    TSUNIT_EQUAL(3, ts::LogHistogram::BucketUpperBound(2));
+    TSUNIT_EQUAL(1023, ts::LogHistogram::BucketUpperBound(10));
+    TSUNIT_EQUAL(~uint64_t(0), ts::LogHistogram::BucketUpperBound(64));
+}
+
+TSUNIT_DEFINE_TEST(Statistics)
+{
+    ts::LogHistogram hist;
+    TSUNIT_EQUAL(0, hist.count());
+    TSUNIT_EQUAL(0, hist.percentile(50));
+    TSUNIT_EQUAL(0.0, hist.mean());
+
+    for (uint64_t i = 1; i <= 100; ++i) {
+        hist.feed(i);
+    }
+    hist.feed(1000);
+
+    debug() << "LogHistogramTest::testStatistics: " << hist.bucketsString() << std::endl;
+
+    TSUNIT_EQUAL(101, hist.count());
+    TSUNIT_EQUAL(6050, hist.sum());
+    TSUNIT_EQUAL(1000, hist.maximum());
+    TSUNIT_EQUAL(1, hist.bucket(1));
+    TSUNIT_EQUAL(2, hist.bucket(2));
+    TSUNIT_EQUAL(37, hist.bucket(7));
+    TSUNIT_EQUAL(1, hist.bucket(10));
+    TSUNIT_EQUAL(63, hist.percentile(50));
+    TSUNIT_EQUAL(127, hist.percentile(99));
+    TSUNIT_EQUAL(1000, hist.percentile(100));
+    TSUNIT_EQUAL(u"<2:1, <4:2, <8:4, <16:8, <32:16, <64:32, <128:37, <1024:1", hist.bucketsString());
+
+    hist.reset();
+    TSUNIT_EQUAL(0, hist.count());
+    TSUNIT_EQUAL(0, hist.maximum());
+    TSUNIT_EQUAL(0, hist.bucket(7));
+}
+
+TSUNIT_DEFINE_TEST(Concurrent)
+{
+    // No update is lost when several threads feed the same histogram.
+    ts::LogHistogram hist;
+    std::vector<std::thread> threads;
+    for (uint64_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&hist, t]() {
+            for (uint64_t i = 1; i <= 10000; ++i) {
+                hist.feed(i + t);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    TSUNIT_EQUAL(40000, hist.count());
+    TSUNIT_EQUAL(4 * 50005000 + 10000 * (0 + 1 + 2 + 3), hist.sum());
+    TSUNIT_EQUAL(10003, hist.maximum());
+
+    hist.reset();
+    TSUNIT_EQUAL(0, hist.count());
+    TSUNIT_EQUAL(0, hist.sum());
+    TSUNIT_EQUAL(0, hist.maximum());
+}
@@ -12,6 +12,8 @@
 
 #include "tsNames.h"
 #include "tsFileUtils.h"
+#include "tsEnvironment.h"
+#include "tsByteBlock.h"
 #include "tsDuckContext.h"
 #include "tsOUI.h"
 #include "tsMPEG2.h"
@@ -80,6 +82,7 @@ class NamesTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(PlatformId);
     TSUNIT_DECLARE_TEST(Inheritance);
     TSUNIT_DECLARE_TEST(Extension);
+    TSUNIT_DECLARE_TEST(Cache);
 
 public:
     virtual void beforeTest() override;
@@ -631,3 +634,89 @@ TSUNIT_DEFINE_TEST(Extension)
     ts::Names::RegisterExtensionFile reg(_tempFileName);
     TSUNIT_EQUAL(u"test-cas", ts::CASIdName(duck, 0xF123));
 }
+
+TSUNIT_DEFINE_TEST(Cache)
+{
+    using AllInstances = ts::Names::AllInstances;
+
+    // The cache files are in the user's home directory. Use a temporary one, do not pollute the real one.
+#if defined(TS_WINDOWS)
+    const ts::UString home_var(u"APPDATA");
+#else
+    const ts::UString home_var(u"HOME");
+#endif
+    const bool home_exists = ts::EnvironmentExists(home_var);
+    const ts::UString home_saved(ts::GetEnvironment(home_var));
+    const fs::path home(ts::TempFile(u""));
+    TSUNIT_ASSERT(fs::create_directories(home));
+    TSUNIT_ASSERT(ts::SetEnvironment(home_var, home));
+
+    // Build a names file which is large enough to be cached.
+    ts::UStringVector lines({u"# Test file", u"[CacheTest]", u"Bits = 16", u"Extended = true", u"Inherit = OtherCacheTest"});
+    for (size_t i = 0; i < 2000; ++i) {
+        lines.push_back(ts::UString::Format(u"0x%04X-0x%04X = name-%d", 2 * i, 2 * i + 1, i));
+    }
+    TSUNIT_ASSERT(ts::UString::Save(lines, _tempFileName));
+    const ts::UString file_name(_tempFileName);
+    const ts::UString cache_file(AllInstances::CacheFileName(file_name));
+    debug() << "NamesTest::Cache: names file: " << file_name << ", cache: " << cache_file << std::endl;
+    TSUNIT_ASSERT(!cache_file.empty());
+    TSUNIT_ASSERT(cache_file.starts_with(ts::UString(home)));
+
+    // Decode the text file.
+    AllInstances::DirectiveVector text_dirs;
+    size_t error_count = 0;
+    TSUNIT_ASSERT(AllInstances::LoadText(file_name, text_dirs, error_count));
+    TSUNIT_EQUAL(0, error_count);
+    TSUNIT_EQUAL(2004, text_dirs.size());
+
+    // Round-trip through the cache, no cache yet.
+    AllInstances::DirectiveVector cache_dirs;
+    TSUNIT_ASSERT(!AllInstances::LoadCache(cache_file, file_name, cache_dirs));
+    AllInstances::SaveCache(cache_file, file_name, text_dirs);
+    TSUNIT_ASSERT(fs::exists(cache_file));
+    TSUNIT_ASSERT(AllInstances::LoadCache(cache_file, file_name, cache_dirs));
+    TSUNIT_EQUAL(text_dirs.size(), cache_dirs.size());
+    for (size_t i = 0; i < text_dirs.size() && i < cache_dirs.size(); ++i) {
+        TSUNIT_EQUAL(int(text_dirs[i].type), int(cache_dirs[i].type));
+        TSUNIT_EQUAL(text_dirs[i].line, cache_dirs[i].line);
+        TSUNIT_EQUAL(text_dirs[i].first, cache_dirs[i].first);
+        TSUNIT_EQUAL(text_dirs[i].last, cache_dirs[i].last);
+        TSUNIT_EQUAL(text_dirs[i].text, cache_dirs[i].text);
+    }
+
+    // Corrupted cache: invalid directive type in the first record, truncated file.
+    ts::ByteBlock data;
+    TSUNIT_ASSERT(data.loadFromFile(cache_file));
+    ts::ByteBlock bad(data);
+    bad[36 + 31] = 0xFF; // header size (36) + type offset in record (28), last byte
+    TSUNIT_ASSERT(bad.saveToFile(cache_file));
+    TSUNIT_ASSERT(!AllInstances::LoadCache(cache_file, file_name, cache_dirs));
+    TSUNIT_ASSERT(cache_dirs.empty());
+    bad = data;
+    bad.resize(data.size() - 1);
+    TSUNIT_ASSERT(bad.saveToFile(cache_file));
+    TSUNIT_ASSERT(!AllInstances::LoadCache(cache_file, file_name, cache_dirs));
+    TSUNIT_ASSERT(data.saveToFile(cache_file));
+    TSUNIT_ASSERT(AllInstances::LoadCache(cache_file, file_name, cache_dirs));
+
+    // Stale cache: the names file was modified after the cache was created.
+    const auto time = fs::last_write_time(_tempFileName);
+    fs::last_write_time(_tempFileName, time + std::chrono::seconds(10));
+    TSUNIT_ASSERT(!AllInstances::LoadCache(cache_file, file_name, cache_dirs));
+    fs::last_write_time(_tempFileName, time);
+    TSUNIT_ASSERT(AllInstances::LoadCache(cache_file, file_name, cache_dirs));
+    lines.push_back(u"0xFFF0 = name-last");
+    TSUNIT_ASSERT(ts::UString::Save(lines, _tempFileName));
+    fs::last_write_time(_tempFileName, time);
+    TSUNIT_ASSERT(!AllInstances::LoadCache(cache_file, file_name, cache_dirs));
+
+    // Restore the home directory.
+    if (home_exists) {
+        ts::SetEnvironment(home_var, home_saved);
+    }
+    else {
+        ts::DeleteEnvironment(home_var);
+    }
+    fs::remove_all(home, &ts::ErrCodeReport());
+}
@@ -46,6 +46,8 @@ class NetworkingTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(IPv6SocketAddress);
     TSUNIT_DECLARE_TEST(TCPSocket);
     TSUNIT_DECLARE_TEST(UDPSocket);
+    TSUNIT_DECLARE_TEST(UDPReceiveMultiple);
+    TSUNIT_DECLARE_TEST(UDPSendMultiple);
     TSUNIT_DECLARE_TEST(IPHeader);
     TSUNIT_DECLARE_TEST(IPProtocol);
     TSUNIT_DECLARE_TEST(TCPPacket);
@@ -883,6 +885,115 @@ TSUNIT_DEFINE_TEST(UDPSocket)
     CERR.debug(u"UDPSocketTest: main thread: reply sent");
 }
 
+TSUNIT_DEFINE_TEST(UDPReceiveMultiple)
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    // Receiver socket on a local port, sender socket to this port.
+    ts::UDPSocket receiver(true, ts::IP::v4);
+    TSUNIT_ASSERT(receiver.isOpen());
+    TSUNIT_ASSERT(receiver.bind(ts::IPSocketAddress(ts::IPAddress::LocalHost4, ts::IPSocketAddress::AnyPort), CERR));
+    ts::IPSocketAddress receiver_addr;
+    TSUNIT_ASSERT(receiver.getLocalAddress(receiver_addr, CERR));
+
+    ts::UDPSocket sender(true, ts::IP::v4);
+    TSUNIT_ASSERT(sender.isOpen());
+    TSUNIT_ASSERT(sender.setDefaultDestination(receiver_addr, CERR));
+
+    // Send more datagrams than received in one system call. On loopback, they are all queued in the receiver socket.
+    const size_t count = ts::UDPSocket::MAX_RECEIVE_MULTIPLE + 36;
+    for (size_t i = 0; i < count; ++i) {
+        const ts::ByteBlock data(1 + i % 50, uint8_t(i));
+        TSUNIT_ASSERT(sender.send(data.data(), data.size(), CERR));
+    }
+
+    // Receive all datagrams by batches, check that they are received in order and intact.
+    std::vector<ts::ByteBlock> buffers(count, ts::ByteBlock(100));
+    std::vector<ts::UDPSocket::ReceivedMessage> messages(count);
+    for (size_t i = 0; i < count; ++i) {
+        messages[i].data = buffers[i].data();
+        messages[i].max_size = buffers[i].size();
+    }
+    size_t received = 0;
+    while (received < count) {
+        size_t ret_count = 0;
+        TSUNIT_ASSERT(receiver.receiveMultiple(messages.data() + received, count - received, ret_count, nullptr, CERR));
+        debug() << "NetworkingTest::UDPReceiveMultiple: received " << ret_count << " datagrams" << std::endl;
+        TSUNIT_ASSERT(ret_count > 0);
+        TSUNIT_ASSERT(ret_count <= ts::UDPSocket::MAX_RECEIVE_MULTIPLE);
+        for (size_t i = received; i < received + ret_count; ++i) {
+            TSUNIT_EQUAL(1 + i % 50, messages[i].size);
+            TSUNIT_ASSERT(ts::ByteBlock(messages[i].data, messages[i].size) == ts::ByteBlock(1 + i % 50, uint8_t(i)));
+            TSUNIT_ASSERT(ts::IPAddress(messages[i].sender) == ts::IPAddress::LocalHost4);
+        }
+        received += ret_count;
+    }
+}
+
+TSUNIT_DEFINE_TEST(UDPSendMultiple)
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    // Receiver socket on a local port, sender socket to this port.
+    ts::UDPSocket receiver(true, ts::IP::v4);
+    TSUNIT_ASSERT(receiver.isOpen());
+    TSUNIT_ASSERT(receiver.bind(ts::IPSocketAddress(ts::IPAddress::LocalHost4, ts::IPSocketAddress::AnyPort), CERR));
+    ts::IPSocketAddress receiver_addr;
+    TSUNIT_ASSERT(receiver.getLocalAddress(receiver_addr, CERR));
+
+    ts::UDPSocket sender(true, ts::IP::v4);
+    TSUNIT_ASSERT(sender.isOpen());
+    TSUNIT_ASSERT(sender.setDefaultDestination(receiver_addr, CERR));
+
+    // Receive the next datagram and check that it is the expected one.
+    char buffer[100];
+    const auto check = [&](size_t index) {
+        size_t size = 0;
+        ts::IPSocketAddress from;
+        ts::IPSocketAddress to;
+        TSUNIT_ASSERT(receiver.receive(buffer, sizeof(buffer), size, from, to, nullptr, CERR));
+        TSUNIT_EQUAL(1 + index % 50, size);
+        TSUNIT_ASSERT(ts::ByteBlock(buffer, size) == ts::ByteBlock(1 + index % 50, uint8_t(index)));
+        TSUNIT_ASSERT(ts::IPAddress(from) == ts::IPAddress::LocalHost4);
+    };
+
+    // Send more datagrams than sent in one system call, in one operation.
+    const size_t count = 2 * ts::UDPSocket::MAX_SEND_MULTIPLE + 2;
+    std::vector<ts::ByteBlock> data(count);
+    std::vector<ts::UDPSocket::SentMessage> messages(count);
+    for (size_t i = 0; i < count; ++i) {
+        data[i].resize(1 + i % 50, uint8_t(i));
+        messages[i].data = data[i].data();
+        messages[i].size = data[i].size();
+    }
+    TSUNIT_ASSERT(sender.sendMultiple(messages.data(), count, CERR));
+
+    // On loopback, they are all queued in the receiver socket, in order.
+    for (size_t i = 0; i < count; ++i) {
+        check(i);
+    }
+
+    // Partial send: a message is too large for a UDP datagram, the previous ones must still be sent in order.
+    const size_t bad_index = ts::UDPSocket::MAX_SEND_MULTIPLE + 10;
+    const ts::ByteBlock too_large(70000);
+    messages[bad_index].data = too_large.data();
+    messages[bad_index].size = too_large.size();
+    TSUNIT_ASSERT(!sender.sendMultiple(messages.data(), count, NULLREP));
+    for (size_t i = 0; i < bad_index; ++i) {
+        check(i);
+    }
+
+    // The rest of the batch was not sent, nothing more must be queued.
+    const ts::ByteBlock marker(1, 0xFF);
+    TSUNIT_ASSERT(sender.send(marker.data(), marker.size(), CERR));
+    size_t size = 0;
+    ts::IPSocketAddress from;
+    ts::IPSocketAddress to;
+    TSUNIT_ASSERT(receiver.receive(buffer, sizeof(buffer), size, from, to, nullptr, CERR));
+    TSUNIT_EQUAL(1, size);
+    TSUNIT_EQUAL(0xFF, uint8_t(buffer[0]));
+}
+
 TSUNIT_DEFINE_TEST(IPHeader)
 {
     static const uint8_t reference_header[] = {
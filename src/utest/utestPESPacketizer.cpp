@@ -24,6 +24,7 @@
 class PESPacketizerTest: public tsunit::Test, private ts::PESHandlerInterface
 {
     TSUNIT_DECLARE_TEST(Packetizer);
+    TSUNIT_DECLARE_TEST(HeaderOnly);
 
 public:
     virtual void beforeTest() override;
@@ -31,7 +32,14 @@ public:
 
 private:
     size_t _pes_count = 0;
+    size_t _header_count = 0;
+    std::vector<size_t> _data_sizes {};
+
+    // Build TS packets for two PES packets, 1234 and 10000 bytes.
+    void buildPackets(ts::DuckContext& duck, ts::TSPacketVector& packets);
+
     virtual void handlePESPacket(ts::PESDemux& demux, const ts::PESPacket& packet) override;
+    virtual void handlePESHeader(ts::PESDemux& demux, const ts::DemuxedData& data, size_t data_size) override;
 };
 
 TSUNIT_REGISTER(PESPacketizerTest);
@@ -45,6 +53,8 @@ TSUNIT_REGISTER(PESPacketizerTest);
 void PESPacketizerTest::beforeTest()
 {
     _pes_count = 0;
+    _header_count = 0;
+    _data_sizes.clear();
 }
 
 // Test suite cleanup method.
@@ -57,7 +67,7 @@ void PESPacketizerTest::afterTest()
 // Unitary tests.
 //----------------------------------------------------------------------------
 
-TSUNIT_DEFINE_TEST(Packetizer)
+void PESPacketizerTest::buildPackets(ts::DuckContext& duck, ts::TSPacketVector& packets)
 {
     // Build two PES packets from scratch.
     uint8_t data1[1234];
@@ -85,7 +95,6 @@ TSUNIT_DEFINE_TEST(Packetizer)
     pes2.setPCR(987654321);
 
     // Packetize the two PES packets at once.
-    ts::DuckContext duck;
     ts::PESOneShotPacketizer zer(duck, 100);
     TSUNIT_ASSERT(zer.empty());
 
@@ -93,8 +102,14 @@ TSUNIT_DEFINE_TEST(Packetizer)
     zer.addPES(pes2, ts::ShareMode::SHARE);
     TSUNIT_ASSERT(!zer.empty());
 
-    ts::TSPacketVector packets;
     zer.getPackets(packets);
+}
+
+TSUNIT_DEFINE_TEST(Packetizer)
+{
+    ts::DuckContext duck;
+    ts::TSPacketVector packets;
+    buildPackets(duck, packets);
     TSUNIT_ASSERT(packets.size() > 2);
     TSUNIT_ASSERT(packets[0].getPUSI());
     TSUNIT_ASSERT(!packets[1].getPUSI());
@@ -113,6 +128,27 @@ TSUNIT_DEFINE_TEST(Packetizer)
         demux.feedPacket(packets[i]);
     }
     TSUNIT_EQUAL(2, _pes_count);
+    TSUNIT_EQUAL(0, _header_count);
+}
+
+TSUNIT_DEFINE_TEST(HeaderOnly)
+{
+    ts::DuckContext duck;
+    ts::TSPacketVector packets;
+    buildPackets(duck, packets);
+
+    // In header-only mode, only the beginning of the PES packets is accumulated.
+    ts::PESDemux demux(duck, this);
+    demux.setHeaderOnly(true);
+    TSUNIT_ASSERT(demux.headerOnly());
+    for (size_t i = 0; i < packets.size(); ++i) {
+        demux.feedPacket(packets[i]);
+    }
+    TSUNIT_EQUAL(0, _pes_count);
+    TSUNIT_EQUAL(2, _header_count);
+    TSUNIT_EQUAL(2, _data_sizes.size());
+    TSUNIT_EQUAL(1234, _data_sizes[0]);
+    TSUNIT_EQUAL(10000, _data_sizes[1]);
 }
 
 void PESPacketizerTest::handlePESPacket(ts::PESDemux& demux, const ts::PESPacket& pes)
@@ -140,3 +176,14 @@ void PESPacketizerTest::handlePESPacket(ts::PESDemux& demux, const ts::PESPacket
             TSUNIT_FAIL("invalid PES packet count");
     }
 }
+
+void PESPacketizerTest::handlePESHeader(ts::PESDemux& demux, const ts::DemuxedData& data, size_t data_size)
+{
+    _header_count++;
+    _data_sizes.push_back(data_size);
+    TSUNIT_EQUAL(100, data.sourcePID());
+    TSUNIT_ASSERT(data.size() >= 6);
+    TSUNIT_ASSERT(data.size() <= ts::PKT_SIZE - 4);
+    TSUNIT_EQUAL(6, ts::PESPacket::HeaderSize(data.content(), data.size()));
+    TSUNIT_EQUAL(data_size - 6, ts::GetUInt16(data.content() + 4));
+}
@@ -32,6 +32,7 @@
 class PacketizerTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(Packetizer);
+    TSUNIT_DECLARE_TEST(Schedule);
 
 private:
     // Demux one table from a list of packets
@@ -132,3 +133,58 @@ TSUNIT_DEFINE_TEST(Packetizer)
     TSUNIT_ASSERT(pmt_count == 4);
     TSUNIT_ASSERT(sdt_count >= 12 && sdt_count <= 18);
 }
+
+TSUNIT_DEFINE_TEST(Schedule)
+{
+    ts::DuckContext duck;
+
+    // One short section per packet, 100 packets per second.
+    ts::CyclingPacketizer pzer(duck, 100, ts::CyclingPacketizer::StuffingPolicy::ALWAYS, ts::PKT_SIZE_BITS * 100);
+    const uint8_t payload[10] {};
+    for (uint8_t sec = 0; sec < 3; ++sec) {
+        // Same due packet for all sections: packetized in order of section number, before the next table.
+        pzer.addSection(std::make_shared<ts::Section>(0x80, true, 0x1234, 0, true, uint8_t(2 - sec), 2, payload, sizeof(payload)), cn::milliseconds(100));
+    }
+    pzer.addSection(std::make_shared<ts::Section>(0x81, true, payload, sizeof(payload)), cn::milliseconds(50));
+    TSUNIT_EQUAL(4, pzer.storedSectionCount());
+
+    // Section identification from a packet: 16 * tid + section number (zero for short sections, zero for stuffing).
+    const auto next = [&pzer]() {
+        ts::TSPacket pkt;
+        return !pzer.getNextPacket(pkt) ? 0 : 16 * pkt.b[5] + (pkt.b[6] & 0x80 ? pkt.b[11] : 0);
+    };
+
+    // First cycle.
+    TSUNIT_EQUAL(0x810, next());
+    TSUNIT_EQUAL(0x800, next());
+    TSUNIT_EQUAL(0x801, next());
+    TSUNIT_EQUAL(0x802, next());
+    TSUNIT_ASSERT(pzer.atCycleBoundary());
+
+    // Count sections over 10 seconds.
+    std::map<int, int> count;
+    for (int i = 0; i < 1000; ++i) {
+        count[next()]++;
+    }
+    debug() << "PacketizerTest::Schedule: " << count[0x800] << ", " << count[0x801] << ", " << count[0x802] << ", " << count[0x810] << ", stuffing: " << count[0] << std::endl;
+    TSUNIT_ASSERT(count[0x800] >= 95 && count[0x800] <= 100);
+    TSUNIT_ASSERT(count[0x801] >= 95 && count[0x801] <= 100);
+    TSUNIT_ASSERT(count[0x802] >= 95 && count[0x802] <= 100);
+    TSUNIT_ASSERT(count[0x810] >= 190 && count[0x810] <= 200);
+
+    // Remove one table, double the bitrate.
+    pzer.removeSections(0x80, 0x1234);
+    TSUNIT_EQUAL(1, pzer.storedSectionCount());
+    pzer.setBitRate(ts::PKT_SIZE_BITS * 200);
+    count.clear();
+    for (int i = 0; i < 1000; ++i) {
+        count[next()]++;
+    }
+    TSUNIT_EQUAL(2, count.size());
+    TSUNIT_ASSERT(count[0x810] >= 95 && count[0x810] <= 100);
+
+    // No bitrate, no more schedule: the remaining section is continuously packetized.
+    pzer.setBitRate(0);
+    TSUNIT_EQUAL(0x810, next());
+    TSUNIT_EQUAL(0x810, next());
+}
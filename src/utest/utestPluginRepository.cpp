@@ -13,6 +13,8 @@
 #include "tsPluginRepository.h"
 #include "tsNullReport.h"
 #include "tsCerrReport.h"
+#include "tsFileUtils.h"
+#include "tsEnvironment.h"
 #include "tsunit.h"
 
 
@@ -25,6 +27,7 @@ class PluginRepositoryTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(Registrations);
     TSUNIT_DECLARE_TEST(Embedded);
     TSUNIT_DECLARE_TEST(Loaded);
+    TSUNIT_DECLARE_TEST(ListPlugins);
 };
 
 TSUNIT_REGISTER(PluginRepositoryTest);
@@ -86,3 +89,45 @@ TSUNIT_DEFINE_TEST(Loaded)
     TSUNIT_ASSERT(repo.getOutput(u"merge", report) == nullptr);
     TSUNIT_ASSERT(repo.getProcessor(u"merge", report) != nullptr);
 }
+
+TSUNIT_DEFINE_TEST(ListPlugins)
+{
+    ts::Report& report(debugMode() ? *static_cast<ts::Report*>(&CERR) : *static_cast<ts::Report*>(&NULLREP));
+    ts::PluginRepository& repo(ts::PluginRepository::Instance());
+
+    // The plugin index is in the user's home directory. Use a temporary one, do not pollute the real one.
+#if defined(TS_WINDOWS)
+    const ts::UString home_var(u"APPDATA");
+#else
+    const ts::UString home_var(u"HOME");
+#endif
+    const bool home_exists = ts::EnvironmentExists(home_var);
+    const ts::UString home_saved(ts::GetEnvironment(home_var));
+    const fs::path home(ts::TempFile(u""));
+    TSUNIT_ASSERT(fs::create_directories(home));
+    TSUNIT_ASSERT(ts::SetEnvironment(home_var, home));
+
+    // Embedded plugins and plugins from shared libraries, either from the plugin index or loaded.
+    const int flags = ts::PluginRepository::LIST_PACKET | ts::PluginRepository::LIST_NAMES;
+    const ts::UString list(repo.listPlugins(true, report, flags));
+    ts::UStringVector names;
+    list.split(names, u'\n', true, true);
+    debug() << "PluginRepositoryTest::ListPlugins: " << ts::UString::Join(names) << std::endl;
+
+    TSUNIT_ASSERT(ts::UString(u"file").isContainedSimilarIn(names));
+    TSUNIT_ASSERT(ts::UString(u"analyze").isContainedSimilarIn(names));
+    TSUNIT_ASSERT(ts::UString(u"merge").isContainedSimilarIn(names));
+    TSUNIT_ASSERT(!ts::UString(u"drop").isContainedSimilarIn(names));
+
+    // The second list uses the plugin index.
+    TSUNIT_EQUAL(list, repo.listPlugins(true, report, flags));
+
+    // Restore the home directory.
+    if (home_exists) {
+        ts::SetEnvironment(home_var, home_saved);
+    }
+    else {
+        ts::DeleteEnvironment(home_var);
+    }
+    fs::remove_all(home, &ts::ErrCodeReport());
+}
@@ -21,6 +21,7 @@
 class ResidentBufferTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(ResidentBuffer);
+    TSUNIT_DECLARE_TEST(HugePages);
 };
 
 TSUNIT_REGISTER(ResidentBufferTest);
@@ -54,3 +55,24 @@ TSUNIT_DEFINE_TEST(ResidentBuffer)
 
     TSUNIT_ASSERT(buf.count() >= buf_size);
 }
+
+TSUNIT_DEFINE_TEST(HugePages)
+{
+    // Huge pages and NUMA placement are only hints, the buffer must be usable in all cases.
+    const size_t buf_size = 3 * 1024 * 1024 + 100;
+    const size_t node = ts::SysInfo::Instance().cpuNUMANode(ts::SysInfo::CurrentCPU());
+
+    ts::ResidentBuffer<uint32_t> buf(buf_size, true, node == ts::NPOS ? 0 : int(node));
+
+    debug() << "ResidentBufferTest: isLocked() = " << buf.isLocked() << ", isHugePages() = " << buf.isHugePages()
+            << ", numaNode() = " << buf.numaNode() << ", NUMA nodes: " << ts::SysInfo::Instance().numaNodeCount()
+            << ", count() = " << buf.count() << std::endl;
+
+    TSUNIT_ASSERT(buf.base() != nullptr);
+    TSUNIT_EQUAL(buf_size, buf.count());
+    TSUNIT_EQUAL(0, size_t(buf.base()) % ts::SysInfo::Instance().memoryPageSize());
+    for (size_t i = 0; i < buf.count(); ++i) {
+        buf.base()[i] = uint32_t(i);
+    }
+    TSUNIT_EQUAL(buf_size - 1, buf.base()[buf_size - 1]);
+}
@@ -11,6 +11,8 @@
 //----------------------------------------------------------------------------
 
 #include "tsDVBCSA2.h"
+#include "tsTSScrambling.h"
+#include "tsNullReport.h"
 #include "tsTSPacket.h"
 #include "tsNames.h"
 #include "tsunit.h"
@@ -23,6 +25,7 @@
 class ScramblingTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(Scrambling);
+    TSUNIT_DECLARE_TEST(MultiplePackets);
 };
 
 TSUNIT_REGISTER(ScramblingTest);
@@ -166,3 +169,38 @@ TSUNIT_DEFINE_TEST(Scrambling)
         TSUNIT_EQUAL(0, ts::MemCompare(pkt.b + header_size, vec->cipher.b + header_size, payload_size));
     }
 }
+
+TSUNIT_DEFINE_TEST(MultiplePackets)
+{
+    // Descramble and scramble batches of identical packets, with clear packets in the middle.
+    constexpr size_t count = 100;
+    const ScramblingTestVector* vec = scrambling_test_vectors;
+    const size_t vec_count = sizeof(scrambling_test_vectors) / sizeof(ScramblingTestVector);
+
+    for (size_t ti = 0; ti < vec_count; ++ti, ++vec) {
+
+        ts::TSScrambling scrambling(NULLREP, ts::SCRAMBLING_DVB_CSA2);
+        TSUNIT_ASSERT(scrambling.setCW(ts::ByteBlock(vec->cw_even, sizeof(vec->cw_even)), ts::SC_EVEN_KEY));
+        TSUNIT_ASSERT(scrambling.setCW(ts::ByteBlock(vec->cw_odd, sizeof(vec->cw_odd)), ts::SC_ODD_KEY));
+
+        ts::TSPacketVector packets(count);
+        std::vector<ts::TSPacket*> addresses(count);
+        for (size_t i = 0; i < count; ++i) {
+            packets[i] = i % 10 == 5 ? ts::NullPacket : vec->cipher;
+            addresses[i] = &packets[i];
+        }
+
+        TSUNIT_ASSERT(scrambling.decrypt(addresses.data(), count));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_ASSERT(packets[i] == (i % 10 == 5 ? ts::NullPacket : vec->plain));
+        }
+
+        // Clear packets are scrambled as well by encrypt(), exclude them.
+        std::erase_if(addresses, [](const ts::TSPacket* pkt) { return *pkt == ts::NullPacket; });
+        TSUNIT_ASSERT(scrambling.setEncryptParity(vec->cipher.getScrambling()));
+        TSUNIT_ASSERT(scrambling.encrypt(addresses.data(), addresses.size()));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_ASSERT(packets[i] == (i % 10 == 5 ? ts::NullPacket : vec->cipher));
+        }
+    }
+}
@@ -50,9 +50,11 @@ class SysUtilsTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(SearchWildcard);
     TSUNIT_DECLARE_TEST(HomeDirectory);
     TSUNIT_DECLARE_TEST(ProcessCpuTime);
+    TSUNIT_DECLARE_TEST(ThreadCpuTime);
     TSUNIT_DECLARE_TEST(ProcessVirtualSize);
     TSUNIT_DECLARE_TEST(IsTerminal);
     TSUNIT_DECLARE_TEST(SysInfo);
+    TSUNIT_DECLARE_TEST(CPUList);
     TSUNIT_DECLARE_TEST(IsAbsoluteFilePath);
     TSUNIT_DECLARE_TEST(AbsoluteFilePath);
     TSUNIT_DECLARE_TEST(CleanupFilePath);
@@ -600,6 +602,23 @@ TSUNIT_DEFINE_TEST(ProcessCpuTime)
     TSUNIT_ASSERT(t2 >= t1);
 }
 
+TSUNIT_DEFINE_TEST(ThreadCpuTime)
+{
+    const cn::microseconds t1 = ts::GetThreadCpuTime();
+    debug() << "SysUtilsTest: thread CPU time (1) = " << ts::UString::Chrono(t1) << std::endl;
+    TSUNIT_ASSERT(t1.count() >= 0);
+
+    // Consume some milliseconds of CPU time
+    volatile uint64_t counter = 7;
+    for (uint64_t i = 0; i < 10000000L; ++i) {
+        counter = counter * counter;
+    }
+
+    const cn::microseconds t2 = ts::GetThreadCpuTime();
+    debug() << "SysUtilsTest: thread CPU time (2) = " << ts::UString::Chrono(t2) << std::endl;
+    TSUNIT_ASSERT(t2 >= t1);
+}
+
 TSUNIT_DEFINE_TEST(ProcessVirtualSize)
 {
     const size_t m1 = ts::GetProcessVirtualSize();
@@ -691,6 +710,32 @@ TSUNIT_DEFINE_TEST(SysInfo)
     TSUNIT_ASSERT(ts::SysInfo::Instance().memoryPageSize() % 256 == 0);
 }
 
+TSUNIT_DEFINE_TEST(CPUList)
+{
+    std::set<size_t> cpus;
+    TSUNIT_ASSERT(ts::SysInfo::DecodeCPUList(cpus, u"0-3,8, 10-11"));
+    TSUNIT_EQUAL(7, cpus.size());
+    TSUNIT_ASSERT(cpus.contains(2));
+    TSUNIT_ASSERT(!cpus.contains(9));
+    TSUNIT_EQUAL(u"0-3,8,10-11", ts::SysInfo::FormatCPUList(cpus));
+
+    TSUNIT_ASSERT(!ts::SysInfo::DecodeCPUList(cpus, u"0-3,x"));
+    TSUNIT_ASSERT(!ts::SysInfo::DecodeCPUList(cpus, u"4-2"));
+    TSUNIT_ASSERT(!ts::SysInfo::DecodeCPUList(cpus, u"0-18446744073709551615"));
+    TSUNIT_ASSERT(!ts::SysInfo::DecodeCPUList(cpus, ts::UString::Format(u"%d", ts::SysInfo::MAX_CPUS)));
+    TSUNIT_ASSERT(ts::SysInfo::DecodeCPUList(cpus, ts::UString::Format(u"0-%d", ts::SysInfo::MAX_CPUS - 1)));
+    TSUNIT_EQUAL(ts::SysInfo::MAX_CPUS, cpus.size());
+    TSUNIT_EQUAL(u"", ts::SysInfo::FormatCPUList(std::set<size_t>()));
+
+    // There is always at least one NUMA node with some CPU's.
+    const ts::SysInfo& sys(ts::SysInfo::Instance());
+    TSUNIT_ASSERT(sys.numaNodeCount() > 0);
+    TSUNIT_ASSERT(!sys.numaNodeCPUs(0).empty());
+    TSUNIT_ASSERT(sys.numaNodeCPUs(sys.numaNodeCount()).empty());
+    const size_t cpu = *sys.numaNodeCPUs(0).begin();
+    TSUNIT_EQUAL(0, sys.cpuNUMANode(cpu));
+}
+
 TSUNIT_DEFINE_TEST(IsAbsoluteFilePath)
 {
 #if defined(TS_WINDOWS)
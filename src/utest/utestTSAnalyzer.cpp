@@ -0,0 +1,262 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::TSAnalyzer.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSAnalyzer.h"
+#include "tsOneShotPacketizer.h"
+#include "tsDuckContext.h"
+#include "tsTSFile.h"
+#include "tsSysUtils.h"
+#include "tsEnvironment.h"
+#include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSAnalyzerTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Counters);
+    TSUNIT_DECLARE_TEST(Benchmark);
+
+private:
+    static constexpr uint16_t SERVICE_ID = 0x0101;
+    static constexpr ts::PID PMT_PID = 0x0100;
+    static constexpr ts::PID VIDEO_PID = 0x0101;
+    static constexpr ts::PID AUDIO_PID = 0x0102;
+    static constexpr ts::PID SCRAMBLED_PID = 0x0103;
+
+    // Build a reference transport stream.
+    static void BuildStream(ts::DuckContext& duck, ts::TSPacketVector& packets, size_t count);
+};
+
+TSUNIT_REGISTER(TSAnalyzerTest);
+
+namespace {
+    // A subclass which gives access to the analysis results.
+    class Analyzer: public ts::TSAnalyzer
+    {
+        TS_NOBUILD_NOCOPY(Analyzer);
+    public:
+        Analyzer(ts::DuckContext& duck) : ts::TSAnalyzer(duck) {}
+
+        // Get a PID context after recomputing the statistics, null if the PID does not exist.
+        const PIDContext* pid(ts::PID pid)
+        {
+            recomputeStatistics();
+            const auto it = _pids.find(pid);
+            return it == _pids.end() ? nullptr : it->second.get();
+        }
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Build a reference transport stream: one service with video, audio and a
+// scrambled PID, PAT and PMT every 100 packets, PCR every 20 packets.
+//----------------------------------------------------------------------------
+
+void TSAnalyzerTest::BuildStream(ts::DuckContext& duck, ts::TSPacketVector& packets, size_t count)
+{
+    ts::PAT pat(0, true, 0x1234);
+    pat.pmts[SERVICE_ID] = PMT_PID;
+    ts::PMT pmt(0, true, SERVICE_ID, VIDEO_PID);
+    pmt.streams[VIDEO_PID].stream_type = ts::ST_AVC_VIDEO;
+    pmt.streams[AUDIO_PID].stream_type = ts::ST_MPEG2_AUDIO;
+    pmt.streams[SCRAMBLED_PID].stream_type = ts::ST_PES_PRIV;
+
+    ts::BinaryTable bin_pat, bin_pmt;
+    TSUNIT_ASSERT(pat.serialize(duck, bin_pat));
+    TSUNIT_ASSERT(pmt.serialize(duck, bin_pmt));
+    ts::TSPacketVector psi_pat, psi_pmt;
+    ts::OneShotPacketizer pzer_pat(duck, ts::PID_PAT, true);
+    ts::OneShotPacketizer pzer_pmt(duck, PMT_PID, true);
+
+    packets.clear();
+    packets.reserve(count);
+    uint8_t video_cc = 0, audio_cc = 0, scr_cc = 0;
+    uint64_t pcr = 0;
+
+    while (packets.size() < count) {
+        const size_t index = packets.size();
+        if (index % 100 == 0) {
+            pzer_pat.addTable(bin_pat);
+            pzer_pat.getPackets(psi_pat);
+            pzer_pmt.addTable(bin_pmt);
+            pzer_pmt.getPackets(psi_pmt);
+            packets.insert(packets.end(), psi_pat.begin(), psi_pat.end());
+            packets.insert(packets.end(), psi_pmt.begin(), psi_pmt.end());
+        }
+        else if (index % 10 < 6) {
+            // Video packets, PES start every 50 packets, PCR every 20 packets.
+            ts::TSPacket& pkt(packets.emplace_back());
+            pkt.init(VIDEO_PID, video_cc, uint8_t(index));
+            video_cc = (video_cc + 1) & ts::CC_MASK;
+            if (index % 50 == 1) {
+                pkt.setPUSI();
+                pkt.b[4] = 0x00; pkt.b[5] = 0x00; pkt.b[6] = 0x01; pkt.b[7] = 0xE0;
+            }
+            if (index % 20 == 1) {
+                pkt.setPCR(pcr, true);
+                pcr += 20 * ts::PKT_SIZE_BITS * ts::SYSTEM_CLOCK_FREQ / 10'000'000; // 10 Mb/s
+            }
+        }
+        else if (index % 10 < 8) {
+            ts::TSPacket& pkt(packets.emplace_back());
+            pkt.init(AUDIO_PID, audio_cc, uint8_t(index));
+            audio_cc = (audio_cc + 1) & ts::CC_MASK;
+            if (index % 50 == 6) {
+                pkt.setPUSI();
+                pkt.b[4] = 0x00; pkt.b[5] = 0x00; pkt.b[6] = 0x01; pkt.b[7] = 0xC0;
+            }
+        }
+        else if (index % 10 == 8) {
+            ts::TSPacket& pkt(packets.emplace_back());
+            pkt.init(SCRAMBLED_PID, scr_cc, uint8_t(index));
+            pkt.setScrambling(index % 1000 < 500 ? ts::SC_EVEN_KEY : ts::SC_ODD_KEY);
+            scr_cc = (scr_cc + 1) & ts::CC_MASK;
+        }
+        else {
+            packets.push_back(ts::NullPacket);
+        }
+    }
+    packets.resize(count);
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(Counters)
+{
+    ts::DuckContext duck;
+    ts::TSPacketVector packets;
+    BuildStream(duck, packets, 10'000);
+
+    // Introduce one discontinuity in the audio PID.
+    size_t audio_index = 0;
+    for (size_t i = packets.size() / 2; audio_index == 0 && i < packets.size(); ++i) {
+        if (packets[i].getPID() == AUDIO_PID) {
+            audio_index = i;
+        }
+    }
+    TSUNIT_ASSERT(audio_index > 0);
+    packets.erase(packets.begin() + audio_index);
+
+    // Count the expected packets per PID in the reference stream.
+    struct Expected {
+        uint64_t packets = 0;
+        uint64_t unit_start = 0;
+        uint64_t pcr = 0;
+        uint64_t cryptop = 0;
+        uint8_t  sc = ts::SC_CLEAR;
+    };
+    std::map<ts::PID, Expected> expected;
+    for (const auto& pkt : packets) {
+        Expected& exp(expected[pkt.getPID()]);
+        exp.packets++;
+        exp.unit_start += pkt.getPUSI();
+        exp.pcr += pkt.hasPCR();
+        if (pkt.getScrambling() != exp.sc) {
+            exp.cryptop += exp.sc != ts::SC_CLEAR;
+            exp.sc = pkt.getScrambling();
+        }
+    }
+
+    Analyzer analyzer(duck);
+    const ts::TSPacketMetadata mdata;
+    for (const auto& pkt : packets) {
+        analyzer.feedPacket(pkt, mdata);
+    }
+
+    std::vector<ts::PID> pids;
+    analyzer.getPIDs(pids);
+    TSUNIT_EQUAL(expected.size(), pids.size());
+
+    for (const auto& it : expected) {
+        const auto* pc = analyzer.pid(it.first);
+        TSUNIT_ASSERT(pc != nullptr);
+        debug() << ts::UString::Format(u"TSAnalyzerTest::testCounters: PID %n, %d packets, %d unit start, %d scrambled", it.first, pc->ts_pkt_cnt, pc->unit_start_cnt, pc->ts_sc_cnt) << std::endl;
+        TSUNIT_EQUAL(it.second.packets, pc->ts_pkt_cnt);
+        TSUNIT_EQUAL(it.second.unit_start, pc->unit_start_cnt);
+        TSUNIT_EQUAL(it.second.pcr, pc->pcr_cnt);
+        TSUNIT_EQUAL(it.second.cryptop, pc->cryptop_cnt);
+        TSUNIT_EQUAL(0, pc->inv_ts_sc_cnt);
+        TSUNIT_EQUAL(0, pc->duplicated);
+    }
+
+    const auto* video = analyzer.pid(VIDEO_PID);
+    TSUNIT_ASSERT(video->referenced);
+    TSUNIT_ASSERT(video->services.contains(SERVICE_ID));
+    TSUNIT_EQUAL(0, video->unexp_discont);
+    TSUNIT_ASSERT(video->pcr_cnt > 0);
+    TSUNIT_ASSERT(!video->scrambled);
+
+    const auto* audio = analyzer.pid(AUDIO_PID);
+    TSUNIT_EQUAL(1, audio->unexp_discont);
+
+    const auto* scrambled = analyzer.pid(SCRAMBLED_PID);
+    TSUNIT_ASSERT(scrambled->scrambled);
+    TSUNIT_EQUAL(scrambled->ts_pkt_cnt, scrambled->ts_sc_cnt);
+    TSUNIT_ASSERT(scrambled->cryptop_cnt > 1);
+
+    // After reset, all PID's are gone.
+    analyzer.reset();
+    TSUNIT_ASSERT(analyzer.pid(VIDEO_PID) == nullptr);
+    analyzer.getPIDs(pids);
+    TSUNIT_ASSERT(pids.empty());
+}
+
+// Measure the analysis throughput in packets/second. By default, use the reference
+// stream. If TSUNIT_TSANALYZER_FILE is defined, use the content of this TS file.
+TSUNIT_DEFINE_TEST(Benchmark)
+{
+    ts::DuckContext duck;
+    ts::TSPacketVector packets;
+    const ts::UString file_name(ts::GetEnvironment(u"TSUNIT_TSANALYZER_FILE"));
+
+    if (file_name.empty()) {
+        BuildStream(duck, packets, 100'000);
+    }
+    else {
+        ts::TSFile file;
+        TSUNIT_ASSERT(file.openRead(file_name, 1, 0, CERR));
+        ts::TSPacket pkt;
+        while (file.readPackets(&pkt, nullptr, 1, CERR) == 1) {
+            packets.push_back(pkt);
+        }
+        file.close(CERR);
+    }
+    TSUNIT_ASSERT(!packets.empty());
+
+    utest::TSUnitBenchmark bench(u"TSUNIT_TSANALYZER_ITERATIONS");
+    Analyzer analyzer(duck);
+    const ts::TSPacketMetadata mdata;
+    const cn::milliseconds start = ts::GetProcessCpuTime();
+    bench.start();
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        analyzer.reset();
+        for (const auto& pkt : packets) {
+            analyzer.feedPacket(pkt, mdata);
+        }
+    }
+    bench.stop();
+    const cn::milliseconds duration = ts::GetProcessCpuTime() - start;
+
+    bench.report(ts::UString::Format(u"TSAnalyzerTest::testBenchmark, %'d packets", packets.size()));
+    if (duration > cn::milliseconds::zero()) {
+        debug() << ts::UString::Format(u"TSAnalyzerTest::testBenchmark: %'d packets/s", (packets.size() * bench.iterations * 1000) / size_t(duration.count())) << std::endl;
+    }
+    TSUNIT_ASSERT(analyzer.pid(VIDEO_PID) != nullptr || !file_name.empty());
+}
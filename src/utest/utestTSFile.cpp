@@ -18,6 +18,13 @@
 #include "tsErrCodeReport.h"
 #include "tsunit.h"
 
+#if defined(TS_UNIX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <sys/types.h>
+    #include <sys/stat.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
+
 
 //----------------------------------------------------------------------------
 // The test fixture
@@ -28,8 +35,12 @@ class TSFileTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(TS);
     TSUNIT_DECLARE_TEST(M2TS);
     TSUNIT_DECLARE_TEST(Duck);
+    TSUNIT_DECLARE_TEST(BulkRead);
     TSUNIT_DECLARE_TEST(StuffingRead);
     TSUNIT_DECLARE_TEST(StuffingWrite);
+    TSUNIT_DECLARE_TEST(ReadMode);
+    TSUNIT_DECLARE_TEST(WriteBehind);
+    TSUNIT_DECLARE_TEST(WriteBehindStalled);
 
 public:
     virtual void beforeTest() override;
@@ -37,6 +48,10 @@ public:
 
 private:
     fs::path _tempFileName {};
+
+    void testBulkRead(ts::TSPacketFormat format);
+    void testReadMode(ts::TSFile::ReadMode mode, size_t packet_count);
+    void testWriteBehind(ts::TSFile::WriteOverflow overflow, bool direct_io, uint64_t preallocate, ts::TSPacketFormat format);
 };
 
 TSUNIT_REGISTER(TSFileTest);
@@ -240,6 +255,57 @@ TSUNIT_DEFINE_TEST(Duck)
     TSUNIT_ASSERT(file.close(CERR));
 }
 
+TSUNIT_DEFINE_TEST(BulkRead)
+{
+    testBulkRead(ts::TSPacketFormat::M2TS);
+    testBulkRead(ts::TSPacketFormat::RS204);
+    testBulkRead(ts::TSPacketFormat::DUCK);
+}
+
+void TSFileTest::testBulkRead(ts::TSPacketFormat format)
+{
+    debug() << "TSFileTest::testBulkRead: format: " << ts::TSPacketFormatEnum().name(int(format)) << std::endl;
+
+    fs::remove(_tempFileName, &ts::ErrCodeReport());
+    ts::TSFile file;
+    ts::TSPacketVector packets(20);
+    ts::TSPacketMetadataVector mdata(packets.size());
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i] = ts::NullPacket;
+        packets[i].setPID(ts::PID(100 + i));
+        mdata[i].setInputTimeStamp(ts::PCR(10 * i), ts::TimeSource::UNDEFINED);
+        mdata[i].setAuxData(packets[i].b + 1, 2);
+    }
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR, format));
+    TSUNIT_ASSERT(file.writePackets(packets.data(), mdata.data(), packets.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+
+    // First packet is read alone for format detection, then bulk read of encapsulated
+    // packets, then one last packet which does not fit in the buffer as a complete frame.
+    ts::TSPacketVector inpackets(packets.size() + 5);
+    ts::TSPacketMetadataVector inmdata(inpackets.size());
+    TSUNIT_ASSERT(file.openRead(_tempFileName, 0, CERR));
+    TSUNIT_EQUAL(packets.size(), file.readPackets(inpackets.data(), inmdata.data(), packets.size(), CERR));
+    TSUNIT_EQUAL(format, file.packetFormat());
+    TSUNIT_EQUAL(0, file.readPackets(inpackets.data(), inmdata.data(), inpackets.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+
+    for (size_t i = 0; i < packets.size(); ++i) {
+        TSUNIT_ASSERT(inpackets[i] == packets[i]);
+        if (format == ts::TSPacketFormat::RS204) {
+            uint8_t aux[ts::RS_SIZE];
+            TSUNIT_EQUAL(ts::RS_SIZE, inmdata[i].getAuxData(aux, sizeof(aux)));
+            TSUNIT_EQUAL(packets[i].b[1], aux[0]);
+            TSUNIT_EQUAL(packets[i].b[2], aux[1]);
+            TSUNIT_EQUAL(0xFF, aux[2]);
+        }
+        else {
+            TSUNIT_ASSERT(inmdata[i].hasInputTimeStamp());
+            TSUNIT_EQUAL(10 * i, size_t(inmdata[i].getInputTimeStamp().count()));
+        }
+    }
+}
+
 TSUNIT_DEFINE_TEST(StuffingRead)
 {
     ts::TSFile file;
@@ -358,3 +424,206 @@ TSUNIT_DEFINE_TEST(StuffingWrite)
     TSUNIT_EQUAL(184, packets[5].getPayloadSize());
     TSUNIT_EQUAL(0xFF, packets[5].getPayload()[0]);
 }
+
+TSUNIT_DEFINE_TEST(ReadMode)
+{
+    // Large enough to use several read-ahead chunks.
+    const size_t packet_count = 12000;
+    ts::TSFile file;
+    ts::TSPacketVector packets(packet_count);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i] = ts::NullPacket;
+        packets[i].setPID(ts::PID(i % ts::PID_MAX));
+    }
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR));
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, packets.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+
+    testReadMode(ts::TSFile::ReadMode::STANDARD, packet_count);
+    testReadMode(ts::TSFile::ReadMode::MMAP, packet_count);
+    testReadMode(ts::TSFile::ReadMode::ASYNC, packet_count);
+}
+
+void TSFileTest::testReadMode(ts::TSFile::ReadMode mode, size_t packet_count)
+{
+    ts::TSFile file;
+    ts::TSPacketVector packets(1000);
+    const size_t offset = 10;
+    const size_t repeat = 2;
+
+    // Read with start offset and repetition. Use odd read sizes to cross chunk boundaries.
+    file.setReadMode(mode);
+    TSUNIT_ASSERT(file.openRead(_tempFileName, repeat, offset * ts::PKT_SIZE, CERR));
+    debug() << "TSFileTest::testReadMode: requested " << ts::TSFile::ReadModeEnum().name(mode)
+            << ", actual " << ts::TSFile::ReadModeEnum().name(file.getReadMode()) << std::endl;
+    size_t index = offset;
+    size_t total = 0;
+    size_t count = 0;
+    while ((count = file.readPackets(packets.data(), nullptr, 777, CERR)) > 0) {
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_EQUAL(index % ts::PID_MAX, packets[i].getPID());
+            if (++index >= packet_count) {
+                index = offset;
+            }
+        }
+        total += count;
+    }
+    TSUNIT_EQUAL(repeat * (packet_count - offset), total);
+    TSUNIT_ASSERT(file.close(CERR));
+
+    // Rewindable read, seek to arbitrary positions.
+    file.setReadMode(mode);
+    TSUNIT_ASSERT(file.openRead(_tempFileName, 0, CERR));
+    TSUNIT_ASSERT(file.seek(packet_count - 5, CERR));
+    TSUNIT_EQUAL(5, file.readPackets(packets.data(), nullptr, packets.size(), CERR));
+    TSUNIT_EQUAL((packet_count - 5) % ts::PID_MAX, packets[0].getPID());
+    TSUNIT_ASSERT(file.seek(6000, CERR));
+    TSUNIT_EQUAL(packets.size(), file.readPackets(packets.data(), nullptr, packets.size(), CERR));
+    TSUNIT_EQUAL(6000 % ts::PID_MAX, packets[0].getPID());
+    TSUNIT_EQUAL(6999 % ts::PID_MAX, packets[999].getPID());
+    TSUNIT_ASSERT(file.close(CERR));
+}
+
+TSUNIT_DEFINE_TEST(WriteBehind)
+{
+    testWriteBehind(ts::TSFile::WriteOverflow::WAIT, false, 0, ts::TSPacketFormat::TS);
+    testWriteBehind(ts::TSFile::WriteOverflow::WAIT, true, 5'000'000, ts::TSPacketFormat::TS);
+    testWriteBehind(ts::TSFile::WriteOverflow::WAIT, true, 0, ts::TSPacketFormat::M2TS);
+    testWriteBehind(ts::TSFile::WriteOverflow::DROP, false, 0, ts::TSPacketFormat::TS);
+}
+
+void TSFileTest::testWriteBehind(ts::TSFile::WriteOverflow overflow, bool direct_io, uint64_t preallocate, ts::TSPacketFormat format)
+{
+    // Large enough to use several write-behind buffers.
+    const size_t packet_count = 12000;
+    const size_t group = 777;
+    ts::TSFile file;
+    ts::TSPacketVector packets(packet_count);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i] = ts::NullPacket;
+        packets[i].setPID(ts::PID(i % ts::PID_MAX));
+    }
+
+    // Use odd write sizes to cross buffer boundaries.
+    fs::remove(_tempFileName, &ts::ErrCodeReport());
+    file.setStuffing(3, 2);
+    file.setWriteBehind(2'000'000, overflow, direct_io, preallocate);
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR, format));
+#if defined(TS_UNIX)
+    TSUNIT_ASSERT(file.isWriteBehind());
+#endif
+    for (size_t i = 0; i < packet_count; i += group) {
+        TSUNIT_ASSERT(file.writePackets(&packets[i], nullptr, std::min(group, packet_count - i), CERR));
+    }
+    TSUNIT_ASSERT(file.close(CERR));
+    TSUNIT_ASSERT(!file.isWriteBehind());
+    const size_t written = size_t(file.writePacketsCount());
+    debug() << "TSFileTest::testWriteBehind: overflow: " << ts::TSFile::WriteOverflowEnum().name(overflow)
+            << ", written: " << written << ", dropped: " << file.writeDroppedCount() << std::endl;
+    TSUNIT_EQUAL(5 + packet_count, written + file.writeDroppedCount());
+    if (overflow == ts::TSFile::WriteOverflow::WAIT) {
+        TSUNIT_EQUAL(0, file.writeDroppedCount());
+    }
+
+    // The preallocated space is not part of the file size.
+    const size_t pkt_size = format == ts::TSPacketFormat::M2TS ? ts::PKT_M2TS_SIZE : ts::PKT_SIZE;
+    TSUNIT_EQUAL(written * pkt_size, fs::file_size(_tempFileName, &ts::ErrCodeReport(CERR)));
+
+    // Read the file back, without the stuffing.
+    ts::TSPacketVector input(packet_count);
+    file.setStuffing(0, 0);
+    TSUNIT_ASSERT(file.openRead(_tempFileName, 3 * pkt_size, CERR, format));
+    const size_t count = file.readPackets(input.data(), nullptr, input.size(), CERR);
+    TSUNIT_ASSERT(file.close(CERR));
+    if (overflow == ts::TSFile::WriteOverflow::WAIT) {
+        TSUNIT_EQUAL(packet_count, count);
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_EQUAL(i % ts::PID_MAX, input[i].getPID());
+        }
+    }
+}
+
+TSUNIT_DEFINE_TEST(WriteBehindStalled)
+{
+#if defined(TS_UNIX)
+    // With the drop policy, writing packets never waits for the writer thread, even when the data
+    // exactly fill the last free buffer. The file is a named pipe which is no longer read after 45 MB.
+    // With 1 MB write-behind buffers and a queue of two buffers, 262144 packets are exactly 47 MB:
+    // the writer thread is blocked on the 46th buffer when the application fills the 47th one.
+    const size_t total = 262144;
+    const size_t group = 1000;
+    const size_t read_max = 45 * 1024 * 1024;
+
+    fs::remove(_tempFileName, &ts::ErrCodeReport());
+    TSUNIT_ASSERT(::mkfifo(_tempFileName.c_str(), 0600) == 0);
+    const int fd = ::open(_tempFileName.c_str(), O_RDONLY | O_NONBLOCK);
+    TSUNIT_ASSERT(fd >= 0);
+
+    ts::TSFile file;
+    file.setWriteBehind(2 * 1024 * 1024, ts::TSFile::WriteOverflow::DROP);
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR));
+    TSUNIT_ASSERT(file.isWriteBehind());
+    TSUNIT_ASSERT(::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_NONBLOCK) == 0);
+
+    // The reader thread stalls after 45 MB, until the end of the test or a timeout.
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool resume = false;
+    size_t read_size = 0;
+    std::thread reader([&]() {
+        std::vector<uint8_t> buffer(64 * 1024);
+        bool stalled = false;
+        for (;;) {
+            if (!stalled && read_size >= read_max) {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait_for(lock, cn::seconds(5), [&]() { return resume; });
+                stalled = true;
+            }
+            const ssize_t size = ::read(fd, buffer.data(), stalled ? buffer.size() : std::min(buffer.size(), read_max - read_size));
+            if (size > 0) {
+                read_size += size_t(size);
+            }
+            else if (size == 0 || errno != EINTR) {
+                break;
+            }
+        }
+    });
+
+    // Retry dropped groups until all packets are queued. No write shall wait.
+    ts::TSPacketVector packets(group, ts::NullPacket);
+    bool success = true;
+    size_t written = 0;
+    cn::milliseconds max_duration(0);
+    while (success && written < total) {
+        const size_t count = std::min(group, total - written);
+        const ts::PacketCounter dropped = file.writeDroppedCount();
+        const ts::Time start(ts::Time::CurrentUTC());
+        success = file.writePackets(packets.data(), nullptr, count, CERR);
+        max_duration = std::max(max_duration, cn::milliseconds(ts::Time::CurrentUTC() - start));
+        if (file.writeDroppedCount() == dropped) {
+            written += count;
+        }
+        else {
+            std::this_thread::sleep_for(cn::milliseconds(1));
+        }
+    }
+
+    // Resume reading, flush the file.
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        resume = true;
+        cond.notify_one();
+    }
+    const bool closed = file.close(CERR);
+    reader.join();
+    ::close(fd);
+
+    debug() << "TSFileTest::WriteBehindStalled: max write duration: " << ts::UString::Chrono(max_duration)
+            << ", dropped: " << file.writeDroppedCount() << std::endl;
+    TSUNIT_ASSERT(success);
+    TSUNIT_ASSERT(closed);
+    TSUNIT_ASSERT(max_duration < cn::seconds(2));
+    TSUNIT_EQUAL(total, file.writePacketsCount());
+    TSUNIT_EQUAL(total * ts::PKT_SIZE, read_size);
+#endif
+}
@@ -32,6 +32,7 @@ class TSPacketTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(PrivateData);
     TSUNIT_DECLARE_TEST(BitRate);
     TSUNIT_DECLARE_TEST(PCR);
+    TSUNIT_DECLARE_TEST(FindSync);
 };
 
 TSUNIT_REGISTER(TSPacketTest);
@@ -524,3 +525,39 @@ TSUNIT_DEFINE_TEST(PCR)
     TSUNIT_EQUAL(ts::PCR_SCALE - 90, ts::AddPCR(10, -100));
     TSUNIT_EQUAL(ts::INVALID_PCR, ts::AddPCR(ts::PCR_SCALE, 100));
 }
+
+TSUNIT_DEFINE_TEST(FindSync)
+{
+    // Garbage, then 30 M2TS packets, then garbage. Make sure that the garbage contains
+    // some sync bytes at the 188 and 192 periods, but not for too long.
+    ts::ByteBlock buf(10000, 0x00);
+    for (size_t i = 0; i < buf.size(); ++i) {
+        buf[i] = uint8_t(i * 7 + i / 13);
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        buf[30 + i * 188] = ts::SYNC_BYTE;
+        buf[31 + i * 192] = ts::SYNC_BYTE;
+    }
+    const size_t start = 1003;
+    for (size_t i = 0; i < 30; ++i) {
+        buf[start + i * ts::PKT_M2TS_SIZE + ts::M2TS_HEADER_SIZE] = ts::SYNC_BYTE;
+    }
+
+    TSUNIT_EQUAL(ts::NPOS, ts::TSPacket::FindSync(nullptr, 0));
+    TSUNIT_EQUAL(ts::NPOS, ts::TSPacket::FindSync(buf.data(), 100));
+    TSUNIT_EQUAL(ts::NPOS, ts::TSPacket::FindSync(buf.data(), buf.size(), ts::PKT_SIZE, 0, 10));
+    TSUNIT_EQUAL(30, ts::TSPacket::FindSync(buf.data(), buf.size(), ts::PKT_SIZE, 0, 4));
+    TSUNIT_EQUAL(27, ts::TSPacket::FindSync(buf.data(), buf.size(), ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE, 4));
+    TSUNIT_EQUAL(start, ts::TSPacket::FindSync(buf.data(), buf.size(), ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE, 5));
+    TSUNIT_EQUAL(start, ts::TSPacket::FindSync(buf.data(), buf.size(), ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE, 30));
+    TSUNIT_EQUAL(ts::NPOS, ts::TSPacket::FindSync(buf.data(), buf.size(), ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE, 31));
+
+    // All packets must fit in the buffer, at any position in the vector or scalar search.
+    for (size_t size = start + 29 * ts::PKT_M2TS_SIZE; size < start + 30 * ts::PKT_M2TS_SIZE; ++size) {
+        TSUNIT_EQUAL(ts::NPOS, ts::TSPacket::FindSync(buf.data(), size, ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE, 30));
+    }
+    TSUNIT_EQUAL(start, ts::TSPacket::FindSync(buf.data(), start + 30 * ts::PKT_M2TS_SIZE, ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE, 30));
+    for (size_t offset = 1; offset < 40; ++offset) {
+        TSUNIT_EQUAL(start - offset, ts::TSPacket::FindSync(buf.data() + offset, start + 30 * ts::PKT_M2TS_SIZE - offset, ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE, 30));
+    }
+}
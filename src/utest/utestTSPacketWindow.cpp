@@ -21,6 +21,7 @@
 class TSPacketWindowTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(All);
+    TSUNIT_DECLARE_TEST(SelectPIDs);
 };
 
 TSUNIT_REGISTER(TSPacketWindowTest);
@@ -127,3 +128,52 @@ TSUNIT_DEFINE_TEST(All)
     TSUNIT_EQUAL(map[7], win.packetIndexInBuffer(7, packets, 10));
     TSUNIT_EQUAL(ts::NPOS, win.packetIndexInBuffer(11, packets, 10));
 }
+
+TSUNIT_DEFINE_TEST(SelectPIDs)
+{
+    // Physical buffer of 10 packets, PID 200 to 204, twice.
+    ts::TSPacket packets[10];
+    ts::TSPacketMetadata mdata[10];
+    for (size_t i = 0; i < 10; ++i) {
+        packets[i].init(ts::PID(200 + i % 5));
+    }
+
+    // Two segments: physical packets 6-9, then 0-3.
+    ts::TSPacketWindow win;
+    win.addPacketsReference(packets + 6, mdata + 6, 4);
+    win.addPacketsReference(packets, mdata, 4);
+    TSUNIT_EQUAL(8, win.size());
+    TSUNIT_EQUAL(2, win.segmentCount());
+    win.drop(2);
+
+    std::vector<ts::PID> pids;
+    win.getPIDs(pids);
+    TSUNIT_EQUAL(8, pids.size());
+    TSUNIT_EQUAL(201, pids[0]);
+    TSUNIT_EQUAL(202, pids[1]);
+    TSUNIT_EQUAL(ts::PID_MAX, pids[2]);
+    TSUNIT_EQUAL(204, pids[3]);
+    TSUNIT_EQUAL(200, pids[4]);
+    TSUNIT_EQUAL(201, pids[5]);
+    TSUNIT_EQUAL(202, pids[6]);
+    TSUNIT_EQUAL(203, pids[7]);
+
+    ts::PIDSet set;
+    set.set(201);
+    set.set(203);
+
+    std::vector<size_t> indexes;
+    TSUNIT_EQUAL(3, win.selectPIDs(indexes, set));
+    TSUNIT_EQUAL(3, indexes.size());
+    TSUNIT_EQUAL(0, indexes[0]);
+    TSUNIT_EQUAL(5, indexes[1]);
+    TSUNIT_EQUAL(7, indexes[2]);
+
+    // The dropped packet (PID 203) is never selected.
+    TSUNIT_EQUAL(4, win.selectPIDs(indexes, set, false));
+    TSUNIT_EQUAL(4, indexes.size());
+    TSUNIT_EQUAL(1, indexes[0]);
+    TSUNIT_EQUAL(3, indexes[1]);
+    TSUNIT_EQUAL(4, indexes[2]);
+    TSUNIT_EQUAL(6, indexes[3]);
+}
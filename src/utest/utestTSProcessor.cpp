@@ -12,6 +12,8 @@
 
 #include "tsTSProcessor.h"
 #include "tsPluginRepository.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
 #include "tsCerrReport.h"
 #include "tsunit.h"
 
@@ -23,6 +25,13 @@
 class TSProcessorTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(Processing);
+    TSUNIT_DECLARE_TEST(Parallel);
+    TSUNIT_DECLARE_TEST(JointTermination);
+
+private:
+    // All tests are run with the global mutex and with lock-free packet hand-off.
+    void testProcessing(bool lock_free);
+    void testParallel(bool lock_free);
 };
 
 TSUNIT_REGISTER(TSProcessorTest);
@@ -151,6 +160,7 @@ namespace {
             size_t            index;
             size_t            count;
             ts::PacketCounter packets;
+            ts::BitRate       bitrate;
         };
 
         std::vector<LogEntry> logs;
@@ -180,16 +190,149 @@ void TestEventHandler::handlePluginEvent(const ts::PluginEventContext& ctx)
         return;
     }
 
-    LogEntry log{ctx.eventCode(), data->data, ctx.pluginName(), ctx.pluginIndex(), ctx.pluginCount(), ctx.pluginPackets()};
+    LogEntry log{ctx.eventCode(), data->data, ctx.pluginName(), ctx.pluginIndex(), ctx.pluginCount(), ctx.pluginPackets(), ctx.bitrate()};
     logs.push_back(log);
 }
 
 
+//----------------------------------------------------------------------------
+// Internal packet processing plugin class for parallel processing.
+// Each packet contains a sequence number in its payload. The plugin drops
+// packets with a sequence number multiple of 7 and marks all others.
+// In per-PID mode, it checks that the packets of each PID come in order.
+//----------------------------------------------------------------------------
+
+namespace {
+    class ParallelPlugin : public ts::ProcessorPlugin
+    {
+    public:
+        ParallelPlugin(ts::TSP*);
+        virtual bool getOptions() override;
+        virtual size_t getPacketWindowSize() override;
+        virtual ParallelMode getParallelMode() override;
+        virtual size_t processPacketWindow(ts::TSPacketWindow&) override;
+        static ts::ProcessorPlugin* CreateInstance(ts::TSP*);
+
+        static constexpr uint8_t MARKER = 0xA5;
+        static std::atomic<size_t> order_errors;
+
+    private:
+        bool _per_pid = false;
+        std::array<uint32_t, ts::PID_MAX> _last_sequence {};
+    };
+
+    std::atomic<size_t> ParallelPlugin::order_errors {0};
+}
+
+ts::ProcessorPlugin* ParallelPlugin::CreateInstance(ts::TSP* t)
+{
+    return new ParallelPlugin(t);
+}
+
+ParallelPlugin::ParallelPlugin(ts::TSP* t) :
+    ts::ProcessorPlugin(t, u"Parallel test plugin", u"[options]")
+{
+    option(u"per-pid");
+}
+
+bool ParallelPlugin::getOptions()
+{
+    _per_pid = present(u"per-pid");
+    return true;
+}
+
+size_t ParallelPlugin::getPacketWindowSize()
+{
+    return 50;
+}
+
+ParallelPlugin::ParallelMode ParallelPlugin::getParallelMode()
+{
+    return _per_pid ? ParallelMode::PER_PID : ParallelMode::PER_PACKET;
+}
+
+size_t ParallelPlugin::processPacketWindow(ts::TSPacketWindow& win)
+{
+    for (size_t i = 0; i < win.size(); ++i) {
+        ts::TSPacket* pkt = win.packet(i);
+        if (pkt != nullptr) {
+            const uint32_t seq = ts::GetUInt32(pkt->b + 4);
+            const ts::PID pid = pkt->getPID();
+            if (_per_pid) {
+                if (seq <= _last_sequence[pid]) {
+                    order_errors++;
+                }
+                _last_sequence[pid] = seq;
+            }
+            if (seq % 7 == 0) {
+                win.drop(i);
+            }
+            else {
+                pkt->b[8] = MARKER;
+            }
+        }
+    }
+    return win.size();
+}
+
+
+//----------------------------------------------------------------------------
+// Event handlers for memory input and output plugins: send packets with
+// sequence numbers, collect output sequence numbers.
+//----------------------------------------------------------------------------
+
+namespace {
+    class SequenceHandler : public ts::PluginEventHandlerInterface
+    {
+    public:
+        SequenceHandler(uint32_t count) : _count(count) {}
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+
+        std::vector<uint32_t> output {};
+        size_t                unmarked = 0;
+        ts::BitRate           bitrate = 0;  // Last bitrate in output plugin.
+
+    private:
+        const uint32_t _count;
+        uint32_t       _next = 1;
+    };
+}
+
+void SequenceHandler::handlePluginEvent(const ts::PluginEventContext& context)
+{
+    ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+    if (data != nullptr && !data->readOnly()) {
+        while (_next <= _count && data->size() + ts::PKT_SIZE <= data->maxSize()) {
+            ts::TSPacket pkt;
+            pkt.init(ts::PID(0x0100 + _next % 5));
+            ts::PutUInt32(pkt.b + 4, _next++);
+            data->append(&pkt, ts::PKT_SIZE);
+        }
+    }
+    else if (data != nullptr) {
+        bitrate = context.bitrate();
+        const ts::TSPacket* pkt = reinterpret_cast<const ts::TSPacket*>(data->data());
+        for (size_t i = 0; i < data->size() / ts::PKT_SIZE; ++i) {
+            output.push_back(ts::GetUInt32(pkt[i].b + 4));
+            if (pkt[i].b[8] != ParallelPlugin::MARKER) {
+                unmarked++;
+            }
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Unitary tests.
 //----------------------------------------------------------------------------
 
 TSUNIT_DEFINE_TEST(Processing)
+{
+    testProcessing(false);
+    testProcessing(true);
+}
+
+void TSProcessorTest::testProcessing(bool lock_free)
 {
     // Register our custom plugin with the name "test1".
     ts::PluginRepository::Instance().registerProcessor(u"test1", TestPlugin::CreateInstance);
@@ -208,6 +351,8 @@ TSUNIT_DEFINE_TEST(Processing)
         {u"test1", {u"--count", u"10"}},
     };
     opt.output = {u"drop"};
+    opt.fixed_bitrate = 1'000'000;
+    opt.lock_free = lock_free;
 
     // The TS processing is performed into this object.
     ts::TSProcessor tsproc(CERR);
@@ -242,6 +387,7 @@ TSUNIT_DEFINE_TEST(Processing)
     TSUNIT_EQUAL(1,          handler1.logs[1].index);
     TSUNIT_EQUAL(3,          handler1.logs[1].count);
     TSUNIT_EQUAL(0,          handler1.logs[1].packets);
+    TSUNIT_EQUAL(1'000'000,  handler1.logs[1].bitrate.toInt());
 
     TSUNIT_EQUAL(0xBEEF0003, handler1.logs[2].code);
     TSUNIT_EQUAL(1,          handler1.logs[2].data);
@@ -249,6 +395,7 @@ TSUNIT_DEFINE_TEST(Processing)
     TSUNIT_EQUAL(1,          handler1.logs[2].index);
     TSUNIT_EQUAL(3,          handler1.logs[2].count);
     TSUNIT_EQUAL(10,         handler1.logs[2].packets);
+    TSUNIT_EQUAL(1'000'000,  handler1.logs[2].bitrate.toInt());
 
     TSUNIT_EQUAL(0xBEEF0003, handler1.logs[3].code);
     TSUNIT_EQUAL(2,          handler1.logs[3].data);
@@ -256,6 +403,7 @@ TSUNIT_DEFINE_TEST(Processing)
     TSUNIT_EQUAL(1,          handler1.logs[3].index);
     TSUNIT_EQUAL(3,          handler1.logs[3].count);
     TSUNIT_EQUAL(20,         handler1.logs[3].packets);
+    TSUNIT_EQUAL(1'000'000,  handler1.logs[3].bitrate.toInt());
 
     TSUNIT_EQUAL(0xBEEF0002, handler1.logs[4].code);
     TSUNIT_EQUAL(-2,         handler1.logs[4].data);
@@ -263,6 +411,7 @@ TSUNIT_DEFINE_TEST(Processing)
     TSUNIT_EQUAL(1,          handler1.logs[4].index);
     TSUNIT_EQUAL(3,          handler1.logs[4].count);
     TSUNIT_EQUAL(26,         handler1.logs[4].packets);
+    TSUNIT_EQUAL(1'000'000,  handler1.logs[4].bitrate.toInt());
 
     // Only stop events were reported to handler2.
     TSUNIT_EQUAL(1, handler2.logs.size());
@@ -273,4 +422,92 @@ TSUNIT_DEFINE_TEST(Processing)
     TSUNIT_EQUAL(1,          handler2.logs[0].index);
     TSUNIT_EQUAL(3,          handler2.logs[0].count);
     TSUNIT_EQUAL(26,         handler2.logs[0].packets);
+    TSUNIT_EQUAL(1'000'000,  handler2.logs[0].bitrate.toInt());
+}
+
+TSUNIT_DEFINE_TEST(Parallel)
+{
+    testParallel(false);
+    testParallel(true);
+}
+
+void TSProcessorTest::testParallel(bool lock_free)
+{
+    ts::PluginRepository::Instance().registerProcessor(u"parallel_test", ParallelPlugin::CreateInstance);
+
+    for (bool per_pid : {true, false}) {
+        ts::TSProcessorArgs opt;
+        opt.app_name = u"TSProcessorTest::testParallel";
+        opt.input = {u"memory", {}};
+        opt.plugins = {
+            {u"parallel_test", {u"--parallel", u"4"}},
+        };
+        if (per_pid) {
+            opt.plugins[0].args.push_back(u"--per-pid");
+        }
+        opt.output = {u"memory", {}};
+        opt.fixed_bitrate = 2'000'000;
+        opt.lock_free = lock_free;
+
+        constexpr uint32_t count = 10'000;
+        SequenceHandler handler(count);
+        ParallelPlugin::order_errors = 0;
+
+        ts::TSProcessor tsproc(CERR);
+        tsproc.registerEventHandler(&handler, ts::PluginType::INPUT);
+        tsproc.registerEventHandler(&handler, ts::PluginType::OUTPUT);
+        TSUNIT_ASSERT(tsproc.start(opt));
+        tsproc.waitForTermination();
+
+        debug() << "TSProcessorTest::testParallel: " << (per_pid ? "per PID" : "per packet") << (lock_free ? ", lock-free" : "")
+                << ", output packets: " << handler.output.size() << std::endl;
+
+        // All packets, except the dropped ones, are in output, in the original order.
+        TSUNIT_EQUAL(count - count / 7, handler.output.size());
+        TSUNIT_EQUAL(0, handler.unmarked);
+        TSUNIT_EQUAL(0, ParallelPlugin::order_errors.load());
+        bool ordered = true;
+        for (size_t i = 1; ordered && i < handler.output.size(); ++i) {
+            ordered = handler.output[i - 1] < handler.output[i];
+        }
+        TSUNIT_ASSERT(ordered);
+        TSUNIT_EQUAL(2'000'000, handler.bitrate.toInt());
+    }
+}
+
+TSUNIT_DEFINE_TEST(JointTermination)
+{
+    // The input and two plugins use joint termination. The output stops after the
+    // highest number of packets when all of them declared their termination.
+    // The output must be identical with the global mutex and with lock-free hand-off.
+    std::vector<uint32_t> output[2];
+    ts::BitRate bitrate[2];
+    for (bool lock_free : {false, true}) {
+        ts::TSProcessorArgs opt;
+        opt.app_name = u"TSProcessorTest::testJointTermination";
+        opt.input = {u"null", {u"--joint-termination", u"1000"}};
+        opt.plugins = {
+            {u"until", {u"--joint-termination", u"--packets", u"3000"}},
+            {u"until", {u"--joint-termination", u"--packets", u"2000"}},
+        };
+        opt.output = {u"memory", {}};
+        opt.fixed_bitrate = 3'000'000;
+        opt.lock_free = lock_free;
+
+        SequenceHandler handler(0);
+        ts::TSProcessor tsproc(CERR);
+        tsproc.registerEventHandler(&handler, ts::PluginType::OUTPUT);
+        TSUNIT_ASSERT(tsproc.start(opt));
+        tsproc.waitForTermination();
+
+        debug() << "TSProcessorTest::testJointTermination: " << (lock_free ? "lock-free" : "global mutex")
+                << ", output packets: " << handler.output.size() << ", bitrate: " << handler.bitrate.toInt() << std::endl;
+        output[lock_free] = handler.output;
+        bitrate[lock_free] = handler.bitrate;
+    }
+    TSUNIT_ASSERT(output[0].size() >= 3000);
+    TSUNIT_ASSERT(output[0].size() <= 3001);
+    TSUNIT_ASSERT(output[0] == output[1]);
+    TSUNIT_EQUAL(3'000'000, bitrate[0].toInt());
+    TSUNIT_ASSERT(bitrate[0] == bitrate[1]);
 }
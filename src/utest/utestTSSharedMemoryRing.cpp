@@ -0,0 +1,178 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for TSSharedMemoryRing.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSSharedMemoryRing.h"
+#include "tsCerrReport.h"
+#include "tsNullReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSSharedMemoryRingTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(WriteRead);
+    TSUNIT_DECLARE_TEST(Overrun);
+    TSUNIT_DECLARE_TEST(EndOfStream);
+
+private:
+    // Unique ring name for the test process.
+    static ts::UString RingName();
+
+    // Build a packet with a sequence number in the payload.
+    static void MakePacket(ts::TSPacket& pkt, uint32_t seq);
+    static uint32_t PacketSequence(const ts::TSPacket& pkt);
+};
+
+TSUNIT_REGISTER(TSSharedMemoryRingTest);
+
+
+//----------------------------------------------------------------------------
+// Support functions.
+//----------------------------------------------------------------------------
+
+ts::UString TSSharedMemoryRingTest::RingName()
+{
+    return u"utest-" + ts::UString::Decimal(cn::steady_clock::now().time_since_epoch().count(), 0, true, u"");
+}
+
+void TSSharedMemoryRingTest::MakePacket(ts::TSPacket& pkt, uint32_t seq)
+{
+    pkt = ts::NullPacket;
+    ts::PutUInt32(pkt.b + 4, seq);
+}
+
+uint32_t TSSharedMemoryRingTest::PacketSequence(const ts::TSPacket& pkt)
+{
+    return ts::GetUInt32(pkt.b + 4);
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(WriteRead)
+{
+    const ts::UString name(RingName());
+    ts::TSSharedMemoryRing writer;
+    ts::TSSharedMemoryRing reader;
+
+    TSUNIT_ASSERT(writer.openWriter(name, 100, CERR));
+    TSUNIT_ASSERT(writer.isOpen());
+    TSUNIT_ASSERT(writer.isWriter());
+    TSUNIT_EQUAL(100, writer.capacity());
+
+    TSUNIT_ASSERT(reader.openReader(name, CERR));
+    TSUNIT_ASSERT(reader.isOpen());
+    TSUNIT_ASSERT(!reader.isWriter());
+    TSUNIT_EQUAL(100, reader.capacity());
+
+    // Write 150 packets in 3 steps, read them in 4 steps, crossing the end of ring.
+    ts::TSPacketVector packets(150);
+    ts::TSPacketMetadataVector mdata(150);
+    for (uint32_t i = 0; i < packets.size(); ++i) {
+        MakePacket(packets[i], i);
+        mdata[i].setLabel(i % ts::TSPacketLabelSet::SIZE);
+    }
+    writer.setBitrate(1'234'567, ts::BitRateConfidence::PCR_AVERAGE);
+
+    ts::TSPacketVector rpackets(150);
+    ts::TSPacketMetadataVector rmdata(150);
+    uint64_t lost = 0;
+    size_t rcount = 0;
+
+    TSUNIT_ASSERT(writer.write(&packets[0], &mdata[0], 60));
+    TSUNIT_EQUAL(40, reader.read(&rpackets[rcount], &rmdata[rcount], 40, lost));
+    TSUNIT_EQUAL(0, lost);
+    rcount += 40;
+    TSUNIT_EQUAL(20, reader.read(&rpackets[rcount], &rmdata[rcount], 100, lost));
+    TSUNIT_EQUAL(0, lost);
+    rcount += 20;
+    TSUNIT_EQUAL(0, reader.read(&rpackets[rcount], &rmdata[rcount], 100, lost));
+
+    TSUNIT_ASSERT(writer.write(&packets[60], &mdata[60], 50));
+    TSUNIT_ASSERT(writer.write(&packets[110], &mdata[110], 40));
+    TSUNIT_EQUAL(90, reader.read(&rpackets[rcount], &rmdata[rcount], 150, lost));
+    TSUNIT_EQUAL(0, lost);
+    rcount += 90;
+    TSUNIT_EQUAL(150, rcount);
+
+    for (uint32_t i = 0; i < rpackets.size(); ++i) {
+        TSUNIT_EQUAL(i, PacketSequence(rpackets[i]));
+        TSUNIT_ASSERT(rmdata[i].hasLabel(i % ts::TSPacketLabelSet::SIZE));
+    }
+
+    TSUNIT_EQUAL(1'234'567, reader.bitrate().toInt());
+    TSUNIT_ASSERT(reader.bitrateConfidence() == ts::BitRateConfidence::PCR_AVERAGE);
+
+    TSUNIT_ASSERT(reader.close(CERR));
+    TSUNIT_ASSERT(writer.close(CERR));
+    TSUNIT_ASSERT(!writer.isOpen());
+
+    // The ring no longer exists.
+    ts::TSSharedMemoryRing reader2;
+    TSUNIT_ASSERT(!reader2.openReader(name, NULLREP));
+}
+
+TSUNIT_DEFINE_TEST(Overrun)
+{
+    const ts::UString name(RingName());
+    ts::TSSharedMemoryRing writer;
+    ts::TSSharedMemoryRing reader;
+
+    TSUNIT_ASSERT(writer.openWriter(name, 100, CERR));
+    TSUNIT_ASSERT(reader.openReader(name, CERR));
+
+    ts::TSPacketVector packets(250);
+    for (uint32_t i = 0; i < packets.size(); ++i) {
+        MakePacket(packets[i], i);
+    }
+
+    // The reader is too slow, only the last 100 packets are available.
+    TSUNIT_ASSERT(writer.write(&packets[0], nullptr, 80));
+    TSUNIT_ASSERT(writer.write(&packets[80], nullptr, 170));
+
+    ts::TSPacketVector rpackets(250);
+    uint64_t lost = 0;
+    TSUNIT_EQUAL(100, reader.read(&rpackets[0], nullptr, 250, lost));
+    TSUNIT_EQUAL(150, lost);
+    for (uint32_t i = 0; i < 100; ++i) {
+        TSUNIT_EQUAL(150 + i, PacketSequence(rpackets[i]));
+    }
+    TSUNIT_EQUAL(0, reader.read(&rpackets[0], nullptr, 250, lost));
+    TSUNIT_EQUAL(0, lost);
+}
+
+TSUNIT_DEFINE_TEST(EndOfStream)
+{
+    const ts::UString name(RingName());
+    ts::TSSharedMemoryRing writer;
+    ts::TSSharedMemoryRing reader;
+
+    TSUNIT_ASSERT(writer.openWriter(name, 10, CERR));
+    TSUNIT_ASSERT(reader.openReader(name, CERR));
+    TSUNIT_ASSERT(!reader.endOfStream());
+
+    ts::TSPacketVector packets(5);
+    TSUNIT_ASSERT(writer.write(&packets[0], nullptr, packets.size()));
+    TSUNIT_ASSERT(writer.close(CERR));
+
+    // Remaining packets are still available after the writer terminated.
+    TSUNIT_ASSERT(!reader.endOfStream());
+    uint64_t lost = 0;
+    TSUNIT_EQUAL(5, reader.read(&packets[0], nullptr, packets.size(), lost));
+    TSUNIT_ASSERT(reader.endOfStream());
+    TSUNIT_EQUAL(0, reader.read(&packets[0], nullptr, packets.size(), lost));
+}
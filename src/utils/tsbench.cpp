@@ -0,0 +1,571 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+// Reproducible benchmark of canonical tsp plugin chains.
+//
+// Each chain is executed by a complete transport stream processor, the same
+// as tsp. The input is a deterministic synthetic transport stream which is
+// generated in memory and passed through the "memory" input plugin. The
+// output is always the "drop" plugin. The results (packets per second,
+// nanoseconds per packet, memory allocations per packet) can be produced in
+// JSON format to track performance regressions across TSDuck versions.
+//
+// Memory allocations are counted by replacing the global operator new.
+// This works with the shared TSDuck library on Linux and macOS only, where
+// the replacement applies to the complete process. On Windows, only the
+// allocations from the executable are counted.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsDuckContext.h"
+#include "tsAsyncReport.h"
+#include "tsTSProcessor.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
+#include "tsOneShotPacketizer.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsSDT.h"
+#include "tsEIT.h"
+#include "tsShortEventDescriptor.h"
+#include "tsExtendedEventDescriptor.h"
+#include "tsTSFile.h"
+#include "tsjsonOutputArgs.h"
+#include "tsjsonObject.h"
+#include "tsVersionInfo.h"
+#include "tsSysUtils.h"
+#include "tsFileUtils.h"
+#include "tsTime.h"
+TS_MAIN(MainCode);
+
+
+//----------------------------------------------------------------------------
+// Count memory allocations in the complete process.
+//----------------------------------------------------------------------------
+
+namespace {
+    std::atomic<uint64_t> alloc_count {0};
+    std::atomic<uint64_t> alloc_bytes {0};
+}
+
+void* operator new(std::size_t size)
+{
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+
+//----------------------------------------------------------------------------
+// Description of the synthetic transport stream.
+//----------------------------------------------------------------------------
+
+namespace {
+    // One cycle of 100 packets lasts 10 ms, 15.04 Mb/s.
+    constexpr size_t   CYCLE_PACKETS = 100;
+    constexpr uint64_t CYCLE_PCR = ts::SYSTEM_CLOCK_FREQ / 100;
+
+    // The pattern is a multiple of 16 cycles. Since all PID's have a number of packets per
+    // cycle which is a multiple of 16, the continuity counters loop without discontinuity.
+    constexpr size_t PATTERN_CYCLES = 16;
+    constexpr size_t PATTERN_PACKETS = PATTERN_CYCLES * CYCLE_PACKETS;
+
+    // Layout of one cycle: PAT, PMT, SDT, video (with PCR), audio, data, stuffing.
+    constexpr uint16_t TS_ID = 0x0001;
+    constexpr uint16_t SERVICE_ID = 0x0001;
+    constexpr ts::PID  PMT_PID = 0x0100;
+    constexpr ts::PID  VIDEO_PID = 0x0101;
+    constexpr ts::PID  AUDIO_PID = 0x0102;
+    constexpr ts::PID  DATA_PID = 0x0103;
+    constexpr ts::PID  MUX_PID = 0x0200;
+    constexpr size_t   PCR_SLOT = 3;
+    constexpr size_t   VIDEO_SLOT = 3;
+    constexpr size_t   AUDIO_SLOT = 63;
+    constexpr size_t   DATA_SLOT = 83;
+    constexpr size_t   NULL_SLOT = 93;
+
+    // EIT schedule which is muxed in the "eit" chain.
+    constexpr size_t   EIT_SERVICES = 8;
+    constexpr size_t   EIT_EVENTS = 24;
+}
+
+
+//----------------------------------------------------------------------------
+// Description of the benchmarked chains.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Placeholders in plugin arguments, replaced by actual file names.
+    const ts::UString OUT_FILE(u"{output-file}");
+    const ts::UString MUX_FILE(u"{mux-file}");
+    const ts::UString EIT_FILE(u"{eit-file}");
+
+    // Command which reads and discards its standard input, for the fork plugin.
+#if defined(TS_WINDOWS)
+    const ts::UString SINK_COMMAND(u"more > NUL");
+#else
+    const ts::UString SINK_COMMAND(u"cat > /dev/null");
+#endif
+
+    struct Chain
+    {
+        ts::UString             name {};
+        ts::UString             description {};
+        ts::PluginOptionsVector plugins {};
+    };
+
+    const std::vector<Chain> chains {
+        {u"null", u"no packet processor, input and output overhead only", {}},
+        {u"analyze", u"global transport stream analysis", {
+            {u"analyze", {u"--output-file", OUT_FILE}},
+        }},
+        {u"filter-remap", u"PID filtering and remapping", {
+            {u"filter", {u"--pid", u"0x0000-0x0103", u"--pid", u"0x1FFF"}},
+            {u"remap", {u"0x0101=0x0201", u"0x0102=0x0202"}},
+        }},
+        {u"scrambling", u"DVB-CSA2 scrambling and descrambling of a service", {
+            {u"scrambler", {u"0x0001", u"--cw", u"0123456789ABCDEF"}},
+            {u"descrambler", {u"0x0001", u"--cw", u"0123456789ABCDEF"}},
+        }},
+        {u"pes", u"PES packets analysis", {
+            {u"pes", {u"--output-file", OUT_FILE}},
+        }},
+        {u"tables", u"demux and display of all sections", {
+            {u"tables", {u"--all-sections", u"--output-file", OUT_FILE}},
+        }},
+        {u"mux", u"insertion of packets from a file in stuffing", {
+            {u"mux", {MUX_FILE, u"--pid", u"0x0200"}},
+        }},
+        {u"eit", u"insertion and deserialization of EIT schedule", {
+            {u"mux", {EIT_FILE, u"--pid", u"0x0012"}},
+            {u"eit", {u"--epg-dump", u"--output-file", OUT_FILE}},
+        }},
+        {u"regulate", u"bitrate regulation at very high bitrate", {
+            {u"regulate", {u"--bitrate", u"100000000000"}},
+        }},
+        {u"fork", u"send packets to a process through a pipe, small writes", {
+            {u"fork", {u"--buffered-packets", u"100", SINK_COMMAND}},
+        }},
+        {u"fork-large", u"send packets to a process through a large pipe", {
+            {u"fork", {u"--buffered-packets", u"5000", SINK_COMMAND}},
+        }},
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class Options: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(Options);
+    public:
+        Options(int argc, char *argv[]);
+
+        ts::DuckContext    duck {this};
+        ts::json::OutputArgs json {};
+        ts::PacketCounter  packets = 0;
+        size_t             repeat = 0;
+        bool               list = false;
+        ts::UStringVector  chain_names {};
+    };
+}
+
+Options::Options(int argc, char *argv[]) :
+    ts::Args(u"Reproducible benchmark of canonical tsp plugin chains", u"[options]")
+{
+    json.defineArgs(*this, true, u"Report the benchmark results in JSON format.");
+
+    ts::Names names;
+    for (size_t i = 0; i < chains.size(); ++i) {
+        names.add(chains[i].name, ts::Names::int_t(i));
+    }
+    option(u"chain", 'c', names, 0, UNLIMITED_COUNT);
+    help(u"chain", u"name",
+         u"Run the specified chain only. Several --chain options may be specified. "
+         u"By default, all chains are run. Use --list to get the list of chains.");
+
+    option(u"list", 'l');
+    help(u"list", u"List the available chains and exit.");
+
+    option(u"packets", 'p', POSITIVE);
+    help(u"packets", u"Number of TS packets to process in each chain. The default is 1,000,000.");
+
+    option(u"repeat", 'r', POSITIVE);
+    help(u"repeat",
+         u"Run each chain the specified number of times and report the fastest execution. "
+         u"The default is 3.");
+
+    analyze(argc, argv);
+
+    json.loadArgs(duck, *this);
+    getIntValue(packets, u"packets", 1'000'000);
+    getIntValue(repeat, u"repeat", 3);
+    getValues(chain_names, u"chain");
+    list = present(u"list");
+
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+// Build the synthetic transport stream pattern.
+//----------------------------------------------------------------------------
+
+static void BuildPattern(ts::TSPacketVector& pattern)
+{
+    ts::DuckContext duck;
+
+    // Signalization: one packet per table.
+    ts::PAT pat(0, true, TS_ID);
+    pat.pmts[SERVICE_ID] = PMT_PID;
+    ts::PMT pmt(0, true, SERVICE_ID, VIDEO_PID);
+    pmt.streams[VIDEO_PID].stream_type = ts::ST_MPEG2_VIDEO;
+    pmt.streams[AUDIO_PID].stream_type = ts::ST_MPEG1_AUDIO;
+    pmt.streams[DATA_PID].stream_type = ts::ST_PES_PRIV;
+    ts::SDT sdt(true, 0, true, TS_ID, TS_ID);
+    sdt.services[SERVICE_ID].setName(duck, u"tsbench");
+
+    ts::TSPacketVector pat_pkt, pmt_pkt, sdt_pkt;
+    ts::OneShotPacketizer pzer(duck, ts::PID_PAT);
+    pzer.addTable(duck, pat);
+    pzer.getPackets(pat_pkt);
+    pzer.setPID(PMT_PID);
+    pzer.addTable(duck, pmt);
+    pzer.getPackets(pmt_pkt);
+    pzer.setPID(ts::PID_SDT);
+    pzer.addTable(duck, sdt);
+    pzer.getPackets(sdt_pkt);
+
+    // Build all cycles, payloads are filled with a deterministic pseudo-random sequence.
+    pattern.resize(PATTERN_PACKETS);
+    uint32_t rnd = 0x12345678;
+    std::map<ts::PID, uint8_t> cc;
+    for (size_t index = 0; index < PATTERN_PACKETS; ++index) {
+        const size_t cycle = index / CYCLE_PACKETS;
+        const size_t slot = index % CYCLE_PACKETS;
+        ts::TSPacket& pkt(pattern[index]);
+
+        if (slot == 0 && !pat_pkt.empty()) {
+            pkt = pat_pkt.front();
+        }
+        else if (slot == 1 && !pmt_pkt.empty()) {
+            pkt = pmt_pkt.front();
+        }
+        else if (slot == 2 && !sdt_pkt.empty()) {
+            pkt = sdt_pkt.front();
+        }
+        else if (slot >= NULL_SLOT) {
+            pkt = ts::NullPacket;
+            continue;
+        }
+        else {
+            const ts::PID pid = slot >= DATA_SLOT ? DATA_PID : (slot >= AUDIO_SLOT ? AUDIO_PID : VIDEO_PID);
+            pkt.init(pid);
+            for (size_t i = ts::PKT_HEADER_SIZE; i < ts::PKT_SIZE; ++i) {
+                rnd = rnd * 1103515245 + 12345;
+                pkt.b[i] = uint8_t(rnd >> 16);
+            }
+            if (slot == PCR_SLOT) {
+                pkt.setPCR(cycle * CYCLE_PCR, true);
+            }
+            // One PES packet per cycle on video (unbounded) and audio (bounded).
+            if (slot == VIDEO_SLOT || slot == AUDIO_SLOT) {
+                uint8_t* pl = pkt.getPayload();
+                const size_t pes_size = slot == AUDIO_SLOT ? (DATA_SLOT - AUDIO_SLOT) * ts::PKT_MAX_PAYLOAD_SIZE : 0;
+                pl[0] = 0x00; pl[1] = 0x00; pl[2] = 0x01;
+                pl[3] = slot == AUDIO_SLOT ? 0xC0 : 0xE0;
+                ts::PutUInt16(pl + 4, uint16_t(pes_size == 0 ? 0 : pes_size - 6));
+                pl[6] = 0x80; pl[7] = 0x80; pl[8] = 0x05;
+                pkt.setPUSI();
+                pkt.setPTS(cycle * CYCLE_PCR / ts::SYSTEM_CLOCK_SUBFACTOR);
+            }
+        }
+
+        // Continuity counters.
+        const ts::PID pid = pkt.getPID();
+        pkt.setCC(cc[pid]);
+        cc[pid] = (cc[pid] + 1) & ts::CC_MASK;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Build the EIT schedule which is muxed in the "eit" chain.
+//----------------------------------------------------------------------------
+
+static void BuildEIT(ts::TSPacketVector& packets)
+{
+    ts::DuckContext duck;
+    ts::OneShotPacketizer pzer(duck, ts::PID_EIT);
+    const ts::Time start(2025, 1, 1, 0, 0);
+
+    // Each event has the typical descriptors of an EPG, only a few of them are used by the "eit" plugin.
+    const uint8_t content[] {ts::DID_DVB_CONTENT, 2, 0x10, 0x00};
+    const uint8_t rating[] {ts::DID_DVB_PARENTAL_RATING, 4, 'f', 'r', 'a', 0x08};
+    const uint8_t component[] {ts::DID_DVB_COMPONENT, 6, 0x05, 0x03, 0x01, 'f', 'r', 'a'};
+
+    for (uint16_t srv = 0; srv < EIT_SERVICES; ++srv) {
+        ts::EIT eit(true, false, 0, 0, true, uint16_t(SERVICE_ID + srv), TS_ID, TS_ID);
+        for (uint16_t evt = 0; evt < EIT_EVENTS; ++evt) {
+            ts::EIT::Event& ev(eit.events.newEntry());
+            ev.event_id = evt;
+            ev.start_time = start + cn::minutes(30 * evt);
+            ev.duration = cn::minutes(30);
+            ev.running_status = 1;
+            ev.descs.add(duck, ts::ShortEventDescriptor(u"fra", ts::UString::Format(u"Event %d", evt), u"Short description of the event"));
+            ts::ExtendedEventDescriptor ext;
+            ext.language_code = u"fra";
+            ext.text = u"Extended description of the event, as found in most EPG";
+            ev.descs.add(duck, ext);
+            ev.descs.add(content);
+            ev.descs.add(rating);
+            ev.descs.add(component);
+        }
+        pzer.addTable(duck, eit);
+    }
+    pzer.getPackets(packets);
+}
+
+
+//----------------------------------------------------------------------------
+// Write packets in a file, return false on error.
+//----------------------------------------------------------------------------
+
+static bool WritePackets(const ts::UString& file_name, const ts::TSPacketVector& packets, ts::Report& report)
+{
+    ts::TSFile file;
+    return file.open(file_name, ts::TSFile::WRITE, report) && file.writePackets(packets.data(), nullptr, packets.size(), report) && file.close(report);
+}
+
+
+//----------------------------------------------------------------------------
+// Input event handler for the "memory" plugin.
+//----------------------------------------------------------------------------
+
+namespace {
+    class InputHandler : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(InputHandler);
+    public:
+        InputHandler(const ts::TSPacketVector& pattern, ts::PacketCounter packets) : _pattern(pattern), _packets(packets) {}
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+    private:
+        const ts::TSPacketVector& _pattern;
+        const ts::PacketCounter   _packets;
+        ts::PacketCounter         _next = 0;
+    };
+}
+
+void InputHandler::handlePluginEvent(const ts::PluginEventContext& context)
+{
+    ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+    if (data == nullptr || data->outputData() == nullptr) {
+        return;
+    }
+
+    ts::TSPacket* out = reinterpret_cast<ts::TSPacket*>(data->outputData());
+    const size_t count = size_t(std::min<ts::PacketCounter>(data->maxSize() / ts::PKT_SIZE, _packets - _next));
+
+    for (size_t done = 0; done < count; ) {
+        // Copy a contiguous chunk of the pattern.
+        const size_t start = size_t(_next % PATTERN_PACKETS);
+        const size_t chunk = std::min(count - done, PATTERN_PACKETS - start);
+        ts::TSPacket::Copy(out + done, _pattern.data() + start, chunk);
+
+        // Adjust the PCR's to make them continuous when the pattern loops.
+        const uint64_t offset = (_next / PATTERN_PACKETS) * PATTERN_CYCLES * CYCLE_PCR;
+        if (offset > 0) {
+            for (size_t i = 0; i < chunk; ++i) {
+                if ((start + i) % CYCLE_PACKETS == PCR_SLOT) {
+                    out[done + i].setPCR((out[done + i].getPCR() + offset) % ts::PCR_SCALE);
+                }
+            }
+        }
+        done += chunk;
+        _next += chunk;
+    }
+    data->updateSize(count * ts::PKT_SIZE);
+}
+
+
+//----------------------------------------------------------------------------
+// Execute one chain, return false on error.
+//----------------------------------------------------------------------------
+
+namespace {
+    struct Result
+    {
+        cn::nanoseconds  duration {};
+        cn::milliseconds cpu {};
+        uint64_t         allocs = 0;
+        uint64_t         bytes = 0;
+    };
+
+    bool RunChain(const Chain& chain, const ts::TSPacketVector& pattern, const Options& opt, const ts::UString& mux_file, const ts::UString& eit_file, Result& res, ts::Report& report)
+    {
+        // Build the plugin options, replacing file names.
+        const ts::UString out_file(ts::TempFile(u".txt"));
+        ts::TSProcessorArgs args;
+        args.app_name = u"tsbench";
+        args.input = {u"memory", {}};
+        args.output = {u"drop", {}};
+        args.plugins = chain.plugins;
+        for (auto& pl : args.plugins) {
+            for (auto& arg : pl.args) {
+                if (arg == OUT_FILE) {
+                    arg = out_file;
+                }
+                else if (arg == MUX_FILE) {
+                    arg = mux_file;
+                }
+                else if (arg == EIT_FILE) {
+                    arg = eit_file;
+                }
+            }
+        }
+
+        InputHandler input(pattern, opt.packets);
+        ts::TSProcessor tsp(report);
+        tsp.registerEventHandler(&input, ts::PluginType::INPUT);
+
+        const uint64_t allocs = alloc_count.load(std::memory_order_relaxed);
+        const uint64_t bytes = alloc_bytes.load(std::memory_order_relaxed);
+        const cn::milliseconds cpu = ts::GetProcessCpuTime();
+        const ts::monotonic_time start = ts::monotonic_time::clock::now();
+
+        const bool ok = tsp.start(args);
+        if (ok) {
+            tsp.waitForTermination();
+        }
+
+        res.duration = ts::monotonic_time::clock::now() - start;
+        res.cpu = ts::GetProcessCpuTime() - cpu;
+        res.allocs = alloc_count.load(std::memory_order_relaxed) - allocs;
+        res.bytes = alloc_bytes.load(std::memory_order_relaxed) - bytes;
+
+        fs::remove(out_file, &ts::ErrCodeReport(report, u"error deleting", out_file));
+        return ok;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Program entry point
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    Options opt(argc, argv);
+
+    if (opt.list) {
+        for (const auto& ch : chains) {
+            std::cout << ch.name.toJustifiedLeft(15) << ch.description << std::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // Plugins are executed in separate threads, use an asynchronous report.
+    ts::AsyncReport report(opt.maxSeverity());
+
+    // Build the synthetic input and the files to mux.
+    ts::TSPacketVector pattern;
+    BuildPattern(pattern);
+    const ts::UString mux_file(ts::TempFile(u".ts"));
+    const ts::UString eit_file(ts::TempFile(u".ts"));
+    {
+        ts::TSPacketVector mux(CYCLE_PACKETS);
+        for (size_t i = 0; i < mux.size(); ++i) {
+            mux[i].init(MUX_PID, uint8_t(i & ts::CC_MASK), uint8_t(i));
+        }
+        ts::TSPacketVector eit;
+        BuildEIT(eit);
+        if (!WritePackets(mux_file, mux, report) || !WritePackets(eit_file, eit, report)) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    // JSON root object.
+    ts::json::Object jroot;
+    jroot.add(u"version", ts::VersionInfo::GetVersion());
+    jroot.add(u"date", ts::Time::CurrentUTC().format(ts::Time::DATETIME));
+    jroot.add(u"packets", opt.packets);
+    jroot.add(u"repeat", opt.repeat);
+
+    if (!opt.json.useJSON()) {
+        std::cout << ts::UString::Format(u"%-15s %12s %10s %10s %10s %10s", u"Chain", u"Packets/s", u"ns/packet", u"cpu ns/pkt", u"alloc/pkt", u"bytes/pkt") << std::endl;
+    }
+
+    bool success = true;
+    for (const auto& ch : chains) {
+        if (!opt.chain_names.empty() && std::find(opt.chain_names.begin(), opt.chain_names.end(), ch.name) == opt.chain_names.end()) {
+            continue;
+        }
+
+        // Keep the fastest execution.
+        Result best;
+        bool ok = true;
+        for (size_t iter = 0; ok && iter < opt.repeat; ++iter) {
+            Result res;
+            ok = RunChain(ch, pattern, opt, mux_file, eit_file, res, report);
+            if (ok && (iter == 0 || res.duration < best.duration)) {
+                best = res;
+            }
+        }
+        if (!ok) {
+            report.error(u"chain %s failed", ch.name);
+            success = false;
+            continue;
+        }
+
+        const double pkt = double(opt.packets);
+        const double sec = double(best.duration.count()) / 1e9;
+        const double pps = sec <= 0.0 ? 0.0 : pkt / sec;
+        const double ns = double(best.duration.count()) / pkt;
+        const double cpu_ns = double(cn::duration_cast<cn::nanoseconds>(best.cpu).count()) / pkt;
+        const double allocs = double(best.allocs) / pkt;
+        const double bytes = double(best.bytes) / pkt;
+
+        if (opt.json.useJSON()) {
+            ts::json::Value& jv(jroot.query(u"chains[]", true));
+            jv.add(u"name", ch.name);
+            jv.add(u"description", ch.description);
+            jv.add(u"duration-ms", cn::duration_cast<cn::milliseconds>(best.duration).count());
+            jv.add(u"cpu-ms", best.cpu.count());
+            jv.add(u"packets-per-second", uint64_t(pps));
+            jv.add(u"ns-per-packet", ns);
+            jv.add(u"cpu-ns-per-packet", cpu_ns);
+            jv.add(u"allocations", best.allocs);
+            jv.add(u"allocations-per-packet", allocs);
+            jv.add(u"bytes-per-packet", bytes);
+        }
+        else {
+            std::cout << ts::UString::Format(u"%-15s %12'd %10.1f %10.1f %10.3f %10.1f", ch.name, uint64_t(pps), ns, cpu_ns, allocs, bytes) << std::endl;
+        }
+    }
+
+    fs::remove(mux_file, &ts::ErrCodeReport(report, u"error deleting", mux_file));
+    fs::remove(eit_file, &ts::ErrCodeReport(report, u"error deleting", eit_file));
+    opt.json.report(jroot, std::cout, report);
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}